@@ -0,0 +1,251 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    Host test of clkm.c against the AHBCLK and APBCLK bit layout
+ *
+ * @note     CLK and SYS are plain memory at their real addresses and the module clocks are switched by clk.c.
+ *           The gate of every one of the 23 module indexes is checked against its enable bit, alone and
+ *           together with bits set by others. WDT_MODULE and WWDT_MODULE share one count. Also covered are
+ *           WDT_EN, whose writes are refused while the registers are locked, the slot and reference limits,
+ *           the single holder reset, and the active time across the wrap of the 32-bit microsecond time.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+static uint32_t s_u32Now;               /* Microsecond time */
+#define CLKM_GET_US()   (s_u32Now)
+
+#include "NUC029xAN.h"
+#include "host.h"
+
+uint32_t SystemCoreClock = 50000000;
+uint32_t CyclesPerUs = 50;
+uint32_t PllClock = 50000000;
+
+void SystemCoreClockUpdate(void)
+{
+}
+
+#include "../../Library/StdDriver/src/clk.c"
+
+static uint32_t s_u32Resets, s_u32LastRst;
+
+uint32_t SYS_IsRegLocked(void)
+{
+    return !(SYS->REGWRPROT & SYS_REGWRPROT_REGPROTDIS_Msk);
+}
+
+void SYS_ResetModule(uint32_t u32ModuleIndex)
+{
+    s_u32Resets++;
+    s_u32LastRst = u32ModuleIndex;
+}
+
+/* WDT_EN only changes while unlocked, that is REGPROTDIS set or the last key just written */
+static uint32_t s_u32Protected;
+
+static void Test_Gate(uint32_t u32ModuleIdx, uint32_t u32On)
+{
+    if((u32ModuleIdx == WDT_MODULE) || (u32ModuleIdx == WWDT_MODULE))
+    {
+        if((SYS->REGWRPROT != SYS_REGWRPROT_REGPROTDIS_Msk) && (SYS->REGWRPROT != 0x88))
+        {
+            s_u32Protected++;
+            return;
+        }
+    }
+    if(u32On)
+        CLK_EnableModuleClock(u32ModuleIdx);
+    else
+        CLK_DisableModuleClock(u32ModuleIdx);
+}
+
+#define CLK_EnableModuleClock(u32ModuleIdx)     Test_Gate(u32ModuleIdx, 1)
+#define CLK_DisableModuleClock(u32ModuleIdx)    Test_Gate(u32ModuleIdx, 0)
+
+#include "../../Library/StdDriver/src/clkm.c"
+
+typedef struct
+{
+    uint32_t u32Module;
+    uint32_t u32Apb;                    /* 0 in AHBCLK, 1 in APBCLK */
+    uint32_t u32Msk;
+} MODULE_T;
+
+static const MODULE_T s_asModule[] =
+{
+    {ISP_MODULE,    0, CLK_AHBCLK_ISP_EN_Msk},
+    {EBI_MODULE,    0, CLK_AHBCLK_EBI_EN_Msk},
+    {HDIV_MODULE,   0, CLK_AHBCLK_HDIV_EN_Msk},
+    {WDT_MODULE,    1, CLK_APBCLK_WDT_EN_Msk},
+    {WWDT_MODULE,   1, CLK_APBCLK_WDT_EN_Msk},
+    {TMR0_MODULE,   1, CLK_APBCLK_TMR0_EN_Msk},
+    {TMR1_MODULE,   1, CLK_APBCLK_TMR1_EN_Msk},
+    {TMR2_MODULE,   1, CLK_APBCLK_TMR2_EN_Msk},
+    {TMR3_MODULE,   1, CLK_APBCLK_TMR3_EN_Msk},
+    {FDIV_MODULE,   1, CLK_APBCLK_FDIV_EN_Msk},
+    {I2C0_MODULE,   1, CLK_APBCLK_I2C0_EN_Msk},
+    {I2C1_MODULE,   1, CLK_APBCLK_I2C1_EN_Msk},
+    {SPI0_MODULE,   1, CLK_APBCLK_SPI0_EN_Msk},
+    {SPI1_MODULE,   1, CLK_APBCLK_SPI1_EN_Msk},
+    {UART0_MODULE,  1, CLK_APBCLK_UART0_EN_Msk},
+    {UART1_MODULE,  1, CLK_APBCLK_UART1_EN_Msk},
+    {PWM01_MODULE,  1, CLK_APBCLK_PWM01_EN_Msk},
+    {PWM23_MODULE,  1, CLK_APBCLK_PWM23_EN_Msk},
+    {PWM45_MODULE,  1, CLK_APBCLK_PWM45_EN_Msk},
+    {PWM67_MODULE,  1, CLK_APBCLK_PWM67_EN_Msk},
+    {ADC_MODULE,    1, CLK_APBCLK_ADC_EN_Msk},
+    {ACMP01_MODULE, 1, CLK_APBCLK_ACMP01_EN_Msk},
+    {ACMP23_MODULE, 1, CLK_APBCLK_ACMP23_EN_Msk},
+};
+
+#define MODULE_NUM  (sizeof(s_asModule) / sizeof(s_asModule[0]))
+
+static void ClearSlots(void)
+{
+    memset(s_asClkmSlot, 0, sizeof(s_asClkmSlot));
+    s_u32ClkmSlots = 0;
+}
+
+static volatile uint32_t *GateReg(const MODULE_T *psModule, uint32_t u32Other)
+{
+    return (psModule->u32Apb ^ u32Other) ? &CLK->APBCLK : &CLK->AHBCLK;
+}
+
+int main(void)
+{
+    const MODULE_T *psModule;
+    CLKM_STATS_T sStats;
+    uint32_t i, j, u32Gate, u32Found, u32Own, u32Other;
+
+    if(HOST_MapPeripherals() != 0)
+    {
+        printf("cannot map peripherals\n");
+        return 1;
+    }
+    SYS->REGWRPROT = SYS_REGWRPROT_REGPROTDIS_Msk;
+
+    CHECK(MODULE_NUM == 23);
+
+    /* Gate index matches the register bit, one table entry with a current per gate */
+    for(i = 0; i < MODULE_NUM; i++)
+    {
+        psModule = &s_asModule[i];
+        u32Gate = CLKM_GATE(psModule->u32Module);
+        CHECK((u32Gate >> 5) == psModule->u32Apb && (1UL << (u32Gate & 0x1F)) == psModule->u32Msk);
+        for(j = 0, u32Found = 0; j < sizeof(s_asClkmInfo) / sizeof(s_asClkmInfo[0]); j++)
+        {
+            if(s_asClkmInfo[j].u8Gate == u32Gate)
+            {
+                u32Found++;
+                CHECK(s_asClkmInfo[j].u16MicroAmp > 0);
+            }
+        }
+        CHECK(u32Found == 1);
+    }
+
+    /* Each module alone switches its bit only, bits enabled elsewhere stay */
+    for(i = 0; i < MODULE_NUM; i++)
+    {
+        psModule = &s_asModule[i];
+        ClearSlots();
+        CLK->AHBCLK = CLK_AHBCLK_ISP_EN_Msk | CLK_AHBCLK_HDIV_EN_Msk;
+        CLK->APBCLK = CLK_APBCLK_I2C1_EN_Msk | CLK_APBCLK_UART0_EN_Msk;
+        *GateReg(psModule, 0) &= ~psModule->u32Msk;
+        u32Own = *GateReg(psModule, 0);
+        u32Other = *GateReg(psModule, 1);
+        CHECK(CLKM_Acquire(psModule->u32Module) == 1);
+        CHECK(*GateReg(psModule, 0) == (u32Own | psModule->u32Msk) && *GateReg(psModule, 1) == u32Other);
+        CHECK(CLKM_Acquire(psModule->u32Module) == 2 && CLKM_GetRef(psModule->u32Module) == 2);
+        CHECK(CLKM_Release(psModule->u32Module) == 1 && (*GateReg(psModule, 0) & psModule->u32Msk));
+        CHECK(CLKM_Release(psModule->u32Module) == 0);
+        CHECK(*GateReg(psModule, 0) == u32Own && *GateReg(psModule, 1) == u32Other);
+        CHECK(CLKM_Release(psModule->u32Module) == -1);
+    }
+
+    /* UART0 and UART1 are separate gates, WDT and WWDT one */
+    ClearSlots();
+    CLK->APBCLK = 0;
+    CLKM_Acquire(UART0_MODULE);
+    CLKM_Acquire(UART1_MODULE);
+    CLKM_Release(UART0_MODULE);
+    CHECK(CLK->APBCLK == CLK_APBCLK_UART1_EN_Msk);
+    CLKM_Release(UART1_MODULE);
+    CHECK(CLKM_Acquire(WDT_MODULE) == 1 && CLKM_Acquire(WWDT_MODULE) == 2);
+    CHECK(CLKM_Release(WDT_MODULE) == 1 && CLK->APBCLK == CLK_APBCLK_WDT_EN_Msk);
+    CHECK(CLKM_Release(WWDT_MODULE) == 0 && CLK->APBCLK == 0);
+
+    /* WDT_EN is write protected, registers are unlocked for it and locked again */
+    SYS->REGWRPROT = 0;
+    CHECK(CLKM_Acquire(WDT_MODULE) == 1 && CLK->APBCLK == CLK_APBCLK_WDT_EN_Msk && SYS->REGWRPROT == 0);
+    CHECK(CLKM_Release(WDT_MODULE) == 0 && CLK->APBCLK == 0 && SYS->REGWRPROT == 0);
+    CHECK(s_u32Protected == 0);
+    SYS->REGWRPROT = SYS_REGWRPROT_REGPROTDIS_Msk;
+
+    /* A clock enabled before, as by SYS_Init, is gated by the last release */
+    ClearSlots();
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk;
+    CLKM_Acquire(TMR0_MODULE);
+    CLKM_Release(TMR0_MODULE);
+    CHECK(CLK->APBCLK == CLK_APBCLK_UART0_EN_Msk);
+
+    /* Slots and references overflow */
+    ClearSlots();
+    for(i = 0; i < CLKM_MAX_MODULES; i++)
+        CHECK(CLKM_Acquire(s_asModule[5 + i].u32Module) == 1);
+    CHECK(CLKM_Acquire(ADC_MODULE) == -1 && !(CLK->APBCLK & CLK_APBCLK_ADC_EN_Msk));
+    CHECK(CLKM_SetCurrent(ADC_MODULE, 100) == -1 && CLKM_GetStats(ADC_MODULE, &sStats) == -1);
+    for(i = 0; i < 253; i++)
+        CLKM_Acquire(TMR0_MODULE);
+    CHECK(CLKM_Acquire(TMR0_MODULE) == 255 && CLKM_Acquire(TMR0_MODULE) == -1);
+
+    /* Reset only for a single holder */
+    ClearSlots();
+    s_u32Resets = 0;
+    CHECK(CLKM_Reset(SPI0_MODULE, SPI0_RST) == -1);
+    CLKM_Acquire(SPI0_MODULE);
+    CHECK(CLKM_Reset(SPI0_MODULE, SPI0_RST) == 0 && s_u32Resets == 1 && s_u32LastRst == SPI0_RST);
+    CLKM_Acquire(SPI0_MODULE);
+    CHECK(CLKM_Reset(SPI0_MODULE, SPI0_RST) == -1 && s_u32Resets == 1);
+
+    /* Active time and energy, across the wrap of the microsecond time */
+    ClearSlots();
+    CLK->APBCLK = 0;
+    s_u32Now = 0xFFFFFF00;
+    CLKM_Acquire(ADC_MODULE);
+    s_u32Now += 100;
+    CLKM_Release(ADC_MODULE);
+    s_u32Now += 5000;
+    CLKM_Acquire(ADC_MODULE);
+    s_u32Now += 250;
+    CHECK(CLKM_GetStats(ADC_MODULE, &sStats) == 0);
+    CHECK(sStats.u64ActiveUs == 350 && sStats.u32Ref == 1 && sStats.u32Enables == 2);
+    CLKM_Release(ADC_MODULE);
+    for(i = 0; i < 10000; i++)
+    {
+        CLKM_Acquire(ADC_MODULE);
+        s_u32Now += 1000;
+        CLKM_Release(ADC_MODULE);
+        s_u32Now += 7;
+    }
+    CHECK(CLKM_GetStats(ADC_MODULE, &sStats) == 0 && sStats.u64ActiveUs == 10000350ULL);
+    /* 1500 uA for 10.00035 s at 3.3 V */
+    CHECK(sStats.u32MicroAmp == 1500 && sStats.u32EnergyUJ == 49501);
+    CHECK(CLKM_SetCurrent(ADC_MODULE, 1200) == 0 && CLKM_GetStats(ADC_MODULE, &sStats) == 0);
+    CHECK(sStats.u32MicroAmp == 1200 && sStats.u32EnergyUJ == 39601);
+    CHECK(CLKM_GetStats(UART1_MODULE, &sStats) == -1);
+
+    CLKM_Acquire(UART0_MODULE);
+    s_u32Now += 2000;
+    CLKM_Release(UART0_MODULE);
+    CLKM_Report();
+
+    CHECK(g_u32IrqOff == 0);
+
+    return HOST_Result();
+}
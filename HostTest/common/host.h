@@ -0,0 +1,65 @@
+/**************************************************************************//**
+ * @file     host.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:49p $
+ * @brief    Common definitions of the host tests
+ *
+ * @note     Include after NUC029xAN.h, or after the stub header of the test, and before the driver source under
+ *           test. Interrupt masking becomes a flag the test can check, WFI calls HOST_WFI() if the test defines
+ *           it. Peripherals are plain memory mapped at their real addresses by HOST_MapPeripherals().
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __HOST_H__
+#define __HOST_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* Not every test masks interrupts or maps peripherals */
+#define HOST_UNUSED     __attribute__((unused))
+
+static HOST_UNUSED uint32_t g_u32IrqOff;    /* 1 while the code under test masks interrupts */
+static int s_iHostFails;
+
+#undef __get_PRIMASK
+#undef __disable_irq
+#undef __enable_irq
+#undef __set_PRIMASK
+#undef __WFI
+#undef __NOP
+#define __get_PRIMASK()     (g_u32IrqOff)
+#define __disable_irq()     (g_u32IrqOff = 1)
+#define __enable_irq()      (g_u32IrqOff = 0)
+#define __set_PRIMASK(x)    (g_u32IrqOff = (x))
+#ifndef HOST_WFI
+#define HOST_WFI()
+#endif
+#define __WFI()             HOST_WFI()
+#define __NOP()
+
+#define CHECK(c)    do { if(!(c)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #c); s_iHostFails++; } } while(0)
+
+/* APB at 0x40000000 and AHB at 0x50000000 as zeroed memory, 1 MB each. Returns 0 on success. */
+static HOST_UNUSED int HOST_MapPeripherals(void)
+{
+    if(mmap((void *)0x40000000, 0x100000, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED)
+        return -1;
+    if(mmap((void *)0x50000000, 0x100000, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED)
+        return -1;
+    return 0;
+}
+
+static int HOST_Result(void)
+{
+    if(s_iHostFails)
+        printf("FAILED %d\n", s_iHostFails);
+    else
+        printf("all passed\n");
+    return s_iHostFails != 0;
+}
+
+#endif /* __HOST_H__ */
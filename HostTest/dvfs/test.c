@@ -0,0 +1,245 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    Host test of dvfs.c with the real clk.c and system_NUC029xAN.c
+ *
+ * @note     CLK and SYS are plain memory at their real addresses with every oscillator reported stable. Time is
+ *           in microseconds, each notification takes a few of them and WFI sleeps until the next tick of a
+ *           periodic task. Checked are the final clock of every level, the order of the notifications with
+ *           interrupts enabled for PRE and disabled for POST, refusal and abort, the PLL kept for a UART on it,
+ *           the PLL from HIRC without a crystal, the relock of the PLL through HIRC and the governor on a
+ *           periodic task of several loads.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+static uint32_t s_u32Now, s_u32Wfi;     /* Microsecond time, time the next WFI sleeps */
+#define DVFS_GET_US()   (s_u32Now)
+#define HOST_WFI()      (s_u32Now += s_u32Wfi)
+
+#include "NUC029xAN.h"
+#include "host.h"
+
+#include "../../Library/Device/Nuvoton/NUC029xAN/Source/system_NUC029xAN.c"
+#include "../../Library/StdDriver/src/clk.c"
+
+uint32_t SYS_IsRegLocked(void)
+{
+    return !(SYS->REGWRPROT & SYS_REGWRPROT_REGPROTDIS_Msk);
+}
+
+#include "../../Library/StdDriver/src/dvfs.c"
+
+static uint32_t s_au32Event[16], s_au32Hz[16], s_au32Off[16], s_u32Events, s_u32Refuse;
+
+/* Events of A as they are, of B with 0x10 added, the first 16 are kept */
+static int32_t NotifyA(uint32_t u32Event, uint32_t u32Hclk)
+{
+    if(s_u32Events < 16)
+    {
+        s_au32Event[s_u32Events] = u32Event;
+        s_au32Hz[s_u32Events] = u32Hclk;
+        s_au32Off[s_u32Events] = g_u32IrqOff;
+    }
+    s_u32Events++;
+    if(u32Event == DVFS_EVENT_POST)
+        CHECK(u32Hclk == SystemCoreClock);
+    s_u32Now += 5;
+    return 0;
+}
+
+static int32_t NotifyB(uint32_t u32Event, uint32_t u32Hclk)
+{
+    if(s_u32Events < 16)
+    {
+        s_au32Event[s_u32Events] = 0x10 | u32Event;
+        s_au32Hz[s_u32Events] = u32Hclk;
+        s_au32Off[s_u32Events] = g_u32IrqOff;
+    }
+    s_u32Events++;
+    s_u32Now += 7;
+    return (u32Event == DVFS_EVENT_PRE) ? s_u32Refuse : 0;
+}
+
+static uint32_t HclkSrc(void)
+{
+    return CLK->CLKSEL0 & CLK_CLKSEL0_HCLK_S_Msk;
+}
+
+/* A task of a fixed number of cycles every 10 ms, idle otherwise. Returns the level changes. */
+static uint32_t Run(uint32_t u32Cycles, uint32_t u32Ms)
+{
+    DVFS_STATS_T sStats;
+    uint32_t u32Start = s_u32Now, u32Next = s_u32Now, u32Changes;
+
+    DVFS_GetStats(&sStats);
+    u32Changes = sStats.u32Transitions;
+    while(s_u32Now - u32Start < u32Ms * 1000)
+    {
+        s_u32Now += (uint32_t)((uint64_t)u32Cycles * 1000000 / SystemCoreClock);
+        u32Next += 10000;
+        do
+        {
+            /* WFI returns at once if the next tick is already pending */
+            s_u32Wfi = ((int32_t)(u32Next - s_u32Now) > 0) ? u32Next - s_u32Now : 0;
+            DVFS_Idle();
+        }
+        while((int32_t)(u32Next - s_u32Now) > 0);
+    }
+    DVFS_GetStats(&sStats);
+
+    return sStats.u32Transitions - u32Changes;
+}
+
+static void PrintRun(const char *pcName, uint32_t u32Changes)
+{
+    DVFS_STATS_T sStats;
+
+    DVFS_GetStats(&sStats);
+    printf("  %-8s level %u load %3u%% changes %u\n", pcName, sStats.u32Level, sStats.u32Load, u32Changes);
+}
+
+int main(void)
+{
+    static const DVFS_OPP_T asOpp[] =
+    {
+        {CLK_CLKSEL0_HCLK_S_PLL, 1, 48000000},
+        {CLK_CLKSEL0_HCLK_S_PLL, 1, 32000000},
+        {CLK_CLKSEL0_HCLK_S_PLL, 4, 32000000},
+        {CLK_CLKSEL0_HCLK_S_HXT, 2, 0},
+    };
+    static const DVFS_OPP_T asBadDiv[] = {{CLK_CLKSEL0_HCLK_S_HXT, 17, 0}, {CLK_CLKSEL0_HCLK_S_HIRC, 0, 0}};
+    DVFS_STATS_T sStats;
+    uint32_t u32Changes;
+
+    if(HOST_MapPeripherals() != 0)
+    {
+        printf("cannot map peripherals\n");
+        return 1;
+    }
+    SYS->REGWRPROT = SYS_REGWRPROT_REGPROTDIS_Msk;
+    CLK->CLKSTATUS = CLK_CLKSTATUS_XTL12M_STB_Msk | CLK_CLKSTATUS_OSC22M_STB_Msk | CLK_CLKSTATUS_PLL_STB_Msk |
+                     CLK_CLKSTATUS_OSC10K_STB_Msk;
+    CLK->PWRCON = CLK_PWRCON_XTL12M_EN_Msk;
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HXT;
+    CLK->PLLCON = CLK_PLLCON_PD_Msk;
+    SystemCoreClockUpdate();
+    CHECK(SystemCoreClock == 12000000);
+
+    DVFS_Register(NotifyA);
+    DVFS_Register(NotifyB);
+
+    /* Dividers out of 1 ~ 16 are refused, nothing changes */
+    CHECK(DVFS_Open(asBadDiv, 1) == -1 && DVFS_Open(&asBadDiv[1], 1) == -1);
+    CHECK(DVFS_GetLevel() == DVFS_LEVEL_NONE && HclkSrc() == CLK_CLKSEL0_HCLK_S_HXT);
+
+    /* Level 0 is 50 MHz from the PLL on HXT, HIRC stays off */
+    s_u32Events = 0;
+    CHECK(DVFS_Open(NULL, 0) == 0);
+    CHECK(HclkSrc() == CLK_CLKSEL0_HCLK_S_PLL && SystemCoreClock == 50000000 && !(CLK->PLLCON & CLK_PLLCON_PD_Msk));
+    CHECK((CLK->PLLCON & CLK_PLLCON_PLL_SRC_Msk) == CLK_PLLCON_PLL_SRC_HXT);
+    CHECK(!(CLK->PWRCON & CLK_PWRCON_OSC22M_EN_Msk));
+    CHECK(s_u32Events == 4 && s_au32Event[0] == DVFS_EVENT_PRE && s_au32Event[1] == (0x10 | DVFS_EVENT_PRE));
+    CHECK(s_au32Event[2] == DVFS_EVENT_POST && s_au32Event[3] == (0x10 | DVFS_EVENT_POST));
+    CHECK(s_au32Hz[0] == 50000000 && !s_au32Off[0] && !s_au32Off[1] && s_au32Off[2] && s_au32Off[3]);
+    CHECK(g_u32IrqOff == 0 && DVFS_GetLevel() == 0);
+    DVFS_GetStats(&sStats);
+    CHECK(sStats.u32LastUs == 24 && sStats.u32LastIrqOffUs == 12);
+
+    /* HIRC powers the PLL down, HXT keeps HIRC on as the level before enabled it */
+    CHECK(DVFS_SetLevel(1) == 0);
+    CHECK(HclkSrc() == CLK_CLKSEL0_HCLK_S_HIRC && SystemCoreClock == __HIRC && (CLK->PLLCON & CLK_PLLCON_PD_Msk));
+    CHECK(DVFS_SetLevel(2) == 0 && HclkSrc() == CLK_CLKSEL0_HCLK_S_HXT && SystemCoreClock == 12000000);
+    CLK->PWRCON &= ~CLK_PWRCON_OSC22M_EN_Msk;
+
+    /* UART0 on the PLL keeps it running, back on the PLL it is not locked again */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk;
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL;
+    CHECK(DVFS_SetLevel(0) == 0 && SystemCoreClock == 50000000);
+    CHECK(DVFS_SetLevel(2) == 0 && !(CLK->PLLCON & CLK_PLLCON_PD_Msk) && SystemCoreClock == 12000000);
+    CHECK(!(CLK->PWRCON & CLK_PWRCON_OSC22M_EN_Msk));
+    s_u32Events = 0;
+    CHECK(DVFS_SetLevel(0) == 0 && s_u32Events == 4);
+    CLK->APBCLK = 0;
+    CLK->CLKSEL1 = 0;
+
+    /* Refused by B, A gets an abort with the clock it keeps */
+    s_u32Events = 0;
+    s_u32Refuse = 1;
+    CHECK(DVFS_SetLevel(1) == -2 && HclkSrc() == CLK_CLKSEL0_HCLK_S_PLL && SystemCoreClock == 50000000);
+    CHECK(s_u32Events == 3 && s_au32Event[2] == DVFS_EVENT_ABORT && s_au32Hz[2] == 50000000 && DVFS_GetLevel() == 0);
+    s_u32Refuse = 0;
+    DVFS_GetStats(&sStats);
+    CHECK(sStats.u32Refused == 1);
+    CHECK(DVFS_SetLevel(3) == -1);
+
+    /* Without a crystal the HXT level fails and the PLL runs from HIRC */
+    CLK->CLKSTATUS &= ~CLK_CLKSTATUS_XTL12M_STB_Msk;
+    CHECK(DVFS_SetLevel(2) == -1 && DVFS_GetLevel() == 0);
+    CHECK(DVFS_SetLevel(1) == 0 && DVFS_SetLevel(0) == 0);
+    CHECK((CLK->PLLCON & CLK_PLLCON_PLL_SRC_Msk) == CLK_PLLCON_PLL_SRC_HIRC);
+    CHECK(SystemCoreClock > 49000000 && SystemCoreClock <= 50000000);
+    printf("  PLL from HIRC %u Hz\n", SystemCoreClock);
+    CLK->CLKSTATUS |= CLK_CLKSTATUS_XTL12M_STB_Msk;
+    DVFS_SetLevel(2);
+
+    /* Two PLL frequencies and dividers */
+    CHECK(DVFS_Open(asOpp, 4) == 0 && SystemCoreClock == 48000000);
+    s_u32Events = 0;
+    CHECK(DVFS_SetLevel(1) == 0 && SystemCoreClock == 32000000 && HclkSrc() == CLK_CLKSEL0_HCLK_S_PLL);
+    /* The relock runs HCLK from HIRC, with a notification of its own */
+    CHECK(s_u32Events == 6 && s_au32Event[2] == DVFS_EVENT_POST && s_au32Hz[2] == __HIRC && s_au32Off[2]);
+    CHECK(s_au32Event[3] == (0x10 | DVFS_EVENT_POST) && s_au32Off[3]);
+    CHECK(s_au32Event[4] == DVFS_EVENT_POST && s_au32Hz[4] == 32000000 && s_au32Off[4]);
+    DVFS_GetStats(&sStats);
+    CHECK(sStats.u32LastIrqOffUs == 12);
+    CHECK(DVFS_SetLevel(2) == 0 && SystemCoreClock == 8000000 && (CLK->CLKDIV & CLK_CLKDIV_HCLK_N_Msk) == 3);
+    CHECK(DVFS_SetLevel(3) == 0 && SystemCoreClock == 6000000 && HclkSrc() == CLK_CLKSEL0_HCLK_S_HXT);
+    CHECK(DVFS_SetLevel(0) == 0 && SystemCoreClock == 48000000 && (CLK->CLKDIV & CLK_CLKDIV_HCLK_N_Msk) == 0);
+    CHECK(DVFS_GetLevelHz(2) == 8000000 && DVFS_GetLevelHz(4) == 0);
+
+    /* Governor with the default table */
+    DVFS_Unregister(NotifyB);
+    CHECK(DVFS_Open(NULL, 0) == 0);
+
+    /* 8 ms of 10 at 50 MHz */
+    u32Changes = Run(400000, 3000);
+    PrintRun("heavy", u32Changes);
+    CHECK(DVFS_GetLevel() == 0 && u32Changes == 0);
+
+    /* 3 ms at 50 MHz, 6.8 ms at HIRC */
+    u32Changes = Run(150000, 3000);
+    PrintRun("medium", u32Changes);
+    CHECK(DVFS_GetLevel() == 1 && u32Changes == 1);
+
+    /* 0.6 ms at 50 MHz */
+    u32Changes = Run(30000, 3000);
+    PrintRun("light", u32Changes);
+    CHECK(DVFS_GetLevel() == 2 && u32Changes == 1);
+
+    /* 33 ms at 12 MHz, overloaded */
+    u32Changes = Run(400000, 3000);
+    PrintRun("heavy", u32Changes);
+    CHECK(DVFS_GetLevel() == 0 && u32Changes == 1);
+
+    /* 39 % at 50 MHz would be 88 % at HIRC, no step down */
+    u32Changes = Run(195000, 3000);
+    PrintRun("39%", u32Changes);
+    CHECK(DVFS_GetLevel() == 0 && u32Changes == 0);
+
+    DVFS_SetGovernor(0);
+    u32Changes = Run(30000, 3000);
+    DVFS_GetStats(&sStats);
+    CHECK(DVFS_GetLevel() == 0 && u32Changes == 0 && sStats.u32Load < 10);
+    printf("  latency last %u us max %u us, interrupts off last %u us max %u us\n", sStats.u32LastUs, sStats.u32MaxUs,
+           sStats.u32LastIrqOffUs, sStats.u32MaxIrqOffUs);
+
+    CHECK(g_u32IrqOff == 0);
+
+    return HOST_Result();
+}
@@ -0,0 +1,62 @@
+/**************************************************************************//**
+ * @file     NUC029xAN.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/01 10:34a $
+ * @brief    Host stub of the device header for the EBI_NOR sample driver
+ *
+ * @note     EBI bus cycles go to the NOR model of test.c. Every SysTick access advances the simulated HCLK.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __NUC029xAN_H__
+#define __NUC029xAN_H__
+
+#include <stdint.h>
+
+#define BIT0    0x01
+#define BIT1    0x02
+#define BIT2    0x04
+#define BIT3    0x08
+#define BIT4    0x10
+#define BIT5    0x20
+#define BIT6    0x40
+#define BIT7    0x80
+
+#define TRUE    1
+#define FALSE   0
+
+#define __INLINE    inline
+
+typedef struct
+{
+    uint32_t CTRL;
+    uint32_t LOAD;
+    uint32_t VAL;
+    uint32_t CALIB;
+} SysTick_Type;
+
+#define SysTick_CTRL_ENABLE_Msk     1UL
+#define SysTick_CTRL_CLKSOURCE_Msk  4UL
+#define SysTick_LOAD_RELOAD_Msk     0xFFFFFFUL
+
+extern uint32_t CyclesPerUs;
+extern uint8_t g_au8NorArray[];
+
+SysTick_Type *NorModel_SysTick(void);
+uint32_t NorModel_Read(uint32_t u32Addr);
+void NorModel_Write(uint32_t u32Addr, uint32_t u32Data);
+
+#define SysTick     (NorModel_SysTick())
+
+#define EBI_BASE_ADDR           ((uintptr_t)g_au8NorArray)
+#define EBI_MAX_SIZE            0x00020000UL
+#define EBI_BUSWIDTH_8BIT       8
+#define EBI_BUSWIDTH_16BIT      16
+
+#define EBI_READ_DATA8(u32Addr)             NorModel_Read(u32Addr)
+#define EBI_WRITE_DATA8(u32Addr, u32Data)   NorModel_Write((u32Addr), (u32Data))
+#define EBI_READ_DATA16(u32Addr)            NorModel_Read(u32Addr)
+#define EBI_WRITE_DATA16(u32Addr, u32Data)  NorModel_Write((u32Addr), (u32Data))
+
+#endif /* __NUC029xAN_H__ */
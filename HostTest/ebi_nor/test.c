@@ -0,0 +1,522 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/01 10:34a $
+ * @brief    Host test of the EBI_NOR sample driver against a NOR flash model
+ *
+ * @note     The model follows the AMD command set: unlock cycles, CFI query, autoselect, single, unlock bypass
+ *           and write buffer program, sector and chip erase, erase suspend and DQ7/DQ6/DQ5 status. It runs as
+ *           a x8 CFI part on an 8-bit bus, a x16 CFI part on a 16-bit bus and a JEDEC W39L040P. Simulated HCLK is
+ *           50 MHz, each bus cycle takes 10 HCLK and each SysTick access 4.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "NUC029xAN.h"
+#include "host.h"
+
+#include "../../SampleCode/StdDriver/EBI_NOR/ebi_nor.c"
+
+#define HCLK_MHZ        50
+#define BUS_CYCLES      10
+#define TICK_CYCLES     4
+
+/* Operation times of the model in us */
+#define T_PROG          10
+#define T_BUFFER        100
+#define T_SECTOR        20000
+#define T_CHIP          80000
+#define T_SUSPEND       20
+
+enum
+{
+    M_READ, M_U1, M_U2, M_PROG, M_CMD80, M_E_U1, M_E_U2, M_CFI, M_AUTOSEL,
+    M_BYPASS, M_BYP_PROG, M_BYP_EXIT, M_BUF_COUNT, M_BUF_DATA, M_BUF_CONFIRM
+};
+
+enum { OP_NONE, OP_PROG, OP_ERASE };
+
+uint32_t CyclesPerUs = HCLK_MHZ;
+uint8_t g_au8NorArray[EBI_MAX_SIZE];
+
+static SysTick_Type s_sTick;
+static uint64_t s_u64Cycles;
+
+static struct
+{
+    uint32_t u32Bus16, u32Cfi, u32Unlock1, u32Unlock2, u32CfiEntry, u32Manu, u32Dev;
+    uint32_t u32Mode;
+    /* Embedded operation */
+    uint32_t u32Op, u32OpUnit, u32OpData, u32Fail, u32Stuck, u32Toggle, u32Suspended;
+    uint32_t u32EraseBase, u32EraseSize;
+    uint64_t u64OpEnd, u64SuspendAt, u64Left;
+    /* Write buffer */
+    uint32_t u32BufUnit, u32BufLeft, u32BufNum, au32BufUnit[64], au32BufData[64];
+    /* Statistics */
+    uint32_t u32Writes, u32Reads;
+    /* Fault injection */
+    uint32_t u32InjectStuck, u32InjectFail;
+} s_sNor;
+
+static void Advance(uint32_t u32Cycles)
+{
+    uint32_t u32Period;
+
+    s_u64Cycles += u32Cycles;
+    if(!(s_sTick.CTRL & SysTick_CTRL_ENABLE_Msk))
+        return;
+
+    /* Down counter, reloads from LOAD after 0 */
+    u32Period = (s_sTick.LOAD & SysTick_LOAD_RELOAD_Msk) + 1;
+    if(s_sTick.VAL >= u32Cycles)
+        s_sTick.VAL -= u32Cycles;
+    else
+        s_sTick.VAL = s_sTick.LOAD - ((u32Cycles - s_sTick.VAL - 1) % u32Period);
+}
+
+static uint64_t NowUs(void)
+{
+    return s_u64Cycles / HCLK_MHZ;
+}
+
+SysTick_Type *NorModel_SysTick(void)
+{
+    Advance(TICK_CYCLES);
+    return &s_sTick;
+}
+
+/* Sector of a byte address, 8 KB boot sectors then 64 KB, or 64 KB for the JEDEC part */
+static void Sector(uint32_t u32Byte, uint32_t *pu32Base, uint32_t *pu32Size)
+{
+    *pu32Size = (s_sNor.u32Cfi && (u32Byte < 0x10000)) ? 0x2000 : 0x10000;
+    *pu32Base = u32Byte & ~(*pu32Size - 1);
+}
+
+static uint32_t Cfi(uint32_t u32Off)
+{
+    static const uint8_t au8Cfi[0x50] =
+    {
+        [0x10] = 'Q', [0x11] = 'R', [0x12] = 'Y', [0x13] = 0x02, [0x14] = 0x00, [0x15] = 0x40, [0x16] = 0x00,
+        [0x1F] = 4, [0x20] = 7, [0x21] = 5, [0x22] = 7, [0x23] = 3, [0x24] = 3, [0x25] = 2, [0x26] = 2,
+        [0x27] = 21, [0x2A] = 5, [0x2B] = 0, [0x2C] = 2,
+        [0x2D] = 7, [0x2E] = 0, [0x2F] = 0x20, [0x30] = 0x00,
+        [0x31] = 30, [0x32] = 0, [0x33] = 0x00, [0x34] = 0x01,
+        [0x40] = 'P', [0x41] = 'R', [0x42] = 'I', [0x43] = '1', [0x44] = '3', [0x46] = 2
+    };
+
+    return (u32Off < sizeof(au8Cfi)) ? au8Cfi[u32Off] : 0;
+}
+
+static uint32_t ArrayRead(uint32_t u32Unit)
+{
+    if(s_sNor.u32Bus16)
+        return g_au8NorArray[u32Unit * 2] | (g_au8NorArray[u32Unit * 2 + 1] << 8);
+    return g_au8NorArray[u32Unit];
+}
+
+static void ArrayProgram(uint32_t u32Unit, uint32_t u32Data)
+{
+    /* Programming only clears bits */
+    if(s_sNor.u32Bus16)
+    {
+        g_au8NorArray[u32Unit * 2] &= (uint8_t)u32Data;
+        g_au8NorArray[u32Unit * 2 + 1] &= (uint8_t)(u32Data >> 8);
+    }
+    else
+        g_au8NorArray[u32Unit] &= (uint8_t)u32Data;
+}
+
+static void StartOp(uint32_t u32Op, uint32_t u32Unit, uint32_t u32Data, uint32_t u32Us)
+{
+    s_sNor.u32Op = u32Op;
+    s_sNor.u32OpUnit = u32Unit;
+    s_sNor.u32OpData = u32Data;
+    s_sNor.u64OpEnd = s_u64Cycles + (uint64_t)u32Us * HCLK_MHZ;
+    s_sNor.u32Stuck = s_sNor.u32InjectStuck;
+    s_sNor.u32Fail = s_sNor.u32InjectFail;
+    s_sNor.u32Suspended = 0;
+    s_sNor.u64SuspendAt = 0;
+    s_sNor.u32Mode = M_READ;
+}
+
+/* Finish the operation if its time has come. Returns 1 while busy. */
+static uint32_t Busy(void)
+{
+    uint32_t i;
+
+    if(s_sNor.u32Op == OP_NONE)
+        return 0;
+    if(s_sNor.u64SuspendAt && !s_sNor.u32Suspended && (s_u64Cycles >= s_sNor.u64SuspendAt))
+    {
+        s_sNor.u32Suspended = 1;
+        s_sNor.u64Left = (s_sNor.u64OpEnd > s_u64Cycles) ? s_sNor.u64OpEnd - s_u64Cycles : 0;
+    }
+    if(s_sNor.u32Suspended || s_sNor.u32Stuck || (s_u64Cycles < s_sNor.u64OpEnd))
+        return 1;
+    if(s_sNor.u32Fail)
+        return 1;
+
+    if(s_sNor.u32Op == OP_PROG)
+    {
+        for(i = 0; i < s_sNor.u32BufNum; i++)
+            ArrayProgram(s_sNor.au32BufUnit[i], s_sNor.au32BufData[i]);
+        /* A program that has to set bits never verifies and fails with DQ5 */
+        for(i = 0; i < s_sNor.u32BufNum; i++)
+        {
+            if(ArrayRead(s_sNor.au32BufUnit[i]) != s_sNor.au32BufData[i])
+            {
+                s_sNor.u32Fail = 1;
+                return 1;
+            }
+        }
+    }
+    else
+        memset(&g_au8NorArray[s_sNor.u32EraseBase], 0xFF, s_sNor.u32EraseSize);
+
+    s_sNor.u32Op = OP_NONE;
+    return 0;
+}
+
+uint32_t NorModel_Read(uint32_t u32Addr)
+{
+    uint32_t u32Unit = s_sNor.u32Bus16 ? (u32Addr >> 1) : u32Addr, u32Byte, u32Base, u32Size, u32Status;
+
+    Advance(BUS_CYCLES);
+    s_sNor.u32Reads++;
+    u32Byte = s_sNor.u32Bus16 ? u32Unit * 2 : u32Unit;
+
+    if(Busy())
+    {
+        if(s_sNor.u32Suspended)
+        {
+            /* Other sectors read normally, the suspended one shows no toggle */
+            Sector(u32Byte, &u32Base, &u32Size);
+            if(u32Base != s_sNor.u32EraseBase)
+                return ArrayRead(u32Unit);
+            return 0;
+        }
+
+        s_sNor.u32Toggle ^= NOR_DQ6;
+        u32Status = s_sNor.u32Toggle;
+        if(s_sNor.u32Op == OP_PROG)
+            u32Status |= ~s_sNor.u32OpData & NOR_DQ7;
+        if(s_sNor.u32Fail && (s_u64Cycles >= s_sNor.u64OpEnd))
+            u32Status |= NOR_DQ5;
+        return u32Status;
+    }
+
+    if(s_sNor.u32Mode == M_CFI)
+        return Cfi(u32Unit);
+    if(s_sNor.u32Mode == M_AUTOSEL)
+        return (u32Unit == 0) ? s_sNor.u32Manu : (u32Unit == 1) ? s_sNor.u32Dev : 0;
+
+    return ArrayRead(u32Unit);
+}
+
+void NorModel_Write(uint32_t u32Addr, uint32_t u32Data)
+{
+    uint32_t u32Unit = s_sNor.u32Bus16 ? (u32Addr >> 1) : u32Addr, u32Cmd = u32Data & 0xFF, u32Base, u32Size;
+
+    Advance(BUS_CYCLES);
+    s_sNor.u32Writes++;
+
+    if(Busy())
+    {
+        if((s_sNor.u32Op == OP_ERASE) && (u32Cmd == 0xB0) && !s_sNor.u64SuspendAt)
+            s_sNor.u64SuspendAt = s_u64Cycles + T_SUSPEND * HCLK_MHZ;
+        else if(s_sNor.u32Suspended && (u32Cmd == 0x30))
+        {
+            s_sNor.u32Suspended = 0;
+            s_sNor.u64SuspendAt = 0;
+            s_sNor.u64OpEnd = s_u64Cycles + s_sNor.u64Left;
+        }
+        else if(s_sNor.u32Fail && (u32Cmd == 0xF0))
+        {
+            /* Reset after DQ5 returns to read array, also from unlock bypass */
+            s_sNor.u32Op = OP_NONE;
+            s_sNor.u32Mode = M_READ;
+        }
+        return;
+    }
+
+    switch(s_sNor.u32Mode)
+    {
+        case M_PROG:
+        case M_BYP_PROG:
+            s_sNor.u32BufNum = 1;
+            s_sNor.au32BufUnit[0] = u32Unit;
+            s_sNor.au32BufData[0] = u32Data;
+            /* Unlock bypass stays active after each program */
+            u32Base = (s_sNor.u32Mode == M_BYP_PROG) ? M_BYPASS : M_READ;
+            StartOp(OP_PROG, u32Unit, u32Data, T_PROG);
+            s_sNor.u32Mode = u32Base;
+            return;
+        case M_BYP_EXIT:
+            s_sNor.u32Mode = (u32Cmd == 0x00) ? M_READ : M_BYPASS;
+            return;
+        case M_BUF_COUNT:
+            s_sNor.u32BufLeft = u32Cmd + 1;
+            s_sNor.u32BufNum = 0;
+            s_sNor.u32Mode = M_BUF_DATA;
+            return;
+        case M_BUF_DATA:
+            s_sNor.au32BufUnit[s_sNor.u32BufNum] = u32Unit;
+            s_sNor.au32BufData[s_sNor.u32BufNum++] = u32Data;
+            /* Data outside the write buffer page of the first address aborts */
+            u32Size = s_sNor.u32Bus16 ? 16 : 32;
+            CHECK((u32Unit & ~(u32Size - 1)) == (s_sNor.u32BufUnit & ~(u32Size - 1)));
+            if(--s_sNor.u32BufLeft == 0)
+                s_sNor.u32Mode = M_BUF_CONFIRM;
+            return;
+        case M_BUF_CONFIRM:
+            CHECK(u32Cmd == 0x29);
+            StartOp(OP_PROG, s_sNor.au32BufUnit[s_sNor.u32BufNum - 1], s_sNor.au32BufData[s_sNor.u32BufNum - 1], T_BUFFER);
+            return;
+        default:
+            break;
+    }
+
+    if(s_sNor.u32Mode == M_BYPASS)
+    {
+        if(u32Cmd == 0xA0)
+            s_sNor.u32Mode = M_BYP_PROG;
+        else if(u32Cmd == 0x90)
+            s_sNor.u32Mode = M_BYP_EXIT;
+        return;
+    }
+
+    if(u32Cmd == 0xF0)
+    {
+        s_sNor.u32Mode = M_READ;
+        return;
+    }
+
+    if((u32Cmd == 0x98) && s_sNor.u32Cfi && (u32Unit == s_sNor.u32CfiEntry) &&
+            ((s_sNor.u32Mode == M_READ) || (s_sNor.u32Mode == M_AUTOSEL)))
+    {
+        s_sNor.u32Mode = M_CFI;
+        return;
+    }
+
+    switch(s_sNor.u32Mode)
+    {
+        case M_READ:
+        case M_AUTOSEL:
+        case M_CFI:
+            if((u32Cmd == 0xAA) && (u32Unit == s_sNor.u32Unlock1))
+                s_sNor.u32Mode = M_U1;
+            break;
+        case M_U1:
+            s_sNor.u32Mode = ((u32Cmd == 0x55) && (u32Unit == s_sNor.u32Unlock2)) ? M_U2 : M_READ;
+            break;
+        case M_U2:
+            s_sNor.u32Mode = M_READ;
+            if((u32Cmd == 0x25) && s_sNor.u32Cfi)
+            {
+                s_sNor.u32BufUnit = u32Unit;
+                s_sNor.u32Mode = M_BUF_COUNT;
+            }
+            else if(u32Unit != s_sNor.u32Unlock1)
+                break;
+            else if(u32Cmd == 0xA0)
+                s_sNor.u32Mode = M_PROG;
+            else if(u32Cmd == 0x80)
+                s_sNor.u32Mode = M_CMD80;
+            else if(u32Cmd == 0x90)
+                s_sNor.u32Mode = M_AUTOSEL;
+            else if((u32Cmd == 0x20) && s_sNor.u32Cfi)
+                s_sNor.u32Mode = M_BYPASS;
+            break;
+        case M_CMD80:
+            s_sNor.u32Mode = ((u32Cmd == 0xAA) && (u32Unit == s_sNor.u32Unlock1)) ? M_E_U1 : M_READ;
+            break;
+        case M_E_U1:
+            s_sNor.u32Mode = ((u32Cmd == 0x55) && (u32Unit == s_sNor.u32Unlock2)) ? M_E_U2 : M_READ;
+            break;
+        case M_E_U2:
+            s_sNor.u32Mode = M_READ;
+            if((u32Cmd == 0x10) && (u32Unit == s_sNor.u32Unlock1))
+            {
+                s_sNor.u32EraseBase = 0;
+                s_sNor.u32EraseSize = EBI_MAX_SIZE;
+                StartOp(OP_ERASE, u32Unit, 0xFF, T_CHIP);
+            }
+            else if(u32Cmd == 0x30)
+            {
+                Sector(s_sNor.u32Bus16 ? u32Unit * 2 : u32Unit, &u32Base, &u32Size);
+                s_sNor.u32EraseBase = u32Base;
+                s_sNor.u32EraseSize = u32Size;
+                StartOp(OP_ERASE, u32Unit, 0xFF, T_SECTOR);
+            }
+            break;
+        default:
+            s_sNor.u32Mode = M_READ;
+            break;
+    }
+}
+
+static void ModelInit(uint32_t u32Bus16, uint32_t u32Cfi)
+{
+    memset(&s_sNor, 0, sizeof(s_sNor));
+    memset(g_au8NorArray, 0xFF, sizeof(g_au8NorArray));
+    s_sNor.u32Bus16 = u32Bus16;
+    s_sNor.u32Cfi = u32Cfi;
+    if(u32Cfi)
+    {
+        s_sNor.u32Unlock1 = 0x555;
+        s_sNor.u32Unlock2 = 0x2AA;
+        s_sNor.u32CfiEntry = 0x55;
+        s_sNor.u32Manu = 0x01;
+        s_sNor.u32Dev = u32Bus16 ? 0x227E : 0x7E;
+    }
+    else
+    {
+        s_sNor.u32Unlock1 = 0x5555;
+        s_sNor.u32Unlock2 = 0x2AAA;
+        s_sNor.u32Manu = 0xDA;
+        s_sNor.u32Dev = 0xB6;
+    }
+    memset(&s_sTick, 0, sizeof(s_sTick));
+}
+
+static uint8_t s_au8Data[0x2000];
+
+static void Fill(uint32_t u32Seed)
+{
+    uint32_t i;
+
+    srand(u32Seed);
+    for(i = 0; i < sizeof(s_au8Data); i++)
+        s_au8Data[i] = (rand() % 5 == 0) ? 0xFF : (uint8_t)rand();
+}
+
+/* Program 8 KB in one mode at an odd place inside a sector, check and report bus cycles */
+static void ProgramMode(uint32_t u32Mode, const char *pcName, uint32_t u32Addr)
+{
+    uint32_t u32Writes, u32Reads;
+    uint64_t u64Start;
+
+    CHECK(NOR_EraseSector(u32Addr) == NOR_OK);
+    Fill(u32Mode + 1);
+    u32Writes = s_sNor.u32Writes;
+    u32Reads = s_sNor.u32Reads;
+    u64Start = NowUs();
+    CHECK(NOR_Program(u32Addr + 6, s_au8Data, sizeof(s_au8Data) - 6, u32Mode) == NOR_OK);
+    CHECK(memcmp(&g_au8NorArray[u32Addr + 6], s_au8Data, sizeof(s_au8Data) - 6) == 0);
+    CHECK(s_sNor.u32Mode == M_READ);
+    printf("  %-7s %6u writes %7u reads %7u us\n", pcName, s_sNor.u32Writes - u32Writes, s_sNor.u32Reads - u32Reads,
+           (uint32_t)(NowUs() - u64Start));
+}
+
+/* Sector erase that never finishes must time out at the CFI maximum, 2^5 * 2^2 ms */
+static void EraseTimeout(const char *pcName)
+{
+    uint64_t u64Start, u64Us;
+    int32_t i32Ret;
+
+    s_sNor.u32InjectStuck = 1;
+    u64Start = NowUs();
+    i32Ret = NOR_EraseSector(0x4000);
+    u64Us = NowUs() - u64Start;
+    s_sNor.u32InjectStuck = 0;
+    s_sNor.u32Op = OP_NONE;
+    printf("  stuck erase, %s: %d after %u us\n", pcName, i32Ret, (uint32_t)u64Us);
+    CHECK(i32Ret == NOR_ERR_TIMEOUT);
+    CHECK((u64Us >= 128000) && (u64Us <= 128000 + 1000));
+}
+
+int main(void)
+{
+    uint32_t u32Id;
+    uint8_t au8Pat[4] = {0x12, 0x34, 0x56, 0x78};
+
+    /* x8 CFI part, SysTick stopped */
+    printf("x8 CFI part\n");
+    ModelInit(0, 1);
+    NOR_Init(EBI_BUSWIDTH_8BIT);
+    CHECK(g_sNorInfo.u32Flags == (NOR_FLAG_CFI | NOR_FLAG_BYPASS | NOR_FLAG_BUFFER | NOR_FLAG_SUSPEND));
+    CHECK(g_sNorInfo.u32Id == 0x0001007E);
+    CHECK(g_sNorInfo.u32Size == EBI_MAX_SIZE);
+    CHECK(g_sNorInfo.u32BufSize == 32);
+    CHECK(g_sNorInfo.u32ProgTimeout == 128 && g_sNorInfo.u32BufTimeout == 1024);
+    CHECK(g_sNorInfo.u32EraseTimeout == 128 && g_sNorInfo.u32ChipTimeout == 512);
+    CHECK(g_sNorInfo.u32RegionNum == 2);
+    CHECK(NOR_GetSectorSize(0) == 0x2000 && NOR_GetSectorSize(0xFFFF) == 0x2000 && NOR_GetSectorSize(0x10000) == 0x10000);
+    CHECK(s_sTick.CTRL & SysTick_CTRL_ENABLE_Msk);
+
+    ProgramMode(NOR_MODE_SINGLE, "single", 0x2000);
+    ProgramMode(NOR_MODE_BYPASS, "bypass", 0x4000);
+    ProgramMode(NOR_MODE_BUFFER, "buffer", 0x6000);
+    ProgramMode(NOR_MODE_AUTO, "auto", 0x8000);
+
+    /* Parameter checks and programming a non-erased area */
+    CHECK(NOR_Program(EBI_MAX_SIZE - 2, au8Pat, 4, NOR_MODE_AUTO) == NOR_ERR_PARAM);
+    CHECK(NOR_Program(0, au8Pat, 4, 7) == NOR_ERR_PARAM);
+    CHECK(NOR_WriteData(0xC000, 0x5A) == TRUE && NOR_ReadData(0xC000) == 0x5A);
+    CHECK(NOR_WriteData(0xC000, 0xA5) == FALSE);
+    CHECK(s_sNor.u32Op == OP_NONE && s_sNor.u32Mode == M_READ);
+
+    /* Erase suspend, read another sector, resume */
+    CHECK(NOR_WriteData(0x10, 0x3C) == TRUE);
+    NOR_EraseSectorStart(0x2000);
+    Advance(1000 * HCLK_MHZ);
+    CHECK(NOR_IsBusy(0x2000) == 1);
+    CHECK(NOR_EraseSuspend(0x2000) == NOR_OK);
+    CHECK(s_sNor.u32Suspended);
+    CHECK(NOR_IsBusy(0x2000) == 0);
+    CHECK(NOR_ReadData(0x10) == 0x3C && NorModel_Read(0x10) == 0x3C);
+    NOR_EraseResume(0x2000);
+    CHECK(NOR_EraseWait(0x2000) == NOR_OK);
+    CHECK(g_au8NorArray[0x2000] == 0xFF && g_au8NorArray[0x3FFF] == 0xFF && g_au8NorArray[0x10] == 0x3C);
+
+    /* Chip erase */
+    CHECK(NOR_Erase() == TRUE);
+    CHECK(g_au8NorArray[0x10] == 0xFF && g_au8NorArray[0x8000] == 0xFF);
+
+    /* Device failure with DQ5 */
+    s_sNor.u32InjectFail = 1;
+    CHECK(NOR_Program(0x100, au8Pat, 4, NOR_MODE_BYPASS) == NOR_ERR_FAIL);
+    s_sNor.u32InjectFail = 0;
+    CHECK(s_sNor.u32Op == OP_NONE && s_sNor.u32Mode == M_READ);
+
+    /* Deadlines with SysTick free running, then with an application 1 ms and 20 us tick */
+    EraseTimeout("SysTick 0xFFFFFF");
+    s_sTick.LOAD = HCLK_MHZ * 1000 - 1;
+    s_sTick.VAL = 0;
+    s_sTick.CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    EraseTimeout("SysTick 1 ms");
+    CHECK(s_sTick.LOAD == HCLK_MHZ * 1000 - 1);
+    s_sTick.LOAD = HCLK_MHZ * 20 - 1;
+    s_sTick.VAL = 0;
+    EraseTimeout("SysTick 20 us");
+
+    /* x16 CFI part on 16-bit bus */
+    printf("x16 CFI part\n");
+    ModelInit(1, 1);
+    NOR_Init(EBI_BUSWIDTH_16BIT);
+    CHECK(g_sNorInfo.u32Flags == (NOR_FLAG_CFI | NOR_FLAG_BYPASS | NOR_FLAG_BUFFER | NOR_FLAG_SUSPEND | NOR_FLAG_BUS16));
+    CHECK(g_sNorInfo.u32Unlock1 == 0xAAA && g_sNorInfo.u32Unlock2 == 0x554);
+    CHECK(g_sNorInfo.u32Id == 0x0001227E);
+    CHECK(NOR_Program(1, au8Pat, 2, NOR_MODE_AUTO) == NOR_ERR_PARAM);
+    ProgramMode(NOR_MODE_SINGLE, "single", 0x2000);
+    ProgramMode(NOR_MODE_BYPASS, "bypass", 0x4000);
+    ProgramMode(NOR_MODE_BUFFER, "buffer", 0x6000);
+
+    /* JEDEC part without CFI */
+    printf("JEDEC W39L040P\n");
+    ModelInit(0, 0);
+    NOR_Init(EBI_BUSWIDTH_8BIT);
+    u32Id = g_sNorInfo.u32Id;
+    CHECK(u32Id == 0x00DA00B6);
+    CHECK(g_sNorInfo.u32Flags == 0);
+    CHECK(g_sNorInfo.u32Unlock1 == 0x5555 && g_sNorInfo.u32Unlock2 == 0x2AAA);
+    CHECK(NOR_GetSectorSize(0x12345) == 0x10000);
+    CHECK(NOR_Program(0, au8Pat, 4, NOR_MODE_BYPASS) == NOR_ERR_UNSUPPORTED);
+    CHECK(NOR_Program(0, au8Pat, 4, NOR_MODE_BUFFER) == NOR_ERR_UNSUPPORTED);
+    CHECK(NOR_EraseSuspend(0) == NOR_ERR_UNSUPPORTED);
+    ProgramMode(NOR_MODE_AUTO, "auto", 0x10000);
+
+    return HOST_Result();
+}
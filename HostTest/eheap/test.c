@@ -0,0 +1,189 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/06 2:15p $
+ * @brief    Randomized host test of eheap.c
+ *
+ * @note     The EBI window is mapped at EBI_BASE_ADDR. Random traces of allocations and frees with small, medium
+ *           and large sizes check data integrity, alignment, the pool and TLSF statistics and EHEAP_Check() after
+ *           every step, and that the whole TLSF area coalesces back into one block at the end.
+ *           Block headers are 16 bytes on a 64-bit host instead of 8, the layout logic is the same.
+ *           Pass a seed as argument to rerun one trace.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "NUC029xAN.h"
+#include "host.h"
+
+#include "../../Library/StdDriver/src/pool.c"
+#include "../../Library/StdDriver/src/eheap.c"
+
+#define SLOTS       400
+#define STEPS       200000
+#define SEEDS       8
+
+static uint8_t *s_apu8Ptr[SLOTS];
+static uint32_t s_au32Size[SLOTS];
+static uint8_t s_au8Tag[SLOTS];
+
+static uint32_t RandSize(void)
+{
+    uint32_t r = rand() % 100;
+
+    if(r < 60)
+        return 1 + rand() % 128;
+    if(r < 95)
+        return 1 + rand() % 2048;
+    return 1 + rand() % 16384;
+}
+
+static uint32_t InEbi(const void *pvPtr, uint32_t u32Size)
+{
+    return ((uintptr_t)pvPtr >= EBI_BASE_ADDR) && ((uintptr_t)pvPtr + u32Size <= EBI_BASE_ADDR + EBI_MAX_SIZE);
+}
+
+static uint32_t InFast(const void *pvPtr)
+{
+    return ((const uint8_t *)pvPtr >= (const uint8_t *)s_au32EheapFast) &&
+           ((const uint8_t *)pvPtr < (const uint8_t *)s_au32EheapFast + sizeof(s_au32EheapFast));
+}
+
+/* One random trace. Returns the number of failed allocations. */
+static uint32_t Trace(uint32_t u32Seed, uint32_t u32Base)
+{
+    EHEAP_STATS_T sStats, sInit;
+    EHEAP_POOL_STATS_T sPool;
+    uint32_t i, k, u32Step, u32Flags, u32Fails = 0, u32Bad = 0;
+    void *pvBig;
+
+    srand(u32Seed);
+    memset(s_apu8Ptr, 0, sizeof(s_apu8Ptr));
+    CHECK(EHEAP_Init((void *)(uintptr_t)u32Base, EBI_BASE_ADDR + EBI_MAX_SIZE - u32Base) == 0);
+    EHEAP_GetStats(&sInit);
+
+    for(u32Step = 0; (u32Step < STEPS) && (u32Bad == 0); u32Step++)
+    {
+        i = rand() % SLOTS;
+        if(s_apu8Ptr[i])
+        {
+            for(k = 0; k < s_au32Size[i]; k++)
+            {
+                if(s_apu8Ptr[i][k] != s_au8Tag[i])
+                {
+                    printf("  seed %u step %u: slot %u corrupted\n", u32Seed, u32Step, i);
+                    u32Bad++;
+                    break;
+                }
+            }
+            EHEAP_Free(s_apu8Ptr[i]);
+            s_apu8Ptr[i] = NULL;
+        }
+        else
+        {
+            s_au32Size[i] = RandSize();
+            k = rand() % 8;
+            u32Flags = (k < 2) ? EHEAP_FLAG_FAST : (k == 2) ? EHEAP_FLAG_NOPOOL : 0;
+            s_apu8Ptr[i] = EHEAP_Alloc(s_au32Size[i], u32Flags);
+            if(s_apu8Ptr[i] == NULL)
+            {
+                u32Fails++;
+            }
+            else
+            {
+                CHECK(((uintptr_t)s_apu8Ptr[i] & 3) == 0);
+                CHECK(InEbi(s_apu8Ptr[i], s_au32Size[i]) ||
+                      ((u32Flags & EHEAP_FLAG_FAST) && (s_au32Size[i] <= EHEAP_FAST_SIZE) && InFast(s_apu8Ptr[i])));
+                s_au8Tag[i] = (uint8_t)rand();
+                memset(s_apu8Ptr[i], s_au8Tag[i], s_au32Size[i]);
+            }
+        }
+        CHECK(g_u32IrqOff == 0);
+        if(EHEAP_Check() != 0)
+        {
+            printf("  seed %u step %u: EHEAP_Check failed\n", u32Seed, u32Step);
+            u32Bad++;
+        }
+    }
+    CHECK(u32Bad == 0);
+
+    /* All pools empty and peaks within their size after freeing everything */
+    for(i = 0; i < SLOTS; i++)
+        EHEAP_Free(s_apu8Ptr[i]);
+    for(i = 0; i <= EHEAP_POOL_NUM; i++)
+    {
+        CHECK(EHEAP_GetPoolStats(i, &sPool) == 0);
+        CHECK(sPool.u32Used == 0 && sPool.u32Peak <= sPool.u32Blocks);
+        CHECK(sPool.u32BlockSize == ((i < EHEAP_POOL_NUM) ? (16UL << i) : EHEAP_FAST_SIZE));
+    }
+    CHECK(EHEAP_GetPoolStats(EHEAP_POOL_NUM + 1, &sPool) == -1);
+
+    /* TLSF area merges back into the single initial block */
+    EHEAP_GetStats(&sStats);
+    CHECK(sStats.u32Free == sInit.u32Free && sStats.u32FreeBlocks == 1 && sStats.u32UsedBlocks == 0);
+    CHECK(sStats.u32LargestFree == sStats.u32Free && sStats.u32Frag == 0);
+    CHECK(sStats.u32MinFree < sInit.u32Free && sStats.u32Fail <= u32Fails);
+    printf("  seed %u base 0x%08X: %u fails, min free %u of %u\n", u32Seed, u32Base, u32Fails, sStats.u32MinFree,
+           sStats.u32Free);
+
+    pvBig = EHEAP_Alloc(sStats.u32Free, EHEAP_FLAG_NOPOOL);
+    CHECK(pvBig != NULL);
+    CHECK(EHEAP_Alloc(4, EHEAP_FLAG_NOPOOL) == NULL);
+    EHEAP_Free(pvBig);
+    CHECK(EHEAP_Check() == 0);
+
+    return u32Fails;
+}
+
+int main(int argc, char *argv[])
+{
+    EHEAP_STATS_T sStats;
+    void *apvPtr[EHEAP_POOL_BLOCKS + 1];
+    uint32_t i, u32Seed;
+
+    if(mmap((void *)EBI_BASE_ADDR, EBI_MAX_SIZE, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED)
+    {
+        printf("cannot map EBI window\n");
+        return 1;
+    }
+
+    /* Not initialized, then areas too small */
+    CHECK(EHEAP_Alloc(16, 0) == NULL);
+    CHECK(EHEAP_Check() == -1);
+    CHECK(EHEAP_Init((void *)EBI_BASE_ADDR, 1024) == -1);
+    CHECK(EHEAP_Alloc(16, 0) == NULL);
+    CHECK(g_u32IrqOff == 0);
+
+    /* Pool overflow falls back to the TLSF area, pool failures are counted */
+    CHECK(EHEAP_Init((void *)EBI_BASE_ADDR, EBI_MAX_SIZE) == 0);
+    CHECK(EHEAP_Alloc(0, 0) == NULL);
+    for(i = 0; i <= EHEAP_POOL_BLOCKS; i++)
+        apvPtr[i] = EHEAP_Alloc(16, 0);
+    CHECK(POOL_IS_BLOCK(&s_asEheapPool[0], apvPtr[0]) && !POOL_IS_BLOCK(&s_asEheapPool[0], apvPtr[EHEAP_POOL_BLOCKS]));
+    EHEAP_GetStats(&sStats);
+    CHECK(sStats.u32UsedBlocks == 1);
+    for(i = 0; i <= EHEAP_POOL_BLOCKS; i++)
+        EHEAP_Free(apvPtr[i]);
+    EHEAP_Free(NULL);
+    EHEAP_GetStats(&sStats);
+    CHECK(sStats.u32UsedBlocks == 0 && sStats.u32FreeBlocks == 1);
+    CHECK(EHEAP_Alloc(EBI_MAX_SIZE, 0) == NULL);
+    EHEAP_GetStats(&sStats);
+    CHECK(sStats.u32Fail == 1);
+
+    /* Random traces, with the area starting at an odd address for half of them */
+    if(argc > 1)
+    {
+        u32Seed = (uint32_t)atoi(argv[1]);
+        Trace(u32Seed, EBI_BASE_ADDR + (u32Seed & 1));
+    }
+    else
+    {
+        for(u32Seed = 1; u32Seed <= SEEDS; u32Seed++)
+            Trace(u32Seed, EBI_BASE_ADDR + (u32Seed & 1));
+    }
+
+    return HOST_Result();
+}
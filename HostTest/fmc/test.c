@@ -0,0 +1,185 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/07 9:12a $
+ * @brief    Host test of FMC_WriteMultiple and FMC_WritePage against an FMC model
+ *
+ * @note     FMC registers are plain memory at FMC_BASE. The model runs the ISP command at the __ISB() after each
+ *           trigger: program ANDs ISPDAT into a 64 KB flash array mapped at address 0, erase fills a page with
+ *           0xFF, and commands outside the array set the fail flag. Writing 1 to ISPFF clears it.
+ *           A hang flag keeps ISPGO set to test the time-out.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fmc.c also builds the inline commands of fmc.h, whose barrier is the isb instruction */
+__asm__(".macro isb\n.endm");
+
+#include "NUC029xAN.h"
+#include "host.h"
+
+#define SIM_FLASH_BASE  0x10000         /* Lowest address a host process can map */
+#define SIM_FLASH_SIZE  0x10000
+
+static void Model_Isb(void);
+
+/* The program loop runs from host memory, barriers run the model, the fail flag is kept by the model */
+#undef FMC_RAMFUNC
+#define FMC_RAMFUNC
+#define __ISB()                 Model_Isb()
+#undef M32
+#define M32(adr)                (*((volatile uint32_t *)(uintptr_t)(adr)))      /* vu32 is 64-bit on the host */
+#undef FMC_GET_FAIL_FLAG
+#define FMC_GET_FAIL_FLAG()     (s_u32Fail)
+
+static uint32_t s_u32Fail, s_u32Hang, s_u32Programs, s_u32Commands;
+
+#include "../../Library/StdDriver/src/fmc.c"
+
+uint32_t SystemCoreClock = 50000000;
+
+static void Model_Isb(void)
+{
+    uint32_t u32Addr = FMC->ISPADR;
+
+    /* ISPFF is write 1 to clear, the model never sets the register bit itself */
+    if(FMC->ISPCON & FMC_ISPCON_ISPFF_Msk)
+    {
+        FMC->ISPCON &= ~FMC_ISPCON_ISPFF_Msk;
+        s_u32Fail = 0;
+    }
+
+    if(!(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) || s_u32Hang)
+        return;
+
+    s_u32Commands++;
+    if((u32Addr < SIM_FLASH_BASE) || (u32Addr >= SIM_FLASH_BASE + SIM_FLASH_SIZE) || (u32Addr & 3))
+    {
+        s_u32Fail = 1;
+    }
+    else if(FMC->ISPCMD == FMC_ISPCMD_PROGRAM)
+    {
+        M32(u32Addr) &= FMC->ISPDAT;
+        s_u32Programs++;
+    }
+    else if(FMC->ISPCMD == FMC_ISPCMD_PAGE_ERASE)
+    {
+        memset((void *)(uintptr_t)(u32Addr & ~(FMC_FLASH_PAGE_SIZE - 1)), 0xFF, FMC_FLASH_PAGE_SIZE);
+    }
+    else if(FMC->ISPCMD == FMC_ISPCMD_READ)
+    {
+        FMC->ISPDAT = M32(u32Addr);
+    }
+    else
+    {
+        s_u32Fail = 1;
+    }
+
+    FMC->ISPTRG = 0;
+}
+
+/* Per-word reference, the way FMC_Write() programs */
+static void RefWrite(uint8_t *pu8Ref, uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Words)
+{
+    uint32_t i, u32Data;
+
+    for(i = 0; i < u32Words; i++)
+    {
+        memcpy(&u32Data, &pu8Ref[u32Addr - SIM_FLASH_BASE + i * 4], 4);
+        u32Data &= pu32Buf[i];
+        memcpy(&pu8Ref[u32Addr - SIM_FLASH_BASE + i * 4], &u32Data, 4);
+    }
+}
+
+int main(void)
+{
+    static uint8_t au8Ref[SIM_FLASH_SIZE];
+    uint32_t au32Buf[FMC_FLASH_PAGE_SIZE / 4], u32Addr, u32Words, u32Erased, u32Iter, i;
+    int32_t i32Ret;
+
+    if((HOST_MapPeripherals() != 0) ||
+            (mmap((void *)SIM_FLASH_BASE, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED))
+    {
+        printf("cannot map FMC or flash\n");
+        return 1;
+    }
+    memset((void *)SIM_FLASH_BASE, 0xFF, SIM_FLASH_SIZE);
+    memset(au8Ref, 0xFF, sizeof(au8Ref));
+
+    /* One page, a third of it erased words. Only the others are programmed. */
+    for(i = 0, u32Erased = 0; i < FMC_FLASH_PAGE_SIZE / 4; i++)
+    {
+        au32Buf[i] = (i % 3 == 0) ? 0xFFFFFFFF : 0x1000 + i;
+        u32Erased += (i % 3 == 0);
+    }
+    i32Ret = FMC_WritePage(SIM_FLASH_BASE, au32Buf, FMC_WRITE_VERIFY);
+    CHECK(i32Ret == (int32_t)(FMC_FLASH_PAGE_SIZE / 4 - u32Erased) && i32Ret == 85);
+    CHECK(g_FMC_i32ErrCode == 0 && s_u32Programs == 85 && s_u32Commands == 85);
+    CHECK(memcmp((void *)SIM_FLASH_BASE, au32Buf, FMC_FLASH_PAGE_SIZE) == 0);
+    CHECK(FMC->ISPCMD == FMC_ISPCMD_PROGRAM);
+
+    /* All erased, nothing to program */
+    memset(au32Buf, 0xFF, sizeof(au32Buf));
+    s_u32Commands = 0;
+    CHECK(FMC_WritePage(SIM_FLASH_BASE + FMC_FLASH_PAGE_SIZE, au32Buf, FMC_WRITE_VERIFY) == 0 && s_u32Commands == 0);
+
+    /* Page address not aligned */
+    CHECK(FMC_WritePage(SIM_FLASH_BASE + 4, au32Buf, 0) == -1 && g_FMC_i32ErrCode == -1);
+
+    /* Part of a page, first and last words and lengths not a page */
+    au32Buf[0] = 0x12345678;
+    au32Buf[1] = 0xFFFFFFFF;
+    au32Buf[2] = 0x9ABCDEF0;
+    CHECK(FMC_WriteMultiple(SIM_FLASH_BASE + 0x404, au32Buf, 12, FMC_WRITE_VERIFY) == 2);
+    CHECK(M32(SIM_FLASH_BASE + 0x400) == 0xFFFFFFFF && M32(SIM_FLASH_BASE + 0x404) == 0x12345678);
+    CHECK(M32(SIM_FLASH_BASE + 0x40C) == 0x9ABCDEF0 && M32(SIM_FLASH_BASE + 0x410) == 0xFFFFFFFF);
+    CHECK(FMC_WriteMultiple(SIM_FLASH_BASE + 0x420, au32Buf, 0, FMC_WRITE_VERIFY) == 0);
+
+    /* Programming over written words cannot set bits, verify catches it */
+    au32Buf[0] = 0x87654321;
+    CHECK(FMC_WriteMultiple(SIM_FLASH_BASE + 0x404, au32Buf, 4, FMC_WRITE_VERIFY) == -1 && g_FMC_i32ErrCode == -2);
+    CHECK(FMC_WriteMultiple(SIM_FLASH_BASE + 0x404, au32Buf, 4, 0) == 1 && g_FMC_i32ErrCode == 0);
+
+    /* Program fail flag on the word past the array, cleared again for the next call */
+    au32Buf[1] = 0;
+    CHECK(FMC_WriteMultiple(SIM_FLASH_BASE + SIM_FLASH_SIZE - 4, au32Buf, 8, 0) == -1 && g_FMC_i32ErrCode == -1);
+    CHECK(s_u32Fail && (FMC->ISPCON & FMC_ISPCON_ISPFF_Msk));
+    CHECK(FMC_WriteMultiple(SIM_FLASH_BASE + 0x800, au32Buf, 4, FMC_WRITE_VERIFY) == 1 && !s_u32Fail);
+
+    /* ISPGO never clears, time-out after SystemCoreClock / 8 polls */
+    SystemCoreClock = 8000;
+    s_u32Hang = 1;
+    CHECK(FMC_WritePage(SIM_FLASH_BASE + 0xA00, au32Buf, 0) == -1 && g_FMC_i32ErrCode == -1);
+    s_u32Hang = 0;
+    FMC->ISPTRG = 0;
+    SystemCoreClock = 50000000;
+
+    /* Random runs against the per-word reference */
+    memset((void *)SIM_FLASH_BASE, 0xFF, SIM_FLASH_SIZE);
+    memset(au8Ref, 0xFF, sizeof(au8Ref));
+    srand(1);
+    for(u32Iter = 0; u32Iter < 20000; u32Iter++)
+    {
+        u32Words = 1 + rand() % (FMC_FLASH_PAGE_SIZE / 4);
+        u32Addr = SIM_FLASH_BASE + (rand() % (SIM_FLASH_SIZE / 4 - u32Words + 1)) * 4;
+        for(i = 0; i < u32Words; i++)
+            au32Buf[i] = (rand() % 4) ? 0xFFFFFFFF : ~(1UL << (rand() % 32));
+        if(rand() % 64 == 0)
+            memset((void *)(uintptr_t)SIM_FLASH_BASE, 0xFF, SIM_FLASH_SIZE), memset(au8Ref, 0xFF, sizeof(au8Ref));
+
+        i32Ret = FMC_WriteMultiple(u32Addr, au32Buf, u32Words * 4, 0);
+        RefWrite(au8Ref, u32Addr, au32Buf, u32Words);
+        if((i32Ret < 0) || (memcmp((void *)SIM_FLASH_BASE, au8Ref, SIM_FLASH_SIZE) != 0))
+        {
+            printf("  iteration %u differs\n", u32Iter);
+            CHECK(0);
+            break;
+        }
+    }
+    CHECK(g_u32IrqOff == 0);
+
+    return HOST_Result();
+}
@@ -0,0 +1,116 @@
+/**************************************************************************//**
+ * @file     NUC029xAN.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    Host stub of the device header for the frequency meter
+ *
+ * @note     TIMER0 and TIMER1 are plain memory driven by the pulse train simulator of test.c. Flags raised by the
+ *           simulator carry SIM_FLAG_SET, a write of 1 by the driver clears them. The timer driver functions
+ *           used by freq.c work on the registers as the device does.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __NUC029xAN_H__
+#define __NUC029xAN_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct
+{
+    uint32_t TCSR;
+    uint32_t TCMPR;
+    uint32_t TISR;
+    uint32_t TDR;
+    uint32_t TCAP;
+    uint32_t TEXCON;
+    uint32_t TEXISR;
+} TIMER_T;
+
+extern TIMER_T g_sSimTimer0, g_sSimTimer1;
+extern uint32_t g_u32SimClk0, g_u32SimClk1;
+extern uint32_t g_au32SimPriority[2];
+
+#define TIMER0          (&g_sSimTimer0)
+#define TIMER1          (&g_sSimTimer1)
+#define TMR0_IRQn       0
+#define TMR1_IRQn       1
+
+#define NVIC_EnableIRQ(IRQn)
+#define NVIC_DisableIRQ(IRQn)
+#define NVIC_SetPriority(IRQn, priority)    (g_au32SimPriority[IRQn] = (priority))
+#define NVIC_GetPriority(IRQn)              (g_au32SimPriority[IRQn])
+
+#define SIM_FLAG_SET    0x80000000UL
+
+#define TIMER_TCSR_PRESCALE_Msk     (0xFFul << 0)
+#define TIMER_TCSR_TDR_EN_Msk       (1ul << 16)
+#define TIMER_TCSR_CTB_Msk          (1ul << 24)
+#define TIMER_TCSR_IE_Msk           (1ul << 29)
+#define TIMER_TCSR_CEN_Msk          (1ul << 30)
+#define TIMER_TISR_TIF_Msk          (1ul << 0)
+#define TIMER_TEXISR_TEXIF_Msk      (1ul << 0)
+#define TIMER_TEXCON_TX_PHASE_Msk   (1ul << 0)
+#define TIMER_TEXCON_TEX_EDGE_Msk   (3ul << 1)
+#define TIMER_TEXCON_TEXEN_Msk      (1ul << 3)
+#define TIMER_TEXCON_RSTCAPSEL_Msk  (1ul << 4)
+#define TIMER_TEXCON_TEXIEN_Msk     (1ul << 5)
+
+#define TIMER_PERIODIC_MODE                 (1ul << 27)
+#define TIMER_CONTINUOUS_MODE               (3ul << 27)
+#define TIMER_CAPTURE_FREE_COUNTING_MODE    (0ul << 4)
+#define TIMER_CAPTURE_FALLING_EDGE          (0ul << 1)
+#define TIMER_CAPTURE_RISING_EDGE           (1ul << 1)
+#define TIMER_CAPTURE_FALLING_AND_RISING_EDGE   (2ul << 1)
+#define TIMER_COUNTER_FALLING_EDGE          (0ul << 0)
+#define TIMER_COUNTER_RISING_EDGE           (1ul << 0)
+
+static __inline uint32_t TIMER_GetModuleClock(TIMER_T *timer)
+{
+    return (timer == TIMER1) ? g_u32SimClk1 : g_u32SimClk0;
+}
+
+static __inline uint32_t TIMER_Open(TIMER_T *timer, uint32_t u32Mode, uint32_t u32Freq)
+{
+    uint32_t u32Clk = TIMER_GetModuleClock(timer);
+    uint32_t u32Cmpr = u32Clk / u32Freq, u32Prescale = u32Cmpr >> 24;
+
+    if(u32Prescale)
+        u32Cmpr /= u32Prescale + 1;
+    timer->TCSR = u32Mode | u32Prescale;
+    timer->TCMPR = u32Cmpr;
+    return u32Clk / (u32Cmpr * (u32Prescale + 1));
+}
+
+static __inline void TIMER_Close(TIMER_T *timer)
+{
+    timer->TCSR = 0;
+    timer->TEXCON = 0;
+}
+
+#define TIMER_Start(timer)                  ((timer)->TCSR |= TIMER_TCSR_CEN_Msk)
+#define TIMER_EnableInt(timer)              ((timer)->TCSR |= TIMER_TCSR_IE_Msk)
+#define TIMER_EnableCaptureInt(timer)       ((timer)->TEXCON |= TIMER_TEXCON_TEXIEN_Msk)
+#define TIMER_GetIntFlag(timer)             ((timer)->TISR & TIMER_TISR_TIF_Msk)
+#define TIMER_ClearIntFlag(timer)           ((timer)->TISR = TIMER_TISR_TIF_Msk)
+#define TIMER_GetCaptureIntFlag(timer)      ((timer)->TEXISR & TIMER_TEXISR_TEXIF_Msk)
+#define TIMER_ClearCaptureIntFlag(timer)    ((timer)->TEXISR = TIMER_TEXISR_TEXIF_Msk)
+#define TIMER_GetCaptureData(timer)         ((timer)->TCAP)
+#define TIMER_GetCounter(timer)             ((timer)->TDR)
+
+static __inline void TIMER_EnableCapture(TIMER_T *timer, uint32_t u32CapMode, uint32_t u32Edge)
+{
+    timer->TEXCON = (timer->TEXCON & ~(TIMER_TEXCON_RSTCAPSEL_Msk | TIMER_TEXCON_TEX_EDGE_Msk)) |
+                    u32CapMode | u32Edge | TIMER_TEXCON_TEXEN_Msk;
+}
+
+static __inline void TIMER_EnableEventCounter(TIMER_T *timer, uint32_t u32Edge)
+{
+    timer->TEXCON = (timer->TEXCON & ~TIMER_TEXCON_TX_PHASE_Msk) | u32Edge;
+    timer->TCSR |= TIMER_TCSR_CTB_Msk;
+}
+
+#include "freq.h"
+
+#endif /* __NUC029xAN_H__ */
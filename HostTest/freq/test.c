@@ -0,0 +1,272 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    Host test of freq.c with a pulse train simulator
+ *
+ * @note     Time is continuous in seconds. The measuring timer counts a 50 MHz clock, the gate timer a 12 MHz
+ *           one. Signal edges capture or count on the measuring timer, its counter wraps at 0xFFFFFF and each
+ *           pending interrupt runs 2 us after its flag is raised. Edges jitter around an ideal grid without
+ *           accumulating. Steady signals from 0.1 Hz to 200 kHz, a 1 % duty, jitter, a step down, a stopped
+ *           signal and a restart are checked against the resolution reported by FREQ_Read().
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "NUC029xAN.h"
+#include "host.h"
+
+TIMER_T g_sSimTimer0, g_sSimTimer1;
+uint32_t g_u32SimClk0 = 12000000, g_u32SimClk1 = 50000000;
+uint32_t g_au32SimPriority[2];
+
+#include "../../Library/StdDriver/src/freq.c"
+
+#define SIM_LATENCY     2e-6        /* Interrupt entry after the flag */
+#define SIM_WRAP        16777216.0
+
+#define EV_NONE     0
+#define EV_RISE     1
+#define EV_FALL     2
+#define EV_GATE     3
+#define EV_WRAP     4
+#define EV_ISR1     5
+#define EV_ISR0     6
+
+static double s_dNow, s_dIsr1 = -1, s_dIsr0 = -1, s_dNextGate, s_dNextWrap;
+static uint32_t s_u32Count;
+
+/* Signal, no edges while s_dFreq is 0 */
+static double s_dFreq, s_dDuty, s_dJitter, s_dNextRise, s_dNextFall, s_dBase;
+static int64_t s_i64Period;
+
+static double Sim_Jitter(void)
+{
+    if(s_dJitter == 0)
+        return 0;
+    return (rand() / (double)RAND_MAX - 0.5) * 2 * s_dJitter / s_dFreq;
+}
+
+static void Sim_Pend(double *pdIsr)
+{
+    if(*pdIsr < 0)
+        *pdIsr = s_dNow + SIM_LATENCY;
+}
+
+static void Sim_Edge(uint32_t u32Rising)
+{
+    uint32_t u32Edge = g_sSimTimer1.TEXCON & TIMER_TEXCON_TEX_EDGE_Msk;
+
+    if(g_sSimTimer1.TCSR & TIMER_TCSR_CTB_Msk)
+    {
+        if(u32Rising)
+            g_sSimTimer1.TDR = ++s_u32Count & FREQ_COUNTER_MAX;
+        return;
+    }
+
+    if((g_sSimTimer1.TEXCON & TIMER_TEXCON_TEXEN_Msk) &&
+            ((u32Edge == (u32Rising ? TIMER_CAPTURE_RISING_EDGE : TIMER_CAPTURE_FALLING_EDGE)) ||
+             (u32Edge == TIMER_CAPTURE_FALLING_AND_RISING_EDGE)))
+    {
+        g_sSimTimer1.TCAP = (uint32_t)(uint64_t)floor(s_dNow * g_u32SimClk1) & FREQ_COUNTER_MAX;
+        g_sSimTimer1.TEXISR = SIM_FLAG_SET | TIMER_TEXISR_TEXIF_Msk;
+        if(g_sSimTimer1.TEXCON & TIMER_TEXCON_TEXIEN_Msk)
+            Sim_Pend(&s_dIsr1);
+    }
+}
+
+/* Run a handler, clear the flags it wrote 1 to and pend again for flags raised meanwhile */
+static void Sim_RunIsr(TIMER_T *psTimer, double *pdIsr, void (*pfnHandler)(void))
+{
+    *pdIsr = -1;
+    pfnHandler();
+    if(psTimer->TISR == TIMER_TISR_TIF_Msk)
+        psTimer->TISR = 0;
+    if(psTimer->TEXISR == TIMER_TEXISR_TEXIF_Msk)
+        psTimer->TEXISR = 0;
+    if(((psTimer->TISR & TIMER_TISR_TIF_Msk) && (psTimer->TCSR & TIMER_TCSR_IE_Msk)) ||
+            ((psTimer->TEXISR & TIMER_TEXISR_TEXIF_Msk) && (psTimer->TEXCON & TIMER_TEXCON_TEXIEN_Msk)))
+        *pdIsr = s_dNow;
+}
+
+static void Sim_Run(double dTime)
+{
+    double dEnd = s_dNow + dTime, dNext;
+    double dGate = g_sSimTimer0.TCMPR * ((g_sSimTimer0.TCSR & TIMER_TCSR_PRESCALE_Msk) + 1) / (double)g_u32SimClk0;
+    uint32_t u32Event;
+
+    while(1)
+    {
+        dNext = dEnd;
+        u32Event = EV_NONE;
+        if(s_dFreq && (s_dNextRise < dNext))
+        {
+            dNext = s_dNextRise;
+            u32Event = EV_RISE;
+        }
+        if(s_dFreq && (s_dNextFall >= 0) && (s_dNextFall < dNext))
+        {
+            dNext = s_dNextFall;
+            u32Event = EV_FALL;
+        }
+        if(s_dNextGate < dNext)
+        {
+            dNext = s_dNextGate;
+            u32Event = EV_GATE;
+        }
+        if(s_dNextWrap < dNext)
+        {
+            dNext = s_dNextWrap;
+            u32Event = EV_WRAP;
+        }
+        if((s_dIsr1 >= 0) && (s_dIsr1 <= dNext))
+        {
+            dNext = s_dIsr1;
+            u32Event = EV_ISR1;
+        }
+        if((s_dIsr0 >= 0) && (s_dIsr0 <= dNext))
+        {
+            dNext = s_dIsr0;
+            u32Event = EV_ISR0;
+        }
+        if(u32Event == EV_NONE)
+        {
+            s_dNow = dEnd;
+            return;
+        }
+
+        s_dNow = dNext;
+        switch(u32Event)
+        {
+            case EV_RISE:
+                Sim_Edge(1);
+                s_dNextFall = s_dNow + s_dDuty / s_dFreq;
+                s_dNextRise = s_dBase + ++s_i64Period / s_dFreq + Sim_Jitter();
+                if(s_dNextFall >= s_dNextRise)
+                    s_dNextFall = s_dNextRise - 1e-9;
+                break;
+
+            case EV_FALL:
+                Sim_Edge(0);
+                s_dNextFall = -1;
+                break;
+
+            case EV_GATE:
+                s_dNextGate += dGate;
+                g_sSimTimer0.TISR = SIM_FLAG_SET | TIMER_TISR_TIF_Msk;
+                Sim_Pend(&s_dIsr0);
+                break;
+
+            case EV_WRAP:
+                /* Compare match at 0xFFFFFF, one clock before the counter wraps */
+                s_dNextWrap = (floor(s_dNow * g_u32SimClk1 / SIM_WRAP + 1e-9) * SIM_WRAP + SIM_WRAP + FREQ_COUNTER_MAX) /
+                              g_u32SimClk1;
+                if((g_sSimTimer1.TCSR & (TIMER_TCSR_CTB_Msk | TIMER_TCSR_IE_Msk)) == TIMER_TCSR_IE_Msk)
+                {
+                    g_sSimTimer1.TISR = SIM_FLAG_SET | TIMER_TISR_TIF_Msk;
+                    Sim_Pend(&s_dIsr1);
+                }
+                break;
+
+            case EV_ISR1:
+                Sim_RunIsr(&g_sSimTimer1, &s_dIsr1, FREQ_TimerHandler);
+                break;
+
+            case EV_ISR0:
+                Sim_RunIsr(&g_sSimTimer0, &s_dIsr0, FREQ_GateHandler);
+                break;
+        }
+    }
+}
+
+/* First edge at an offset that is no multiple of either timer clock */
+static void Sim_Signal(double dFreq, double dDuty, double dJitter)
+{
+    s_dFreq = dFreq;
+    s_dDuty = dDuty;
+    s_dJitter = dJitter;
+    s_dBase = s_dNextRise = s_dNow + 1e-4 + 3.3e-7;
+    s_i64Period = 0;
+    s_dNextFall = -1;
+}
+
+/* Frequency within the reported resolution, plus the jitter over the samples averaged, duty within 0.02 % */
+static void CheckRead(const char *pcName, double dFreq, double dDuty, uint32_t u32Num)
+{
+    FREQ_RESULT_T sResult;
+    int32_t i32Ret = FREQ_Read(&sResult, u32Num);
+    double dMilliHz = dFreq * 1000, dErr = sResult.u32MilliHz - dMilliHz, dTol;
+    int iOk;
+
+    dTol = sResult.u32ResMilliHz + 1 + (sResult.u32Samples ? 2 * s_dJitter * dMilliHz / sResult.u32Samples : 0);
+    if(dFreq == 0)
+        iOk = (i32Ret == -1) && (sResult.u32MilliHz == 0);
+    else
+        iOk = (i32Ret == 0) && (fabs(dErr) <= dTol);
+    if(iOk && dFreq && (sResult.u32Duty != FREQ_DUTY_UNKNOWN) && (fabs(sResult.u32Duty - dDuty * 10000) > 2))
+        iOk = 0;
+    if(iOk && dFreq && (sResult.u32Mode == FREQ_MODE_PERIOD) && (sResult.u32Duty == FREQ_DUTY_UNKNOWN))
+        iOk = 0;
+
+    printf("  %-8s %10.1f Hz: %s %13.3f Hz res %7.3f Hz err %+8.3f Hz duty %6.2f%% %u samples\n", pcName, dFreq,
+           sResult.u32Mode ? "count " : "period", sResult.u32MilliHz / 1000.0, sResult.u32ResMilliHz / 1000.0,
+           dErr / 1000.0, (sResult.u32Duty == FREQ_DUTY_UNKNOWN) ? -1 : sResult.u32Duty / 100.0, sResult.u32Samples);
+    CHECK(iOk);
+}
+
+int main(void)
+{
+    static const double adFreq[] = {0.1, 0.5, 1, 7.3, 100, 1234.5, 2500, 4900, 5100, 9999, 50000, 123456.7, 200000};
+    uint32_t i;
+
+    /* Both handlers must run at the same priority */
+    g_au32SimPriority[TMR1_IRQn] = 2;
+    g_au32SimPriority[TMR0_IRQn] = 0;
+    s_dNextWrap = FREQ_COUNTER_MAX / (double)g_u32SimClk1;
+    FREQ_Open();
+    CHECK(g_au32SimPriority[TMR0_IRQn] == 2 && g_au32SimPriority[TMR1_IRQn] == 2);
+    s_dNextGate = g_sSimTimer0.TCMPR / (double)g_u32SimClk0;
+
+    for(i = 0; i < sizeof(adFreq) / sizeof(adFreq[0]); i++)
+    {
+        Sim_Signal(adFreq[i], 0.3, 0);
+        Sim_Run((adFreq[i] >= 2500) ? 1.5 : 9.5 / adFreq[i] + 1.2);
+        CheckRead("steady", adFreq[i], 0.3, 0);
+    }
+
+    Sim_Signal(1000, 0.01, 0);
+    Sim_Run(0.5);
+    CheckRead("1% duty", 1000, 0.01, 0);
+
+    Sim_Signal(1000, 0.3, 0.05);
+    Sim_Run(0.5);
+    CheckRead("jitter", 1000, 0.3, 0);
+
+    Sim_Signal(150000, 0.5, 0.05);
+    Sim_Run(1.5);
+    CheckRead("jitter", 150000, 0.5, 0);
+
+    /* Counting falls back to period measurement */
+    Sim_Signal(200000, 0.5, 0);
+    Sim_Run(1);
+    Sim_Signal(100, 0.5, 0);
+    Sim_Run(1);
+    CheckRead("down", 100, 0.5, 0);
+
+    /* No edge for FREQ_TIMEOUT_MS clears the samples */
+    Sim_Signal(0, 0, 0);
+    Sim_Run(FREQ_TIMEOUT_MS / 1000.0 + 3);
+    CheckRead("stopped", 0, 0, 0);
+
+    Sim_Signal(3000, 0.5, 0);
+    Sim_Run(0.2);
+    CheckRead("restart", 3000, 0.5, 2);
+
+    CHECK(g_u32IrqOff == 0);
+    FREQ_Close();
+
+    return HOST_Result();
+}
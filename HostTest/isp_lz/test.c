@@ -0,0 +1,293 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/07 4:20p $
+ * @brief    Host test of the LZ4 decoder of the ISP loaders
+ *
+ * @note     The four copies in ISP_UART, ISP_RS485, ISP_SPI and ISP_I2C are built under their own names. Images
+ *           are compressed by a small greedy LZ4 block encoder and sent in ISP packets, 48 bytes in the first
+ *           one and 56 in the others, into a 64 KB flash model that only programs erased bytes. Random
+ *           CMD_RESEND_PACKET rewinds replay the last packet. Corrupt streams must return LZ_ERROR.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "host.h"
+
+/* Flash model in place of FMC_USER.h / fmc_user.h */
+#define FMC_USER_H
+#define FMC_FLASH_PAGE_SIZE     512
+#define FLASH_SIZE              0x10000
+
+void ReadData(unsigned int addr_start, unsigned int addr_end, unsigned int *data);
+void WriteData(unsigned int addr_start, unsigned int addr_end, unsigned int *data);
+int FMC_Erase_User(unsigned int u32Addr);
+
+/* Every copy gets its own names, taken from LZ_PREFIX where it is included */
+#define LZ_CAT2(a, b)   a##b
+#define LZ_CAT(a, b)    LZ_CAT2(a, b)
+#define LZ_Init         LZ_CAT(LZ_PREFIX, Init)
+#define LZ_Decode       LZ_CAT(LZ_PREFIX, Decode)
+#define LZ_Rewind       LZ_CAT(LZ_PREFIX, Rewind)
+#define LZ_Flush        LZ_CAT(LZ_PREFIX, Flush)
+#define LZ_Put          LZ_CAT(LZ_PREFIX, Put)
+#define LZ_Get          LZ_CAT(LZ_PREFIX, Get)
+#define LZ_STATE_T      LZ_CAT(LZ_PREFIX, State_T)
+#define g_lz            LZ_CAT(LZ_PREFIX, g_lz)
+#define g_lzPacket      LZ_CAT(LZ_PREFIX, g_lzPacket)
+#define g_lzPage        LZ_CAT(LZ_PREFIX, g_lzPage)
+#define g_lzCacheAddr   LZ_CAT(LZ_PREFIX, g_lzCacheAddr)
+#define g_lzCacheData   LZ_CAT(LZ_PREFIX, g_lzCacheData)
+
+typedef struct
+{
+    const char *pcName;
+    void (*pfnInit)(uint8_t *page, uint32_t addr, uint32_t len);
+    uint32_t (*pfnDecode)(uint8_t *src, uint32_t len);
+    void (*pfnRewind)(void);
+} LZ_COPY_T;
+
+#define LZ_PREFIX   Uart_
+#include "../../SampleCode/ISP/ISP_UART/LZ_USER.c"
+static const LZ_COPY_T s_sUart = {"ISP_UART", LZ_Init, LZ_Decode, LZ_Rewind};
+#undef LZ_PREFIX
+
+#define LZ_PREFIX   Rs485_
+#include "../../SampleCode/ISP/ISP_RS485/LZ_USER.c"
+static const LZ_COPY_T s_sRs485 = {"ISP_RS485", LZ_Init, LZ_Decode, LZ_Rewind};
+#undef LZ_PREFIX
+
+#define LZ_PREFIX   Spi_
+#include "../../SampleCode/ISP/ISP_SPI/lz_user.c"
+static const LZ_COPY_T s_sSpi = {"ISP_SPI", LZ_Init, LZ_Decode, LZ_Rewind};
+#undef LZ_PREFIX
+
+#define LZ_PREFIX   I2c_
+#include "../../SampleCode/ISP/ISP_I2C/lz_user.c"
+static const LZ_COPY_T s_sI2c = {"ISP_I2C", LZ_Init, LZ_Decode, LZ_Rewind};
+#undef LZ_PREFIX
+
+#define FIRST_DATA  48          /* Data bytes of the first update packet, after address and length */
+#define NEXT_DATA   56
+
+static uint8_t s_au8Flash[FLASH_SIZE];
+static uint32_t s_au32Page[FMC_FLASH_PAGE_SIZE / 4];
+static uint32_t s_u32Overwrites;
+static uint8_t s_au8Image[FLASH_SIZE], s_au8Lz[FLASH_SIZE + FLASH_SIZE / 255 + 64];
+
+void ReadData(unsigned int addr_start, unsigned int addr_end, unsigned int *data)
+{
+    memcpy(data, &s_au8Flash[addr_start], addr_end - addr_start);
+}
+
+void WriteData(unsigned int addr_start, unsigned int addr_end, unsigned int *data)
+{
+    const uint8_t *pu8Data = (const uint8_t *)data;
+    uint32_t i;
+
+    CHECK((addr_start % FMC_FLASH_PAGE_SIZE) == 0 && addr_end <= FLASH_SIZE);
+    for(i = addr_start; i < addr_end; i++)
+    {
+        if(s_au8Flash[i] != 0xFF)
+            s_u32Overwrites++;
+        s_au8Flash[i] &= pu8Data[i - addr_start];
+    }
+}
+
+int FMC_Erase_User(unsigned int u32Addr)
+{
+    CHECK((u32Addr % FMC_FLASH_PAGE_SIZE) == 0 && u32Addr < FLASH_SIZE);
+    memset(&s_au8Flash[u32Addr], 0xFF, FMC_FLASH_PAGE_SIZE);
+    return 0;
+}
+
+/* LZ4 length field continuation bytes */
+static uint8_t *PutLen(uint8_t *pu8Out, uint32_t u32Len)
+{
+    for(; u32Len >= 255; u32Len -= 255)
+        *pu8Out++ = 255;
+    *pu8Out++ = (uint8_t)u32Len;
+    return pu8Out;
+}
+
+/* Greedy LZ4 block encoder with a 4 byte hash, full 64 KB window. Returns the block size. */
+static uint32_t Compress(const uint8_t *pu8In, uint32_t u32Len, uint8_t *pu8Out)
+{
+    static int32_t ai32Hash[4096];
+    uint8_t *pu8Start = pu8Out, *pu8Token;
+    uint32_t u32Pos = 0, u32Anchor = 0, u32Lit, u32Match, u32Key, u32Cand;
+
+    memset(ai32Hash, -1, sizeof(ai32Hash));
+
+    /* The last 5 bytes are always literals and the last match starts 12 bytes before the end */
+    while(u32Len >= 12 && u32Pos + 12 <= u32Len)
+    {
+        u32Key = ((pu8In[u32Pos] | (pu8In[u32Pos + 1] << 8) | (pu8In[u32Pos + 2] << 16) |
+                   ((uint32_t)pu8In[u32Pos + 3] << 24)) * 2654435761U) >> 20;
+        u32Cand = (uint32_t)ai32Hash[u32Key];
+        ai32Hash[u32Key] = (int32_t)u32Pos;
+
+        if((ai32Hash[u32Key] < 0) || (u32Cand == 0xFFFFFFFF) || (u32Pos - u32Cand > 0xFFFF) ||
+                memcmp(&pu8In[u32Cand], &pu8In[u32Pos], 4))
+        {
+            u32Pos++;
+            continue;
+        }
+
+        for(u32Match = 4; u32Pos + u32Match < u32Len - 5 && pu8In[u32Cand + u32Match] == pu8In[u32Pos + u32Match]; u32Match++);
+
+        u32Lit = u32Pos - u32Anchor;
+        pu8Token = pu8Out++;
+        *pu8Token = (uint8_t)(((u32Lit >= 15) ? 15 : u32Lit) << 4);
+        if(u32Lit >= 15)
+            pu8Out = PutLen(pu8Out, u32Lit - 15);
+        memcpy(pu8Out, &pu8In[u32Anchor], u32Lit);
+        pu8Out += u32Lit;
+        *pu8Out++ = (uint8_t)(u32Pos - u32Cand);
+        *pu8Out++ = (uint8_t)((u32Pos - u32Cand) >> 8);
+        *pu8Token |= (uint8_t)((u32Match - 4 >= 15) ? 15 : (u32Match - 4));
+        if(u32Match - 4 >= 15)
+            pu8Out = PutLen(pu8Out, u32Match - 4 - 15);
+
+        u32Pos += u32Match;
+        u32Anchor = u32Pos;
+    }
+
+    u32Lit = u32Len - u32Anchor;
+    *pu8Out++ = (uint8_t)(((u32Lit >= 15) ? 15 : u32Lit) << 4);
+    if(u32Lit >= 15)
+        pu8Out = PutLen(pu8Out, u32Lit - 15);
+    memcpy(pu8Out, &pu8In[u32Anchor], u32Lit);
+    pu8Out += u32Lit;
+
+    return (uint32_t)(pu8Out - pu8Start);
+}
+
+/* Send a block in ISP packets, zero padded like the host tool. Returns the last LZ_Decode() result. */
+static uint32_t Send(const LZ_COPY_T *psCopy, uint32_t u32ImageLen, const uint8_t *pu8Lz, uint32_t u32LzLen,
+                     uint32_t u32ResendPct, uint32_t *pu32Resends)
+{
+    uint8_t au8Pkt[NEXT_DATA];
+    uint32_t u32Pos = 0, u32Size, u32Data = FIRST_DATA, u32Left = LZ_ERROR;
+
+    memset(s_au8Flash, 0xFF, sizeof(s_au8Flash));
+    s_u32Overwrites = 0;
+    psCopy->pfnInit((uint8_t *)s_au32Page, 0, u32ImageLen);
+
+    do
+    {
+        u32Size = (u32LzLen - u32Pos < u32Data) ? u32LzLen - u32Pos : u32Data;
+        memset(au8Pkt, 0, sizeof(au8Pkt));
+        memcpy(au8Pkt, &pu8Lz[u32Pos], u32Size);
+        u32Left = psCopy->pfnDecode(au8Pkt, u32Data);
+
+        if((u32Left != LZ_ERROR) && ((uint32_t)(rand() % 100) < u32ResendPct))
+        {
+            /* CMD_RESEND_PACKET, the packet arrives again in the same buffer */
+            psCopy->pfnRewind();
+            memset(au8Pkt, 0xA5, sizeof(au8Pkt));
+            memcpy(au8Pkt, &pu8Lz[u32Pos], u32Size);
+            memset(&au8Pkt[u32Size], 0, sizeof(au8Pkt) - u32Size);
+            u32Left = psCopy->pfnDecode(au8Pkt, u32Data);
+            (*pu32Resends)++;
+        }
+
+        u32Pos += u32Size;
+        u32Data = NEXT_DATA;
+    }
+    while((u32Pos < u32LzLen) && (u32Left != LZ_ERROR));
+
+    return u32Left;
+}
+
+static void CheckImage(const LZ_COPY_T *psCopy, const char *pcImage, uint32_t u32Len)
+{
+    uint32_t u32LzLen, u32Resends = 0, u32Left, i, u32Pad = 0;
+
+    u32LzLen = Compress(s_au8Image, u32Len, s_au8Lz);
+    u32Left = Send(psCopy, u32Len, s_au8Lz, u32LzLen, 25, &u32Resends);
+
+    CHECK(u32Left == 0);
+    CHECK(memcmp(s_au8Flash, s_au8Image, u32Len) == 0);
+    for(i = u32Len; i < ((u32Len + FMC_FLASH_PAGE_SIZE - 1) & ~(FMC_FLASH_PAGE_SIZE - 1)); i++)
+        u32Pad |= s_au8Flash[i] ^ 0xFF;
+    CHECK(u32Pad == 0);
+    CHECK(s_u32Overwrites == 0);
+
+    if(psCopy == &s_sUart)
+        printf("  %-12s %5u -> %5u bytes, %u resends\n", pcImage, u32Len, u32LzLen, u32Resends);
+}
+
+static void CheckCorrupt(const LZ_COPY_T *psCopy)
+{
+    /* Offset 0 */
+    static uint8_t au8Zero[] = {0x40, 'a', 'b', 'c', 'd', 0x00, 0x00, 0x50, 1, 2, 3, 4, 5};
+    /* Offset before the start of the image */
+    static uint8_t au8Before[] = {0x40, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x50, 1, 2, 3, 4, 5};
+    /* Match past the end of the image */
+    static uint8_t au8Past[] = {0x1F, 'a', 0x01, 0x00, 0x20};
+    uint32_t u32Resends = 0;
+
+    CHECK(Send(psCopy, 100, au8Zero, sizeof(au8Zero), 0, &u32Resends) == LZ_ERROR);
+    CHECK(Send(psCopy, 100, au8Before, sizeof(au8Before), 0, &u32Resends) == LZ_ERROR);
+    CHECK(Send(psCopy, 30, au8Past, sizeof(au8Past), 0, &u32Resends) == LZ_ERROR);
+
+    /* The zero padding after a stream that ends early decodes as offset 0 */
+    CHECK(Send(psCopy, 200, au8Past, 3, 0, &u32Resends) == LZ_ERROR);
+}
+
+int main(void)
+{
+    static const LZ_COPY_T *apsCopy[] = {&s_sUart, &s_sRs485, &s_sSpi, &s_sI2c};
+    uint32_t i, k, n, c, u32Seed, u32Offset;
+
+    for(c = 0; c < sizeof(apsCopy) / sizeof(apsCopy[0]); c++)
+    {
+        printf("%s\n", apsCopy[c]->pcName);
+        u32Seed = 1;
+
+        /* Firmware-like: repeated instruction patterns and a literal pool */
+        srand(u32Seed++);
+        for(i = 0; i < FLASH_SIZE; i += n)
+        {
+            n = 4 + rand() % 60;
+            if(i + n > FLASH_SIZE)
+                n = FLASH_SIZE - i;
+            u32Offset = ((i > 1024) && (rand() % 8)) ? 4 * (1 + rand() % 256) : 0;
+            for(k = 0; k < n; k++)
+                s_au8Image[i + k] = u32Offset ? s_au8Image[i - u32Offset + k] : (uint8_t)rand();
+        }
+        CheckImage(apsCopy[c], "firmware", 30000);
+        CheckImage(apsCopy[c], "firmware", FLASH_SIZE);
+
+        /* Long runs, offset 1 matches longer than a page */
+        memset(s_au8Image, 0, 5000);
+        CheckImage(apsCopy[c], "zeros", 5000);
+
+        /* Incompressible, long literal runs */
+        for(i = 0; i < 20000; i++)
+            s_au8Image[i] = (uint8_t)rand();
+        CheckImage(apsCopy[c], "random", 20000);
+
+        /* Matches reaching back further than 32 KB are read from flash */
+        for(i = 0; i < 0x8400; i++)
+            s_au8Image[i] = (uint8_t)rand();
+        memcpy(&s_au8Image[0xF000], &s_au8Image[0x10], 0x400);
+        for(i = 0x8400; i < 0xF000; i++)
+            s_au8Image[i] = (uint8_t)(i * 7);
+        CheckImage(apsCopy[c], "far matches", 0xF400);
+
+        /* Tiny images */
+        memcpy(s_au8Image, "abc", 3);
+        CheckImage(apsCopy[c], "3 bytes", 3);
+        CheckImage(apsCopy[c], "1 byte", 1);
+
+        CheckCorrupt(apsCopy[c]);
+    }
+
+    return HOST_Result();
+}
@@ -0,0 +1,102 @@
+/**************************************************************************//**
+ * @file     NUC029xAN.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    Host stub of the device header for the Modbus RTU slave
+ *
+ * @note     MB_UART is the simulated UART of test.c. Reading RBR pops the RX FIFO and writing THR pushes the
+ *           TX FIFO through the index of a register array, the other registers are plain memory.
+ *           UART driver functions only set the registers the simulation looks at.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __NUC029xAN_H__
+#define __NUC029xAN_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BIT0    0x01
+
+#define SIM_TX_SIZE     4096        /* Bytes sent by one test run */
+
+typedef struct
+{
+    uint32_t RBR_[1];
+    uint32_t THR_[SIM_TX_SIZE];
+    uint32_t IER;
+    uint32_t FCR;
+    uint32_t LCR;
+    uint32_t MCR;
+    uint32_t ISR;
+    uint32_t FSR;
+    uint32_t TOR;
+    uint32_t ALT_CSR;
+} UART_T;
+
+extern UART_T g_sSimUart;
+uint32_t Sim_RxPop(void);
+uint32_t Sim_TxPush(void);
+
+#define RBR     RBR_[Sim_RxPop()]
+#define THR     THR_[Sim_TxPush()]
+
+#define UART1           (&g_sSimUart)
+#define UART1_IRQn      0
+
+#define NVIC_EnableIRQ(IRQn)
+#define NVIC_DisableIRQ(IRQn)
+
+#define UART_ISR_RDA_INT_Msk        (1ul << 8)
+#define UART_ISR_THRE_INT_Msk       (1ul << 9)
+#define UART_ISR_RLS_INT_Msk        (1ul << 10)
+#define UART_ISR_TOUT_INT_Msk       (1ul << 12)
+#define UART_ISR_BUF_ERR_INT_Msk    (1ul << 13)
+
+#define UART_IER_RDA_IEN_Msk        (1ul << 0)
+#define UART_IER_THRE_IEN_Msk       (1ul << 1)
+#define UART_IER_RLS_IEN_Msk        (1ul << 2)
+#define UART_IER_RTO_IEN_Msk        (1ul << 4)
+#define UART_IER_BUF_ERR_IEN_Msk    (1ul << 5)
+#define UART_IER_TIME_OUT_EN_Msk    (1ul << 11)
+
+#define UART_FSR_RX_OVER_IF_Msk     (1ul << 0)
+#define UART_FSR_PEF_Msk            (1ul << 4)
+#define UART_FSR_FEF_Msk            (1ul << 5)
+#define UART_FSR_BIF_Msk            (1ul << 6)
+#define UART_FSR_RX_POINTER_Pos     8
+#define UART_FSR_RX_POINTER_Msk     (0x3Ful << UART_FSR_RX_POINTER_Pos)
+#define UART_FSR_RX_FULL_Msk        (1ul << 15)
+#define UART_FSR_TE_FLAG_Msk        (1ul << 28)
+
+#define UART_FCR_RFR_Msk            (1ul << 1)
+#define UART_FCR_TFR_Msk            (1ul << 2)
+#define UART_FCR_RFITL_Msk          (0xFul << 4)
+#define UART_FCR_RFITL_8BYTES       (0x2 << 4)
+
+#define UART_MCR_LEV_RTS_Msk        (1ul << 9)
+#define UART_RTS_IS_HIGH_LEV_ACTIVE (0x0 << 9)
+#define UART_ALT_CSR_RS485_AUD_Msk  (1ul << 10)
+
+#define UART_WORD_LEN_8             (3)
+#define UART_PARITY_NONE            (0x0 << 3)
+#define UART_PARITY_ODD             (0x1 << 3)
+#define UART_PARITY_EVEN            (0x3 << 3)
+#define UART_STOP_BIT_1             (0x0 << 2)
+#define UART_STOP_BIT_2             (0x1 << 2)
+
+#define UART_ENABLE_INT(uart, u32eIntSel)   ((uart)->IER |= (u32eIntSel))
+#define UART_DISABLE_INT(uart, u32eIntSel)  ((uart)->IER &= ~(u32eIntSel))
+
+#define UART_Open(uart, u32BaudRate)
+#define UART_Close(uart)
+#define UART_ClearIntFlag(uart, u32InterruptFlag)
+#define UART_SetLine_Config(uart, u32BaudRate, u32DataWidth, u32Parity, u32StopBits) \
+    ((uart)->LCR = (u32DataWidth) | (u32Parity) | (u32StopBits))
+#define UART_SelectRS485Mode(uart, u32Mode, u32Addr)    ((uart)->ALT_CSR = (u32Mode))
+#define UART_SetTimeoutCnt(uart, u32TOC)    ((uart)->TOR = (u32TOC), (uart)->IER |= UART_IER_TIME_OUT_EN_Msk)
+
+#include "modbus.h"
+
+#endif /* __NUC029xAN_H__ */
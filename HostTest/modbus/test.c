@@ -0,0 +1,332 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    Host test of modbus.c with a simulated UART and response latency check
+ *
+ * @note     Time counts in bit periods. The UART has 16-byte FIFOs, the RX FIFO interrupts at 8 bytes and the
+ *           RX time-out fires TOR bit times after the last byte received. Each byte sent leaves the shifter
+ *           11 bit times after the previous one. Latency is measured from the stop bit of the last request
+ *           byte to the first response byte written to THR, ISR execution time is not modelled.
+ *           Every function, the exceptions, broadcast, other address and bad CRC run at 9600 to 921600 bit/s.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "NUC029xAN.h"
+#include "host.h"
+
+#define SIM_FIFO_SIZE   16
+#define SIM_CHAR_BITS   11
+
+UART_T g_sSimUart;
+
+static uint8_t s_au8RxFifo[SIM_FIFO_SIZE];
+static uint32_t s_u32RxCnt;
+static uint32_t s_u32TxWrite, s_u32TxRead;
+static int64_t s_i64Now, s_i64LastRx, s_i64FirstTx, s_i64TxBusy;
+static uint32_t s_u32Irqs;
+
+uint32_t Sim_RxPop(void)
+{
+    g_sSimUart.RBR_[0] = s_au8RxFifo[0];
+    memmove(s_au8RxFifo, s_au8RxFifo + 1, --s_u32RxCnt);
+    return 0;
+}
+
+uint32_t Sim_TxPush(void)
+{
+    if(s_i64FirstTx < 0)
+        s_i64FirstTx = s_i64Now;
+    if(s_u32TxWrite - s_u32TxRead >= SIM_FIFO_SIZE)
+    {
+        printf("TX FIFO overflow\n");
+        exit(1);
+    }
+    return s_u32TxWrite++ % SIM_TX_SIZE;
+}
+
+#include "../../Library/StdDriver/src/modbus.c"
+
+/* Run the handler as long as an enabled interrupt is pending */
+static void Sim_Service(void)
+{
+    uint32_t i, u32Isr;
+
+    for(i = 0; i < 4; i++)
+    {
+        u32Isr = 0;
+        if((g_sSimUart.IER & UART_IER_RDA_IEN_Msk) && (s_u32RxCnt >= 8))
+            u32Isr |= UART_ISR_RDA_INT_Msk;
+        if((g_sSimUart.IER & UART_IER_RTO_IEN_Msk) && s_u32RxCnt && (s_i64Now - s_i64LastRx >= g_sSimUart.TOR))
+            u32Isr |= UART_ISR_TOUT_INT_Msk;
+        if((g_sSimUart.IER & UART_IER_THRE_IEN_Msk) && (s_u32TxWrite == s_u32TxRead))
+            u32Isr |= UART_ISR_THRE_INT_Msk;
+        if(u32Isr == 0)
+            return;
+
+        g_sSimUart.ISR = u32Isr;
+        g_sSimUart.FSR = (s_u32RxCnt == SIM_FIFO_SIZE) ? UART_FSR_RX_FULL_Msk :
+                         (s_u32RxCnt << UART_FSR_RX_POINTER_Pos);
+        s_u32Irqs++;
+        MB_IRQHandler();
+    }
+}
+
+/* Receive a frame and collect the response. Returns the response length, the latency in bit times or -1. */
+static uint32_t Sim_Transfer(const uint8_t *pu8Req, uint32_t u32Len, uint8_t *pu8Rsp, int64_t *pi64Lat)
+{
+    uint32_t i, b, u32RspLen = 0;
+    int64_t i64End, i64Idle = 0;
+
+    s_i64FirstTx = -1;
+    for(i = 0; i < u32Len; i++)
+    {
+        for(b = 0; b < SIM_CHAR_BITS; b++)
+        {
+            s_i64Now++;
+            Sim_Service();
+        }
+        if(s_u32RxCnt == SIM_FIFO_SIZE)
+            g_sSimUart.FSR |= UART_FSR_RX_OVER_IF_Msk;
+        else
+            s_au8RxFifo[s_u32RxCnt++] = pu8Req[i];
+        s_i64LastRx = s_i64Now;
+        Sim_Service();
+    }
+    i64End = s_i64Now;
+
+    /* Until the line stays quiet for 8 characters after the last response byte */
+    while(i64Idle < 8 * SIM_CHAR_BITS + (int64_t)g_sSimUart.TOR)
+    {
+        s_i64Now++;
+        Sim_Service();
+        if((s_u32TxRead != s_u32TxWrite) && (s_i64Now >= s_i64TxBusy))
+        {
+            s_i64TxBusy = s_i64Now + SIM_CHAR_BITS;
+            pu8Rsp[u32RspLen++] = g_sSimUart.THR_[s_u32TxRead++ % SIM_TX_SIZE];
+            i64Idle = 0;
+        }
+        else if(s_i64Now >= s_i64TxBusy)
+        {
+            i64Idle++;
+        }
+    }
+
+    *pi64Lat = (s_i64FirstTx < 0) ? -1 : s_i64FirstTx - i64End;
+    return u32RspLen;
+}
+
+/* Bitwise CRC, independent of the table of modbus.c */
+static uint32_t RefCrc(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t i, b, u32Crc = 0xFFFF;
+
+    for(i = 0; i < u32Len; i++)
+    {
+        u32Crc ^= pu8Data[i];
+        for(b = 0; b < 8; b++)
+            u32Crc = (u32Crc & 1) ? (u32Crc >> 1) ^ 0xA001 : u32Crc >> 1;
+    }
+    return u32Crc;
+}
+
+static uint32_t BuildFrame(uint8_t *pu8Frame, const uint8_t *pu8Pdu, uint32_t u32Len)
+{
+    uint32_t u32Crc;
+
+    memcpy(pu8Frame, pu8Pdu, u32Len);
+    u32Crc = RefCrc(pu8Frame, u32Len);
+    pu8Frame[u32Len] = u32Crc & 0xFF;
+    pu8Frame[u32Len + 1] = u32Crc >> 8;
+    return u32Len + 2;
+}
+
+static uint16_t s_au16Holding[100], s_au16InputRegs[20];
+static uint8_t s_au8Coils[4], s_au8Inputs[2] = {0xA5, 0x3C};
+static uint32_t s_u32Writes;
+
+static void OnWrite(uint32_t u32Func, uint32_t u32Addr, uint32_t u32Num)
+{
+    (void)u32Func, (void)u32Addr, (void)u32Num;
+    s_u32Writes++;
+}
+
+static const MB_MAP_T s_sMap =
+{
+    s_au8Coils, 100, 32,
+    s_au8Inputs, 0, 16,
+    s_au16Holding, 0, 100,
+    s_au16InputRegs, 1000, 20,
+    OnWrite
+};
+
+static int64_t s_i64LatMin, s_i64LatMax;
+
+/* Send one request, check the CRC of the response and keep the latency range */
+static uint32_t Request(const uint8_t *pu8Pdu, uint32_t u32Len, uint8_t *pu8Rsp)
+{
+    uint8_t au8Frame[MB_MAX_FRAME + 2];
+    uint32_t u32RspLen;
+    int64_t i64Lat;
+
+    u32RspLen = Sim_Transfer(au8Frame, BuildFrame(au8Frame, pu8Pdu, u32Len), pu8Rsp, &i64Lat);
+    if(u32RspLen)
+    {
+        CHECK(RefCrc(pu8Rsp, u32RspLen) == 0);
+        if(i64Lat < s_i64LatMin)
+            s_i64LatMin = i64Lat;
+        if(i64Lat > s_i64LatMax)
+            s_i64LatMax = i64Lat;
+    }
+    else
+    {
+        CHECK(i64Lat == -1);
+    }
+    return u32RspLen;
+}
+
+int main(void)
+{
+    static const uint32_t au32Baud[] = {9600, 19200, 115200, 230400, 460800, 921600};
+    MB_STATS_T sStats;
+    uint8_t au8Rsp[SIM_TX_SIZE], au8Frame[16];
+    uint32_t i, u32Baud, u32Gap, u32Len, u32Irqs;
+    double dBitUs;
+    int64_t i64Lat;
+
+    for(i = 0; i < 100; i++)
+        s_au16Holding[i] = 0x1000 + i;
+    for(i = 0; i < 20; i++)
+        s_au16InputRegs[i] = 0xB000 + i;
+
+    printf("  bit/s   gap bits    gap us  latency us\n");
+    for(i = 0; i < sizeof(au32Baud) / sizeof(au32Baud[0]); i++)
+    {
+        u32Baud = au32Baud[i];
+        dBitUs = 1e6 / u32Baud;
+        s_i64LatMin = INT64_MAX;
+        s_i64LatMax = INT64_MIN;
+        s_u32Writes = 0;
+        MB_Open(u32Baud, UART_PARITY_EVEN, 17, &s_sMap);
+        s_au16Holding[5] = 0x1005;
+        memset(s_au8Coils, 0, sizeof(s_au8Coils));
+
+        /* RTU gap: 3.5 characters up to 19200 bit/s, 1.75 ms above, cut to the 8-bit time-out counter */
+        u32Gap = (u32Baud <= 19200) ? 39 : (1750 * u32Baud + 999999) / 1000000;
+        if(u32Gap > 255)
+            u32Gap = 255;
+        CHECK(g_sSimUart.TOR == u32Gap && (g_sSimUart.IER & UART_IER_TIME_OUT_EN_Msk));
+
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_READ_HOLDING, 0, 2, 0, 10};
+            u32Irqs = s_u32Irqs;
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 25 && au8Rsp[2] == 20 && au8Rsp[3] == 0x10 && au8Rsp[4] == 0x02);
+            CHECK(au8Rsp[21] == 0x10 && au8Rsp[22] == 0x0B);
+            /* 8 request bytes and 25 response bytes, FIFO thresholds keep it to a few interrupts */
+            CHECK(s_u32Irqs - u32Irqs <= 5);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_READ_INPUT_REGS, 0x03, 0xE8 + 18, 0, 2};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 9 && au8Rsp[3] == 0xB0 && au8Rsp[4] == 18 && au8Rsp[6] == 19);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_WRITE_REGS, 0, 5, 0, 2, 4, 0xAB, 0xCD, 0x12, 0x34};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 8 && au8Rsp[1] == MB_FC_WRITE_REGS && au8Rsp[5] == 2);
+            CHECK(s_au16Holding[5] == 0xABCD && s_au16Holding[6] == 0x1234);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_WRITE_REG, 0, 99, 0x55, 0xAA};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 8 && s_au16Holding[99] == 0x55AA);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_WRITE_COIL, 0, 103, 0xFF, 0};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 8 && s_au8Coils[0] == 0x08);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_WRITE_COILS, 0, 110, 0, 10, 2, 0xFF, 0x02};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 8 && s_au8Coils[1] == 0xFC && s_au8Coils[2] == 0x0B);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_READ_COILS, 0, 103, 0, 12};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 7 && au8Rsp[2] == 2 && au8Rsp[3] == 0x81 && au8Rsp[4] == 0x0F);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_READ_INPUTS, 0, 4, 0, 8};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 6 && au8Rsp[3] == 0xCA);
+        }
+        {
+            /* Largest read that fits MB_MAX_FRAME */
+            uint8_t au8Pdu[] = {17, MB_FC_READ_HOLDING, 0, 0, 0, (MB_MAX_FRAME - 5) / 2};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 5 + (MB_MAX_FRAME - 5) / 2 * 2);
+        }
+
+        /* Exceptions */
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_READ_HOLDING, 0, 0, 0, (MB_MAX_FRAME - 5) / 2 + 1};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 5 && au8Rsp[1] == 0x83 && au8Rsp[2] == MB_EX_ILLEGAL_VALUE);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_READ_HOLDING, 0, 95, 0, 6};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 5 && au8Rsp[1] == 0x83 && au8Rsp[2] == MB_EX_ILLEGAL_ADDRESS);
+        }
+        {
+            uint8_t au8Pdu[] = {17, 7};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 5 && au8Rsp[1] == 0x87 && au8Rsp[2] == MB_EX_ILLEGAL_FUNCTION);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_WRITE_COIL, 0, 100, 0x12, 0};
+            u32Len = Request(au8Pdu, sizeof(au8Pdu), au8Rsp);
+            CHECK(u32Len == 5 && au8Rsp[2] == MB_EX_ILLEGAL_VALUE);
+        }
+
+        /* Other node, bad CRC and broadcast get no response */
+        {
+            uint8_t au8Pdu[] = {18, MB_FC_READ_HOLDING, 0, 0, 0, 10};
+            CHECK(Request(au8Pdu, sizeof(au8Pdu), au8Rsp) == 0);
+        }
+        {
+            uint8_t au8Pdu[] = {17, MB_FC_READ_HOLDING, 0, 0, 0, 10};
+            BuildFrame(au8Frame, au8Pdu, sizeof(au8Pdu));
+            au8Frame[7] ^= 1;
+            CHECK(Sim_Transfer(au8Frame, 8, au8Rsp, &i64Lat) == 0 && i64Lat == -1);
+        }
+        {
+            uint8_t au8Pdu[] = {MB_BROADCAST, MB_FC_WRITE_REG, 0, 1, 0xBE, 0xEF};
+            CHECK(Request(au8Pdu, sizeof(au8Pdu), au8Rsp) == 0 && s_au16Holding[1] == 0xBEEF);
+        }
+
+        MB_GetStats(&sStats);
+        CHECK(sStats.u32Frames == 14 && sStats.u32Broadcast == 1 && sStats.u32Other == 1);
+        CHECK(sStats.u32CrcError == 1 && sStats.u32Exception == 4 && sStats.u32Overrun == 0);
+        CHECK(s_u32Writes == 5);
+        CHECK(g_u32IrqOff == 0);
+
+        /* Response starts once the gap has passed, within one bit of the time-out tick */
+        CHECK(s_i64LatMin >= u32Gap && s_i64LatMax <= u32Gap + 1);
+        if(u32Baud <= 19200)
+            CHECK(u32Gap * 2 >= 7 * SIM_CHAR_BITS);
+        else if(u32Gap < 255)
+            CHECK(u32Gap * dBitUs >= 1750.0);
+        printf("  %6u  %8u  %8.1f  %10.1f\n", u32Baud, u32Gap, u32Gap * dBitUs, s_i64LatMax * dBitUs);
+
+        MB_Close();
+        CHECK((g_sSimUart.IER & (UART_IER_RDA_IEN_Msk | UART_IER_THRE_IEN_Msk | UART_IER_RTO_IEN_Msk)) == 0);
+    }
+
+    return HOST_Result();
+}
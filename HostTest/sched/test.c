@@ -0,0 +1,167 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:49p $
+ * @brief    Host test of sched.c with a dispatch latency simulation
+ *
+ * @note     Interrupts arrive at random times of a simulated HCLK and post events. Tasks take a fixed number of
+ *           cycles and run to completion, so the latency of the highest priority task is bounded by the longest
+ *           task plus one dispatch.
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* SCHED_Run() never returns and is not tested, its idle call only needs to link */
+#define SCHED_IDLE()    ((void)0)
+
+#include "NUC029xAN.h"
+#include "host.h"
+
+#include "../../Library/StdDriver/src/sched.c"
+
+#define TASKS       5
+#define DISPATCH    40          /* Cycles of one SCHED_RunOnce() on the target, assumed */
+#define IRQS        200000
+
+static const uint32_t s_au32Cost[TASKS] = {200, 500, 1000, 2000, 5000};
+static uint64_t s_u64Now;
+static int64_t s_ai64Since[TASKS];      /* Time of the first post not yet served, -1 if none */
+static uint64_t s_au64MaxLat[TASKS], s_au64SumLat[TASKS], s_au64Runs[TASKS];
+static uint32_t s_au32Events[SCHED_MAX_TASKS];
+static uint32_t s_u32Order[16], s_u32OrderLen;
+
+static void SimTask(uint32_t u32Events, void *pvArg)
+{
+    uint32_t p = (uint32_t)(uintptr_t)pvArg;
+    uint64_t u64Lat;
+
+    s_u64Now += DISPATCH;
+    u64Lat = s_u64Now - (uint64_t)s_ai64Since[p];
+    s_ai64Since[p] = -1;
+    s_au32Events[p] |= u32Events;
+    s_au64SumLat[p] += u64Lat;
+    s_au64Runs[p]++;
+    if(u64Lat > s_au64MaxLat[p])
+        s_au64MaxLat[p] = u64Lat;
+    s_u64Now += s_au32Cost[p];
+}
+
+static void OrderTask(uint32_t u32Events, void *pvArg)
+{
+    s_u32Order[s_u32OrderLen++] = (uint32_t)(uintptr_t)pvArg;
+    s_au32Events[(uintptr_t)pvArg] = u32Events;
+    /* Task 2 posts to task 0 while running, task 0 must run next */
+    if((uintptr_t)pvArg == 2)
+        SCHED_PostEvent(0, 0x100);
+}
+
+static void Reset(void)
+{
+    memset(s_asSchedTask, 0, sizeof(s_asSchedTask));
+    s_u32SchedReady = 0;
+}
+
+int main(void)
+{
+    uint32_t i, p, u32X, u32Irq, u32MaxCost = 0;
+    uint64_t u64Next, u64Start, u64Busy = 0;
+    clock_t t0;
+
+    srand(1);
+
+    /* Lowest set bit against the compiler builtin */
+    for(i = 0; i < 32; i++)
+        CHECK(SCHED_LSB(1UL << i) == i);
+    for(i = 0; i < 1000000; i++)
+    {
+        u32X = ((uint32_t)rand() << 16) ^ (uint32_t)rand() ^ ((uint32_t)rand() << 30);
+        if(u32X)
+            CHECK(SCHED_LSB(u32X) == (uint32_t)__builtin_ctz(u32X));
+    }
+
+    /* Registration */
+    Reset();
+    CHECK(SCHED_AddTask(SCHED_MAX_TASKS, OrderTask, 0) == -1);
+    CHECK(SCHED_AddTask(0, NULL, 0) == -1);
+    CHECK(SCHED_AddTask(0, OrderTask, (void *)0) == 0);
+    CHECK(SCHED_AddTask(0, OrderTask, (void *)0) == -1);
+    CHECK(SCHED_AddTask(2, OrderTask, (void *)2) == 0);
+    CHECK(SCHED_AddTask(5, OrderTask, (void *)5) == 0);
+    CHECK(SCHED_RunOnce() == 0);
+
+    /* Priority order, coalesced events, post from a task */
+    SCHED_PostEvent(5, 1);
+    SCHED_PostEvent(2, 1);
+    SCHED_PostEvent(5, 2);
+    SCHED_PostEvent(SCHED_MAX_TASKS, 1);
+    s_u32OrderLen = 0;
+    while(SCHED_RunOnce());
+    CHECK(s_u32OrderLen == 3);
+    CHECK(s_u32Order[0] == 2 && s_u32Order[1] == 0 && s_u32Order[2] == 5);
+    CHECK(s_au32Events[5] == 3 && s_au32Events[0] == 0x100);
+    CHECK(SCHED_GetRunCount(5) == 1 && SCHED_GetRunCount(0) == 1 && SCHED_GetRunCount(1) == 0);
+    CHECK(SCHED_GetRunCount(SCHED_MAX_TASKS) == 0);
+    CHECK(g_u32IrqOff == 0);
+
+    /* Latency simulation, about 60 % load */
+    Reset();
+    for(p = 0; p < TASKS; p++)
+    {
+        SCHED_AddTask(p, SimTask, (void *)(uintptr_t)p);
+        s_ai64Since[p] = -1;
+        if(s_au32Cost[p] > u32MaxCost)
+            u32MaxCost = s_au32Cost[p];
+    }
+    u64Next = 0;
+    u32Irq = 0;
+    while(u32Irq < IRQS)
+    {
+        /* Interrupts that came while the last task ran */
+        while((u32Irq < IRQS) && (u64Next <= s_u64Now))
+        {
+            p = (uint32_t)rand() % TASKS;
+            if(s_ai64Since[p] < 0)
+                s_ai64Since[p] = (int64_t)u64Next;
+            SCHED_PostEvent(p, 1UL << (rand() % 32));
+            u64Next += 1 + (uint64_t)(rand() % 5000);
+            u32Irq++;
+        }
+
+        u64Start = s_u64Now;
+        if(SCHED_RunOnce())
+            u64Busy += s_u64Now - u64Start;
+        else
+            s_u64Now = u64Next;     /* Idle until the next interrupt */
+    }
+    while(SCHED_RunOnce());
+
+    printf("load %u %%\n", (uint32_t)(u64Busy * 100 / s_u64Now));
+    printf("prio  cost  runs     avg lat  max lat (cycles)\n");
+    for(p = 0; p < TASKS; p++)
+        printf("%4u  %4u  %6llu  %7llu  %7llu\n", p, s_au32Cost[p], (unsigned long long)s_au64Runs[p],
+               (unsigned long long)(s_au64SumLat[p] / (s_au64Runs[p] ? s_au64Runs[p] : 1)),
+               (unsigned long long)s_au64MaxLat[p]);
+
+    /* Run to completion: the top task waits for at most one running task and its own dispatch */
+    CHECK(s_au64MaxLat[0] <= u32MaxCost + 2 * DISPATCH);
+    for(p = 0; p < TASKS; p++)
+        CHECK(s_au64Runs[p] > 0 && s_ai64Since[p] < 0);
+
+    /* Host time of one post and dispatch, for reference only */
+    Reset();
+    SCHED_AddTask(3, OrderTask, (void *)3);
+    t0 = clock();
+    for(i = 0; i < 10000000; i++)
+    {
+        SCHED_PostEvent(3, 1);
+        s_u32OrderLen = 0;
+        SCHED_RunOnce();
+    }
+    printf("host post + dispatch: %.1f ns\n", (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / 10000000);
+
+    return HOST_Result();
+}
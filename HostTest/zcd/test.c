@@ -0,0 +1,232 @@
+/**************************************************************************//**
+ * @file     test.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    Host test of zcd.c with a mains comparator simulation
+ *
+ * @note     A sine of 1 V peak plus an offset of V- meets a comparator with hysteresis, stepped in 1 us. Each
+ *           output edge runs ZCD_AcmpHandler() 0 ~ 2 us later with the 12 MHz timer counter of that time,
+ *           optionally with edge jitter and bounces. Hysteresis and offset delay both edges by a constant lag,
+ *           which is taken off the reported zero crossing before it is compared with the true one. Covered are
+ *           50 Hz clean, a step to 50.3 Hz with jitter and bounces, a lost signal, a single missed cycle, 60 Hz,
+ *           ZCD_NextTime() and the wrap attribution of a capture in ZCD_TimerHandler().
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "NUC029xAN.h"
+#include "host.h"
+
+#define SIM_CLK     12000000.0
+
+/* Module drivers ZCD_Open() and ZCD_Close() call, only the timer clock matters */
+uint32_t TIMER_GetModuleClock(TIMER_T *timer)
+{
+    (void)timer;
+    return (uint32_t)SIM_CLK;
+}
+
+void TIMER_EnableCapture(TIMER_T *timer, uint32_t u32CapMode, uint32_t u32Edge)
+{
+    (void)timer, (void)u32CapMode, (void)u32Edge;
+}
+
+void TIMER_Close(TIMER_T *timer)
+{
+    (void)timer;
+}
+
+void ACMP_Open(ACMP_T *acmp, uint32_t u32ChNum, uint32_t u32NegSrc, uint32_t u32HysteresisEn)
+{
+    (void)acmp, (void)u32ChNum, (void)u32NegSrc, (void)u32HysteresisEn;
+}
+
+void ACMP_Close(ACMP_T *acmp, uint32_t u32ChNum)
+{
+    (void)acmp, (void)u32ChNum;
+}
+
+/* SR is plain memory, the flag is write 1 to clear and the output bit is read only */
+#undef ACMP_CLR_INT_FLAG
+#define ACMP_CLR_INT_FLAG(acmp, u32ChNum)   ((acmp)->SR &= ~(ACMP_SR_ACMPF0_Msk << ((u32ChNum) % 2)))
+
+#include "../../Library/StdDriver/src/zcd.c"
+
+static double s_dFreq = 50.0, s_dPhase, s_dNow;     /* Seconds */
+static double s_dLastZero;                          /* True rising zero crossing of the sine */
+static double s_dLag;                               /* Delay of both comparator edges */
+static uint32_t s_u32Out;
+
+static double Sim_Rand(void)
+{
+    return rand() / (double)RAND_MAX;
+}
+
+/* Timer counter and wraps at a time, no wrap pending */
+static void Sim_SetTime(double dTime)
+{
+    uint64_t u64Cnt = (uint64_t)(dTime * SIM_CLK);
+
+    s_u32ZcdWraps = (uint32_t)(u64Cnt >> 24);
+    TIMER0->TDR = u64Cnt & ZCD_COUNTER_MAX;
+    TIMER0->TISR = 0;
+}
+
+/* Comparator interrupt at a time with the output level */
+static void Sim_Edge(double dTime, uint32_t u32Out)
+{
+    Sim_SetTime(dTime);
+    ACMP01->SR = ACMP_SR_ACMPF0_Msk | (u32Out ? ACMP_SR_ACMPO0_Msk : 0);
+    ZCD_AcmpHandler();
+}
+
+/* Run the signal, dJitter is the width of the edge jitter, 30 % of the edges bounce if iBounce is set,
+   no edge reaches the driver if iDrop is set */
+static void Sim_Run(double dTime, double dOffset, double dHyst, double dJitter, int iBounce, int iDrop)
+{
+    double dEnd = s_dNow + dTime, dPhase, dLatency;
+    uint32_t u32Out;
+
+    s_dLag = ((asin(dHyst - dOffset) + M_PI + asin(dHyst + dOffset)) / 2 - M_PI / 2) / (2 * M_PI * s_dFreq) + 1e-6;
+    while(s_dNow < dEnd)
+    {
+        s_dNow += 1e-6;
+        dPhase = s_dPhase + 2 * M_PI * s_dFreq * 1e-6;
+        if(fmod(dPhase, 2 * M_PI) < fmod(s_dPhase, 2 * M_PI))
+            s_dLastZero = s_dNow - fmod(dPhase, 2 * M_PI) / (2 * M_PI * s_dFreq);
+        s_dPhase = dPhase;
+
+        u32Out = s_u32Out ? (sin(s_dPhase) + dOffset > -dHyst) : (sin(s_dPhase) + dOffset > dHyst);
+        if(u32Out == s_u32Out)
+            continue;
+        s_u32Out = u32Out;
+        if(iDrop)
+            continue;
+
+        dLatency = Sim_Rand() * 2e-6 + dJitter * (Sim_Rand() - 0.5);
+        Sim_Edge(s_dNow + dLatency, u32Out);
+        if(iBounce && (Sim_Rand() < 0.3))
+        {
+            Sim_Edge(s_dNow + 50e-6, !u32Out);
+            Sim_Edge(s_dNow + 80e-6, u32Out);
+        }
+    }
+    Sim_SetTime(s_dNow);
+}
+
+/* Reported zero crossing less the lag against the true one, within half a period, in us */
+static double ZeroError(const ZCD_RESULT_T *psResult)
+{
+    double dPeriod = 1 / s_dFreq;
+    double dErr = psResult->u32Zero / SIM_CLK - s_dLag - fmod(s_dLastZero, 4294967296.0 / SIM_CLK);
+
+    while(dErr > dPeriod / 2)
+        dErr -= dPeriod;
+    while(dErr < -dPeriod / 2)
+        dErr += dPeriod;
+
+    return dErr * 1e6;
+}
+
+static void PrintResult(const char *pcName, const ZCD_RESULT_T *psResult)
+{
+    printf("  %-12s %6u mHz zero error %5.2f us deviation %5u ns edges %4u rejected %3u resyncs %u\n", pcName,
+           psResult->u32MilliHz, ZeroError(psResult), psResult->u32ErrorNs, psResult->u32Edges, psResult->u32Rejected,
+           psResult->u32Resyncs);
+}
+
+int main(void)
+{
+    ZCD_RESULT_T sResult;
+    uint32_t u32Time, u32Now, u32Wraps, u32Edges, u32Resyncs;
+    double dPeriods;
+
+    /* NVIC is written by ZCD_Open() */
+    if((HOST_MapPeripherals() != 0) ||
+            (mmap((void *)SCS_BASE, 0x1000, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED))
+    {
+        printf("cannot map peripherals\n");
+        return 1;
+    }
+    srand(1);
+
+    ZCD_Open(ZCD_MODE_ISR);
+    CHECK(s_u32ZcdClk == 12000000 && (TIMER0->TCSR & TIMER_TCSR_IE_Msk) && (ACMP01->CR[0] & ACMP_CR_ACMPIE_Msk));
+    s_dNow = 1.0;
+    s_dPhase = 0.3;
+    CHECK(ZCD_Read(&sResult) == -1 && sResult.u32MilliHz == 0);
+    CHECK(ZCD_NextTime(0, &u32Time) == -1);
+
+    /* Clean with offset and hysteresis */
+    Sim_Run(1.0, 0.05, 0.03, 0, 0, 0);
+    CHECK(ZCD_Read(&sResult) == 0);
+    PrintResult("50 Hz", &sResult);
+    CHECK(sResult.u32MilliHz > 49990 && sResult.u32MilliHz < 50010);
+    CHECK(fabs(ZeroError(&sResult)) < 3);
+
+    /* Step to 50.3 Hz with jitter and bounces */
+    s_dFreq = 50.3;
+    Sim_Run(2.0, 0.05, 0.03, 40e-6, 1, 0);
+    CHECK(ZCD_Read(&sResult) == 0);
+    PrintResult("50.3 Hz", &sResult);
+    CHECK(sResult.u32MilliHz > 50280 && sResult.u32MilliHz < 50320);
+    CHECK(fabs(ZeroError(&sResult)) < 5);
+    CHECK(sResult.u32Rejected > 20 && sResult.u32Resyncs == 0);
+
+    /* Next rising and falling zero crossing */
+    u32Now = (uint32_t)(uint64_t)(s_dNow * SIM_CLK);
+    CHECK(ZCD_NextTime(0, &u32Time) == 0);
+    CHECK((int32_t)(u32Time - u32Now) > 0 && (int32_t)(u32Time - u32Now) <= (int32_t)(SIM_CLK / 50.3) + 1);
+    dPeriods = (u32Time / SIM_CLK - s_dLag - fmod(s_dLastZero, 4294967296.0 / SIM_CLK)) * 50.3;
+    CHECK(fabs(dPeriods - floor(dPeriods + 0.5)) < 0.0005);
+    CHECK(ZCD_NextTime(ZCD_ANGLE_HALF, &u32Time) == 0);
+    dPeriods = (u32Time / SIM_CLK - s_dLag - fmod(s_dLastZero, 4294967296.0 / SIM_CLK)) * 50.3;
+    CHECK(fabs(dPeriods - floor(dPeriods) - 0.5) < 0.0005);
+
+    /* Lost signal unlocks, the estimate starts again when it is back */
+    Sim_Run(0.1, 0.05, 0.03, 0, 0, 1);
+    CHECK(ZCD_Read(&sResult) == -1 && ZCD_NextTime(0, &u32Time) == -1);
+    Sim_Run(0.3, 0.05, 0.03, 0, 0, 0);
+    CHECK(ZCD_Read(&sResult) == 0);
+    PrintResult("after loss", &sResult);
+    CHECK(sResult.u32Resyncs >= 1 && fabs(ZeroError(&sResult)) < 3);
+
+    /* A single missed cycle keeps the estimate */
+    u32Resyncs = sResult.u32Resyncs;
+    Sim_Run(1.0 / 50.3, 0.05, 0.03, 0, 0, 1);
+    Sim_Run(0.3, 0.05, 0.03, 0, 0, 0);
+    CHECK(ZCD_Read(&sResult) == 0);
+    PrintResult("missed cycle", &sResult);
+    CHECK(sResult.u32Resyncs == u32Resyncs && fabs(ZeroError(&sResult)) < 3);
+
+    /* 60 Hz, negative offset */
+    s_dFreq = 60.0;
+    Sim_Run(1.0, -0.1, 0.05, 40e-6, 1, 0);
+    CHECK(ZCD_Read(&sResult) == 0);
+    PrintResult("60 Hz", &sResult);
+    CHECK(sResult.u32MilliHz > 59985 && sResult.u32MilliHz < 60015);
+    CHECK(fabs(ZeroError(&sResult)) < 5);
+
+    /* A capture low in the counter taken with the wrap belongs after it, the capture edge alternates */
+    u32Wraps = s_u32ZcdWraps;
+    u32Edges = s_u32ZcdEdges;
+    s_u32ZcdCapRising = s_u32Out ? 0 : 1;
+    s_u32ZcdLast = (u32Wraps << 24) | 0xFFFF00;
+    s_u32ZcdLevel = !s_u32ZcdCapRising;
+    TIMER0->TISR = TIMER_TISR_TIF_Msk;
+    TIMER0->TEXISR = TIMER_TEXISR_TEXIF_Msk;
+    TIMER0->TCAP = 0x100000;
+    TIMER0->TDR = 0x100100;
+    ZCD_TimerHandler();
+    CHECK(s_u32ZcdWraps == u32Wraps + 1 && s_u32ZcdLast == (((u32Wraps + 1) << 24) | 0x100000));
+    CHECK(s_u32ZcdEdges == u32Edges + 1);
+    CHECK(((TIMER0->TEXCON & TIMER_TEXCON_TEX_EDGE_Msk) == TIMER_CAPTURE_RISING_EDGE) == s_u32ZcdCapRising);
+
+    CHECK(g_u32IrqOff == 0);
+    ZCD_Close();
+
+    return HOST_Result();
+}
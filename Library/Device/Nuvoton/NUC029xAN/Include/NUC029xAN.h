@@ -6292,10 +6292,26 @@ typedef volatile unsigned short vu16;
 #define _GET_BYTE2(u32Param)    (((u32Param) & BYTE2_Msk) >> 16)  /*!< Extract Byte 2 (Bit 16~23) from parameter u32Param */
 #define _GET_BYTE3(u32Param)    (((u32Param) & BYTE3_Msk) >> 24)  /*!< Extract Byte 3 (Bit 24~31) from parameter u32Param */
 
+/**
+  * @details    Put a global variable in section .noinit, which is neither loaded nor cleared at startup so it
+  *             keeps its value over a reset. The GCC linker script and the IAR ICF files provide the section.
+  *             KEIL needs a scatter file with an UNINIT region, see sample WDT_Supervisor.
+  */
+#if defined (__ARMCC_VERSION) && (__ARMCC_VERSION >= 6000000)
+#define NOINIT      __attribute__((section(".bss.noinit")))
+#elif defined (__CC_ARM)
+#define NOINIT      __attribute__((section(".noinit"), zero_init))
+#elif defined (__ICCARM__)
+#define NOINIT      __no_init
+#else
+#define NOINIT      __attribute__((section(".noinit")))
+#endif
+
 
 /******************************************************************************/
 /*                         Peripheral header files                            */
 /******************************************************************************/
+#include "trace.h"
 #include "sys.h"
 #include "clk.h"
 #include "adc.h"
@@ -6311,4 +6327,20 @@ typedef volatile unsigned short vu16;
 #include "uart.h"
 #include "hdiv.h"
 #include "acmp.h"
+#include "tlog.h"
+#include "sched.h"
+#include "pool.h"
+#include "eheap.h"
+#include "dualimg.h"
+#include "pm.h"
+#include "lin.h"
+#include "rs485.h"
+#include "modbus.h"
+#include "freq.h"
+#include "usec.h"
+#include "wdts.h"
+#include "boot.h"
+#include "clkm.h"
+#include "dvfs.h"
+#include "zcd.h"
 #endif
@@ -24,6 +24,53 @@ extern "C" {
 # define DEBUG_PORT      UART0       /*!< Select Debug Port which is used for retarget.c to output debug message to UART */
 #endif
 
+/**
+ *
+ * @details    Define DEBUG_INT_CONSOLE to drive the debug port by UART THRE/RDA interrupts. printf only copies
+ *             characters into a TX ring and GetChar reads from an RX ring, so logging never waits for the UART.
+ *             DEBUG_PORT_IRQHandler is implemented by retarget.c and must match DEBUG_PORT.
+ *             DEBUG_TX_OVERFLOW selects what happens when the TX ring is full.
+ *
+ */
+//#define DEBUG_INT_CONSOLE
+#ifndef DEBUG_PORT_IRQn
+# define DEBUG_PORT_IRQn         UART0_IRQn          /*!< IRQ number of DEBUG_PORT */
+#endif
+#ifndef DEBUG_PORT_IRQHandler
+# define DEBUG_PORT_IRQHandler   UART0_IRQHandler    /*!< IRQ handler of DEBUG_PORT */
+#endif
+#ifndef DEBUG_TX_BUF_SIZE
+# define DEBUG_TX_BUF_SIZE       256                 /*!< Debug console TX ring size. Must be power of 2 */
+#endif
+#ifndef DEBUG_RX_BUF_SIZE
+# define DEBUG_RX_BUF_SIZE       16                  /*!< Debug console RX ring size. Must be power of 2 */
+#endif
+#define DEBUG_OVERFLOW_DROP         0   /*!< Discard new characters when TX ring is full */
+#define DEBUG_OVERFLOW_BLOCK        1   /*!< Wait for room in TX ring */
+#define DEBUG_OVERFLOW_OVERWRITE    2   /*!< Discard the oldest characters to keep the newest */
+#ifndef DEBUG_TX_OVERFLOW
+# define DEBUG_TX_OVERFLOW       DEBUG_OVERFLOW_DROP /*!< TX ring overflow policy */
+#endif
+
+/**
+ *
+ * @details    Semihost output (DEBUG_ENABLE_SEMIHOST) is collected in a buffer of DEBUG_SEMIHOST_BUF_SIZE bytes and
+ *             written to the debugger with one SYS_WRITE call. If DEBUG_SEMIHOST_FLUSH_MS is 0 the buffer is written
+ *             on each newline, otherwise when it is full or older than DEBUG_SEMIHOST_FLUSH_MS milliseconds as told
+ *             by SH_GetTickMs(). Without ICE the output is kept in a RAM ring of DEBUG_SEMIHOST_RAM_LOG_SIZE bytes
+ *             unless DEBUG_ENABLE_SEMIHOST is 2, which redirects it to DEBUG_PORT.
+ *
+ */
+#ifndef DEBUG_SEMIHOST_BUF_SIZE
+# define DEBUG_SEMIHOST_BUF_SIZE     128     /*!< Semihost output buffer size */
+#endif
+#ifndef DEBUG_SEMIHOST_FLUSH_MS
+# define DEBUG_SEMIHOST_FLUSH_MS     0       /*!< Semihost batching time in ms, 0 to flush on newline */
+#endif
+#ifndef DEBUG_SEMIHOST_RAM_LOG_SIZE
+# define DEBUG_SEMIHOST_RAM_LOG_SIZE 256     /*!< RAM ring size used without ICE. Must be power of 2 */
+#endif
+
 /**
  *
  * @details    This is used to enable PLL to speed up booting at startup. Remove it will cause system using
@@ -34,6 +81,22 @@ extern "C" {
  */
 //#define INIT_SYSCLK_AT_BOOTING
 
+/**
+ *
+ * @details    This is used to enable the external 12 MHz crystal in SystemInit, so it starts up while the C runtime
+ *             initializes RAM and is stable, or nearly, when SYS_Init waits for it.
+ *
+ */
+//#define INIT_HXT_AT_BOOTING
+
+/**
+ *
+ * @details    This is used to time the boot phases with the BOOT driver. SystemInit starts the timer and marks its
+ *             end, the application adds marks and prints BOOT_Report().
+ *
+ */
+//#define BOOT_PROFILE
+
 /*----------------------------------------------------------------------------
   Define SYSCLK
  *----------------------------------------------------------------------------*/
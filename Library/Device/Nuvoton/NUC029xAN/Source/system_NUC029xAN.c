@@ -80,7 +80,25 @@ void SystemInit(void)
     int32_t i32TimeoutCnt;
     uint32_t u32HclkSelect;
     int8_t i8IsPllEn;
+#endif
 
+#ifdef BOOT_PROFILE
+#if defined (__ARMCC_VERSION) || defined (__ICCARM__)
+    BOOT_Start();
+#else
+    /* Started in Reset_Handler, which copied .data since */
+    BOOT_Mark(".data copy");
+#endif
+#endif
+
+#ifdef INIT_HXT_AT_BOOTING
+    /* Start the crystal now, it gets stable while the C runtime initializes */
+    SYS_UnlockReg();
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+    SYS_LockReg();
+#endif
+
+#ifdef INIT_SYSCLK_AT_BOOTING
     PllClock = 0;
     i8IsPllEn = 0;
     u32HclkSelect = CLK->CLKSEL0 & CLK_CLKSEL0_HCLK_S_Msk;
@@ -123,6 +141,10 @@ void SystemInit(void)
         SYS_LockReg();
     }
 #endif
+
+#ifdef BOOT_PROFILE
+    BOOT_Mark("SystemInit");
+#endif
 }
 
 #if USE_ASSERT
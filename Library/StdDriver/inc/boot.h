@@ -0,0 +1,83 @@
+/**************************************************************************//**
+ * @file     boot.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series boot time profiler header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __BOOT_H__
+#define __BOOT_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_BOOT_Driver BOOT Driver
+  @{
+*/
+
+/** @addtogroup NUC029_BOOT_EXPORTED_CONSTANTS BOOT Exported Constants
+  @{
+*/
+#ifndef BOOT_TIMER
+#define BOOT_TIMER              TIMER3                  /*!< Timer counting HIRC from reset, free after \ref BOOT_Stop */
+#define BOOT_TIMER_MODULE       TMR3_MODULE             /*!< Module of \ref BOOT_TIMER */
+#define BOOT_TIMER_CLK_HIRC     CLK_CLKSEL1_TMR3_S_HIRC /*!< HIRC clock selection of \ref BOOT_TIMER */
+#endif
+
+#ifndef BOOT_MAX_MARKS
+#define BOOT_MAX_MARKS          12          /*!< Marks kept, 8 bytes of no-init SRAM each */
+#endif
+
+/*@}*/ /* end of group NUC029_BOOT_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_BOOT_EXPORTED_STRUCTS BOOT Exported Structs
+  @{
+*/
+/**
+  * @details    End of a boot phase
+  */
+typedef struct
+{
+    const char *pcName;             /*!< Phase that ended, a string constant */
+    uint32_t u32Tick;               /*!< HIRC cycles since \ref BOOT_Start */
+} BOOT_MARK_T;
+
+/*@}*/ /* end of group NUC029_BOOT_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_BOOT_EXPORTED_FUNCTIONS BOOT Exported Functions
+  @{
+*/
+
+void BOOT_Start(void);
+void BOOT_Mark(const char *pcName);
+void BOOT_Stop(void);
+uint32_t BOOT_GetMarks(const BOOT_MARK_T **ppsMarks);
+uint32_t BOOT_TicksToNs(uint32_t u32Ticks);
+void BOOT_Report(void);
+
+/*@}*/ /* end of group NUC029_BOOT_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_BOOT_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__BOOT_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -188,6 +188,32 @@
 /*@}*/ /* end of group NUC029_CLK_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup NUC029_CLK_EXPORTED_STRUCTS CLK Exported Structs
+  @{
+*/
+/**
+  * @details    Clock configuration saved by \ref CLK_SaveSnapshot
+  */
+typedef struct
+{
+    uint32_t u32PwrCon;             /*!< PWRCON, oscillator enable bits are restored */
+    uint32_t u32ClkSel0;            /*!< CLKSEL0 */
+    uint32_t u32ClkSel1;            /*!< CLKSEL1 */
+    uint32_t u32ClkSel2;            /*!< CLKSEL2 */
+    uint32_t u32ClkDiv;             /*!< CLKDIV */
+    uint32_t u32PllCon;             /*!< PLLCON */
+    uint32_t u32AhbClk;             /*!< AHBCLK */
+    uint32_t u32ApbClk;             /*!< APBCLK */
+    uint32_t u32Stable;             /*!< CLKSTATUS flags to wait for before HCLK is switched back */
+    uint32_t u32SystemCoreClock;    /*!< Cached SystemCoreClock */
+    uint32_t u32CyclesPerUs;        /*!< Cached CyclesPerUs */
+    uint32_t u32PllClock;           /*!< Cached PllClock */
+    uint32_t u32WakeLatency;        /*!< Time from wake-up to restored clocks of last \ref CLK_PowerDownRestore, in us */
+} CLK_SNAPSHOT_T;
+
+/*@}*/ /* end of group NUC029_CLK_EXPORTED_STRUCTS */
+
+
 /** @addtogroup NUC029_CLK_EXPORTED_FUNCTIONS CLK Exported Functions
   @{
 */
@@ -316,6 +342,9 @@ void CLK_DisablePLL(void);
 uint32_t CLK_WaitClockReady(uint32_t u32ClkMask);
 void CLK_EnableSysTick(uint32_t u32ClkSrc, uint32_t u32Count);
 void CLK_DisableSysTick(void);
+void CLK_SaveSnapshot(CLK_SNAPSHOT_T *psSnap);
+int32_t CLK_RestoreSnapshot(const CLK_SNAPSHOT_T *psSnap);
+int32_t CLK_PowerDownRestore(CLK_SNAPSHOT_T *psSnap);
 
 
 /*@}*/ /* end of group NUC029_CLK_EXPORTED_FUNCTIONS */
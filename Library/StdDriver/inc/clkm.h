@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ * @file     clkm.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series module clock manager header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __CLKM_H__
+#define __CLKM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_CLKM_Driver CLKM Driver
+  @{
+*/
+
+/** @addtogroup NUC029_CLKM_EXPORTED_CONSTANTS CLKM Exported Constants
+  @{
+*/
+#ifndef CLKM_MAX_MODULES
+#define CLKM_MAX_MODULES        8           /*!< Clock gates managed, 24 bytes of SRAM each */
+#endif
+
+#ifndef CLKM_GET_US
+#define CLKM_GET_US()           USEC_Get32()    /*!< Microsecond time for the active time, see \ref USEC_Open */
+#endif
+
+#ifndef CLKM_VDD_MV
+#define CLKM_VDD_MV             3300        /*!< Supply voltage for the energy estimate, in mV */
+#endif
+
+/**
+  * @details    Clock gate of a module index, bit position in AHBCLK (0 ~ 31) or APBCLK (32 ~ 63).
+  *             WDT_MODULE and WWDT_MODULE share one gate.
+  */
+#define CLKM_GATE(u32ModuleIdx)     ((MODULE_APBCLK(u32ModuleIdx) << 5) | MODULE_IP_EN_Pos(u32ModuleIdx))
+
+/*@}*/ /* end of group NUC029_CLKM_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_CLKM_EXPORTED_STRUCTS CLKM Exported Structs
+  @{
+*/
+/**
+  * @details    Use and energy estimate of a clock gate
+  */
+typedef struct
+{
+    uint32_t u32Ref;                /*!< Current references */
+    uint32_t u32Enables;            /*!< Times the clock was enabled by the first reference */
+    uint64_t u64ActiveUs;           /*!< Time the clock was enabled, in us */
+    uint32_t u32MicroAmp;           /*!< Typical current while enabled, in uA */
+    uint32_t u32EnergyUJ;           /*!< Estimated energy at \ref CLKM_VDD_MV, in uJ */
+} CLKM_STATS_T;
+
+/*@}*/ /* end of group NUC029_CLKM_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_CLKM_EXPORTED_FUNCTIONS CLKM Exported Functions
+  @{
+*/
+
+int32_t CLKM_Acquire(uint32_t u32ModuleIdx);
+int32_t CLKM_Release(uint32_t u32ModuleIdx);
+int32_t CLKM_Reset(uint32_t u32ModuleIdx, uint32_t u32RstIdx);
+uint32_t CLKM_GetRef(uint32_t u32ModuleIdx);
+int32_t CLKM_SetCurrent(uint32_t u32ModuleIdx, uint32_t u32MicroAmp);
+int32_t CLKM_GetStats(uint32_t u32ModuleIdx, CLKM_STATS_T *psStats);
+void CLKM_Report(void);
+
+/*@}*/ /* end of group NUC029_CLKM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_CLKM_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__CLKM_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,109 @@
+/**************************************************************************//**
+ * @file     dualimg.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/08 4:20p $
+ * @brief    NUC029 series dual image (A/B) firmware update header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __DUALIMG_H__
+#define __DUALIMG_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_DUALIMG_Driver DUALIMG Driver
+  @{
+*/
+
+/** @addtogroup NUC029_DUALIMG_EXPORTED_CONSTANTS DUALIMG Exported Constants
+  @{
+*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*  APROM partition. Default fits 64 KB APROM: boot manager 4 KB, two 30 KB slots.                         */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef DUALIMG_BOOT_SIZE
+#define DUALIMG_BOOT_SIZE       0x1000  /*!< APROM reserved for boot manager at address 0, multiple of page size */
+#endif
+
+#ifndef DUALIMG_SLOT_SIZE
+#define DUALIMG_SLOT_SIZE       0x7800  /*!< Size of each image slot, multiple of page size */
+#endif
+
+#ifndef DUALIMG_RECORD_ADDR
+#define DUALIMG_RECORD_ADDR     (FMC->DFBADR + 0xC00)  /*!< Two flash pages holding the boot record */
+#endif
+
+#ifndef DUALIMG_TRIAL_BOOTS
+#define DUALIMG_TRIAL_BOOTS     3       /*!< Boots a new image gets to call \ref DUALIMG_Confirm before rollback */
+#endif
+
+#ifndef DUALIMG_TRIAL_TIMEOUT
+#define DUALIMG_TRIAL_TIMEOUT   WDT_TIMEOUT_2POW16  /*!< WDT period of each trial boot, about 6.5 s from LIRC */
+#endif
+
+#define DUALIMG_SLOT_A          0           /*!< First image slot */
+#define DUALIMG_SLOT_B          1           /*!< Second image slot */
+#define DUALIMG_SLOT_NONE       0xFFFFFFFFUL /*!< No slot */
+
+#define DUALIMG_SLOT_BASE(slot) (DUALIMG_BOOT_SIZE + (slot) * DUALIMG_SLOT_SIZE)  /*!< Start address of a slot */
+
+#define DUALIMG_MAGIC           0x474D4944UL    /*!< "DIMG", boot record signature */
+
+/*@}*/ /* end of group NUC029_DUALIMG_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_DUALIMG_EXPORTED_STRUCTS DUALIMG Exported Structs
+  @{
+*/
+/**
+  * @details    Boot record
+  */
+typedef struct
+{
+    uint32_t u32Seq;            /*!< Incremented on each record update */
+    uint32_t u32Active;         /*!< Confirmed slot */
+    uint32_t u32Pending;        /*!< Slot on trial, \ref DUALIMG_SLOT_NONE if none */
+    uint32_t au32Len[2];        /*!< Image length of each slot, 0 if unknown (factory programmed) */
+    uint32_t au32Crc[2];        /*!< CRC-32 of each image */
+    uint32_t u32Attempts;       /*!< Trial boots of pending slot so far */
+} DUALIMG_STATE_T;
+
+/*@}*/ /* end of group NUC029_DUALIMG_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_DUALIMG_EXPORTED_FUNCTIONS DUALIMG Exported Functions
+  @{
+*/
+
+void DUALIMG_GetState(DUALIMG_STATE_T *psState);
+uint32_t DUALIMG_GetRunningSlot(void);
+uint32_t DUALIMG_CalcCrc(uint32_t u32Crc, const uint8_t *pu8Data, uint32_t u32Len);
+int32_t DUALIMG_Write(uint32_t u32Slot, uint32_t u32Offset, const uint8_t *pu8Data, uint32_t u32Len);
+int32_t DUALIMG_Commit(uint32_t u32Slot, uint32_t u32Len, uint32_t u32Crc);
+int32_t DUALIMG_Confirm(void);
+int32_t DUALIMG_Boot(void);
+
+/*@}*/ /* end of group NUC029_DUALIMG_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_DUALIMG_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__DUALIMG_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
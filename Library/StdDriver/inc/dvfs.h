@@ -0,0 +1,133 @@
+/**************************************************************************//**
+ * @file     dvfs.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series core clock scaling governor header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __DVFS_H__
+#define __DVFS_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_DVFS_Driver DVFS Driver
+  @{
+*/
+
+/** @addtogroup NUC029_DVFS_EXPORTED_CONSTANTS DVFS Exported Constants
+  @{
+*/
+#ifndef DVFS_MAX_NOTIFIERS
+#define DVFS_MAX_NOTIFIERS      4           /*!< Drivers notified of clock changes */
+#endif
+
+#ifndef DVFS_GET_US
+#define DVFS_GET_US()           USEC_Get32()    /*!< Microsecond time for load and latency, see \ref USEC_Open.
+                                                     Its timer must not run from HCLK. */
+#endif
+
+#ifndef DVFS_WINDOW_MS
+#define DVFS_WINDOW_MS          100         /*!< Load is measured over this time before the governor decides */
+#endif
+
+#ifndef DVFS_UP_LOAD
+#define DVFS_UP_LOAD            80          /*!< Load in % from which the fastest level is used */
+#endif
+
+#ifndef DVFS_DOWN_LOAD
+#define DVFS_DOWN_LOAD          40          /*!< Load in % below which the next slower level is tried */
+#endif
+
+#ifndef DVFS_PLL_OFF
+#define DVFS_PLL_OFF            1           /*!< 1 to power down the PLL on levels without it, unless a
+                                                 running UART, SPI or ADC is clocked by it */
+#endif
+
+#define DVFS_EVENT_PRE          0           /*!< Before the change, interrupts enabled. Finish or hold transfers,
+                                                 return non-zero to refuse the change. */
+#define DVFS_EVENT_POST         1           /*!< After the change, interrupts disabled. Recompute the divisors.
+                                                 Also sent when HCLK moves to HIRC while the PLL locks again. */
+#define DVFS_EVENT_ABORT        2           /*!< Change refused by a later driver, the clock stays as it was */
+
+#define DVFS_LEVEL_NONE         0xFFFFFFFF  /*!< No level set yet */
+
+/*@}*/ /* end of group NUC029_DVFS_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_DVFS_EXPORTED_STRUCTS DVFS Exported Structs
+  @{
+*/
+/**
+  * @details    Operating point. Tables are ordered from the fastest to the slowest level.
+  */
+typedef struct
+{
+    uint32_t u32HclkSrc;            /*!< CLK_CLKSEL0_HCLK_S_HXT, CLK_CLKSEL0_HCLK_S_HIRC or CLK_CLKSEL0_HCLK_S_PLL */
+    uint32_t u32HclkDiv;            /*!< HCLK divider, 1 ~ 16 */
+    uint32_t u32PllHz;              /*!< PLL output for CLK_CLKSEL0_HCLK_S_PLL, 25 MHz ~ 200 MHz, else 0.
+                                         HCLK must not exceed 50 MHz. */
+} DVFS_OPP_T;
+
+/**
+  * @details    Clock change notification. u32Hclk is the nominal new HCLK for \ref DVFS_EVENT_PRE, the
+  *             current HCLK otherwise. The return value counts for \ref DVFS_EVENT_PRE only.
+  */
+typedef int32_t (*DVFS_FUNC_T)(uint32_t u32Event, uint32_t u32Hclk);
+
+/**
+  * @details    Governor state and transition latency
+  */
+typedef struct
+{
+    uint32_t u32Level;              /*!< Current level, or \ref DVFS_LEVEL_NONE */
+    uint32_t u32Load;               /*!< CPU load of the last window in % */
+    uint32_t u32Transitions;        /*!< Level changes done */
+    uint32_t u32Refused;            /*!< Level changes refused by a driver */
+    uint32_t u32LastUs;             /*!< Time of the last change, notifications and PLL lock included */
+    uint32_t u32MaxUs;              /*!< Longest change */
+    uint32_t u32LastIrqOffUs;       /*!< Longest time with interrupts disabled in the last change */
+    uint32_t u32MaxIrqOffUs;        /*!< Longest time with interrupts disabled */
+} DVFS_STATS_T;
+
+/*@}*/ /* end of group NUC029_DVFS_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_DVFS_EXPORTED_FUNCTIONS DVFS Exported Functions
+  @{
+*/
+
+int32_t DVFS_Open(const DVFS_OPP_T *psOpp, uint32_t u32Num);
+int32_t DVFS_Register(DVFS_FUNC_T pfnFunc);
+void DVFS_Unregister(DVFS_FUNC_T pfnFunc);
+int32_t DVFS_SetLevel(uint32_t u32Level);
+uint32_t DVFS_GetLevel(void);
+uint32_t DVFS_GetLevelHz(uint32_t u32Level);
+void DVFS_SetGovernor(uint32_t u32Enable);
+void DVFS_Idle(void);
+void DVFS_GetStats(DVFS_STATS_T *psStats);
+
+/*@}*/ /* end of group NUC029_DVFS_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_DVFS_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__DVFS_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
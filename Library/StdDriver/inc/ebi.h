@@ -59,9 +59,66 @@ extern "C"
 #define EBI_TIMING_VERYSLOW     0x5UL /*!< EBI timing is very slow */
 #define EBI_TIMING_SLOWEST      0x6UL /*!< EBI timing is the slowest */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Constants for EBI timing calibration                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#define EBI_CAL_READONLY        0x1UL /*!< Calibrate with read-only checks against a slow reference read, for NOR flash */
+
+#ifndef EBI_CAL_MARGIN
+#define EBI_CAL_MARGIN          1     /*!< MCLK cycles added to tALE and tACC of the fastest passing setting */
+#endif
+
+#ifndef EBI_CAL_PASSES
+#define EBI_CAL_PASSES          4     /*!< Pattern passes a setting must survive */
+#endif
+
+#ifndef EBI_CAL_WINDOW
+#define EBI_CAL_WINDOW          512   /*!< Bytes used for data pattern test. Address lines are tested over the whole size */
+#endif
+
+#define EBI_CAL_MAGIC           0x43494245UL /*!< Record signature "EBIC" in flash */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Place variables in external memory                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+/**
+  * @details    Put a global variable in section .ebi_ram, which the linker places at \ref EBI_BASE_ADDR.
+  *             The section is not initialized at startup since EBI is not enabled yet. Usage:
+  *             EBI_RAM_SECTION uint8_t g_au8FrameBuf[0x4000];
+  *             The GCC linker script provides the region. KEIL needs a scatter file and IAR an ICF file with
+  *             the region, see sample EBI_MemCopy.
+  */
+#if defined (__ARMCC_VERSION) && (__ARMCC_VERSION >= 6000000)
+#define EBI_RAM_SECTION         __attribute__((section(".bss.ebi_ram")))
+#elif defined (__CC_ARM)
+#define EBI_RAM_SECTION         __attribute__((section(".ebi_ram"), zero_init))
+#elif defined (__ICCARM__)
+#define EBI_RAM_SECTION         _Pragma("location=\".ebi_ram\"") __no_init
+#else
+#define EBI_RAM_SECTION         __attribute__((section(".ebi_ram")))
+#endif
+
 /*@}*/ /* end of group NUC029_EBI_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup NUC029_EBI_EXPORTED_STRUCTS EBI Exported Structs
+  @{
+*/
+/**
+  * @details    EBI timing found by \ref EBI_Calibrate
+  */
+typedef struct
+{
+    uint32_t u32MclkDiv;    /*!< MCLK divider, \ref EBI_MCLKDIV_1 ~ \ref EBI_MCLKDIV_32 */
+    uint32_t u32ALE;        /*!< ExttALE field of EBICON, tALE = (u32ALE + 1) MCLK */
+    uint32_t u32ExTime;     /*!< EXTIME register value, ExttACC, ExttAHD, ExtIW2X and ExtIR2R */
+    uint32_t u32ReadBps;    /*!< Measured read bandwidth in bytes per second, 32-bit accesses */
+    uint32_t u32WriteBps;   /*!< Measured write bandwidth in bytes per second, 0 if calibrated read-only */
+} EBI_CAL_T;
+
+/*@}*/ /* end of group NUC029_EBI_EXPORTED_STRUCTS */
+
+
 /** @addtogroup NUC029_EBI_EXPORTED_FUNCTIONS EBI Exported Functions
   @{
 */
@@ -138,6 +195,14 @@ extern "C"
 void EBI_Open(uint32_t u32Bank, uint32_t u32DataWidth, uint32_t u32TimingClass, uint32_t u32BusMode, uint32_t u32CSActiveLevel);
 void EBI_Close(uint32_t u32Bank);
 void EBI_SetBusTiming(uint32_t u32Bank, uint32_t u32TimingConfig, uint32_t u32MclkDiv);
+int32_t EBI_Calibrate(uint32_t u32Bank, uint32_t u32Offset, uint32_t u32Size, uint32_t u32Flags, EBI_CAL_T *psCal);
+void EBI_ApplyCalibration(uint32_t u32Bank, const EBI_CAL_T *psCal);
+void EBI_MeasureBandwidth(uint32_t u32Offset, uint32_t u32Size, uint32_t u32Flags, EBI_CAL_T *psCal);
+int32_t EBI_SaveCalibration(uint32_t u32FlashAddr, const EBI_CAL_T *psCal);
+int32_t EBI_LoadCalibration(uint32_t u32FlashAddr, EBI_CAL_T *psCal);
+void EBI_MemCopy(void *pvDst, const void *pvSrc, uint32_t u32Len);
+void EBI_MemSet(void *pvDst, uint32_t u32Value, uint32_t u32Len);
+int32_t EBI_MemCmp(const void *pv1, const void *pv2, uint32_t u32Len);
 
 /*@}*/ /* end of group NUC029_EBI_EXPORTED_FUNCTIONS */
 
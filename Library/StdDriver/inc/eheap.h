@@ -0,0 +1,112 @@
+/**************************************************************************//**
+ * @file     eheap.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/06 2:15p $
+ * @brief    NUC029 series external SRAM heap header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __EHEAP_H__
+#define __EHEAP_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_EHEAP_Driver EHEAP Driver
+  @{
+*/
+
+/** @addtogroup NUC029_EHEAP_EXPORTED_CONSTANTS EHEAP Exported Constants
+  @{
+*/
+#ifndef EHEAP_POOL_NUM
+#define EHEAP_POOL_NUM          4       /*!< Number of segregated pools. Block size of pool n is 16 << n bytes */
+#endif
+
+#ifndef EHEAP_POOL_BLOCKS
+#define EHEAP_POOL_BLOCKS       32      /*!< Blocks in each segregated pool, taken from the heap area by \ref EHEAP_Init */
+#endif
+
+#ifndef EHEAP_FAST_SIZE
+#define EHEAP_FAST_SIZE         32      /*!< Block size of internal SRAM fast pool in bytes, multiple of 4 */
+#endif
+
+#ifndef EHEAP_FAST_BLOCKS
+#define EHEAP_FAST_BLOCKS       8       /*!< Blocks in internal SRAM fast pool, 0 to disable */
+#endif
+
+#define EHEAP_POOL_MAX_SIZE     (16UL << (EHEAP_POOL_NUM - 1))  /*!< Largest request served by segregated pools */
+
+#define EHEAP_FLAG_FAST         BIT0    /*!< \ref EHEAP_Alloc tries internal SRAM fast pool first */
+#define EHEAP_FLAG_NOPOOL       BIT1    /*!< \ref EHEAP_Alloc skips segregated pools, allocate from TLSF area only */
+
+/*@}*/ /* end of group NUC029_EHEAP_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_EHEAP_EXPORTED_STRUCTS EHEAP Exported Structs
+  @{
+*/
+/**
+  * @details    Statistics of one fixed-size pool. Pool index \ref EHEAP_POOL_NUM is the internal SRAM fast pool.
+  */
+typedef struct
+{
+    uint32_t u32BlockSize;      /*!< Block size in bytes */
+    uint32_t u32Blocks;         /*!< Number of blocks */
+    uint32_t u32Used;           /*!< Blocks in use */
+    uint32_t u32Peak;           /*!< Highest number of blocks in use */
+    uint32_t u32Fail;           /*!< Requests not served because pool was empty */
+} EHEAP_POOL_STATS_T;
+
+/**
+  * @details    Statistics of TLSF area
+  */
+typedef struct
+{
+    uint32_t u32Size;           /*!< Bytes managed by TLSF, including block headers */
+    uint32_t u32Free;           /*!< Free payload bytes */
+    uint32_t u32MinFree;        /*!< Lowest u32Free seen since \ref EHEAP_Init */
+    uint32_t u32LargestFree;    /*!< Largest free block */
+    uint32_t u32FreeBlocks;     /*!< Number of free blocks */
+    uint32_t u32UsedBlocks;     /*!< Number of allocated blocks */
+    uint32_t u32Fail;           /*!< Requests that could not be served */
+    uint32_t u32Frag;           /*!< Fragmentation in percent, 100 * (1 - u32LargestFree / u32Free) */
+} EHEAP_STATS_T;
+
+/*@}*/ /* end of group NUC029_EHEAP_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_EHEAP_EXPORTED_FUNCTIONS EHEAP Exported Functions
+  @{
+*/
+
+int32_t EHEAP_Init(void *pvBase, uint32_t u32Size);
+void *EHEAP_Alloc(uint32_t u32Size, uint32_t u32Flags);
+void EHEAP_Free(void *pvPtr);
+int32_t EHEAP_GetPoolStats(uint32_t u32Pool, EHEAP_POOL_STATS_T *psStats);
+void EHEAP_GetStats(EHEAP_STATS_T *psStats);
+int32_t EHEAP_Check(void);
+
+/*@}*/ /* end of group NUC029_EHEAP_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_EHEAP_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__EHEAP_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
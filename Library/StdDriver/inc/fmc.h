@@ -68,6 +68,28 @@ extern "C"
 #define FMC_TIMEOUT_WRITE           (SystemCoreClock>>3) /*!< Write command time-out 125 ms      */
 #define FMC_TIMEOUT_ERASE           (SystemCoreClock>>2) /*!< Erase command time-out 250 ms      */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  FMC_WriteMultiple flags                                                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+#define FMC_WRITE_VERIFY        BIT0    /*!< Compare flash with the buffer after programming */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Run code from SRAM                                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+/**
+  * @details    Put a function in section .ramfunc, so it is copied to SRAM at startup and runs there while
+  *             the flash is busy with an ISP command. IAR and GCC copy it without further setup. KEIL needs
+  *             "*(.ramfunc)" in the RW execution region of the scatter file, see sample FMC_PageWrite.
+  *             Without it the function runs from flash, which works but stalls on each ISP command.
+  */
+#if defined (__ICCARM__)
+#define FMC_RAMFUNC             __ramfunc
+#elif defined (__CC_ARM) || defined (__ARMCC_VERSION)
+#define FMC_RAMFUNC             __attribute__((section(".ramfunc"), noinline))
+#else
+#define FMC_RAMFUNC             __attribute__((section(".data.ramfunc"), noinline, long_call))
+#endif
+
 /*@}*/ /* end of group NUC029_FMC_EXPORTED_CONSTANTS */
 
 extern int32_t g_FMC_i32ErrCode;
@@ -255,6 +277,8 @@ static __INLINE int32_t FMC_Write(uint32_t u32addr, uint32_t u32data)
 {
     uint32_t u32TimeOutCnt;
 
+    TRACE_DRV_ENTER(TRACE_ID_FMC_WRITE, u32addr >> 9);
+
     g_FMC_i32ErrCode = 0;
 
     FMC->ISPCMD = FMC_ISPCMD_PROGRAM;   /* Set ISP Command Code */
@@ -269,10 +293,12 @@ static __INLINE int32_t FMC_Write(uint32_t u32addr, uint32_t u32data)
         if(--u32TimeOutCnt == 0)
         {
             g_FMC_i32ErrCode = -1;
+            TRACE_DRV_EXIT(TRACE_ID_FMC_WRITE, -1);
             return -1;
         }
     }
 
+    TRACE_DRV_EXIT(TRACE_ID_FMC_WRITE, 0);
     return 0;
 }
 
@@ -291,7 +317,9 @@ static __INLINE int32_t FMC_Write(uint32_t u32addr, uint32_t u32data)
  */
 static __INLINE uint32_t FMC_Read(uint32_t u32addr)
 {
-    uint32_t u32TimeOutCnt;
+    uint32_t u32TimeOutCnt, u32Data;
+
+    TRACE_DRV_ENTER(TRACE_ID_FMC_READ, u32addr >> 9);
 
     g_FMC_i32ErrCode = 0;
 
@@ -306,11 +334,14 @@ static __INLINE uint32_t FMC_Read(uint32_t u32addr)
         if(--u32TimeOutCnt == 0)
         {
             g_FMC_i32ErrCode = -1;
+            TRACE_DRV_EXIT(TRACE_ID_FMC_READ, 0xFFFFFFFF);
             return 0xFFFFFFFF;
         }
     }
 
-    return FMC->ISPDAT;
+    u32Data = FMC->ISPDAT;
+    TRACE_DRV_EXIT(TRACE_ID_FMC_READ, u32Data);
+    return u32Data;
 }
 
 
@@ -333,6 +364,8 @@ static __INLINE int32_t FMC_Erase(uint32_t u32addr)
 {
     uint32_t u32TimeOutCnt;
 
+    TRACE_DRV_ENTER(TRACE_ID_FMC_ERASE, u32addr >> 9);
+
     g_FMC_i32ErrCode = 0;
 
     FMC->ISPCMD = FMC_ISPCMD_PAGE_ERASE; /* Set ISP Command Code */
@@ -346,6 +379,7 @@ static __INLINE int32_t FMC_Erase(uint32_t u32addr)
         if(--u32TimeOutCnt == 0)
         {
             g_FMC_i32ErrCode = -1;
+            TRACE_DRV_EXIT(TRACE_ID_FMC_ERASE, -1);
             return -1;
         }
     }
@@ -355,8 +389,10 @@ static __INLINE int32_t FMC_Erase(uint32_t u32addr)
     {
         FMC->ISPCON |= FMC_ISPCON_ISPFF_Msk;
         g_FMC_i32ErrCode = -1;
+        TRACE_DRV_EXIT(TRACE_ID_FMC_ERASE, -1);
         return -1;
     }
+    TRACE_DRV_EXIT(TRACE_ID_FMC_ERASE, 0);
     return 0;
 }
 
@@ -581,6 +617,8 @@ extern void FMC_EnableLDUpdate(void);
 extern void FMC_DisableLDUpdate(void);
 extern int32_t FMC_ReadConfig(uint32_t *u32Config, uint32_t u32Count);
 extern int32_t FMC_WriteConfig(uint32_t *u32Config, uint32_t u32Count);
+extern int32_t FMC_WriteMultiple(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len, uint32_t u32Flags);
+extern int32_t FMC_WritePage(uint32_t u32PageAddr, const uint32_t *pu32Buf, uint32_t u32Flags);
 extern void FMC_SetBootSource(int32_t i32BootSrc);
 extern int32_t FMC_GetBootSource(void);
 extern uint32_t FMC_ReadDataFlashBaseAddr(void);
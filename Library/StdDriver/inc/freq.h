@@ -0,0 +1,107 @@
+/**************************************************************************//**
+ * @file     freq.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series frequency and duty meter header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __FREQ_H__
+#define __FREQ_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_FREQ_Driver FREQ Driver
+  @{
+*/
+
+/** @addtogroup NUC029_FREQ_EXPORTED_CONSTANTS FREQ Exported Constants
+  @{
+*/
+#ifndef FREQ_TIMER
+#define FREQ_TIMER              TIMER1      /*!< Measuring timer, the signal goes to its Tx and TxEX pins */
+#define FREQ_TIMER_IRQn         TMR1_IRQn   /*!< IRQ number of \ref FREQ_TIMER */
+#endif
+
+#ifndef FREQ_GATE
+#define FREQ_GATE               TIMER0      /*!< Gate timer, sets the counting time and the no signal time-out */
+#define FREQ_GATE_IRQn          TMR0_IRQn   /*!< IRQ number of \ref FREQ_GATE */
+#endif
+
+#ifndef FREQ_GATE_MS
+#define FREQ_GATE_MS            100         /*!< Gate time in ms */
+#endif
+
+#ifndef FREQ_SWITCH_HZ
+#define FREQ_SWITCH_HZ          5000        /*!< Period measurement up to this frequency, event counting above.
+                                                 Back to period measurement below half of it. */
+#endif
+
+#ifndef FREQ_TIMEOUT_MS
+#define FREQ_TIMEOUT_MS         12000       /*!< No edge for this time means no signal, sets the lowest frequency */
+#endif
+
+#ifndef FREQ_RING_SIZE
+#define FREQ_RING_SIZE          8           /*!< Samples kept for averaging, power of 2 */
+#endif
+
+#define FREQ_MODE_PERIOD        0           /*!< Period and duty from captured edges */
+#define FREQ_MODE_COUNT         1           /*!< Edges counted over the gate time */
+
+#define FREQ_DUTY_UNKNOWN       0xFFFFFFFF  /*!< Duty not measured, in event counting or after a missed edge */
+
+/*@}*/ /* end of group NUC029_FREQ_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_FREQ_EXPORTED_STRUCTS FREQ Exported Structs
+  @{
+*/
+/**
+  * @details    Measurement averaged over the latest samples
+  */
+typedef struct
+{
+    uint32_t u32MilliHz;            /*!< Frequency in mHz */
+    uint32_t u32ResMilliHz;         /*!< Resolution in mHz, the frequency is exact to one count of the timer */
+    uint32_t u32Duty;               /*!< High time in 0.01 %, or \ref FREQ_DUTY_UNKNOWN */
+    uint32_t u32Mode;               /*!< \ref FREQ_MODE_PERIOD or \ref FREQ_MODE_COUNT */
+    uint32_t u32Samples;            /*!< Periods or gates averaged */
+} FREQ_RESULT_T;
+
+/*@}*/ /* end of group NUC029_FREQ_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_FREQ_EXPORTED_FUNCTIONS FREQ Exported Functions
+  @{
+*/
+
+void FREQ_Open(void);
+void FREQ_Close(void);
+void FREQ_TimerHandler(void);
+void FREQ_GateHandler(void);
+int32_t FREQ_Read(FREQ_RESULT_T *psResult, uint32_t u32Num);
+
+/*@}*/ /* end of group NUC029_FREQ_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_FREQ_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__FREQ_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
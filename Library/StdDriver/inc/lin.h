@@ -0,0 +1,142 @@
+/**************************************************************************//**
+ * @file     lin.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series LIN protocol stack header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __LIN_H__
+#define __LIN_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_LIN_Driver LIN Driver
+  @{
+*/
+
+/** @addtogroup NUC029_LIN_EXPORTED_CONSTANTS LIN Exported Constants
+  @{
+*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*  UART connected to the LIN transceiver, and the timer of the master schedule                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef LIN_UART
+#define LIN_UART                UART1           /*!< UART used for LIN */
+#define LIN_UART_IRQn           UART1_IRQn      /*!< IRQ number of \ref LIN_UART */
+#endif
+
+#ifndef LIN_TIMER
+#define LIN_TIMER               TIMER2          /*!< Timer of the master schedule slots */
+#define LIN_TIMER_IRQn          TMR2_IRQn       /*!< IRQ number of \ref LIN_TIMER */
+#endif
+
+#ifndef LIN_TIME_BASE_US
+#define LIN_TIME_BASE_US        1000            /*!< Schedule time base in us, slot lengths are counted in it */
+#endif
+
+#define LIN_BREAK_LEN           13              /*!< Break field length of master headers in bits */
+#define LIN_MAX_DATA            8               /*!< Longest frame response */
+#define LIN_ID_NUM              64              /*!< Number of frame identifiers */
+
+#define LIN_MODE_SLAVE          0               /*!< Answer headers from the bus */
+#define LIN_MODE_MASTER         1               /*!< Send headers from the schedule table, answer like a slave */
+
+#define LIN_FRAME_PUBLISH       BIT0            /*!< This node sends the response */
+#define LIN_FRAME_CLASSIC       BIT1            /*!< Classic checksum without PID. IDs 0x3C and up always use it. */
+
+#define LIN_SLOT_EMPTY          0xFF            /*!< \ref LIN_SCHED_T ID of a slot without header */
+
+/*@}*/ /* end of group NUC029_LIN_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_LIN_EXPORTED_STRUCTS LIN Exported Structs
+  @{
+*/
+typedef struct LIN_FRAME_S LIN_FRAME_T;
+
+/**
+  * @details    Frame callback, runs in \ref LIN_IRQHandler after the frame completed without error
+  */
+typedef void (*LIN_FUNC_T)(LIN_FRAME_T *psFrame);
+
+/**
+  * @details    Frame of this node. Storage is provided by the caller and must stay valid while LIN is open.
+  */
+struct LIN_FRAME_S
+{
+    uint8_t u8Id;                   /*!< Frame identifier, 0 ~ 63 */
+    uint8_t u8Len;                  /*!< Response length, 1 ~ 8 */
+    uint8_t u8Flags;                /*!< \ref LIN_FRAME_PUBLISH, \ref LIN_FRAME_CLASSIC */
+    volatile uint8_t u8Updated;     /*!< Set when the frame completed, cleared by \ref LIN_ReadFrame */
+    uint8_t au8Data[LIN_MAX_DATA];  /*!< Response. Use \ref LIN_ReadFrame and \ref LIN_WriteFrame while LIN is open. */
+    LIN_FUNC_T pfnFunc;             /*!< Callback, NULL if not used */
+    uint8_t u8Pid;                  /*!< Protected identifier, set by \ref LIN_Open */
+    uint8_t u8Seed;                 /*!< Checksum start value, set by \ref LIN_Open */
+};
+
+/**
+  * @details    Schedule table entry
+  */
+typedef struct
+{
+    uint8_t u8Id;                   /*!< Frame identifier of the header, or \ref LIN_SLOT_EMPTY */
+    uint8_t u8Ticks;                /*!< Slot length in \ref LIN_TIME_BASE_US, 1 ~ 255 */
+} LIN_SCHED_T;
+
+/**
+  * @details    Error counters
+  */
+typedef struct
+{
+    uint32_t u32Frames;             /*!< Frames of this node completed */
+    uint32_t u32Sync;               /*!< Sync field not 0x55 */
+    uint32_t u32Parity;             /*!< PID parity error */
+    uint32_t u32Checksum;           /*!< Checksum error */
+    uint32_t u32NoResponse;         /*!< No response byte before the next header */
+    uint32_t u32Incomplete;         /*!< Response cut short by the next header */
+    uint32_t u32BitError;           /*!< Published byte read back different */
+    uint32_t u32Framing;            /*!< Framing error or RX overflow */
+} LIN_STATS_T;
+
+/*@}*/ /* end of group NUC029_LIN_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_LIN_EXPORTED_FUNCTIONS LIN Exported Functions
+  @{
+*/
+
+int32_t LIN_Open(uint32_t u32BaudRate, uint32_t u32Mode, LIN_FRAME_T *psFrames, uint32_t u32Num);
+void LIN_Close(void);
+void LIN_SetSchedule(const LIN_SCHED_T *psTable, uint32_t u32Num);
+void LIN_IRQHandler(void);
+void LIN_TimerHandler(void);
+uint32_t LIN_ReadFrame(LIN_FRAME_T *psFrame, uint8_t *pu8Data);
+void LIN_WriteFrame(LIN_FRAME_T *psFrame, const uint8_t *pu8Data);
+void LIN_GetStats(LIN_STATS_T *psStats);
+void LIN_ResetStats(void);
+
+/*@}*/ /* end of group NUC029_LIN_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_LIN_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__LIN_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
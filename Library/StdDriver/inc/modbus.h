@@ -0,0 +1,142 @@
+/**************************************************************************//**
+ * @file     modbus.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series Modbus RTU slave header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __MODBUS_H__
+#define __MODBUS_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_MODBUS_Driver MODBUS Driver
+  @{
+*/
+
+/** @addtogroup NUC029_MODBUS_EXPORTED_CONSTANTS MODBUS Exported Constants
+  @{
+*/
+#ifndef MB_UART
+#define MB_UART                 UART1       /*!< UART of the Modbus link */
+#define MB_UART_IRQn            UART1_IRQn  /*!< IRQ number of \ref MB_UART */
+#endif
+
+#ifndef MB_RS485
+#define MB_RS485                1           /*!< 1 to drive the transceiver direction by RTS in RS485 AUD mode */
+#endif
+
+#ifndef MB_RTS_LEVEL
+#define MB_RTS_LEVEL            UART_RTS_IS_HIGH_LEV_ACTIVE     /*!< RTS level while sending */
+#endif
+
+#ifndef MB_MAX_FRAME
+#define MB_MAX_FRAME            128         /*!< Frame buffer size, 16 ~ 256. Limits the registers per request. */
+#endif
+
+#define MB_BROADCAST            0           /*!< Broadcast address, requests are executed without response */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Function codes                                                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MB_FC_READ_COILS            0x01    /*!< Read coils */
+#define MB_FC_READ_INPUTS           0x02    /*!< Read discrete inputs */
+#define MB_FC_READ_HOLDING          0x03    /*!< Read holding registers */
+#define MB_FC_READ_INPUT_REGS       0x04    /*!< Read input registers */
+#define MB_FC_WRITE_COIL            0x05    /*!< Write single coil */
+#define MB_FC_WRITE_REG             0x06    /*!< Write single holding register */
+#define MB_FC_WRITE_COILS           0x0F    /*!< Write multiple coils */
+#define MB_FC_WRITE_REGS            0x10    /*!< Write multiple holding registers */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Exception codes                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MB_EX_ILLEGAL_FUNCTION      0x01    /*!< Function code not supported */
+#define MB_EX_ILLEGAL_ADDRESS       0x02    /*!< Data address out of the map */
+#define MB_EX_ILLEGAL_VALUE         0x03    /*!< Quantity, length or value not allowed */
+
+/*@}*/ /* end of group NUC029_MODBUS_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_MODBUS_EXPORTED_STRUCTS MODBUS Exported Structs
+  @{
+*/
+/**
+  * @details    Write notification, runs in \ref MB_IRQHandler after coils or holding registers were written
+  */
+typedef void (*MB_FUNC_T)(uint32_t u32Func, uint32_t u32Addr, uint32_t u32Num);
+
+/**
+  * @details    Data map. Requests read and write the application arrays directly. Coils and discrete inputs are
+  *             packed 8 per byte, LSB first. Set the count of a table to 0 if it is not used.
+  */
+typedef struct
+{
+    uint8_t *pu8Coils;              /*!< Coils */
+    uint16_t u16CoilStart;          /*!< Address of the first coil */
+    uint16_t u16CoilNum;            /*!< Number of coils */
+    const uint8_t *pu8Inputs;       /*!< Discrete inputs */
+    uint16_t u16InputStart;         /*!< Address of the first discrete input */
+    uint16_t u16InputNum;           /*!< Number of discrete inputs */
+    uint16_t *pu16Holding;          /*!< Holding registers */
+    uint16_t u16HoldingStart;       /*!< Address of the first holding register */
+    uint16_t u16HoldingNum;         /*!< Number of holding registers */
+    const uint16_t *pu16InputRegs;  /*!< Input registers */
+    uint16_t u16InputRegStart;      /*!< Address of the first input register */
+    uint16_t u16InputRegNum;        /*!< Number of input registers */
+    MB_FUNC_T pfnWrite;             /*!< Write notification, NULL if not used */
+} MB_MAP_T;
+
+/**
+  * @details    Counters
+  */
+typedef struct
+{
+    uint32_t u32Frames;             /*!< Requests to this node executed, broadcasts included */
+    uint32_t u32Broadcast;          /*!< Broadcast requests */
+    uint32_t u32Other;              /*!< Frames to other nodes */
+    uint32_t u32CrcError;           /*!< Frames with CRC, parity or framing error, or shorter than 4 bytes */
+    uint32_t u32Overrun;            /*!< Frames longer than \ref MB_MAX_FRAME, lost by RX FIFO overflow or
+                                         received while a response was sent */
+    uint32_t u32Exception;          /*!< Exception responses */
+} MB_STATS_T;
+
+/*@}*/ /* end of group NUC029_MODBUS_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_MODBUS_EXPORTED_FUNCTIONS MODBUS Exported Functions
+  @{
+*/
+
+void MB_Open(uint32_t u32BaudRate, uint32_t u32Parity, uint32_t u32Addr, const MB_MAP_T *psMap);
+void MB_Close(void);
+void MB_IRQHandler(void);
+uint32_t MB_Crc16(const uint8_t *pu8Data, uint32_t u32Len);
+void MB_GetStats(MB_STATS_T *psStats);
+void MB_ResetStats(void);
+
+/*@}*/ /* end of group NUC029_MODBUS_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_MODBUS_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MODBUS_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ * @file     pm.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series tickless power manager header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __PM_H__
+#define __PM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_PM_Driver PM Driver
+  @{
+*/
+
+/** @addtogroup NUC029_PM_EXPORTED_CONSTANTS PM Exported Constants
+  @{
+*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Timebase. A timer clocked by LIRC keeps counting in Power-down mode and wakes the chip up.             */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef PM_TIMEBASE
+#define PM_TIMEBASE             TIMER1                  /*!< Timer used as timebase */
+#define PM_TIMEBASE_MODULE      TMR1_MODULE             /*!< Module index of \ref PM_TIMEBASE */
+#define PM_TIMEBASE_CLKSEL      CLK_CLKSEL1_TMR1_S_LIRC /*!< Clock source setting of \ref PM_TIMEBASE */
+#define PM_TIMEBASE_IRQn        TMR1_IRQn               /*!< IRQ number of \ref PM_TIMEBASE */
+#endif
+
+#define PM_TICK_HZ              __LIRC  /*!< Nominal tick rate. \ref PM_Calibrate measures the real rate. */
+
+#ifndef PM_PD_WAKEUP_TICKS
+#define PM_PD_WAKEUP_TICKS      10      /*!< Ticks reserved for wake-up and clock restore, about 1 ms */
+#endif
+
+#ifndef PM_PD_MIN_TICKS
+#define PM_PD_MIN_TICKS         (4 * PM_PD_WAKEUP_TICKS)    /*!< Shorter sleeps use Idle mode */
+#endif
+
+#define PM_MAX_SLEEP            0x800000UL  /*!< Longest sleep in ticks, keeps the 24-bit counter extension valid */
+
+#define PM_MODE_IDLE            0       /*!< CPU clock stopped, peripherals running */
+#define PM_MODE_PD              1       /*!< Power-down, only LIRC peripherals running */
+#define PM_MODE_NUM             2       /*!< Number of low power modes */
+
+/*@}*/ /* end of group NUC029_PM_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_PM_EXPORTED_STRUCTS PM Exported Structs
+  @{
+*/
+/**
+  * @details    Timer callback, runs in \ref PM_IRQHandler
+  */
+typedef void (*PM_FUNC_T)(void *pvArg);
+
+/**
+  * @details    Software timer. Storage is provided by the caller and must stay valid while the timer runs.
+  */
+typedef struct PM_TIMER_S
+{
+    struct PM_TIMER_S *psNext;  /*!< Next timer in expiry order */
+    uint32_t u32Expire;         /*!< Tick of next expiry */
+    uint32_t u32Period;         /*!< Reload in ticks, 0 for one-shot */
+    PM_FUNC_T pfnFunc;          /*!< Callback */
+    void *pvArg;                /*!< Callback argument */
+} PM_TIMER_T;
+
+/**
+  * @details    Residency counters
+  */
+typedef struct
+{
+    uint32_t au32Count[PM_MODE_NUM];    /*!< Entries of each mode */
+    uint32_t au32Ticks[PM_MODE_NUM];    /*!< Ticks spent in each mode */
+    uint32_t u32MaxWakeup;              /*!< Longest wake-up from Power-down to restored clock, in ticks */
+} PM_STATS_T;
+
+/*@}*/ /* end of group NUC029_PM_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_PM_EXPORTED_FUNCTIONS PM Exported Functions
+  @{
+*/
+
+void PM_Open(void);
+uint32_t PM_Calibrate(uint32_t u32Ticks);
+uint32_t PM_GetTicks(void);
+uint32_t PM_MsToTicks(uint32_t u32Ms);
+void PM_StartTimer(PM_TIMER_T *psTimer, uint32_t u32Ticks, uint32_t u32Period, PM_FUNC_T pfnFunc, void *pvArg);
+void PM_StopTimer(PM_TIMER_T *psTimer);
+void PM_IRQHandler(void);
+void PM_Lock(void);
+void PM_Unlock(void);
+uint32_t PM_Idle(void);
+void PM_GetStats(PM_STATS_T *psStats);
+void PM_ResetStats(void);
+
+/*@}*/ /* end of group NUC029_PM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_PM_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__PM_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,116 @@
+/**************************************************************************//**
+ * @file     pool.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/07 3:40p $
+ * @brief    NUC029 series fixed-block memory pool header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_POOL_Driver POOL Driver
+  @{
+*/
+
+/** @addtogroup NUC029_POOL_EXPORTED_CONSTANTS POOL Exported Constants
+  @{
+*/
+
+/**
+  * @brief      Block size rounded up to word alignment
+  * @param[in]  size    Requested block size in bytes
+  * @return     Block size used by the pool
+  */
+#define POOL_BLOCK_SIZE(size)   ((((uint32_t)(size)) + 3) & ~3UL)
+
+/**
+  * @brief      Define a pool and its storage at compile time
+  * @param[in]  name    Name of POOL_T variable
+  * @param[in]  size    Block size in bytes, 4 ~ 65532
+  * @param[in]  blocks  Number of blocks, 1 ~ 65535
+  * @details    Use at file scope, e.g. POOL_DEFINE(g_sRxPool, 64, 4); The pool is ready without calling
+  *             \ref POOL_Init and takes POOL_BLOCK_SIZE(size) * blocks + sizeof(POOL_T), 28 bytes, of SRAM.
+  *             Use extern POOL_T to access it from other files.
+  */
+#define POOL_DEFINE(name, size, blocks) \
+    static uint32_t name##_au32Buf[POOL_BLOCK_SIZE(size) / 4 * (blocks)]; \
+    POOL_T name = { NULL, (uint8_t *)name##_au32Buf, (uint8_t *)name##_au32Buf + POOL_BLOCK_SIZE(size) * (blocks), \
+                    (uint16_t)POOL_BLOCK_SIZE(size), (uint16_t)(blocks), 0, 0, 0, 0, 0 }
+
+/**
+  * @brief      Check if a pointer is a block of the pool
+  * @param[in]  pool    Pointer to POOL_T
+  * @param[in]  ptr     Pointer to check
+  * @return     1 if ptr is inside the pool storage, 0 otherwise
+  */
+#define POOL_IS_BLOCK(pool, ptr)    ((((uint8_t *)(ptr)) >= (pool)->pu8Start) && (((uint8_t *)(ptr)) < (pool)->pu8End))
+
+/**
+  * @brief      Get number of free blocks
+  * @param[in]  pool    Pointer to POOL_T
+  * @return     Blocks that can still be allocated
+  */
+#define POOL_GET_FREE(pool)         ((uint32_t)((pool)->u16Blocks - (pool)->u16Used))
+
+/*@}*/ /* end of group NUC029_POOL_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_POOL_EXPORTED_STRUCTS POOL Exported Structs
+  @{
+*/
+/**
+  * @details    Pool control block. Fields are read only for the application.
+  */
+typedef struct
+{
+    void *pvFree;               /*!< Freed blocks, linked through their first word */
+    uint8_t *pu8Start;          /*!< First block */
+    uint8_t *pu8End;            /*!< End of storage */
+    uint16_t u16BlockSize;      /*!< Block size in bytes, multiple of 4 */
+    uint16_t u16Blocks;         /*!< Number of blocks */
+    uint16_t u16Next;           /*!< Index of first block never allocated, so storage needs no linking at start */
+    uint16_t u16Used;           /*!< Blocks in use */
+    uint16_t u16Peak;           /*!< Highest number of blocks in use */
+    uint16_t u16Reserved;
+    uint32_t u32Fail;           /*!< Allocations failed because pool was empty */
+} POOL_T;
+
+/*@}*/ /* end of group NUC029_POOL_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_POOL_EXPORTED_FUNCTIONS POOL Exported Functions
+  @{
+*/
+
+int32_t POOL_Init(POOL_T *psPool, void *pvBuf, uint32_t u32BlockSize, uint32_t u32Blocks);
+void *POOL_Alloc(POOL_T *psPool);
+void POOL_Free(POOL_T *psPool, void *pvBlk);
+void POOL_ResetStats(POOL_T *psPool);
+
+/*@}*/ /* end of group NUC029_POOL_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_POOL_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__POOL_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
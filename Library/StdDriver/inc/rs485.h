@@ -0,0 +1,115 @@
+/**************************************************************************//**
+ * @file     rs485.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series RS485 multi-drop link layer header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __RS485_H__
+#define __RS485_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_RS485_Driver RS485 Driver
+  @{
+*/
+
+/** @addtogroup NUC029_RS485_EXPORTED_CONSTANTS RS485 Exported Constants
+  @{
+*/
+#ifndef RS485_UART
+#define RS485_UART              UART1       /*!< UART connected to the transceiver, RTS drives its direction */
+#define RS485_UART_IRQn         UART1_IRQn  /*!< IRQ number of \ref RS485_UART */
+#endif
+
+#ifndef RS485_MAX_FRAME
+#define RS485_MAX_FRAME         64          /*!< Longest payload received, longer frames are dropped */
+#endif
+
+#ifndef RS485_GAP_CHARS
+#define RS485_GAP_CHARS         2           /*!< Idle time in characters that ends a frame, 1 ~ 23 */
+#endif
+
+#ifndef RS485_TURNAROUND_US
+#define RS485_TURNAROUND_US     100         /*!< Delay before the address byte, lets the last sender release the bus */
+#endif
+
+#ifndef RS485_RTS_LEVEL
+#define RS485_RTS_LEVEL         UART_RTS_IS_HIGH_LEV_ACTIVE     /*!< RTS level while sending */
+#endif
+
+#ifndef RS485_PEER_NUM
+#define RS485_PEER_NUM          16          /*!< Destination addresses 0 ~ RS485_PEER_NUM - 1 get their own TX counter */
+#endif
+
+#define RS485_CHAR_BITS         11          /*!< Start, 8 data, address flag and stop bit */
+
+/*@}*/ /* end of group NUC029_RS485_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_RS485_EXPORTED_STRUCTS RS485 Exported Structs
+  @{
+*/
+/**
+  * @details    Frame callback, runs in \ref RS485_IRQHandler. The buffer is reused after it returns.
+  */
+typedef void (*RS485_FUNC_T)(uint8_t *pu8Data, uint32_t u32Len);
+
+/**
+  * @details    Statistics of this node. Received frames carry no source address, so only the frames sent are
+  *             counted per peer.
+  */
+typedef struct
+{
+    uint32_t u32RxFrames;       /*!< Frames received */
+    uint32_t u32TxFrames;       /*!< Frames sent */
+    uint32_t u32RxBytes;        /*!< Payload bytes received */
+    uint32_t u32Dropped;        /*!< Frames lost because the previous one was not read yet */
+    uint32_t u32TooLong;        /*!< Frames longer than \ref RS485_MAX_FRAME */
+    uint32_t u32LineError;      /*!< Frames with parity or framing error */
+    uint32_t u32Overflow;       /*!< RX FIFO overflows */
+    uint32_t u32Interrupts;     /*!< Interrupts taken, shows CPU load of the link */
+    uint32_t au32PeerTx[RS485_PEER_NUM];    /*!< Frames sent to each address below \ref RS485_PEER_NUM */
+} RS485_STATS_T;
+
+/*@}*/ /* end of group NUC029_RS485_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_RS485_EXPORTED_FUNCTIONS RS485 Exported Functions
+  @{
+*/
+
+void RS485_Open(uint32_t u32BaudRate, uint32_t u32Addr, RS485_FUNC_T pfnFunc);
+void RS485_Close(void);
+int32_t RS485_Send(uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len);
+uint32_t RS485_IsTxBusy(void);
+uint32_t RS485_Receive(uint8_t *pu8Buf, uint32_t u32Size);
+void RS485_IRQHandler(void);
+void RS485_GetStats(RS485_STATS_T *psStats);
+void RS485_ResetStats(void);
+
+/*@}*/ /* end of group NUC029_RS485_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_RS485_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__RS485_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,76 @@
+/**************************************************************************//**
+ * @file     sched.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:44p $
+ * @brief    NUC029 series cooperative run-to-completion scheduler header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __SCHED_H__
+#define __SCHED_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_SCHED_Driver SCHED Driver
+  @{
+*/
+
+/** @addtogroup NUC029_SCHED_EXPORTED_CONSTANTS SCHED Exported Constants
+  @{
+*/
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS         8       /*!< Number of task slots, 1 ~ 32. Each slot takes 16 bytes of SRAM */
+#endif
+
+#ifndef SCHED_IDLE
+#define SCHED_IDLE()            CLK_Idle()  /*!< Called with interrupts masked when no task is ready */
+#endif
+
+/*@}*/ /* end of group NUC029_SCHED_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_SCHED_EXPORTED_STRUCTS SCHED Exported Structs
+  @{
+*/
+/**
+  * @details    Task function. u32Events holds all events posted since the task last ran.
+  */
+typedef void (*SCHED_FUNC_T)(uint32_t u32Events, void *pvArg);
+
+/*@}*/ /* end of group NUC029_SCHED_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_SCHED_EXPORTED_FUNCTIONS SCHED Exported Functions
+  @{
+*/
+
+int32_t SCHED_AddTask(uint32_t u32Prio, SCHED_FUNC_T pfnTask, void *pvArg);
+void SCHED_PostEvent(uint32_t u32Prio, uint32_t u32Events);
+uint32_t SCHED_RunOnce(void);
+void SCHED_Run(void);
+uint32_t SCHED_GetRunCount(uint32_t u32Prio);
+
+/*@}*/ /* end of group NUC029_SCHED_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_SCHED_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SCHED_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
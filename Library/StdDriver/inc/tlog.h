@@ -0,0 +1,131 @@
+/**************************************************************************//**
+ * @file     tlog.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:44p $
+ * @brief    NUC029 series tokenized deferred log header file
+ *
+ * @note     With TLOG_ENABLE defined, LOG("fmt", ...) does not format on device. The format string is
+ *           placed in section ".tlog_fmt" and only its 16-bit ID and the raw arguments are queued.
+ *           A host tool looks the format string up in the ELF file and renders the text.
+ *           Without TLOG_ENABLE, LOG() is printf().
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __TLOG_H__
+#define __TLOG_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_TLOG_Driver TLOG Driver
+  @{
+*/
+
+/** @addtogroup NUC029_TLOG_EXPORTED_CONSTANTS TLOG Exported Constants
+  @{
+*/
+#ifndef TLOG_BUF_SIZE
+#define TLOG_BUF_SIZE           128     /*!< Size of log byte ring. Must be power of 2 */
+#endif
+
+#define TLOG_MAX_ARGS           8       /*!< Maximum arguments after the format string */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Stream encoding                                                                                         */
+/*   Log frame  : (TLOG_FRAME_LOG | argc) id[2] arg[0..argc-1]                                             */
+/*   Drop frame : TLOG_FRAME_DROP count                                                                    */
+/* id is little endian. Arguments and count are LEB128 varints, so small values take one byte.             */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TLOG_FRAME_LOG          0xA0    /*!< Log frame header, low nibble is argument count */
+#define TLOG_FRAME_DROP         0xB0    /*!< Frames were dropped because ring was full */
+
+/*@}*/ /* end of group NUC029_TLOG_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_TLOG_EXPORTED_FUNCTIONS TLOG Exported Functions
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#if defined (__CC_ARM) || defined (__GNUC__)
+#define TLOG_FMT_SECTION        __attribute__((section(".tlog_fmt"), used))
+#elif defined (__ICCARM__)
+#define TLOG_FMT_SECTION        _Pragma("location=\".tlog_fmt\"")
+#else
+#define TLOG_FMT_SECTION
+#endif
+
+/* Format ID is the string address. APROM is at most 64 KB from address 0, so flash addresses fit in 16 bits;
+   GCC links the section as non-loaded (INFO) starting at 1 so the strings take no flash at all. */
+#define TLOG_ID(fmt)            ((uint32_t)(fmt) & 0xFFFF)
+
+#define TLOG_CAT_(a, b)         a##b
+#define TLOG_CAT(a, b)          TLOG_CAT_(a, b)
+#define TLOG_FIRST(...)         TLOG_FIRST_(__VA_ARGS__, 0)
+#define TLOG_FIRST_(a, ...)     a
+#define TLOG_NARG(...)          TLOG_NARG_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0)
+#define TLOG_NARG_(f, a1, a2, a3, a4, a5, a6, a7, a8, n, ...)   n
+
+#define TLOG_REST0(f)
+#define TLOG_REST1(f, a)                        , (uint32_t)(a)
+#define TLOG_REST2(f, a, b)                     , (uint32_t)(a), (uint32_t)(b)
+#define TLOG_REST3(f, a, b, c)                  TLOG_REST2(f, a, b), (uint32_t)(c)
+#define TLOG_REST4(f, a, b, c, d)               TLOG_REST3(f, a, b, c), (uint32_t)(d)
+#define TLOG_REST5(f, a, b, c, d, e)            TLOG_REST4(f, a, b, c, d), (uint32_t)(e)
+#define TLOG_REST6(f, a, b, c, d, e, g)         TLOG_REST5(f, a, b, c, d, e), (uint32_t)(g)
+#define TLOG_REST7(f, a, b, c, d, e, g, h)      TLOG_REST6(f, a, b, c, d, e, g), (uint32_t)(h)
+#define TLOG_REST8(f, a, b, c, d, e, g, h, i)   TLOG_REST7(f, a, b, c, d, e, g, h), (uint32_t)(i)
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief      Log a message
+  *
+  * @param[in]  ...     A string literal format followed by up to \ref TLOG_MAX_ARGS arguments.
+  *
+  * @return     None
+  *
+  * @details    With TLOG_ENABLE, arguments are recorded as 32-bit integers. Integer, character and pointer
+  *             arguments are supported; float/double are not. A %s argument is rendered by the host tool
+  *             only if it points to a constant string in flash.
+  *             Without TLOG_ENABLE, this is printf() and works for any argument type.
+  */
+#ifdef TLOG_ENABLE
+#define LOG(...)                                                                    \
+    do                                                                              \
+    {                                                                               \
+        TLOG_FMT_SECTION static const char s_acTlogFmt[] = TLOG_FIRST(__VA_ARGS__); \
+        TLOG_Write(TLOG_ID(s_acTlogFmt), TLOG_NARG(__VA_ARGS__)                     \
+                   TLOG_CAT(TLOG_REST, TLOG_NARG(__VA_ARGS__))(__VA_ARGS__));       \
+    } while(0)
+#else
+#define LOG(...)                printf(__VA_ARGS__)
+#endif
+
+void TLOG_Write(uint32_t u32Id, uint32_t u32Argc, ...);
+uint32_t TLOG_Flush(UART_T *uart);
+uint32_t TLOG_GetDropCount(void);
+
+/*@}*/ /* end of group NUC029_TLOG_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_TLOG_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__TLOG_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
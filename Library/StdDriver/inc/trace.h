@@ -0,0 +1,162 @@
+/**************************************************************************//**
+ * @file     trace.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:44p $
+ * @brief    NUC029 series binary event trace header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_TRACE_Driver TRACE Driver
+  @{
+*/
+
+/** @addtogroup NUC029_TRACE_EXPORTED_CONSTANTS TRACE Exported Constants
+  @{
+*/
+/*---------------------------------------------------------------------------------------------------------*/
+/* Trace buffer configuration                                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef TRACE_BUF_SIZE
+#define TRACE_BUF_SIZE          32      /*!< Number of records in trace ring. Must be power of 2. Each record takes 8 bytes */
+#endif
+
+#define TRACE_MAGIC             0x45435254UL    /*!< "TRCE", marks the head of \ref g_sTraceBuf for debugger read out */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Event word: [15:14] record type, [13:0] event ID                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TRACE_TYPE_Pos          14
+#define TRACE_TYPE_Msk          (0x3UL << TRACE_TYPE_Pos)
+#define TRACE_ID_Msk            0x3FFFUL
+
+#define TRACE_TYPE_POINT        (0x0UL << TRACE_TYPE_Pos)   /*!< Single point event */
+#define TRACE_TYPE_ENTER        (0x1UL << TRACE_TYPE_Pos)   /*!< Function/section entry */
+#define TRACE_TYPE_EXIT         (0x2UL << TRACE_TYPE_Pos)   /*!< Function/section exit */
+#define TRACE_TYPE_ARGHI        (0x3UL << TRACE_TYPE_Pos)   /*!< Continuation record carrying arg[31:16] of previous record */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Event IDs                                                                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TRACE_ID_UART_OPEN          0x0101UL    /*!< UART_Open */
+#define TRACE_ID_UART_READ          0x0102UL    /*!< UART_Read */
+#define TRACE_ID_UART_WRITE         0x0103UL    /*!< UART_Write */
+#define TRACE_ID_UART_SETLINE       0x0104UL    /*!< UART_SetLine_Config */
+#define TRACE_ID_SPI_OPEN           0x0201UL    /*!< SPI_Open */
+#define TRACE_ID_SPI_CLOSE          0x0202UL    /*!< SPI_Close */
+#define TRACE_ID_SPI_SETBUSCLOCK    0x0203UL    /*!< SPI_SetBusClock */
+#define TRACE_ID_I2C_OPEN           0x0301UL    /*!< I2C_Open */
+#define TRACE_ID_I2C_CLOSE          0x0302UL    /*!< I2C_Close */
+#define TRACE_ID_I2C_SETBUSCLOCK    0x0303UL    /*!< I2C_SetBusClockFreq */
+#define TRACE_ID_FMC_READ           0x0401UL    /*!< FMC_Read */
+#define TRACE_ID_FMC_WRITE          0x0402UL    /*!< FMC_Write */
+#define TRACE_ID_FMC_ERASE          0x0403UL    /*!< FMC_Erase */
+#define TRACE_ID_USER               0x1000UL    /*!< First ID free for application use */
+#define TRACE_ID_LOST               0x3FFFUL    /*!< Emitted by \ref TRACE_Flush, argument is number of overwritten records */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* UART stream framing used by TRACE_Flush: SYNC0 SYNC1 time[4] event[2] arg[2], little endian            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TRACE_FRAME_SYNC0       0xA5
+#define TRACE_FRAME_SYNC1       0x5A
+#define TRACE_FRAME_LEN         10
+
+/*@}*/ /* end of group NUC029_TRACE_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_TRACE_EXPORTED_STRUCTS TRACE Exported Structs
+  @{
+*/
+/**
+  * @details    Trace record
+  */
+typedef struct
+{
+    uint32_t u32Time;           /*!< Timestamp in trace timer ticks, 24-bit counter extended to 32 bits */
+    uint16_t u16Event;          /*!< Record type and event ID */
+    uint16_t u16Arg;            /*!< Event argument */
+} TRACE_REC_T;
+
+/**
+  * @details    Trace ring buffer. Layout is fixed so that a raw memory dump can be decoded on host.
+  */
+typedef struct
+{
+    uint32_t u32Magic;          /*!< \ref TRACE_MAGIC once \ref TRACE_Open is called */
+    uint32_t u32Freq;           /*!< Timestamp frequency in Hz */
+    uint32_t u32Size;           /*!< Number of records in asRec */
+    volatile uint32_t u32Head;  /*!< Free running write index */
+    volatile uint32_t u32Tail;  /*!< Free running read index */
+    volatile uint32_t u32Lost;  /*!< Records overwritten before drained */
+    TRACE_REC_T asRec[TRACE_BUF_SIZE];
+} TRACE_BUF_T;
+
+/*@}*/ /* end of group NUC029_TRACE_EXPORTED_STRUCTS */
+
+extern TRACE_BUF_T g_sTraceBuf;
+
+
+/** @addtogroup NUC029_TRACE_EXPORTED_FUNCTIONS TRACE Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Record events
+  *
+  * @details    TRACE_EVENT/TRACE_ENTER/TRACE_EXIT are compiled in only if TRACE_ENABLE is defined.
+  *             TRACE_DRV_ENTER/TRACE_DRV_EXIT are used inside UART, SPI, I2C and FMC drivers and are
+  *             compiled in only if both TRACE_ENABLE and TRACE_ENABLE_DRIVER are defined.
+  */
+#ifdef TRACE_ENABLE
+#define TRACE_EVENT(id, arg)        TRACE_Event(TRACE_TYPE_POINT | (id), (uint32_t)(arg))
+#define TRACE_ENTER(id, arg)        TRACE_Event(TRACE_TYPE_ENTER | (id), (uint32_t)(arg))
+#define TRACE_EXIT(id, arg)         TRACE_Event(TRACE_TYPE_EXIT | (id), (uint32_t)(arg))
+#else
+#define TRACE_EVENT(id, arg)        ((void)0)
+#define TRACE_ENTER(id, arg)        ((void)0)
+#define TRACE_EXIT(id, arg)         ((void)0)
+#endif
+
+#if defined(TRACE_ENABLE) && defined(TRACE_ENABLE_DRIVER)
+#define TRACE_DRV_ENTER(id, arg)    TRACE_ENTER(id, arg)
+#define TRACE_DRV_EXIT(id, arg)     TRACE_EXIT(id, arg)
+#else
+#define TRACE_DRV_ENTER(id, arg)    ((void)0)
+#define TRACE_DRV_EXIT(id, arg)     ((void)0)
+#endif
+
+uint32_t TRACE_Open(TIMER_T *timer, uint32_t u32Freq);
+void TRACE_Close(void);
+uint32_t TRACE_GetTime(void);
+void TRACE_Event(uint32_t u32Event, uint32_t u32Arg);
+void TRACE_Event32(uint32_t u32Event, uint32_t u32Arg);
+uint32_t TRACE_Flush(UART_T *uart);
+
+/*@}*/ /* end of group NUC029_TRACE_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_TRACE_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__TRACE_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,69 @@
+/**************************************************************************//**
+ * @file     usec.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series microsecond timebase and delay header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __USEC_H__
+#define __USEC_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_USEC_Driver USEC Driver
+  @{
+*/
+
+/** @addtogroup NUC029_USEC_EXPORTED_CONSTANTS USEC Exported Constants
+  @{
+*/
+#ifndef USEC_TIMER
+#define USEC_TIMER              TIMER3      /*!< Free running timer of the timebase */
+#define USEC_TIMER_IRQn         TMR3_IRQn   /*!< IRQ number of \ref USEC_TIMER */
+#endif
+
+#ifndef USEC_SPIN_US
+#define USEC_SPIN_US            100         /*!< Delays up to this are counted in CPU cycles, longer ones on the timebase */
+#endif
+
+/*@}*/ /* end of group NUC029_USEC_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_USEC_EXPORTED_FUNCTIONS USEC Exported Functions
+  @{
+*/
+
+void USEC_Open(void);
+void USEC_Close(void);
+void USEC_Calibrate(void);
+uint64_t USEC_Get(void);
+uint32_t USEC_Get32(void);
+void USEC_Delay(uint32_t u32Us);
+void USEC_DelayCycles(uint32_t u32Cycles);
+void USEC_IRQHandler(void);
+
+/*@}*/ /* end of group NUC029_USEC_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_USEC_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__USEC_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ * @file     wdts.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series watchdog supervisor header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __WDTS_H__
+#define __WDTS_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_WDTS_Driver WDTS Driver
+  @{
+*/
+
+/** @addtogroup NUC029_WDTS_EXPORTED_CONSTANTS WDTS Exported Constants
+  @{
+*/
+#ifndef WDTS_MAX_CLIENTS
+#define WDTS_MAX_CLIENTS        8           /*!< Number of client slots, 1 ~ 254. Each slot takes 5 bytes of SRAM */
+#endif
+
+#ifndef WDTS_LOG_SIZE
+#define WDTS_LOG_SIZE           4           /*!< Entries kept in the no-init log */
+#endif
+
+#ifndef WDTS_WDT_TIMEOUT
+#define WDTS_WDT_TIMEOUT        WDT_TIMEOUT_2POW14  /*!< WDT time-out, about 1.6 s from LIRC */
+#endif
+
+#ifndef WDTS_WWDT_PRESCALER
+#define WDTS_WWDT_PRESCALER     WWDT_PRESCALER_64   /*!< WWDT counter period, 64 * 64 WWDT clocks */
+#endif
+
+#ifndef WDTS_WWDT_WINDOW
+#define WDTS_WWDT_WINDOW        32          /*!< WWDT compare value. The reload is done when the counter reaches it. */
+#endif
+
+#ifndef WDTS_ON_MISS
+#define WDTS_ON_MISS(u32Client)             /*!< Called by \ref WDTS_Service after a miss is logged, e.g. to reset at once */
+#endif
+
+#define WDTS_HW_WDT             0           /*!< Feed WDT */
+#define WDTS_HW_WWDT            1           /*!< Feed WWDT inside its window */
+
+#define WDTS_REASON_MISS        1           /*!< A client missed its deadline */
+#define WDTS_REASON_STALL       2           /*!< Watchdog reset without a logged miss, the service itself was not run */
+
+#define WDTS_CLIENT_NONE        0xFF        /*!< Client of a \ref WDTS_REASON_STALL entry */
+
+/*@}*/ /* end of group NUC029_WDTS_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_WDTS_EXPORTED_STRUCTS WDTS Exported Structs
+  @{
+*/
+/**
+  * @details    Log entry
+  */
+typedef struct
+{
+    uint8_t u8Client;               /*!< Client ID, or \ref WDTS_CLIENT_NONE */
+    uint8_t u8Reason;               /*!< \ref WDTS_REASON_MISS or \ref WDTS_REASON_STALL */
+    uint16_t u16Boot;               /*!< Boot count when it was logged */
+    uint32_t u32Tick;               /*!< Service periods since \ref WDTS_Open, 0 for a stall */
+} WDTS_ENTRY_T;
+
+/**
+  * @details    Log kept in no-init RAM over resets. It is cleared after power-on or when its check fails.
+  */
+typedef struct
+{
+    uint32_t u32Magic;              /*!< Marks a valid log */
+    uint32_t u32Boots;              /*!< Calls of \ref WDTS_Open since the log was cleared */
+    uint32_t u32Resets;             /*!< Watchdog resets */
+    uint32_t u32Count;              /*!< Entries written, the latest is asEntry[(u32Count - 1) % \ref WDTS_LOG_SIZE] */
+    uint32_t u32Pending;            /*!< A miss was logged and the watchdog reset is expected */
+    WDTS_ENTRY_T asEntry[WDTS_LOG_SIZE];    /*!< Latest entries */
+    uint32_t u32Check;              /*!< Check word of the fields above */
+} WDTS_LOG_T;
+
+/*@}*/ /* end of group NUC029_WDTS_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_WDTS_EXPORTED_FUNCTIONS WDTS Exported Functions
+  @{
+*/
+
+void WDTS_Open(uint32_t u32Hw, uint32_t u32PeriodMs);
+int32_t WDTS_Register(uint32_t u32DeadlineMs);
+void WDTS_Unregister(uint32_t u32Client);
+void WDTS_CheckIn(uint32_t u32Client);
+void WDTS_Service(void);
+void WDTS_IRQHandler(void);
+const WDTS_LOG_T *WDTS_GetLog(void);
+void WDTS_ClearLog(void);
+
+/*@}*/ /* end of group NUC029_WDTS_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_WDTS_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__WDTS_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
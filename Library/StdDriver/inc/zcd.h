@@ -0,0 +1,122 @@
+/**************************************************************************//**
+ * @file     zcd.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series zero-crossing detector header file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __ZCD_H__
+#define __ZCD_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_ZCD_Driver ZCD Driver
+  @{
+*/
+
+/** @addtogroup NUC029_ZCD_EXPORTED_CONSTANTS ZCD Exported Constants
+  @{
+*/
+#ifndef ZCD_ACMP
+#define ZCD_ACMP                ACMP01      /*!< Comparator module of the mains input */
+#define ZCD_ACMP_CH             0           /*!< Comparator of \ref ZCD_ACMP, 0 or 1 */
+#define ZCD_ACMP_IRQn           ACMP01_IRQn /*!< IRQ number of \ref ZCD_ACMP */
+#endif
+
+#ifndef ZCD_TIMER
+#define ZCD_TIMER               TIMER0      /*!< Free running timer of the time stamps */
+#define ZCD_TIMER_IRQn          TMR0_IRQn   /*!< IRQ number of \ref ZCD_TIMER */
+#endif
+
+#ifndef ZCD_MIN_HZ
+#define ZCD_MIN_HZ              40          /*!< Lowest mains frequency tracked */
+#endif
+
+#ifndef ZCD_MAX_HZ
+#define ZCD_MAX_HZ              70          /*!< Highest mains frequency tracked */
+#endif
+
+#ifndef ZCD_BLANK_PERCENT
+#define ZCD_BLANK_PERCENT       25          /*!< Edges this part of a half cycle after a crossing are bounces */
+#endif
+
+#ifndef ZCD_ALPHA_SHIFT
+#define ZCD_ALPHA_SHIFT         2           /*!< Phase follows 1 / 2^n of the error of each cycle */
+#endif
+
+#ifndef ZCD_BETA_SHIFT
+#define ZCD_BETA_SHIFT          5           /*!< Period follows 1 / 2^n of the error of each cycle */
+#endif
+
+#ifndef ZCD_LOCK_CYCLES
+#define ZCD_LOCK_CYCLES         4           /*!< Cycles within 1/256 period of the estimate before it is locked */
+#endif
+
+#define ZCD_MODE_ISR            0           /*!< Comparator interrupt reads the timer */
+#define ZCD_MODE_CAPTURE_ACMP   1           /*!< Timer captures the internal comparator output */
+#define ZCD_MODE_CAPTURE_PIN    2           /*!< Timer captures its TxEX pin, wired to the CPOn pin */
+
+#define ZCD_ANGLE_HALF          0x8000      /*!< Half a cycle in the angle unit of \ref ZCD_NextTime */
+
+/*@}*/ /* end of group NUC029_ZCD_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NUC029_ZCD_EXPORTED_STRUCTS ZCD Exported Structs
+  @{
+*/
+/**
+  * @details    Smoothed estimate. Times are counts of \ref ZCD_TIMER extended to 32 bits, see \ref ZCD_GetTime.
+  */
+typedef struct
+{
+    uint32_t u32Locked;             /*!< 1 while the estimate follows the input */
+    uint32_t u32MilliHz;            /*!< Mains frequency in mHz */
+    uint32_t u32PeriodNs;           /*!< Period in ns */
+    uint32_t u32Zero;               /*!< Time of the latest rising zero crossing */
+    uint32_t u32ErrorNs;            /*!< Average deviation of the measured cycles from the estimate in ns */
+    uint32_t u32Duty;               /*!< Comparator high time in 0.01 %, off 50 % by the offset of V- */
+    uint32_t u32Edges;              /*!< Crossings accepted */
+    uint32_t u32Rejected;           /*!< Edges dropped as bounces */
+    uint32_t u32Resyncs;            /*!< Estimate started again after lost cycles */
+} ZCD_RESULT_T;
+
+/*@}*/ /* end of group NUC029_ZCD_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NUC029_ZCD_EXPORTED_FUNCTIONS ZCD Exported Functions
+  @{
+*/
+
+void ZCD_Open(uint32_t u32Mode);
+void ZCD_Close(void);
+void ZCD_AcmpHandler(void);
+void ZCD_TimerHandler(void);
+uint32_t ZCD_GetTime(void);
+int32_t ZCD_Read(ZCD_RESULT_T *psResult);
+int32_t ZCD_NextTime(uint32_t u32Angle, uint32_t *pu32Time);
+
+/*@}*/ /* end of group NUC029_ZCD_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_ZCD_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__ZCD_H__
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
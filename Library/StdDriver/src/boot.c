@@ -0,0 +1,180 @@
+/**************************************************************************//**
+ * @file     boot.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series boot time profiler source file
+ *
+ * @note     With BOOT_PROFILE defined, \ref BOOT_Start runs first in SystemInit, or first in Reset_Handler with
+ *           GCC, where .data is copied before SystemInit. \ref BOOT_TIMER then counts HIRC cycles, 45 ns each,
+ *           and every \ref BOOT_Mark stores the end of a phase in a no-init table, which works before the C
+ *           runtime has initialized RAM. SystemInit marks its own end, the application marks the C runtime at
+ *           the start of main and the steps of its clock and peripheral setup, then prints \ref BOOT_Report.
+ *           The counter wraps after 758 ms, longer boots are not measured correctly.
+ *           KEIL needs a scatter file with an UNINIT region for the table, see \ref NOINIT.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_BOOT_Driver BOOT Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define BOOT_MAGIC          0x424F4F54UL
+#define BOOT_COUNTER_MAX    0xFFFFFF
+
+typedef struct
+{
+    uint32_t u32Magic;
+    uint32_t u32Num;
+    BOOT_MARK_T asMark[BOOT_MAX_MARKS];
+} BOOT_TABLE_T;
+
+/* Written before the C runtime initializes RAM */
+static NOINIT BOOT_TABLE_T s_sBoot;
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_BOOT_EXPORTED_FUNCTIONS BOOT Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start the boot timer
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Runs \ref BOOT_TIMER from HIRC, which is enabled after reset, and clears the table. Uses no
+  *             initialized variable, so it can be called before the C runtime.
+  */
+void BOOT_Start(void)
+{
+    CLK_EnableModuleClock(BOOT_TIMER_MODULE);
+    CLK_SetModuleClock(BOOT_TIMER_MODULE, BOOT_TIMER_CLK_HIRC, 0);
+
+    BOOT_TIMER->TCSR = 0;
+    BOOT_TIMER->TCMPR = BOOT_COUNTER_MAX;
+    BOOT_TIMER->TCSR = TIMER_TCSR_CEN_Msk | TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk;
+
+    s_sBoot.u32Magic = BOOT_MAGIC;
+    s_sBoot.u32Num = 0;
+}
+
+/**
+  * @brief      Mark the end of a boot phase
+  *
+  * @param[in]  pcName  Name of the phase, a string constant
+  *
+  * @return     None
+  *
+  * @details    The time is read first. Marks after the table is full are dropped.
+  */
+void BOOT_Mark(const char *pcName)
+{
+    uint32_t u32Tick = BOOT_TIMER->TDR & BOOT_COUNTER_MAX;
+
+    if(s_sBoot.u32Num < BOOT_MAX_MARKS)
+    {
+        s_sBoot.asMark[s_sBoot.u32Num].pcName = pcName;
+        s_sBoot.asMark[s_sBoot.u32Num].u32Tick = u32Tick;
+        s_sBoot.u32Num++;
+    }
+}
+
+/**
+  * @brief      Stop the boot timer
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Stops \ref BOOT_TIMER and its clock, the application may use it afterwards. The marks are kept.
+  */
+void BOOT_Stop(void)
+{
+    BOOT_TIMER->TCSR = 0;
+    CLK_DisableModuleClock(BOOT_TIMER_MODULE);
+}
+
+/**
+  * @brief      Get the marks
+  *
+  * @param[out] ppsMarks    Set to the first mark
+  *
+  * @return     Number of marks, 0 if \ref BOOT_Start was not called
+  */
+uint32_t BOOT_GetMarks(const BOOT_MARK_T **ppsMarks)
+{
+    *ppsMarks = s_sBoot.asMark;
+
+    if((s_sBoot.u32Magic != BOOT_MAGIC) || (s_sBoot.u32Num > BOOT_MAX_MARKS))
+        return 0;
+
+    return s_sBoot.u32Num;
+}
+
+/**
+  * @brief      Convert boot timer ticks
+  *
+  * @param[in]  u32Ticks    HIRC cycles, up to 24 bits
+  *
+  * @return     Nanoseconds
+  */
+uint32_t BOOT_TicksToNs(uint32_t u32Ticks)
+{
+    /* 1e9 / 22118400 = 78125 / 1728 */
+    return (uint32_t)(((uint64_t)u32Ticks * 78125 + 864) / 1728);
+}
+
+/**
+  * @brief      Print the boot time breakdown
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Prints each phase with its length and end time in us since \ref BOOT_Start.
+  */
+void BOOT_Report(void)
+{
+    const BOOT_MARK_T *psMark;
+    uint32_t u32Num, u32Prev = 0, u32Ns, u32AtNs, i;
+
+    u32Num = BOOT_GetMarks(&psMark);
+    if(u32Num == 0)
+    {
+        printf("No boot profile, define BOOT_PROFILE\n");
+        return;
+    }
+
+    printf("  Phase                  Time us        At us\n");
+    for(i = 0; i < u32Num; i++)
+    {
+        u32Ns = BOOT_TicksToNs((psMark[i].u32Tick - u32Prev) & BOOT_COUNTER_MAX);
+        u32AtNs = BOOT_TicksToNs(psMark[i].u32Tick);
+        printf("  %-18s %8lu.%02lu  %8lu.%02lu\n", psMark[i].pcName, (unsigned long)(u32Ns / 1000),
+               (unsigned long)((u32Ns % 1000) / 10), (unsigned long)(u32AtNs / 1000),
+               (unsigned long)((u32AtNs % 1000) / 10));
+        u32Prev = psMark[i].u32Tick;
+    }
+}
+
+/*@}*/ /* end of group NUC029_BOOT_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_BOOT_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
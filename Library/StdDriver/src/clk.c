@@ -55,6 +55,8 @@ void CLK_DisableCKO(void)
   */
 void CLK_EnableCKO(uint32_t u32ClkSrc, uint32_t u32ClkDiv, uint32_t u32ClkDivBy1En)
 {
+    (void)u32ClkDivBy1En;
+
     /* CKO = clock source / 2^(u32ClkDiv + 1) */
     CLK->FRQDIV = CLK_FRQDIV_DIVIDER_EN_Msk | u32ClkDiv;
 
@@ -315,26 +317,27 @@ void CLK_SetHCLK(uint32_t u32ClkSrc, uint32_t u32ClkDiv)
   */
 void CLK_SetModuleClock(uint32_t u32ModuleIdx, uint32_t u32ClkSrc, uint32_t u32ClkDiv)
 {
-    uint32_t u32tmp = 0, u32sel = 0, u32div = 0;
+    uint32_t u32tmp = 0;
+    volatile uint32_t *pu32sel, *pu32div;
 
     if(MODULE_CLKSEL_Msk(u32ModuleIdx) != MODULE_NoMsk)
     {
         /* Get clock select control register address */
-        u32sel = (uint32_t)&CLK->CLKSEL0 + ((MODULE_CLKSEL(u32ModuleIdx)) * 4);
-        u32tmp = *(volatile uint32_t *)(u32sel);
+        pu32sel = &CLK->CLKSEL0 + MODULE_CLKSEL(u32ModuleIdx);
+        u32tmp = *pu32sel;
         /* Set new clock selection setting */
         u32tmp = (u32tmp & (~(MODULE_CLKSEL_Msk(u32ModuleIdx) << MODULE_CLKSEL_Pos(u32ModuleIdx)))) | u32ClkSrc;
-        *(volatile uint32_t *)(u32sel) = u32tmp;
+        *pu32sel = u32tmp;
     }
 
     if(MODULE_CLKDIV_Msk(u32ModuleIdx) != MODULE_NoMsk)
     {
         /* Get clock divider control register address */
-        u32div = (uint32_t)&CLK->CLKDIV + ((MODULE_CLKDIV(u32ModuleIdx)) * 4);
-        u32tmp = *(volatile uint32_t *)(u32div);
+        pu32div = &CLK->CLKDIV + MODULE_CLKDIV(u32ModuleIdx);
+        u32tmp = *pu32div;
         /* Apply new divider */
         u32tmp = (u32tmp & (~(MODULE_CLKDIV_Msk(u32ModuleIdx) << MODULE_CLKDIV_Pos(u32ModuleIdx)))) | u32ClkDiv;
-        *(volatile uint32_t *)(u32div) = u32tmp;
+        *pu32div = u32tmp;
     }
 }
 
@@ -416,7 +419,7 @@ void CLK_DisableXtalRC(uint32_t u32ClkMask)
   */
 void CLK_EnableModuleClock(uint32_t u32ModuleIdx)
 {
-    *(volatile uint32_t *)((uint32_t)&CLK->AHBCLK + (MODULE_APBCLK(u32ModuleIdx) * 4))  |= 1 << MODULE_IP_EN_Pos(u32ModuleIdx);
+    *(&CLK->AHBCLK + MODULE_APBCLK(u32ModuleIdx)) |= 1 << MODULE_IP_EN_Pos(u32ModuleIdx);
 }
 
 /**
@@ -451,7 +454,7 @@ void CLK_EnableModuleClock(uint32_t u32ModuleIdx)
   */
 void CLK_DisableModuleClock(uint32_t u32ModuleIdx)
 {
-    *(volatile uint32_t *)((uint32_t)&CLK->AHBCLK + (MODULE_APBCLK(u32ModuleIdx) * 4))  &= ~(1 << MODULE_IP_EN_Pos(u32ModuleIdx));
+    *(&CLK->AHBCLK + MODULE_APBCLK(u32ModuleIdx)) &= ~(1 << MODULE_IP_EN_Pos(u32ModuleIdx));
 }
 
 
@@ -468,7 +471,7 @@ void CLK_DisableModuleClock(uint32_t u32ModuleIdx)
 uint32_t CLK_EnablePLL(uint32_t u32PllClkSrc, uint32_t u32PllFreq)
 {
     uint32_t u32PllSrcClk, u32NR, u32NF, u32NO, u32CLK_SRC;
-    uint32_t u32Tmp, u32Tmp2, u32Tmp3, u32Min, u32MinNF, u32MinNR;
+    uint32_t u32Tmp, u32Tmp2, u32Tmp3, u32Min, u32MinNF, u32MinNR, u32End;
 
     /* Disable PLL first to avoid unstable when setting PLL. */
     CLK->PLLCON = CLK_PLLCON_PD_Msk;
@@ -537,7 +540,9 @@ uint32_t CLK_EnablePLL(uint32_t u32PllClkSrc, uint32_t u32PllFreq)
         u32Tmp = u32PllSrcClk / u32NR;
         if((u32Tmp > 1600000) && (u32Tmp < 15000000))
         {
-            for(u32NF = 2; u32NF <= 513; u32NF++)
+            /* Only the NF below and above the request can be closest. NF stays within 7 ~ 125 here. */
+            u32NF = u32PllFreq / u32Tmp;
+            for(u32End = u32NF + 2; u32NF < u32End; u32NF++)
             {
                 u32Tmp2 = u32Tmp * u32NF;
                 if((u32Tmp2 >= 100000000) && (u32Tmp2 <= 200000000))
@@ -548,13 +553,13 @@ uint32_t CLK_EnablePLL(uint32_t u32PllClkSrc, uint32_t u32PllFreq)
                         u32Min = u32Tmp3;
                         u32MinNR = u32NR;
                         u32MinNF = u32NF;
-
-                        /* Break when get good results */
-                        if(u32Min == 0)
-                            break;
                     }
                 }
             }
+
+            /* Break when get good results */
+            if(u32Min == 0)
+                break;
         }
     }
 
@@ -670,6 +675,149 @@ void CLK_DisableSysTick(void)
     SysTick->CTRL = 0;
 }
 
+/** @cond HIDDEN_SYMBOLS */
+
+/* Oscillator enable bits restored from a snapshot */
+#define CLK_PWRCON_OSC_Msk  (CLK_PWRCON_XTL12M_EN_Msk | CLK_PWRCON_IRC22M_EN_Msk | CLK_PWRCON_IRC10K_EN_Msk)
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief      Save clock configuration
+  * @param[out] psSnap is the snapshot buffer
+  * @return     None
+  * @details    This function saves the clock registers together with SystemCoreClock, CyclesPerUs and PllClock,
+  *             so \ref CLK_RestoreSnapshot can set up the same clocks without searching PLL settings or
+  *             recomputing frequencies. Take the snapshot after clock initialization.
+  */
+void CLK_SaveSnapshot(CLK_SNAPSHOT_T *psSnap)
+{
+    psSnap->u32PwrCon = CLK->PWRCON;
+    psSnap->u32ClkSel0 = CLK->CLKSEL0;
+    psSnap->u32ClkSel1 = CLK->CLKSEL1;
+    psSnap->u32ClkSel2 = CLK->CLKSEL2;
+    psSnap->u32ClkDiv = CLK->CLKDIV;
+    psSnap->u32PllCon = CLK->PLLCON;
+    psSnap->u32AhbClk = CLK->AHBCLK;
+    psSnap->u32ApbClk = CLK->APBCLK;
+
+    psSnap->u32Stable = 0;
+    if(psSnap->u32PwrCon & CLK_PWRCON_XTL12M_EN_Msk)
+        psSnap->u32Stable |= CLK_CLKSTATUS_XTL12M_STB_Msk;
+    if(psSnap->u32PwrCon & CLK_PWRCON_IRC10K_EN_Msk)
+        psSnap->u32Stable |= CLK_CLKSTATUS_IRC10K_STB_Msk;
+    if(!(psSnap->u32PllCon & CLK_PLLCON_PD_Msk))
+        psSnap->u32Stable |= CLK_CLKSTATUS_PLL_STB_Msk;
+
+    psSnap->u32SystemCoreClock = SystemCoreClock;
+    psSnap->u32CyclesPerUs = CyclesPerUs;
+    psSnap->u32PllClock = PllClock;
+    psSnap->u32WakeLatency = 0;
+}
+
+/**
+  * @brief      Restore clock configuration
+  * @param[in]  psSnap is the snapshot taken by \ref CLK_SaveSnapshot
+  * @retval     0  Success
+  * @retval     -1 A clock source did not become stable, HCLK stays on HIRC
+  * @details    This function restores the clocks in the order that keeps the CPU clocked at all times.
+  *             HCLK runs from HIRC while the oscillators start and the PLL locks. PLLCON is only written if it
+  *             changed, so a PLL that is still locked is not disturbed. Then dividers, peripheral clock sources
+  *             and enables are restored and HCLK is switched back last. SystemCoreClock, CyclesPerUs and
+  *             PllClock are set from the cached values.
+  *             The register write-protection function should be disabled before using this function.
+  */
+int32_t CLK_RestoreSnapshot(const CLK_SNAPSHOT_T *psSnap)
+{
+    int32_t i32TimeOutCnt;
+
+    /* HIRC is ready within a few us, run from it while the other clocks start */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+    i32TimeOutCnt = __HIRC >> 8;
+    while(!(CLK->CLKSTATUS & CLK_CLKSTATUS_IRC22M_STB_Msk))
+    {
+        if(--i32TimeOutCnt <= 0)
+            break;
+    }
+    CLK->CLKSEL0 = (CLK->CLKSEL0 & ~CLK_CLKSEL0_HCLK_S_Msk) | CLK_CLKSEL0_HCLK_S_HIRC;
+
+    CLK->PWRCON = (CLK->PWRCON & ~CLK_PWRCON_OSC_Msk) | (psSnap->u32PwrCon & CLK_PWRCON_OSC_Msk) | CLK_PWRCON_IRC22M_EN_Msk;
+    if(CLK->PLLCON != psSnap->u32PllCon)
+        CLK->PLLCON = psSnap->u32PllCon;
+
+    /* Time-out counted on HIRC, at least 250 ms */
+    i32TimeOutCnt = __HIRC >> 2;
+    while((CLK->CLKSTATUS & psSnap->u32Stable) != psSnap->u32Stable)
+    {
+        if(--i32TimeOutCnt <= 0)
+        {
+            SystemCoreClockUpdate();
+            return -1;
+        }
+    }
+
+    CLK->CLKDIV = psSnap->u32ClkDiv;
+    CLK->CLKSEL1 = psSnap->u32ClkSel1;
+    CLK->CLKSEL2 = psSnap->u32ClkSel2;
+    CLK->AHBCLK = psSnap->u32AhbClk;
+    CLK->APBCLK = psSnap->u32ApbClk;
+    CLK->CLKSEL0 = psSnap->u32ClkSel0;
+
+    if(!(psSnap->u32PwrCon & CLK_PWRCON_IRC22M_EN_Msk))
+        CLK->PWRCON &= ~CLK_PWRCON_IRC22M_EN_Msk;
+
+    SystemCoreClock = psSnap->u32SystemCoreClock;
+    CyclesPerUs = psSnap->u32CyclesPerUs;
+    PllClock = psSnap->u32PllClock;
+
+    return 0;
+}
+
+/**
+  * @brief      Enter Power-down mode and restore clocks after wake-up
+  * @param[in,out] psSnap is the snapshot taken by \ref CLK_SaveSnapshot, u32WakeLatency is updated
+  * @retval     0  Success
+  * @retval     -1 A clock source did not become stable, HCLK stays on HIRC
+  * @details    HCLK is switched to HIRC before Power-down, so the CPU runs as soon as the chip wakes up and
+  *             \ref CLK_RestoreSnapshot is called. The time from the first instruction after wake-up until the
+  *             clocks are restored is measured with SysTick on HIRC/2 and stored in psSnap->u32WakeLatency.
+  *             SysTick control and reload are restored afterwards, its current value is cleared.
+  *             Call with interrupts masked if wake-up interrupts must not run before the clocks are restored.
+  *             The register write-protection function should be disabled before using this function.
+  */
+int32_t CLK_PowerDownRestore(CLK_SNAPSHOT_T *psSnap)
+{
+    uint32_t u32Ctrl = SysTick->CTRL, u32Load = SysTick->LOAD, u32Cnt;
+    int32_t i32Ret;
+
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+    CLK->CLKSEL0 = (CLK->CLKSEL0 & ~(CLK_CLKSEL0_HCLK_S_Msk | CLK_CLKSEL0_STCLK_S_Msk)) |
+                   CLK_CLKSEL0_HCLK_S_HIRC | CLK_CLKSEL0_STCLK_S_HIRC_DIV2;
+
+    SysTick->CTRL = 0;
+    SysTick->LOAD = 0xFFFFFF;
+
+    CLK_PowerDown();
+
+    /* SysTick on external reference, HIRC/2 */
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_ENABLE_Msk;
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    i32Ret = CLK_RestoreSnapshot(psSnap);
+
+    u32Cnt = 0xFFFFFF - SysTick->VAL;
+    psSnap->u32WakeLatency = u32Cnt * 100 / (__HIRC / 2 / 10000);
+
+    SysTick->CTRL = 0;
+    SysTick->LOAD = u32Load;
+    SysTick->VAL = 0;
+    SysTick->CTRL = u32Ctrl;
+
+    return i32Ret;
+}
+
 /*@}*/ /* end of group NUC029_CLK_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group NUC029_CLK_Driver */
@@ -0,0 +1,365 @@
+/**************************************************************************//**
+ * @file     clkm.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series module clock manager source file
+ *
+ * @note     Drivers and tasks acquire a module clock around their active use and release it afterwards. The
+ *           first reference enables the clock gate in AHBCLK or APBCLK, the last release disables it again,
+ *           whatever enabled it before. References count per gate bit, so WDT_MODULE and WWDT_MODULE share one
+ *           count. A slot per gate keeps the time the clock was enabled, measured with \ref CLKM_GET_US, and
+ *           the typical current of the module, from which the energy is estimated. The default currents are
+ *           rough estimates at HCLK 50 MHz, set measured values with \ref CLKM_SetCurrent.
+ *           All functions may be called from interrupts.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_CLKM_Driver CLKM Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define CLKM_GATE_NONE      0xFF
+
+typedef struct
+{
+    uint8_t u8Gate;
+    uint8_t u8Ref;
+    uint16_t u16MicroAmp;
+    uint32_t u32Start;
+    uint32_t u32Enables;
+    uint64_t u64ActiveUs;
+} CLKM_SLOT_T;
+
+typedef struct
+{
+    uint8_t u8Gate;
+    const char *pcName;
+    uint16_t u16MicroAmp;
+} CLKM_INFO_T;
+
+static const CLKM_INFO_T s_asClkmInfo[] =
+{
+    {CLKM_GATE(ISP_MODULE),     "ISP",      500},
+    {CLKM_GATE(EBI_MODULE),     "EBI",      400},
+    {CLKM_GATE(HDIV_MODULE),    "HDIV",     100},
+    {CLKM_GATE(WDT_MODULE),     "WDT/WWDT", 20},
+    {CLKM_GATE(TMR0_MODULE),    "TMR0",     100},
+    {CLKM_GATE(TMR1_MODULE),    "TMR1",     100},
+    {CLKM_GATE(TMR2_MODULE),    "TMR2",     100},
+    {CLKM_GATE(TMR3_MODULE),    "TMR3",     100},
+    {CLKM_GATE(FDIV_MODULE),    "FDIV",     50},
+    {CLKM_GATE(I2C0_MODULE),    "I2C0",     150},
+    {CLKM_GATE(I2C1_MODULE),    "I2C1",     150},
+    {CLKM_GATE(SPI0_MODULE),    "SPI0",     300},
+    {CLKM_GATE(SPI1_MODULE),    "SPI1",     300},
+    {CLKM_GATE(UART0_MODULE),   "UART0",    350},
+    {CLKM_GATE(UART1_MODULE),   "UART1",    350},
+    {CLKM_GATE(PWM01_MODULE),   "PWM01",    300},
+    {CLKM_GATE(PWM23_MODULE),   "PWM23",    300},
+    {CLKM_GATE(PWM45_MODULE),   "PWM45",    300},
+    {CLKM_GATE(PWM67_MODULE),   "PWM67",    300},
+    {CLKM_GATE(ADC_MODULE),     "ADC",      1500},
+    {CLKM_GATE(ACMP01_MODULE),  "ACMP01",   150},
+    {CLKM_GATE(ACMP23_MODULE),  "ACMP23",   150},
+};
+
+static CLKM_SLOT_T s_asClkmSlot[CLKM_MAX_MODULES];
+static uint32_t s_u32ClkmSlots = 0;
+
+/* Slot of a gate, a new one if u32Add. Called with interrupts disabled. */
+static CLKM_SLOT_T *CLKM_FindSlot(uint32_t u32Gate, uint32_t u32Add)
+{
+    CLKM_SLOT_T *psSlot;
+    uint32_t i;
+
+    for(i = 0; i < s_u32ClkmSlots; i++)
+    {
+        if(s_asClkmSlot[i].u8Gate == u32Gate)
+            return &s_asClkmSlot[i];
+    }
+
+    if(!u32Add || (s_u32ClkmSlots >= CLKM_MAX_MODULES))
+        return NULL;
+
+    psSlot = &s_asClkmSlot[s_u32ClkmSlots++];
+    psSlot->u8Gate = (uint8_t)u32Gate;
+    psSlot->u8Ref = 0;
+    psSlot->u16MicroAmp = 0;
+    psSlot->u32Enables = 0;
+    psSlot->u64ActiveUs = 0;
+    for(i = 0; i < sizeof(s_asClkmInfo) / sizeof(s_asClkmInfo[0]); i++)
+    {
+        if(s_asClkmInfo[i].u8Gate == u32Gate)
+            psSlot->u16MicroAmp = s_asClkmInfo[i].u16MicroAmp;
+    }
+
+    return psSlot;
+}
+
+/* Gate bit write, WDT_EN is write protected */
+static void CLKM_SetGate(uint32_t u32ModuleIdx, uint32_t u32On)
+{
+    uint32_t u32Locked = 0;
+
+    if(CLKM_GATE(u32ModuleIdx) == CLKM_GATE(WDT_MODULE))
+    {
+        u32Locked = SYS_IsRegLocked();
+        if(u32Locked)
+            SYS_UnlockReg();
+    }
+
+    if(u32On)
+        CLK_EnableModuleClock(u32ModuleIdx);
+    else
+        CLK_DisableModuleClock(u32ModuleIdx);
+
+    if(u32Locked)
+        SYS_LockReg();
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_CLKM_EXPORTED_FUNCTIONS CLKM Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Acquire a module clock
+  *
+  * @param[in]  u32ModuleIdx    Module index, e.g. \ref UART0_MODULE
+  *
+  * @retval     >0      References after this one
+  * @retval     -1      No free slot, or 255 references
+  *
+  * @details    The first reference enables the clock. The clock source and divider are not changed, set them
+  *             once with CLK_SetModuleClock().
+  */
+int32_t CLKM_Acquire(uint32_t u32ModuleIdx)
+{
+    CLKM_SLOT_T *psSlot;
+    uint32_t u32PriMask;
+    int32_t i32Ref = -1;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    psSlot = CLKM_FindSlot(CLKM_GATE(u32ModuleIdx), 1);
+    if((psSlot != NULL) && (psSlot->u8Ref < 0xFF))
+    {
+        if(psSlot->u8Ref == 0)
+        {
+            CLKM_SetGate(u32ModuleIdx, 1);
+            psSlot->u32Start = CLKM_GET_US();
+            psSlot->u32Enables++;
+        }
+        i32Ref = ++psSlot->u8Ref;
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    return i32Ref;
+}
+
+/**
+  * @brief      Release a module clock
+  *
+  * @param[in]  u32ModuleIdx    Module index, e.g. \ref UART0_MODULE
+  *
+  * @retval     >=0     References left
+  * @retval     -1      Not acquired
+  *
+  * @details    The last release disables the clock and adds the time it was enabled.
+  */
+int32_t CLKM_Release(uint32_t u32ModuleIdx)
+{
+    CLKM_SLOT_T *psSlot;
+    uint32_t u32PriMask;
+    int32_t i32Ref = -1;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    psSlot = CLKM_FindSlot(CLKM_GATE(u32ModuleIdx), 0);
+    if((psSlot != NULL) && (psSlot->u8Ref > 0))
+    {
+        i32Ref = --psSlot->u8Ref;
+        if(i32Ref == 0)
+        {
+            CLKM_SetGate(u32ModuleIdx, 0);
+            psSlot->u64ActiveUs += (uint32_t)(CLKM_GET_US() - psSlot->u32Start);
+        }
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    return i32Ref;
+}
+
+/**
+  * @brief      Reset a module held by one reference
+  *
+  * @param[in]  u32ModuleIdx    Module index, e.g. \ref UART0_MODULE
+  * @param[in]  u32RstIdx       Reset index for SYS_ResetModule(), e.g. \ref UART0_RST
+  *
+  * @retval     0       Module reset
+  * @retval     -1      Not acquired, or used by other references too
+  *
+  * @details    Resets only a module the caller holds alone, so no other user loses its setting. PWM03_RST and
+  *             PWM47_RST reset two gates each, check the other gate before.
+  */
+int32_t CLKM_Reset(uint32_t u32ModuleIdx, uint32_t u32RstIdx)
+{
+    if(CLKM_GetRef(u32ModuleIdx) != 1)
+        return -1;
+
+    SYS_ResetModule(u32RstIdx);
+
+    return 0;
+}
+
+/**
+  * @brief      Get the references of a module clock
+  *
+  * @param[in]  u32ModuleIdx    Module index, e.g. \ref UART0_MODULE
+  *
+  * @return     References, 0 if the clock is not held
+  */
+uint32_t CLKM_GetRef(uint32_t u32ModuleIdx)
+{
+    CLKM_SLOT_T *psSlot;
+    uint32_t u32PriMask, u32Ref = 0;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    psSlot = CLKM_FindSlot(CLKM_GATE(u32ModuleIdx), 0);
+    if(psSlot != NULL)
+        u32Ref = psSlot->u8Ref;
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Ref;
+}
+
+/**
+  * @brief      Set the typical current of a module
+  *
+  * @param[in]  u32ModuleIdx    Module index, e.g. \ref UART0_MODULE
+  * @param[in]  u32MicroAmp     Current while the clock is enabled, in uA, up to 65535
+  *
+  * @retval     0       Done
+  * @retval     -1      No free slot
+  *
+  * @details    Replaces the default estimate, for example with a value measured on the board.
+  */
+int32_t CLKM_SetCurrent(uint32_t u32ModuleIdx, uint32_t u32MicroAmp)
+{
+    CLKM_SLOT_T *psSlot;
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    psSlot = CLKM_FindSlot(CLKM_GATE(u32ModuleIdx), 1);
+    if(psSlot != NULL)
+        psSlot->u16MicroAmp = (u32MicroAmp > 0xFFFF) ? 0xFFFF : (uint16_t)u32MicroAmp;
+
+    __set_PRIMASK(u32PriMask);
+
+    return (psSlot != NULL) ? 0 : -1;
+}
+
+/**
+  * @brief      Get the use of a module clock
+  *
+  * @param[in]  u32ModuleIdx    Module index, e.g. \ref UART0_MODULE
+  * @param[out] psStats         Use and energy, the active time includes a clock enabled now
+  *
+  * @retval     0       Done
+  * @retval     -1      Module never acquired
+  */
+int32_t CLKM_GetStats(uint32_t u32ModuleIdx, CLKM_STATS_T *psStats)
+{
+    CLKM_SLOT_T *psSlot;
+    uint32_t u32PriMask;
+    uint64_t u64NanoC;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    psSlot = CLKM_FindSlot(CLKM_GATE(u32ModuleIdx), 0);
+    if(psSlot != NULL)
+    {
+        psStats->u32Ref = psSlot->u8Ref;
+        psStats->u32Enables = psSlot->u32Enables;
+        psStats->u64ActiveUs = psSlot->u64ActiveUs;
+        if(psSlot->u8Ref)
+            psStats->u64ActiveUs += (uint32_t)(CLKM_GET_US() - psSlot->u32Start);
+        psStats->u32MicroAmp = psSlot->u16MicroAmp;
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    if(psSlot == NULL)
+        return -1;
+
+    /* uA * us = pC */
+    u64NanoC = psStats->u64ActiveUs * psStats->u32MicroAmp / 1000;
+    psStats->u32EnergyUJ = (uint32_t)(u64NanoC * CLKM_VDD_MV / 1000000);
+
+    return 0;
+}
+
+/**
+  * @brief      Print the use of all managed clocks
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void CLKM_Report(void)
+{
+    CLKM_STATS_T sStats;
+    const char *pcName;
+    uint32_t u32Module, i, j;
+
+    printf("  Module    Refs  Enables  Active ms      uA      uJ\n");
+    for(i = 0; i < s_u32ClkmSlots; i++)
+    {
+        /* Module index with the gate bits only is enough to look it up */
+        u32Module = ((uint32_t)(s_asClkmSlot[i].u8Gate >> 5) << 30) | (s_asClkmSlot[i].u8Gate & 0x1F);
+        if(CLKM_GetStats(u32Module, &sStats) != 0)
+            continue;
+
+        pcName = "?";
+        for(j = 0; j < sizeof(s_asClkmInfo) / sizeof(s_asClkmInfo[0]); j++)
+        {
+            if(s_asClkmInfo[j].u8Gate == s_asClkmSlot[i].u8Gate)
+                pcName = s_asClkmInfo[j].pcName;
+        }
+
+        printf("  %-8s %5lu %8lu %10lu %7lu %7lu\n", pcName, (unsigned long)sStats.u32Ref,
+               (unsigned long)sStats.u32Enables, (unsigned long)(sStats.u64ActiveUs / 1000),
+               (unsigned long)sStats.u32MicroAmp, (unsigned long)sStats.u32EnergyUJ);
+    }
+}
+
+/*@}*/ /* end of group NUC029_CLKM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_CLKM_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,415 @@
+/**************************************************************************//**
+ * @file     dualimg.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/08 4:20p $
+ * @brief    NUC029 series dual image (A/B) firmware update source file
+ *
+ * @note     APROM holds a small boot manager at address 0 and two image slots. The running application
+ *           programs the other slot, then \ref DUALIMG_Commit marks it pending. After a chip reset the boot
+ *           manager selects the slot with VECMAP and a CPU reset, so no image is ever copied. A pending image
+ *           runs under WDT and must call \ref DUALIMG_Confirm, otherwise the boot manager rolls back to the
+ *           previous image after \ref DUALIMG_TRIAL_BOOTS attempts. VECMAP needs CBS = 00'b or 10'b in CONFIG0.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_DUALIMG_Driver DUALIMG Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+/*
+ * Boot record, one flash page. The record is written alternately to two pages with an increasing sequence
+ * number, so a power failure while updating leaves the previous record valid. Words after the record are
+ * trial marks: the boot manager programs one word to 0 on every trial boot, no erase needed.
+ */
+#define DUALIMG_REC_MAGIC       0
+#define DUALIMG_REC_SEQ         1
+#define DUALIMG_REC_ACTIVE      2
+#define DUALIMG_REC_PENDING     3
+#define DUALIMG_REC_LEN0        4       /* Slot n length and CRC at DUALIMG_REC_LEN0 + 2 * n and + 1 */
+#define DUALIMG_REC_CHECK       8
+#define DUALIMG_REC_WORDS       9
+#define DUALIMG_REC_MARKS       (FMC_FLASH_PAGE_SIZE / 4 - DUALIMG_REC_WORDS)
+
+#define DUALIMG_WORD(addr)      (*(volatile uint32_t *)(addr))
+
+/* Reflected CRC-32 (poly 0xEDB88320), four bits at a time */
+static const uint32_t s_au32DualImgCrc[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/* Address of page holding the newest valid record, 0 if none */
+static uint32_t DUALIMG_FindRecord(void)
+{
+    uint32_t u32Page, u32Best = 0, u32Check, i;
+
+    for(u32Page = DUALIMG_RECORD_ADDR; u32Page < DUALIMG_RECORD_ADDR + 2 * FMC_FLASH_PAGE_SIZE; u32Page += FMC_FLASH_PAGE_SIZE)
+    {
+        if(DUALIMG_WORD(u32Page) != DUALIMG_MAGIC)
+            continue;
+
+        u32Check = 0;
+        for(i = 0; i < DUALIMG_REC_CHECK; i++)
+            u32Check ^= DUALIMG_WORD(u32Page + i * 4);
+        if(DUALIMG_WORD(u32Page + DUALIMG_REC_CHECK * 4) != ~u32Check)
+            continue;
+
+        if((u32Best == 0) ||
+                ((int32_t)(DUALIMG_WORD(u32Page + DUALIMG_REC_SEQ * 4) - DUALIMG_WORD(u32Best + DUALIMG_REC_SEQ * 4)) > 0))
+            u32Best = u32Page;
+    }
+
+    return u32Best;
+}
+
+static int32_t DUALIMG_SaveRecord(DUALIMG_STATE_T *psState)
+{
+    uint32_t au32Rec[DUALIMG_REC_WORDS], u32Page, i;
+
+    u32Page = (DUALIMG_FindRecord() == DUALIMG_RECORD_ADDR) ? DUALIMG_RECORD_ADDR + FMC_FLASH_PAGE_SIZE : DUALIMG_RECORD_ADDR;
+
+    au32Rec[DUALIMG_REC_MAGIC] = DUALIMG_MAGIC;
+    au32Rec[DUALIMG_REC_SEQ] = psState->u32Seq + 1;
+    au32Rec[DUALIMG_REC_ACTIVE] = psState->u32Active;
+    au32Rec[DUALIMG_REC_PENDING] = psState->u32Pending;
+    au32Rec[DUALIMG_REC_CHECK] = 0;
+    for(i = 0; i < 2; i++)
+    {
+        au32Rec[DUALIMG_REC_LEN0 + 2 * i] = psState->au32Len[i];
+        au32Rec[DUALIMG_REC_LEN0 + 2 * i + 1] = psState->au32Crc[i];
+    }
+    for(i = 0; i < DUALIMG_REC_CHECK; i++)
+        au32Rec[DUALIMG_REC_CHECK] ^= au32Rec[i];
+    au32Rec[DUALIMG_REC_CHECK] = ~au32Rec[DUALIMG_REC_CHECK];
+
+    if(FMC_Erase(u32Page) != 0)
+        return -1;
+
+    for(i = 0; i < DUALIMG_REC_WORDS; i++)
+    {
+        if((FMC_Write(u32Page + i * 4, au32Rec[i]) != 0) || (DUALIMG_WORD(u32Page + i * 4) != au32Rec[i]))
+            return -1;
+    }
+
+    psState->u32Seq++;
+    psState->u32Attempts = 0;
+
+    return 0;
+}
+
+/* Check vector table and, if the length is known, CRC of a slot */
+static int32_t DUALIMG_IsValid(const DUALIMG_STATE_T *psState, uint32_t u32Slot)
+{
+    uint32_t u32Base = DUALIMG_SLOT_BASE(u32Slot);
+    uint32_t u32Sp = DUALIMG_WORD(u32Base);
+    uint32_t u32Pc = DUALIMG_WORD(u32Base + 4);
+
+    if(((u32Sp - SRAM_BASE) > 0x1000) || (u32Sp & 3) || ((u32Pc - u32Base) >= DUALIMG_SLOT_SIZE) || !(u32Pc & 1))
+        return 0;
+
+    if(psState->au32Len[u32Slot] == 0)
+        return 1;
+
+    if(psState->au32Len[u32Slot] > DUALIMG_SLOT_SIZE)
+        return 0;
+
+    return (DUALIMG_CalcCrc(0, (const uint8_t *)u32Base, psState->au32Len[u32Slot]) == psState->au32Crc[u32Slot]);
+}
+
+static void DUALIMG_Start(uint32_t u32Slot)
+{
+    /* No interrupt may be taken from the remapped vector table before the CPU restarts */
+    __disable_irq();
+
+    FMC_SetVectorPageAddr(DUALIMG_SLOT_BASE(u32Slot));
+
+    /* CPU reset keeps VECMAP, the image starts from its own vector table */
+    SYS->IPRSTC1 |= SYS_IPRSTC1_CPU_RST_Msk;
+    while(1);
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_DUALIMG_EXPORTED_FUNCTIONS DUALIMG Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Read boot record
+  *
+  * @param[out] psState     Boot record and number of trial boots
+  *
+  * @return     None
+  *
+  * @details    Without a valid record, e.g. after factory programming, slot A is active, nothing is pending
+  *             and image lengths are 0.
+  */
+void DUALIMG_GetState(DUALIMG_STATE_T *psState)
+{
+    uint32_t u32Page = DUALIMG_FindRecord();
+    uint32_t i;
+
+    if(u32Page == 0)
+    {
+        psState->u32Seq = 0;
+        psState->u32Active = DUALIMG_SLOT_A;
+        psState->u32Pending = DUALIMG_SLOT_NONE;
+        psState->au32Len[0] = psState->au32Len[1] = 0;
+        psState->au32Crc[0] = psState->au32Crc[1] = 0;
+        psState->u32Attempts = 0;
+        return;
+    }
+
+    psState->u32Seq = DUALIMG_WORD(u32Page + DUALIMG_REC_SEQ * 4);
+    psState->u32Active = DUALIMG_WORD(u32Page + DUALIMG_REC_ACTIVE * 4);
+    psState->u32Pending = DUALIMG_WORD(u32Page + DUALIMG_REC_PENDING * 4);
+    for(i = 0; i < 2; i++)
+    {
+        psState->au32Len[i] = DUALIMG_WORD(u32Page + (DUALIMG_REC_LEN0 + 2 * i) * 4);
+        psState->au32Crc[i] = DUALIMG_WORD(u32Page + (DUALIMG_REC_LEN0 + 2 * i + 1) * 4);
+    }
+
+    for(i = 0; i < DUALIMG_REC_MARKS; i++)
+    {
+        if(DUALIMG_WORD(u32Page + (DUALIMG_REC_WORDS + i) * 4) == 0xFFFFFFFF)
+            break;
+    }
+    psState->u32Attempts = i;
+}
+
+/**
+  * @brief      Get slot of running image
+  *
+  * @param      None
+  *
+  * @return     \ref DUALIMG_SLOT_A, \ref DUALIMG_SLOT_B, or \ref DUALIMG_SLOT_NONE if not started by the boot manager
+  */
+uint32_t DUALIMG_GetRunningSlot(void)
+{
+    uint32_t u32VecMap = FMC_GetVECMAP();
+
+    if(u32VecMap == DUALIMG_SLOT_BASE(DUALIMG_SLOT_A))
+        return DUALIMG_SLOT_A;
+    if(u32VecMap == DUALIMG_SLOT_BASE(DUALIMG_SLOT_B))
+        return DUALIMG_SLOT_B;
+
+    return DUALIMG_SLOT_NONE;
+}
+
+/**
+  * @brief      Calculate CRC-32
+  *
+  * @param[in]  u32Crc      0 to start, or result of previous call to continue
+  * @param[in]  pu8Data     Data, may be flash or SRAM
+  * @param[in]  u32Len      Length in bytes
+  *
+  * @return     CRC-32, same as zlib crc32() and the common "CRC-32" of image tools
+  */
+uint32_t DUALIMG_CalcCrc(uint32_t u32Crc, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    u32Crc = ~u32Crc;
+    while(u32Len--)
+    {
+        u32Crc ^= *pu8Data++;
+        u32Crc = (u32Crc >> 4) ^ s_au32DualImgCrc[u32Crc & 0xF];
+        u32Crc = (u32Crc >> 4) ^ s_au32DualImgCrc[u32Crc & 0xF];
+    }
+
+    return ~u32Crc;
+}
+
+/**
+  * @brief      Program part of a new image into a slot
+  *
+  * @param[in]  u32Slot     Slot to program, must not be the running one
+  * @param[in]  u32Offset   Offset in slot, multiple of 4. Write in order from 0.
+  * @param[in]  pu8Data     Image data, no alignment needed
+  * @param[in]  u32Len      Length in bytes, multiple of 4
+  *
+  * @retval     0   Success
+  * @retval     -1  Parameter error, running image not confirmed yet, or flash error
+  *
+  * @details    A page is erased when writing reaches its start. Call with each received packet while the
+  *             application keeps running; CPU only stalls for the erase or program time of each word or page.
+  *             Writing offset 0 removes the slot from the boot record first, so a partial image never boots.
+  *             Registers must be unlocked and ISP and APROM update enabled by caller.
+  */
+int32_t DUALIMG_Write(uint32_t u32Slot, uint32_t u32Offset, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    DUALIMG_STATE_T sState;
+    uint32_t u32Addr, u32Data, i;
+
+    if((u32Slot > DUALIMG_SLOT_B) || (u32Slot == DUALIMG_GetRunningSlot()) || ((u32Offset | u32Len) & 3) ||
+            (u32Offset + u32Len > DUALIMG_SLOT_SIZE))
+        return -1;
+
+    if(u32Offset == 0)
+    {
+        DUALIMG_GetState(&sState);
+
+        /* Keep the fallback image while the running one is on trial */
+        if((sState.u32Pending != DUALIMG_SLOT_NONE) && (sState.u32Pending == DUALIMG_GetRunningSlot()))
+            return -1;
+
+        if((sState.u32Pending == u32Slot) || (sState.au32Len[u32Slot] != 0) || (sState.u32Active == u32Slot))
+        {
+            if(sState.u32Pending == u32Slot)
+                sState.u32Pending = DUALIMG_SLOT_NONE;
+            if(sState.u32Active == u32Slot)
+                sState.u32Active = u32Slot ^ 1;
+            sState.au32Len[u32Slot] = 0;
+            sState.au32Crc[u32Slot] = 0;
+            if(DUALIMG_SaveRecord(&sState) != 0)
+                return -1;
+        }
+    }
+
+    u32Addr = DUALIMG_SLOT_BASE(u32Slot) + u32Offset;
+    for(i = 0; i < u32Len; i += 4, u32Addr += 4)
+    {
+        if((u32Addr & (FMC_FLASH_PAGE_SIZE - 1)) == 0)
+        {
+            if(FMC_Erase(u32Addr) != 0)
+                return -1;
+        }
+
+        u32Data = pu8Data[i] | (pu8Data[i + 1] << 8) | (pu8Data[i + 2] << 16) | ((uint32_t)pu8Data[i + 3] << 24);
+        if((FMC_Write(u32Addr, u32Data) != 0) || (DUALIMG_WORD(u32Addr) != u32Data))
+            return -1;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Validate a programmed image and make it pending
+  *
+  * @param[in]  u32Slot     Slot programmed by \ref DUALIMG_Write
+  * @param[in]  u32Len      Image length in bytes
+  * @param[in]  u32Crc      Expected CRC-32 of image, see \ref DUALIMG_CalcCrc
+  *
+  * @retval     0   Success, image starts on next chip reset, e.g. SYS_ResetChip()
+  * @retval     -1  CRC mismatch, invalid vector table, or flash error
+  */
+int32_t DUALIMG_Commit(uint32_t u32Slot, uint32_t u32Len, uint32_t u32Crc)
+{
+    DUALIMG_STATE_T sState;
+
+    if((u32Slot > DUALIMG_SLOT_B) || (u32Slot == DUALIMG_GetRunningSlot()) || (u32Len == 0) || (u32Len > DUALIMG_SLOT_SIZE))
+        return -1;
+
+    DUALIMG_GetState(&sState);
+    sState.au32Len[u32Slot] = u32Len;
+    sState.au32Crc[u32Slot] = u32Crc;
+    if(!DUALIMG_IsValid(&sState, u32Slot))
+        return -1;
+
+    sState.u32Pending = u32Slot;
+
+    return DUALIMG_SaveRecord(&sState);
+}
+
+/**
+  * @brief      Confirm that the running image works
+  *
+  * @param      None
+  *
+  * @retval     0   Success, running image stays active on later resets
+  * @retval     -1  Not started by the boot manager, or flash error
+  *
+  * @details    Call after the application has passed its own checks. A pending image that does not call
+  *             this function before the trial WDT expires is rolled back after \ref DUALIMG_TRIAL_BOOTS boots.
+  *             The WDT keeps running after confirmation; feed it with WDT_RESET_COUNTER() or close it.
+  */
+int32_t DUALIMG_Confirm(void)
+{
+    DUALIMG_STATE_T sState;
+    uint32_t u32Running = DUALIMG_GetRunningSlot();
+
+    if(u32Running == DUALIMG_SLOT_NONE)
+        return -1;
+
+    DUALIMG_GetState(&sState);
+    if(sState.u32Pending == u32Running)
+        sState.u32Pending = DUALIMG_SLOT_NONE;
+    else if(sState.u32Active == u32Running)
+        return 0;
+
+    sState.u32Active = u32Running;
+
+    return DUALIMG_SaveRecord(&sState);
+}
+
+/**
+  * @brief      Select and start an image
+  *
+  * @param      None
+  *
+  * @retval     -1  No valid image
+  * @retval     -2  Rollback of a failed trial image could not be saved
+  *
+  * @details    Called by the boot manager after reset. A pending image is started with the WDT reset enabled
+  *             for up to \ref DUALIMG_TRIAL_BOOTS times, then it is dropped and the active image is started.
+  *             If the active image is not valid, the other one is tried.
+  *             The function returns only on error. After -2 the record still names the trial image, so the
+  *             caller must stay in the boot manager rather than start an image the next reset would not expect.
+  *             Registers must be unlocked and ISP enabled by caller.
+  */
+int32_t DUALIMG_Boot(void)
+{
+    DUALIMG_STATE_T sState;
+    uint32_t u32Page;
+
+    DUALIMG_GetState(&sState);
+
+    if(sState.u32Pending <= DUALIMG_SLOT_B)
+    {
+        u32Page = DUALIMG_FindRecord();
+        if((sState.u32Attempts < DUALIMG_TRIAL_BOOTS) && (sState.u32Attempts < DUALIMG_REC_MARKS) &&
+                DUALIMG_IsValid(&sState, sState.u32Pending) &&
+                (FMC_Write(u32Page + (DUALIMG_REC_WORDS + sState.u32Attempts) * 4, 0) == 0))
+        {
+            /* WDT resets the chip if the image hangs before it confirms */
+            CLK_EnableXtalRC(CLK_PWRCON_IRC10K_EN_Msk);
+            CLK_WaitClockReady(CLK_CLKSTATUS_IRC10K_STB_Msk);
+            CLK_SetModuleClock(WDT_MODULE, CLK_CLKSEL1_WDT_S_LIRC, 0);
+            CLK_EnableModuleClock(WDT_MODULE);
+            WDT_Open(DUALIMG_TRIAL_TIMEOUT, WDT_RESET_DELAY_1026CLK, TRUE, FALSE);
+
+            DUALIMG_Start(sState.u32Pending);
+        }
+
+        /* Roll back. A failed save leaves the previous record intact, so it can be tried again. */
+        sState.u32Pending = DUALIMG_SLOT_NONE;
+        if((DUALIMG_SaveRecord(&sState) != 0) && (DUALIMG_SaveRecord(&sState) != 0))
+            return -2;
+    }
+
+    if((sState.u32Active <= DUALIMG_SLOT_B) && DUALIMG_IsValid(&sState, sState.u32Active))
+        DUALIMG_Start(sState.u32Active);
+
+    if(DUALIMG_IsValid(&sState, sState.u32Active ^ 1))
+        DUALIMG_Start(sState.u32Active ^ 1);
+
+    return -1;
+}
+
+/*@}*/ /* end of group NUC029_DUALIMG_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_DUALIMG_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,427 @@
+/**************************************************************************//**
+ * @file     dvfs.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series core clock scaling governor source file
+ *
+ * @note     HCLK is switched between the operating points of a table, ordered from the fastest to the slowest.
+ *           The chip runs from one supply at any clock, so only the frequency is scaled.
+ *           A change is announced to the registered drivers with \ref DVFS_EVENT_PRE while interrupts are
+ *           enabled, so they can finish a transfer or refuse the change. The new source and divider are then
+ *           written with interrupts disabled, SystemCoreClock is updated and the drivers recompute their
+ *           divisors in \ref DVFS_EVENT_POST before any interrupt sees the new clock. Oscillators are enabled
+ *           and the PLL is locked before interrupts are disabled. Only a PLL level with another PLL frequency
+ *           runs HCLK from HIRC while the PLL locks again. HCLK moves to HIRC in a section of its own with
+ *           interrupts disabled and its own \ref DVFS_EVENT_POST, so the drivers see two of them.
+ *           The governor measures the time spent in \ref DVFS_Idle. A load of \ref DVFS_UP_LOAD or more jumps
+ *           to the fastest level. Below \ref DVFS_DOWN_LOAD it steps one level slower, if the load scaled to
+ *           that level stays below \ref DVFS_UP_LOAD, so it does not swing back at once.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_DVFS_Driver DVFS Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+static const DVFS_OPP_T s_asDvfsDefault[] =
+{
+    {CLK_CLKSEL0_HCLK_S_PLL,  1, FREQ_50MHZ},   /* 50 MHz */
+    {CLK_CLKSEL0_HCLK_S_HIRC, 1, 0},            /* 22.1184 MHz */
+    {CLK_CLKSEL0_HCLK_S_HXT,  1, 0},            /* 12 MHz */
+};
+
+static const DVFS_OPP_T *s_psDvfsOpp = s_asDvfsDefault;
+static uint32_t s_u32DvfsNum = sizeof(s_asDvfsDefault) / sizeof(s_asDvfsDefault[0]);
+static DVFS_FUNC_T s_apfnDvfsNotify[DVFS_MAX_NOTIFIERS];
+static uint32_t s_u32DvfsNotifiers = 0;
+static uint32_t s_u32DvfsPllHz = 0;         /* PLL output set here, 0 if not known */
+static uint32_t s_u32DvfsGovernor = 1;
+static uint32_t s_u32DvfsWindowStart;
+static uint32_t s_u32DvfsIdleUs;
+static DVFS_STATS_T s_sDvfsStats = {DVFS_LEVEL_NONE, 0, 0, 0, 0, 0, 0, 0};
+
+/* A running UART, SPI or ADC is clocked by the PLL */
+static uint32_t DVFS_PllInUse(void)
+{
+    uint32_t u32Apb = CLK->APBCLK, u32Sel = CLK->CLKSEL1;
+
+    if((u32Apb & (CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_UART1_EN_Msk)) &&
+            ((u32Sel & CLK_CLKSEL1_UART_S_Msk) == CLK_CLKSEL1_UART_S_PLL))
+        return 1;
+    if((u32Apb & CLK_APBCLK_ADC_EN_Msk) && ((u32Sel & CLK_CLKSEL1_ADC_S_Msk) == CLK_CLKSEL1_ADC_S_PLL))
+        return 1;
+    if((u32Apb & CLK_APBCLK_SPI0_EN_Msk) && ((u32Sel & CLK_CLKSEL1_SPI0_S_Msk) == CLK_CLKSEL1_SPI0_S_PLL))
+        return 1;
+    if((u32Apb & CLK_APBCLK_SPI1_EN_Msk) && ((u32Sel & CLK_CLKSEL1_SPI1_S_Msk) == CLK_CLKSEL1_SPI1_S_PLL))
+        return 1;
+
+    return 0;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_DVFS_EXPORTED_FUNCTIONS DVFS Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start the governor
+  *
+  * @param[in]  psOpp   Operating points from the fastest to the slowest, NULL for 50 MHz from PLL,
+  *                     22.1184 MHz from HIRC and 12 MHz from HXT. Must stay valid.
+  * @param[in]  u32Num  Number of operating points
+  *
+  * @return     Result of \ref DVFS_SetLevel to level 0, or -1 if an HCLK divider of the table is not 1 ~ 16
+  *
+  * @details    Switches to the fastest level. The timebase of \ref DVFS_GET_US must be running, and drivers
+  *             registered before are notified of this first change. Protected registers are unlocked as needed.
+  */
+int32_t DVFS_Open(const DVFS_OPP_T *psOpp, uint32_t u32Num)
+{
+    uint32_t i;
+
+    if((psOpp != NULL) && (u32Num != 0))
+    {
+        for(i = 0; i < u32Num; i++)
+        {
+            if((psOpp[i].u32HclkDiv == 0) || (psOpp[i].u32HclkDiv > 16))
+                return -1;
+        }
+        s_psDvfsOpp = psOpp;
+        s_u32DvfsNum = u32Num;
+    }
+    else
+    {
+        s_psDvfsOpp = s_asDvfsDefault;
+        s_u32DvfsNum = sizeof(s_asDvfsDefault) / sizeof(s_asDvfsDefault[0]);
+    }
+
+    s_sDvfsStats.u32Level = DVFS_LEVEL_NONE;
+    s_u32DvfsWindowStart = DVFS_GET_US();
+    s_u32DvfsIdleUs = 0;
+
+    return DVFS_SetLevel(0);
+}
+
+/**
+  * @brief      Register a driver for clock change notifications
+  *
+  * @param[in]  pfnFunc     Notification, called in the order of registration
+  *
+  * @retval     0   Success
+  * @retval     -1  \ref DVFS_MAX_NOTIFIERS already registered
+  */
+int32_t DVFS_Register(DVFS_FUNC_T pfnFunc)
+{
+    if(s_u32DvfsNotifiers >= DVFS_MAX_NOTIFIERS)
+        return -1;
+
+    s_apfnDvfsNotify[s_u32DvfsNotifiers++] = pfnFunc;
+
+    return 0;
+}
+
+/**
+  * @brief      Remove a notification
+  *
+  * @param[in]  pfnFunc     Notification given to \ref DVFS_Register
+  *
+  * @return     None
+  */
+void DVFS_Unregister(DVFS_FUNC_T pfnFunc)
+{
+    uint32_t i;
+
+    for(i = 0; i < s_u32DvfsNotifiers; i++)
+    {
+        if(s_apfnDvfsNotify[i] == pfnFunc)
+        {
+            s_u32DvfsNotifiers--;
+            for(; i < s_u32DvfsNotifiers; i++)
+                s_apfnDvfsNotify[i] = s_apfnDvfsNotify[i + 1];
+            break;
+        }
+    }
+}
+
+/**
+  * @brief      Change the operating point
+  *
+  * @param[in]  u32Level    Index in the table given to \ref DVFS_Open
+  *
+  * @retval     0   Success, or already at this level
+  * @retval     -1  Level out of range, or its oscillator did not become stable
+  * @retval     -2  Refused by a driver
+  *
+  * @details    Must not be called from an interrupt handler. The latency and the time with interrupts disabled
+  *             are kept for \ref DVFS_GetStats.
+  */
+int32_t DVFS_SetLevel(uint32_t u32Level)
+{
+    const DVFS_OPP_T *psOpp;
+    uint32_t u32Locked, u32PriMask, u32Start, u32IrqOff, u32Fallback = 0, u32Hirc, u32Osc, u32Hz, u32Div, i;
+    int32_t i32Ret = 0;
+
+    if(u32Level >= s_u32DvfsNum)
+        return -1;
+    if(u32Level == s_sDvfsStats.u32Level)
+        return 0;
+
+    psOpp = &s_psDvfsOpp[u32Level];
+    u32Hz = DVFS_GetLevelHz(u32Level);
+    u32Start = DVFS_GET_US();
+
+    u32Locked = SYS_IsRegLocked();
+    if(u32Locked)
+        SYS_UnlockReg();
+
+    /* Oscillator of the level. The PLL runs from HXT if it is stable, as in CLK_SetCoreClock(). */
+    u32Hirc = CLK->PWRCON & CLK_PWRCON_OSC22M_EN_Msk;
+    if((psOpp->u32HclkSrc == CLK_CLKSEL0_HCLK_S_HXT) ||
+            ((psOpp->u32HclkSrc == CLK_CLKSEL0_HCLK_S_PLL) && (CLK->CLKSTATUS & CLK_CLKSTATUS_XTL12M_STB_Msk)))
+    {
+        u32Osc = CLK_CLKSTATUS_XTL12M_STB_Msk;
+        CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+    }
+    else
+    {
+        u32Osc = CLK_CLKSTATUS_OSC22M_STB_Msk;
+        CLK->PWRCON |= CLK_PWRCON_OSC22M_EN_Msk;
+    }
+    if(!CLK_WaitClockReady(u32Osc))
+    {
+        i32Ret = -1;
+        goto lexit;
+    }
+
+    for(i = 0; i < s_u32DvfsNotifiers; i++)
+    {
+        if(s_apfnDvfsNotify[i](DVFS_EVENT_PRE, u32Hz) != 0)
+        {
+            while(i--)
+                s_apfnDvfsNotify[i](DVFS_EVENT_ABORT, SystemCoreClock);
+            s_sDvfsStats.u32Refused++;
+            i32Ret = -2;
+            goto lexit;
+        }
+    }
+
+    if((psOpp->u32HclkSrc == CLK_CLKSEL0_HCLK_S_PLL) &&
+            ((s_u32DvfsPllHz != psOpp->u32PllHz) || (CLK->PLLCON & CLK_PLLCON_PD_Msk)))
+    {
+        /* HCLK leaves the PLL while it locks at the new frequency, the drivers follow it to HIRC */
+        if((CLK->CLKSEL0 & CLK_CLKSEL0_HCLK_S_Msk) == CLK_CLKSEL0_HCLK_S_PLL)
+        {
+            CLK->PWRCON |= CLK_PWRCON_OSC22M_EN_Msk;
+            CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+            u32PriMask = __get_PRIMASK();
+            __disable_irq();
+            u32Fallback = DVFS_GET_US();
+            CLK->CLKSEL0 = (CLK->CLKSEL0 & (~CLK_CLKSEL0_HCLK_S_Msk)) | CLK_CLKSEL0_HCLK_S_HIRC;
+            SystemCoreClockUpdate();
+            for(i = 0; i < s_u32DvfsNotifiers; i++)
+                s_apfnDvfsNotify[i](DVFS_EVENT_POST, SystemCoreClock);
+            u32Fallback = DVFS_GET_US() - u32Fallback;
+            __set_PRIMASK(u32PriMask);
+        }
+        CLK_EnablePLL((u32Osc == CLK_CLKSTATUS_XTL12M_STB_Msk) ? CLK_PLLCON_PLL_SRC_HXT : CLK_PLLCON_PLL_SRC_HIRC,
+                      psOpp->u32PllHz);
+        s_u32DvfsPllHz = psOpp->u32PllHz;
+    }
+
+    u32Div = CLK_CLKDIV_HCLK(psOpp->u32HclkDiv);
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    u32IrqOff = DVFS_GET_US();
+
+    /* HCLK never gets above the faster of the two settings, a larger divider is applied first */
+    if(u32Div > (CLK->CLKDIV & CLK_CLKDIV_HCLK_N_Msk))
+    {
+        CLK->CLKDIV = (CLK->CLKDIV & (~CLK_CLKDIV_HCLK_N_Msk)) | u32Div;
+        CLK->CLKSEL0 = (CLK->CLKSEL0 & (~CLK_CLKSEL0_HCLK_S_Msk)) | psOpp->u32HclkSrc;
+    }
+    else
+    {
+        CLK->CLKSEL0 = (CLK->CLKSEL0 & (~CLK_CLKSEL0_HCLK_S_Msk)) | psOpp->u32HclkSrc;
+        CLK->CLKDIV = (CLK->CLKDIV & (~CLK_CLKDIV_HCLK_N_Msk)) | u32Div;
+    }
+    SystemCoreClockUpdate();
+
+    for(i = 0; i < s_u32DvfsNotifiers; i++)
+        s_apfnDvfsNotify[i](DVFS_EVENT_POST, SystemCoreClock);
+
+    u32IrqOff = DVFS_GET_US() - u32IrqOff;
+    __set_PRIMASK(u32PriMask);
+    if(u32Fallback > u32IrqOff)
+        u32IrqOff = u32Fallback;
+
+#if DVFS_PLL_OFF
+    if((psOpp->u32HclkSrc != CLK_CLKSEL0_HCLK_S_PLL) && !(CLK->PLLCON & CLK_PLLCON_PD_Msk) && !DVFS_PllInUse())
+    {
+        CLK_DisablePLL();
+        s_u32DvfsPllHz = 0;
+    }
+#endif
+
+    /* HIRC goes off again if it was only needed during the change */
+    if(!u32Hirc && (psOpp->u32HclkSrc != CLK_CLKSEL0_HCLK_S_HIRC) &&
+            ((CLK->PLLCON & CLK_PLLCON_PD_Msk) || ((CLK->PLLCON & CLK_PLLCON_PLL_SRC_Msk) == CLK_PLLCON_PLL_SRC_HXT)))
+        CLK->PWRCON &= ~CLK_PWRCON_OSC22M_EN_Msk;
+
+    s_sDvfsStats.u32Level = u32Level;
+    s_sDvfsStats.u32Transitions++;
+    s_sDvfsStats.u32LastUs = DVFS_GET_US() - u32Start;
+    if(s_sDvfsStats.u32LastUs > s_sDvfsStats.u32MaxUs)
+        s_sDvfsStats.u32MaxUs = s_sDvfsStats.u32LastUs;
+    s_sDvfsStats.u32LastIrqOffUs = u32IrqOff;
+    if(u32IrqOff > s_sDvfsStats.u32MaxIrqOffUs)
+        s_sDvfsStats.u32MaxIrqOffUs = u32IrqOff;
+
+    /* Load at the new speed is measured from now */
+    s_u32DvfsWindowStart = DVFS_GET_US();
+    s_u32DvfsIdleUs = 0;
+
+lexit:
+    if(u32Locked)
+        SYS_LockReg();
+
+    return i32Ret;
+}
+
+/**
+  * @brief      Get the operating point
+  *
+  * @param      None
+  *
+  * @return     Current level, or \ref DVFS_LEVEL_NONE
+  */
+uint32_t DVFS_GetLevel(void)
+{
+    return s_sDvfsStats.u32Level;
+}
+
+/**
+  * @brief      Get the nominal HCLK of an operating point
+  *
+  * @param[in]  u32Level    Index in the table given to \ref DVFS_Open
+  *
+  * @return     HCLK in Hz, 0 if the level is out of range
+  *
+  * @details    For a PLL level the PLL may end up slightly off the requested output, SystemCoreClock has the
+  *             real value once the level is set.
+  */
+uint32_t DVFS_GetLevelHz(uint32_t u32Level)
+{
+    const DVFS_OPP_T *psOpp;
+    uint32_t u32Hz;
+
+    if(u32Level >= s_u32DvfsNum)
+        return 0;
+
+    psOpp = &s_psDvfsOpp[u32Level];
+    if(psOpp->u32HclkSrc == CLK_CLKSEL0_HCLK_S_PLL)
+        u32Hz = psOpp->u32PllHz;
+    else if(psOpp->u32HclkSrc == CLK_CLKSEL0_HCLK_S_HIRC)
+        u32Hz = __HIRC;
+    else
+        u32Hz = __HXT;
+
+    return u32Hz / psOpp->u32HclkDiv;
+}
+
+/**
+  * @brief      Enable or disable the governor
+  *
+  * @param[in]  u32Enable   1 to let \ref DVFS_Idle change the level, 0 to keep the level set by
+  *                         \ref DVFS_SetLevel. The load is measured in both cases.
+  *
+  * @return     None
+  */
+void DVFS_SetGovernor(uint32_t u32Enable)
+{
+    s_u32DvfsGovernor = u32Enable;
+}
+
+/**
+  * @brief      Wait for an interrupt and run the governor
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Call from the idle loop of the application instead of __WFI(). Time between going to sleep and
+  *             waking up counts as idle, interrupt handlers run after it is taken and count as load. Every
+  *             \ref DVFS_WINDOW_MS the load is updated and the governor may change the level.
+  */
+void DVFS_Idle(void)
+{
+    uint32_t u32PriMask, u32Now, u32Elapsed, u32Load, u32Level;
+
+    u32Now = DVFS_GET_US();
+    u32Elapsed = u32Now - s_u32DvfsWindowStart;
+    if(u32Elapsed >= DVFS_WINDOW_MS * 1000)
+    {
+        u32Load = s_u32DvfsIdleUs / (u32Elapsed / 100);
+        u32Load = (u32Load < 100) ? 100 - u32Load : 0;
+        s_sDvfsStats.u32Load = u32Load;
+        s_u32DvfsWindowStart = u32Now;
+        s_u32DvfsIdleUs = 0;
+
+        u32Level = s_sDvfsStats.u32Level;
+        if(s_u32DvfsGovernor && (u32Level != DVFS_LEVEL_NONE))
+        {
+            if(u32Load >= DVFS_UP_LOAD)
+                u32Level = 0;
+            else if((u32Load < DVFS_DOWN_LOAD) && (u32Level + 1 < s_u32DvfsNum) &&
+                    (u32Load * (DVFS_GetLevelHz(u32Level) / 1000) / (DVFS_GetLevelHz(u32Level + 1) / 1000) < DVFS_UP_LOAD))
+                u32Level++;
+
+            DVFS_SetLevel(u32Level);
+        }
+    }
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    u32Now = DVFS_GET_US();
+    __WFI();
+    s_u32DvfsIdleUs += DVFS_GET_US() - u32Now;
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Get the governor state and the transition latency
+  *
+  * @param[out] psStats     Copy of the counters
+  *
+  * @return     None
+  */
+void DVFS_GetStats(DVFS_STATS_T *psStats)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    *psStats = s_sDvfsStats;
+    __set_PRIMASK(u32PriMask);
+}
+
+/*@}*/ /* end of group NUC029_DVFS_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_DVFS_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
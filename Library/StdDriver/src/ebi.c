@@ -20,6 +20,152 @@
   @{
 */
 
+/** @cond HIDDEN_SYMBOLS */
+
+#define EBI_CAL_ALE         0       /* Index of timing parameters tried by calibration */
+#define EBI_CAL_ACC         1
+#define EBI_CAL_AHD         2
+#define EBI_CAL_IW2X        3
+#define EBI_CAL_IR2R        4
+#define EBI_CAL_PARAMS      5
+
+#define EBI_CAL_ADDR_BITS   17      /* log2(EBI_MAX_SIZE) */
+
+static const uint8_t s_au8EbiCalMax[EBI_CAL_PARAMS] = {7, 31, 7, 15, 15};
+
+static uint32_t s_u32EbiCalBase;                            /* Absolute start address of test area */
+static uint32_t s_u32EbiCalSize;
+static uint32_t s_u32EbiCalFlags;
+static uint32_t s_u32EbiCalRefSum;                          /* Window checksum at slowest timing, read-only mode */
+static uint16_t s_au16EbiCalRefAddr[EBI_CAL_ADDR_BITS + 1]; /* Data at power of 2 offsets, read-only mode */
+
+static __INLINE uint32_t EBI_CalUnit(void)
+{
+    return (EBI->EBICON & EBI_EBICON_ExtBW16_Msk) ? 2 : 1;
+}
+
+static __INLINE uint32_t EBI_CalRead(uint32_t u32Addr)
+{
+    if(EBI->EBICON & EBI_EBICON_ExtBW16_Msk)
+        return *(volatile uint16_t *)u32Addr;
+    else
+        return *(volatile uint8_t *)u32Addr;
+}
+
+static __INLINE void EBI_CalWrite(uint32_t u32Addr, uint32_t u32Data)
+{
+    if(EBI->EBICON & EBI_EBICON_ExtBW16_Msk)
+        *(volatile uint16_t *)u32Addr = (uint16_t)u32Data;
+    else
+        *(volatile uint8_t *)u32Addr = (uint8_t)u32Data;
+}
+
+static void EBI_CalSet(uint32_t u32MclkDiv, const uint32_t *pu32Param)
+{
+    EBI->EBICON = (EBI->EBICON & ~(EBI_EBICON_MCLKDIV_Msk | EBI_EBICON_ExttALE_Msk)) |
+                  (u32MclkDiv << EBI_EBICON_MCLKDIV_Pos) | (pu32Param[EBI_CAL_ALE] << EBI_EBICON_ExttALE_Pos);
+    EBI->EXTIME = (pu32Param[EBI_CAL_IR2R] << EBI_EXTIME_ExtIR2R_Pos) | (pu32Param[EBI_CAL_IW2X] << EBI_EXTIME_ExtIW2X_Pos) |
+                  (pu32Param[EBI_CAL_AHD] << EBI_EXTIME_ExttAHD_Pos) | (pu32Param[EBI_CAL_ACC] << EBI_EXTIME_ExttACC_Pos);
+}
+
+static uint32_t EBI_CalWindow(void)
+{
+    return (s_u32EbiCalSize < EBI_CAL_WINDOW) ? s_u32EbiCalSize : EBI_CAL_WINDOW;
+}
+
+static uint32_t EBI_CalSum(void)
+{
+    uint32_t u32Off, u32Sum = 0, u32Unit = EBI_CalUnit();
+
+    for(u32Off = 0; u32Off < EBI_CalWindow(); u32Off += u32Unit)
+        u32Sum = ((u32Sum << 1) | (u32Sum >> 31)) ^ EBI_CalRead(s_u32EbiCalBase + u32Off);
+
+    return u32Sum;
+}
+
+/* Return 1 if current timing passes all patterns */
+static uint32_t EBI_CalCheck(void)
+{
+    uint32_t u32Unit, u32Mask, u32Pass, u32Off, u32Bit, u32Data, u32Seed, i;
+
+    u32Unit = EBI_CalUnit();
+    u32Mask = (u32Unit == 2) ? 0xFFFF : 0xFF;
+
+    for(u32Pass = 0; u32Pass < EBI_CAL_PASSES; u32Pass++)
+    {
+        if(s_u32EbiCalFlags & EBI_CAL_READONLY)
+        {
+            if(EBI_CalSum() != s_u32EbiCalRefSum)
+                return 0;
+
+            for(i = 0, u32Off = 0; u32Off < s_u32EbiCalSize; u32Off = u32Unit << i++)
+            {
+                if(EBI_CalRead(s_u32EbiCalBase + u32Off) != s_au16EbiCalRefAddr[i])
+                    return 0;
+            }
+            continue;
+        }
+
+        /* Walking ones and zeros on data lines */
+        for(u32Bit = 0; u32Bit < u32Unit * 8; u32Bit++)
+        {
+            EBI_CalWrite(s_u32EbiCalBase, 1UL << u32Bit);
+            if(EBI_CalRead(s_u32EbiCalBase) != (1UL << u32Bit))
+                return 0;
+            EBI_CalWrite(s_u32EbiCalBase, ~(1UL << u32Bit) & u32Mask);
+            if(EBI_CalRead(s_u32EbiCalBase) != (~(1UL << u32Bit) & u32Mask))
+                return 0;
+        }
+
+        /* Address lines, a distinct value at each power of 2 offset catches stuck or shorted lines */
+        for(i = 1, u32Off = u32Unit; u32Off < s_u32EbiCalSize; i++, u32Off <<= 1)
+            EBI_CalWrite(s_u32EbiCalBase + u32Off, (i * 0x1111 + 0x5A) & u32Mask);
+        EBI_CalWrite(s_u32EbiCalBase, 0x5A);
+        for(i = 0, u32Off = 0; u32Off < s_u32EbiCalSize; u32Off = u32Unit << i++)
+        {
+            if(EBI_CalRead(s_u32EbiCalBase + u32Off) != ((i * 0x1111 + 0x5A) & u32Mask))
+                return 0;
+        }
+
+        /* Pseudo random data over window, different for each pass */
+        u32Seed = 0x1234567 * (u32Pass + 1);
+        for(u32Data = u32Seed, u32Off = 0; u32Off < EBI_CalWindow(); u32Off += u32Unit)
+        {
+            u32Data = u32Data * 1103515245 + 12345;
+            EBI_CalWrite(s_u32EbiCalBase + u32Off, u32Data >> 16);
+        }
+        for(u32Data = u32Seed, u32Off = 0; u32Off < EBI_CalWindow(); u32Off += u32Unit)
+        {
+            u32Data = u32Data * 1103515245 + 12345;
+            if(EBI_CalRead(s_u32EbiCalBase + u32Off) != ((u32Data >> 16) & u32Mask))
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+static __INLINE uint32_t EBI_IsExtAddr(uint32_t u32Addr)
+{
+    return ((u32Addr - EBI_BASE_ADDR) < EBI_MAX_SIZE);
+}
+
+static __INLINE uint32_t EBI_IsBus16(void)
+{
+    return (EBI->EBICON & EBI_EBICON_ExtBW16_Msk);
+}
+
+static uint32_t EBI_CalBps(uint32_t u32Bytes, uint32_t u32Cycles)
+{
+    if(u32Cycles == 0)
+        return 0;
+
+    /* u32Bytes * SystemCoreClock / u32Cycles without 64-bit division */
+    return ((u32Bytes << 12) / u32Cycles) * (SystemCoreClock >> 12);
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
 
 /** @addtogroup NUC029_EBI_EXPORTED_FUNCTIONS EBI Exported Functions
   @{
@@ -148,6 +294,547 @@ void EBI_SetBusTiming(uint32_t u32Bank, uint32_t u32TimingConfig, uint32_t u32Mc
     EBI->EXTIME = u32TimingConfig;
 }
 
+/**
+  * @brief      Find the fastest reliable EBI timing
+  *
+  * @param[in]  u32Bank     Bank number for EBI. This parameter is current not used.
+  * @param[in]  u32Offset   Start of test area on EBI bus
+  * @param[in]  u32Size     Size of test area. Address lines are tested up to this size.
+  * @param[in]  u32Flags    0 for SRAM, \ref EBI_CAL_READONLY for NOR flash or other read-only device
+  * @param[out] psCal       Chosen timing and measured bandwidth
+  *
+  * @retval     0   Success, the chosen timing is applied
+  * @retval     -1  No timing passed or parameter error, original timing is restored
+  *
+  * @details    EBI must be opened with the right bus width first. For each MCLK divider from HCLK/1 up,
+  *             the shortest passing tACC is searched with the other parameters at maximum, then tALE, tAHD,
+  *             ExtIW2X and ExtIR2R are reduced while the pattern tests still pass. \ref EBI_CAL_MARGIN cycles
+  *             are added to tALE and tACC, and the setting with the least HCLK cycles per access is kept.
+  *             Each candidate must pass \ref EBI_CAL_PASSES rounds of walking ones/zeros on the data lines,
+  *             a power of 2 address line test and a pseudo random pattern over \ref EBI_CAL_WINDOW bytes.
+  *             In read-only mode, the window checksum and address line data are compared against a reference
+  *             read at the slowest timing instead. SRAM content in the test area is destroyed.
+  *             Code must not run from EBI while this function runs.
+  */
+int32_t EBI_Calibrate(uint32_t u32Bank, uint32_t u32Offset, uint32_t u32Size, uint32_t u32Flags, EBI_CAL_T *psCal)
+{
+    uint32_t au32Param[EBI_CAL_PARAMS], au32Best[EBI_CAL_PARAMS];
+    uint32_t u32EbiCon, u32ExTime, u32Div, u32BestDiv, u32Cost, u32BestCost, u32Off, i, k;
+
+    if((u32Size == 0) || (u32Offset + u32Size > EBI_MAX_SIZE) || (u32Offset + u32Size < u32Offset))
+        return -1;
+
+    u32EbiCon = EBI->EBICON;
+    u32ExTime = EBI->EXTIME;
+
+    s_u32EbiCalBase = EBI_BASE_ADDR + u32Offset;
+    s_u32EbiCalSize = u32Size;
+    s_u32EbiCalFlags = u32Flags;
+
+    /* Reference read at the slowest timing */
+    if(u32Flags & EBI_CAL_READONLY)
+    {
+        for(k = 0; k < EBI_CAL_PARAMS; k++)
+            au32Param[k] = s_au8EbiCalMax[k];
+        EBI_CalSet(EBI_MCLKDIV_32, au32Param);
+
+        s_u32EbiCalRefSum = EBI_CalSum();
+        for(i = 0, u32Off = 0; u32Off < u32Size; u32Off = EBI_CalUnit() << i++)
+            s_au16EbiCalRefAddr[i] = (uint16_t)EBI_CalRead(s_u32EbiCalBase + u32Off);
+    }
+
+    u32BestCost = 0xFFFFFFFF;
+    u32BestDiv = 0;
+    for(u32Div = EBI_MCLKDIV_1; u32Div <= EBI_MCLKDIV_32; u32Div++)
+    {
+        /* Even the shortest timing at this divider cannot beat the best so far */
+        if(((1UL << u32Div) * 3 * 2) >= u32BestCost)
+            break;
+
+        for(k = 0; k < EBI_CAL_PARAMS; k++)
+            au32Param[k] = s_au8EbiCalMax[k];
+
+        /* Shortest access time with generous setup, hold and idle */
+        for(au32Param[EBI_CAL_ACC] = 0; au32Param[EBI_CAL_ACC] <= s_au8EbiCalMax[EBI_CAL_ACC]; au32Param[EBI_CAL_ACC]++)
+        {
+            EBI_CalSet(u32Div, au32Param);
+            if(EBI_CalCheck())
+                break;
+        }
+        if(au32Param[EBI_CAL_ACC] > s_au8EbiCalMax[EBI_CAL_ACC])
+            continue;
+
+        /* Then trim the other parameters one by one */
+        for(k = 0; k < EBI_CAL_PARAMS; k++)
+        {
+            if(k == EBI_CAL_ACC)
+                continue;
+
+            while(au32Param[k] > 0)
+            {
+                au32Param[k]--;
+                EBI_CalSet(u32Div, au32Param);
+                if(!EBI_CalCheck())
+                {
+                    au32Param[k]++;
+                    break;
+                }
+            }
+        }
+
+        au32Param[EBI_CAL_ALE] += EBI_CAL_MARGIN;
+        if(au32Param[EBI_CAL_ALE] > s_au8EbiCalMax[EBI_CAL_ALE])
+            au32Param[EBI_CAL_ALE] = s_au8EbiCalMax[EBI_CAL_ALE];
+        au32Param[EBI_CAL_ACC] += EBI_CAL_MARGIN;
+        if(au32Param[EBI_CAL_ACC] > s_au8EbiCalMax[EBI_CAL_ACC])
+            au32Param[EBI_CAL_ACC] = s_au8EbiCalMax[EBI_CAL_ACC];
+
+        EBI_CalSet(u32Div, au32Param);
+        if(!EBI_CalCheck())
+            continue;
+
+        /* HCLK cycles per access, times 2. Idle cycles count half since they only follow some accesses. */
+        u32Cost = (1UL << u32Div) * ((au32Param[EBI_CAL_ALE] + au32Param[EBI_CAL_ACC] + au32Param[EBI_CAL_AHD] + 3) * 2 +
+                                      au32Param[EBI_CAL_IW2X] + au32Param[EBI_CAL_IR2R]);
+        if(u32Cost < u32BestCost)
+        {
+            u32BestCost = u32Cost;
+            u32BestDiv = u32Div;
+            for(k = 0; k < EBI_CAL_PARAMS; k++)
+                au32Best[k] = au32Param[k];
+        }
+    }
+
+    if(u32BestCost == 0xFFFFFFFF)
+    {
+        EBI->EBICON = u32EbiCon;
+        EBI->EXTIME = u32ExTime;
+        return -1;
+    }
+
+    EBI_CalSet(u32BestDiv, au32Best);
+    psCal->u32MclkDiv = u32BestDiv;
+    psCal->u32ALE = au32Best[EBI_CAL_ALE];
+    psCal->u32ExTime = EBI->EXTIME;
+    EBI_MeasureBandwidth(u32Offset, u32Size, u32Flags, psCal);
+
+    return 0;
+}
+
+/**
+  * @brief      Apply a calibrated EBI timing
+  *
+  * @param[in]  u32Bank     Bank number for EBI. This parameter is current not used.
+  * @param[in]  psCal       Timing from \ref EBI_Calibrate or \ref EBI_LoadCalibration
+  *
+  * @return     None
+  */
+void EBI_ApplyCalibration(uint32_t u32Bank, const EBI_CAL_T *psCal)
+{
+    EBI->EBICON = (EBI->EBICON & ~(EBI_EBICON_MCLKDIV_Msk | EBI_EBICON_ExttALE_Msk)) |
+                  (psCal->u32MclkDiv << EBI_EBICON_MCLKDIV_Pos) | (psCal->u32ALE << EBI_EBICON_ExttALE_Pos);
+    EBI->EXTIME = psCal->u32ExTime;
+}
+
+/**
+  * @brief      Measure EBI bandwidth with current timing
+  *
+  * @param[in]  u32Offset   Start of area on EBI bus
+  * @param[in]  u32Size     Size of area, up to 4 KB is used
+  * @param[in]  u32Flags    \ref EBI_CAL_READONLY to skip the write measurement
+  * @param[out] psCal       u32ReadBps and u32WriteBps are updated
+  *
+  * @return     None
+  *
+  * @details    Time 32-bit reads and writes over the area with SysTick. SysTick settings are restored after.
+  *             SRAM content in the area is destroyed unless \ref EBI_CAL_READONLY is set.
+  */
+void EBI_MeasureBandwidth(uint32_t u32Offset, uint32_t u32Size, uint32_t u32Flags, EBI_CAL_T *psCal)
+{
+    volatile uint32_t *pu32Addr, *pu32End;
+    uint32_t u32Ctrl, u32Load, u32Start, u32Sum = 0;
+
+    u32Offset = (u32Offset + 3) & ~3UL;
+    if(u32Size > 0x1000)
+        u32Size = 0x1000;
+    u32Size &= ~15UL;
+    pu32End = (volatile uint32_t *)(EBI_BASE_ADDR + u32Offset + u32Size);
+
+    u32Ctrl = SysTick->CTRL;
+    u32Load = SysTick->LOAD;
+    SysTick->CTRL = 0;
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    u32Start = SysTick->VAL;
+    for(pu32Addr = (volatile uint32_t *)(EBI_BASE_ADDR + u32Offset); pu32Addr < pu32End; pu32Addr += 4)
+        u32Sum += pu32Addr[0] + pu32Addr[1] + pu32Addr[2] + pu32Addr[3];
+    psCal->u32ReadBps = EBI_CalBps(u32Size, (u32Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk);
+
+    psCal->u32WriteBps = 0;
+    if(!(u32Flags & EBI_CAL_READONLY))
+    {
+        u32Start = SysTick->VAL;
+        for(pu32Addr = (volatile uint32_t *)(EBI_BASE_ADDR + u32Offset); pu32Addr < pu32End; pu32Addr += 4)
+        {
+            pu32Addr[0] = u32Sum;
+            pu32Addr[1] = u32Sum;
+            pu32Addr[2] = u32Sum;
+            pu32Addr[3] = u32Sum;
+        }
+        psCal->u32WriteBps = EBI_CalBps(u32Size, (u32Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk);
+    }
+
+    SysTick->CTRL = 0;
+    SysTick->LOAD = u32Load;
+    SysTick->VAL = 0;
+    SysTick->CTRL = u32Ctrl;
+}
+
+/**
+  * @brief      Save calibrated EBI timing to flash
+  *
+  * @param[in]  u32FlashAddr    Page aligned address in Data Flash or APROM. The whole page is erased.
+  * @param[in]  psCal           Timing to save
+  *
+  * @retval     0   Success
+  * @retval     -1  Erase, program or verify failed
+  *
+  * @details    Registers must be unlocked and ISP enabled by FMC_Open(). Call FMC_EnableAPUpdate() first
+  *             if the page is in APROM.
+  */
+int32_t EBI_SaveCalibration(uint32_t u32FlashAddr, const EBI_CAL_T *psCal)
+{
+    uint32_t au32Rec[4], i;
+
+    au32Rec[0] = EBI_CAL_MAGIC;
+    au32Rec[1] = (psCal->u32MclkDiv << EBI_EBICON_MCLKDIV_Pos) | (psCal->u32ALE << EBI_EBICON_ExttALE_Pos);
+    au32Rec[2] = psCal->u32ExTime;
+    au32Rec[3] = ~(au32Rec[0] ^ au32Rec[1] ^ au32Rec[2]);
+
+    if(FMC_Erase(u32FlashAddr) != 0)
+        return -1;
+
+    for(i = 0; i < 4; i++)
+    {
+        if(FMC_Write(u32FlashAddr + i * 4, au32Rec[i]) != 0)
+            return -1;
+        if(FMC_Read(u32FlashAddr + i * 4) != au32Rec[i])
+            return -1;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Load EBI timing saved by \ref EBI_SaveCalibration
+  *
+  * @param[in]  u32FlashAddr    Address passed to \ref EBI_SaveCalibration
+  * @param[out] psCal           Saved timing. Bandwidth fields are cleared.
+  *
+  * @retval     0   Valid record found
+  * @retval     -1  No valid record, calibration is needed
+  *
+  * @details    ISP must be enabled by FMC_Open(). The timing is not applied, call \ref EBI_ApplyCalibration.
+  */
+int32_t EBI_LoadCalibration(uint32_t u32FlashAddr, EBI_CAL_T *psCal)
+{
+    uint32_t au32Rec[4], i;
+
+    for(i = 0; i < 4; i++)
+        au32Rec[i] = FMC_Read(u32FlashAddr + i * 4);
+
+    if((au32Rec[0] != EBI_CAL_MAGIC) || (au32Rec[3] != ~(au32Rec[0] ^ au32Rec[1] ^ au32Rec[2])))
+        return -1;
+
+    psCal->u32MclkDiv = (au32Rec[1] & EBI_EBICON_MCLKDIV_Msk) >> EBI_EBICON_MCLKDIV_Pos;
+    psCal->u32ALE = (au32Rec[1] & EBI_EBICON_ExttALE_Msk) >> EBI_EBICON_ExttALE_Pos;
+    psCal->u32ExTime = au32Rec[2];
+    psCal->u32ReadBps = 0;
+    psCal->u32WriteBps = 0;
+
+    return 0;
+}
+
+/**
+  * @brief      Copy memory, optimized for EBI
+  *
+  * @param[out] pvDst       Destination, internal SRAM or EBI
+  * @param[in]  pvSrc       Source, flash, internal SRAM or EBI
+  * @param[in]  u32Len      Number of bytes
+  *
+  * @return     None
+  *
+  * @details    Same alignment on both sides is copied in 16-byte bursts of 4 word loads then 4 word stores,
+  *             which compilers turn into LDM/STM. On 16-bit bus, an EBI word access is two halfword bus cycles,
+  *             so buffers that only share halfword alignment are moved by halfwords, and buffers at odd
+  *             offsets are combined into halfwords on the EBI side instead of falling back to byte cycles.
+  *             Areas must not overlap.
+  */
+void EBI_MemCopy(void *pvDst, const void *pvSrc, uint32_t u32Len)
+{
+    uint8_t *pu8Dst = (uint8_t *)pvDst;
+    const uint8_t *pu8Src = (const uint8_t *)pvSrc;
+    uint32_t *pu32Dst;
+    const uint32_t *pu32Src;
+    uint16_t *pu16Dst;
+    const uint16_t *pu16Src;
+    uint32_t u32W0, u32W1, u32W2, u32W3;
+
+    if(u32Len >= 8)
+    {
+        if((((uint32_t)pu8Dst ^ (uint32_t)pu8Src) & 3) == 0)
+        {
+            /* Align to word with at most one byte and one halfword access */
+            if((uint32_t)pu8Dst & 1)
+            {
+                *pu8Dst++ = *pu8Src++;
+                u32Len--;
+            }
+            if((uint32_t)pu8Dst & 2)
+            {
+                *(uint16_t *)pu8Dst = *(const uint16_t *)pu8Src;
+                pu8Dst += 2;
+                pu8Src += 2;
+                u32Len -= 2;
+            }
+
+            pu32Dst = (uint32_t *)pu8Dst;
+            pu32Src = (const uint32_t *)pu8Src;
+            for(; u32Len >= 16; u32Len -= 16)
+            {
+                u32W0 = pu32Src[0];
+                u32W1 = pu32Src[1];
+                u32W2 = pu32Src[2];
+                u32W3 = pu32Src[3];
+                pu32Src += 4;
+                pu32Dst[0] = u32W0;
+                pu32Dst[1] = u32W1;
+                pu32Dst[2] = u32W2;
+                pu32Dst[3] = u32W3;
+                pu32Dst += 4;
+            }
+            for(; u32Len >= 4; u32Len -= 4)
+                *pu32Dst++ = *pu32Src++;
+
+            pu8Dst = (uint8_t *)pu32Dst;
+            pu8Src = (const uint8_t *)pu32Src;
+            if(u32Len >= 2)
+            {
+                *(uint16_t *)pu8Dst = *(const uint16_t *)pu8Src;
+                pu8Dst += 2;
+                pu8Src += 2;
+                u32Len -= 2;
+            }
+        }
+        else if((((uint32_t)pu8Dst ^ (uint32_t)pu8Src) & 1) == 0)
+        {
+            if((uint32_t)pu8Dst & 1)
+            {
+                *pu8Dst++ = *pu8Src++;
+                u32Len--;
+            }
+
+            pu16Dst = (uint16_t *)pu8Dst;
+            pu16Src = (const uint16_t *)pu8Src;
+            for(; u32Len >= 8; u32Len -= 8)
+            {
+                u32W0 = pu16Src[0];
+                u32W1 = pu16Src[1];
+                u32W2 = pu16Src[2];
+                u32W3 = pu16Src[3];
+                pu16Src += 4;
+                pu16Dst[0] = (uint16_t)u32W0;
+                pu16Dst[1] = (uint16_t)u32W1;
+                pu16Dst[2] = (uint16_t)u32W2;
+                pu16Dst[3] = (uint16_t)u32W3;
+                pu16Dst += 4;
+            }
+            for(; u32Len >= 2; u32Len -= 2)
+                *pu16Dst++ = *pu16Src++;
+
+            pu8Dst = (uint8_t *)pu16Dst;
+            pu8Src = (const uint8_t *)pu16Src;
+        }
+        else if(EBI_IsBus16() && EBI_IsExtAddr((uint32_t)pu8Dst))
+        {
+            /* Odd offset, write EBI by halfwords built from source bytes */
+            if((uint32_t)pu8Dst & 1)
+            {
+                *pu8Dst++ = *pu8Src++;
+                u32Len--;
+            }
+
+            pu16Dst = (uint16_t *)pu8Dst;
+            for(; u32Len >= 2; u32Len -= 2)
+            {
+                *pu16Dst++ = (uint16_t)(pu8Src[0] | (pu8Src[1] << 8));
+                pu8Src += 2;
+            }
+            pu8Dst = (uint8_t *)pu16Dst;
+        }
+        else if(EBI_IsBus16() && EBI_IsExtAddr((uint32_t)pu8Src))
+        {
+            /* Odd offset, read EBI by halfwords and split into destination bytes */
+            if((uint32_t)pu8Src & 1)
+            {
+                *pu8Dst++ = *pu8Src++;
+                u32Len--;
+            }
+
+            pu16Src = (const uint16_t *)pu8Src;
+            for(; u32Len >= 2; u32Len -= 2)
+            {
+                u32W0 = *pu16Src++;
+                pu8Dst[0] = (uint8_t)u32W0;
+                pu8Dst[1] = (uint8_t)(u32W0 >> 8);
+                pu8Dst += 2;
+            }
+            pu8Src = (const uint8_t *)pu16Src;
+        }
+    }
+
+    while(u32Len--)
+        *pu8Dst++ = *pu8Src++;
+}
+
+/**
+  * @brief      Fill memory, optimized for EBI
+  *
+  * @param[out] pvDst       Destination, internal SRAM or EBI
+  * @param[in]  u32Value    Fill value, only the low byte is used
+  * @param[in]  u32Len      Number of bytes
+  *
+  * @return     None
+  *
+  * @details    The aligned part is filled with 16-byte bursts of word stores.
+  */
+void EBI_MemSet(void *pvDst, uint32_t u32Value, uint32_t u32Len)
+{
+    uint8_t *pu8Dst = (uint8_t *)pvDst;
+    uint32_t *pu32Dst;
+
+    u32Value = (u32Value & 0xFF) * 0x01010101UL;
+
+    if(u32Len >= 8)
+    {
+        if((uint32_t)pu8Dst & 1)
+        {
+            *pu8Dst++ = (uint8_t)u32Value;
+            u32Len--;
+        }
+        if((uint32_t)pu8Dst & 2)
+        {
+            *(uint16_t *)pu8Dst = (uint16_t)u32Value;
+            pu8Dst += 2;
+            u32Len -= 2;
+        }
+
+        pu32Dst = (uint32_t *)pu8Dst;
+        for(; u32Len >= 16; u32Len -= 16)
+        {
+            pu32Dst[0] = u32Value;
+            pu32Dst[1] = u32Value;
+            pu32Dst[2] = u32Value;
+            pu32Dst[3] = u32Value;
+            pu32Dst += 4;
+        }
+        for(; u32Len >= 4; u32Len -= 4)
+            *pu32Dst++ = u32Value;
+
+        pu8Dst = (uint8_t *)pu32Dst;
+        if(u32Len >= 2)
+        {
+            *(uint16_t *)pu8Dst = (uint16_t)u32Value;
+            pu8Dst += 2;
+            u32Len -= 2;
+        }
+    }
+
+    while(u32Len--)
+        *pu8Dst++ = (uint8_t)u32Value;
+}
+
+/**
+  * @brief      Compare memory, optimized for EBI
+  *
+  * @param[in]  pv1         First buffer
+  * @param[in]  pv2         Second buffer
+  * @param[in]  u32Len      Number of bytes
+  *
+  * @retval     0           Buffers are equal
+  * @retval     <0 or >0    Difference of the first differing bytes, as memcmp()
+  *
+  * @details    Buffers with the same word or halfword alignment are compared by words or halfwords until
+  *             a difference is found, then the differing unit is compared by bytes.
+  */
+int32_t EBI_MemCmp(const void *pv1, const void *pv2, uint32_t u32Len)
+{
+    const uint8_t *pu81 = (const uint8_t *)pv1;
+    const uint8_t *pu82 = (const uint8_t *)pv2;
+    const uint32_t *pu321, *pu322;
+    const uint16_t *pu161, *pu162;
+
+    if(u32Len >= 8)
+    {
+        if((((uint32_t)pu81 ^ (uint32_t)pu82) & 3) == 0)
+        {
+            while((uint32_t)pu81 & 3)
+            {
+                if(*pu81 != *pu82)
+                    return (int32_t) * pu81 - (int32_t) * pu82;
+                pu81++;
+                pu82++;
+                u32Len--;
+            }
+
+            pu321 = (const uint32_t *)pu81;
+            pu322 = (const uint32_t *)pu82;
+            while((u32Len >= 4) && (*pu321 == *pu322))
+            {
+                pu321++;
+                pu322++;
+                u32Len -= 4;
+            }
+            pu81 = (const uint8_t *)pu321;
+            pu82 = (const uint8_t *)pu322;
+        }
+        else if((((uint32_t)pu81 ^ (uint32_t)pu82) & 1) == 0)
+        {
+            if((uint32_t)pu81 & 1)
+            {
+                if(*pu81 != *pu82)
+                    return (int32_t) * pu81 - (int32_t) * pu82;
+                pu81++;
+                pu82++;
+                u32Len--;
+            }
+
+            pu161 = (const uint16_t *)pu81;
+            pu162 = (const uint16_t *)pu82;
+            while((u32Len >= 2) && (*pu161 == *pu162))
+            {
+                pu161++;
+                pu162++;
+                u32Len -= 2;
+            }
+            pu81 = (const uint8_t *)pu161;
+            pu82 = (const uint8_t *)pu162;
+        }
+    }
+
+    for(; u32Len; u32Len--)
+    {
+        if(*pu81 != *pu82)
+            return (int32_t) * pu81 - (int32_t) * pu82;
+        pu81++;
+        pu82++;
+    }
+
+    return 0;
+}
+
 /*@}*/ /* end of group NUC029_EBI_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group NUC029_EBI_Driver */
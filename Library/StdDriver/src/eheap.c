@@ -0,0 +1,611 @@
+/**************************************************************************//**
+ * @file     eheap.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/06 2:15p $
+ * @brief    NUC029 series external SRAM heap source file
+ *
+ * @note     The heap area, normally in the EBI window, is split into segregated fixed-size pools for small
+ *           objects and a TLSF (two-level segregated fit) area for everything else. A small fast pool in
+ *           internal SRAM serves latency-critical requests. Allocation and free take bounded time and are
+ *           protected by PRIMASK, so they may be called from interrupt handlers.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stddef.h>
+#include "NUC029xAN.h"
+
+#if (EHEAP_POOL_NUM < 0) || (EHEAP_POOL_NUM > 8)
+#error "EHEAP_POOL_NUM must be 0 ~ 8"
+#endif
+
+#if (EHEAP_FAST_SIZE & 3) || (EHEAP_FAST_SIZE < 4)
+#error "EHEAP_FAST_SIZE must be a multiple of 4"
+#endif
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_EHEAP_Driver EHEAP Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+/*
+ * TLSF geometry. The first level splits sizes by power of two, the second level splits each power of two
+ * range into EHEAP_SL_NUM lists. Sizes below EHEAP_SMALL fall into first level 0 with 4 byte steps.
+ * EHEAP_FL_NUM covers blocks up to 128 KB, the whole EBI window.
+ */
+#define EHEAP_SL_SHIFT      3
+#define EHEAP_SL_NUM        (1UL << EHEAP_SL_SHIFT)
+#define EHEAP_FL_SHIFT      (EHEAP_SL_SHIFT + 2)
+#define EHEAP_SMALL         (1UL << EHEAP_FL_SHIFT)
+#define EHEAP_FL_NUM        13
+#define EHEAP_MAX_BLOCK     ((1UL << (EHEAP_FL_NUM + EHEAP_FL_SHIFT - 1)) - 4)
+
+/* Low bits of u32Size */
+#define EHEAP_BLK_FREE      BIT0
+#define EHEAP_BLK_PREV_FREE BIT1
+#define EHEAP_BLK_SIZE(b)   ((b)->u32Size & ~3UL)
+
+typedef struct EHEAP_BLK
+{
+    struct EHEAP_BLK *psPrevPhys;   /* Previous block in memory */
+    uint32_t u32Size;               /* Payload size | EHEAP_BLK_xxx */
+    struct EHEAP_BLK *psNextFree;   /* Free list links, only valid while block is free */
+    struct EHEAP_BLK *psPrevFree;
+} EHEAP_BLK_T;
+
+#define EHEAP_HDR           offsetof(EHEAP_BLK_T, psNextFree)               /* Header in front of payload, 8 bytes */
+#define EHEAP_MIN           (sizeof(EHEAP_BLK_T) - EHEAP_HDR)               /* Minimum payload, holds free list links */
+
+#define EHEAP_NEXT_PHYS(b)  ((EHEAP_BLK_T *)((uint8_t *)(b) + EHEAP_HDR + EHEAP_BLK_SIZE(b)))
+#define EHEAP_PAYLOAD(b)    ((void *)((uint8_t *)(b) + EHEAP_HDR))
+#define EHEAP_BLOCK(p)      ((EHEAP_BLK_T *)((uint8_t *)(p) - EHEAP_HDR))
+
+/* Kept at the start of the heap area to save internal SRAM */
+typedef struct
+{
+    uint32_t u32FlMap;
+    uint8_t au8SlMap[EHEAP_FL_NUM];
+    EHEAP_BLK_T *apsFree[EHEAP_FL_NUM][EHEAP_SL_NUM];
+} EHEAP_CTRL_T;
+
+static EHEAP_CTRL_T *s_psEheapCtrl = NULL;
+static EHEAP_BLK_T *s_psEheapFirst;
+static POOL_T s_asEheapPool[EHEAP_POOL_NUM + 1];  /* Last one is the fast pool */
+static EHEAP_STATS_T s_sEheapStats;
+
+#if (EHEAP_FAST_BLOCKS > 0)
+static uint32_t s_au32EheapFast[EHEAP_FAST_BLOCKS * EHEAP_FAST_SIZE / 4];
+#endif
+
+/* Cortex-M0 has no CLZ. Bit index by de Bruijn multiply, constant time. */
+static const uint8_t s_au8EheapLsb[32] =
+{
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+static const uint8_t s_au8EheapMsb[32] =
+{
+    0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+    8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+};
+
+#define EHEAP_LSB(x)        (s_au8EheapLsb[(uint32_t)(((x) & (0UL - (x))) * 0x077CB531UL) >> 27])
+
+static uint32_t EHEAP_Msb(uint32_t x)
+{
+    /* Set all bits below the highest one */
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    return s_au8EheapMsb[(uint32_t)(x * 0x07C4ACDDUL) >> 27];
+}
+
+static void EHEAP_Mapping(uint32_t u32Size, uint32_t *pu32Fl, uint32_t *pu32Sl)
+{
+    uint32_t u32Msb;
+
+    if(u32Size < EHEAP_SMALL)
+    {
+        *pu32Fl = 0;
+        *pu32Sl = u32Size >> 2;
+    }
+    else
+    {
+        u32Msb = EHEAP_Msb(u32Size);
+        *pu32Sl = (u32Size >> (u32Msb - EHEAP_SL_SHIFT)) ^ EHEAP_SL_NUM;
+        *pu32Fl = u32Msb - EHEAP_FL_SHIFT + 1;
+    }
+}
+
+static void EHEAP_Insert(EHEAP_BLK_T *psBlk)
+{
+    EHEAP_CTRL_T *psCtrl = s_psEheapCtrl;
+    uint32_t u32Fl, u32Sl;
+
+    EHEAP_Mapping(EHEAP_BLK_SIZE(psBlk), &u32Fl, &u32Sl);
+
+    psBlk->psPrevFree = NULL;
+    psBlk->psNextFree = psCtrl->apsFree[u32Fl][u32Sl];
+    if(psBlk->psNextFree != NULL)
+        psBlk->psNextFree->psPrevFree = psBlk;
+    psCtrl->apsFree[u32Fl][u32Sl] = psBlk;
+
+    psCtrl->au8SlMap[u32Fl] |= (uint8_t)(1UL << u32Sl);
+    psCtrl->u32FlMap |= (1UL << u32Fl);
+
+    s_sEheapStats.u32Free += EHEAP_BLK_SIZE(psBlk);
+    s_sEheapStats.u32FreeBlocks++;
+}
+
+static void EHEAP_Remove(EHEAP_BLK_T *psBlk)
+{
+    EHEAP_CTRL_T *psCtrl = s_psEheapCtrl;
+    uint32_t u32Fl, u32Sl;
+
+    EHEAP_Mapping(EHEAP_BLK_SIZE(psBlk), &u32Fl, &u32Sl);
+
+    if(psBlk->psNextFree != NULL)
+        psBlk->psNextFree->psPrevFree = psBlk->psPrevFree;
+    if(psBlk->psPrevFree != NULL)
+        psBlk->psPrevFree->psNextFree = psBlk->psNextFree;
+    else
+    {
+        psCtrl->apsFree[u32Fl][u32Sl] = psBlk->psNextFree;
+        if(psBlk->psNextFree == NULL)
+        {
+            psCtrl->au8SlMap[u32Fl] &= (uint8_t)~(1UL << u32Sl);
+            if(psCtrl->au8SlMap[u32Fl] == 0)
+                psCtrl->u32FlMap &= ~(1UL << u32Fl);
+        }
+    }
+
+    s_sEheapStats.u32Free -= EHEAP_BLK_SIZE(psBlk);
+    s_sEheapStats.u32FreeBlocks--;
+}
+
+static void *EHEAP_TlsfAlloc(uint32_t u32Size)
+{
+    EHEAP_CTRL_T *psCtrl = s_psEheapCtrl;
+    EHEAP_BLK_T *psBlk, *psRem;
+    uint32_t u32Search, u32Fl, u32Sl, u32Map;
+
+    u32Size = (u32Size + 3) & ~3UL;
+    if(u32Size < EHEAP_MIN)
+        u32Size = EHEAP_MIN;
+    if(u32Size > EHEAP_MAX_BLOCK)
+        return NULL;
+
+    /* Round up to the next list so that any block found is large enough */
+    u32Search = u32Size;
+    if(u32Search >= EHEAP_SMALL)
+        u32Search += (1UL << (EHEAP_Msb(u32Search) - EHEAP_SL_SHIFT)) - 1;
+    EHEAP_Mapping(u32Search, &u32Fl, &u32Sl);
+
+    psBlk = NULL;
+    if(u32Fl < EHEAP_FL_NUM)
+    {
+        u32Map = psCtrl->au8SlMap[u32Fl] & (~0UL << u32Sl);
+        if(u32Map == 0)
+        {
+            u32Map = psCtrl->u32FlMap & (~0UL << (u32Fl + 1));
+            if(u32Map != 0)
+            {
+                u32Fl = EHEAP_LSB(u32Map);
+                u32Map = psCtrl->au8SlMap[u32Fl];
+            }
+        }
+        if(u32Map != 0)
+            psBlk = psCtrl->apsFree[u32Fl][EHEAP_LSB(u32Map)];
+    }
+
+    if(psBlk == NULL)
+    {
+        /* Nothing in larger lists. The head of the list holding u32Size may still be large enough. */
+        EHEAP_Mapping(u32Size, &u32Fl, &u32Sl);
+        psBlk = psCtrl->apsFree[u32Fl][u32Sl];
+        if((psBlk == NULL) || (EHEAP_BLK_SIZE(psBlk) < u32Size))
+            return NULL;
+    }
+
+    EHEAP_Remove(psBlk);
+
+    if(EHEAP_BLK_SIZE(psBlk) >= u32Size + EHEAP_HDR + EHEAP_MIN)
+    {
+        /* Split, the remainder stays free. Next block already has EHEAP_BLK_PREV_FREE set. */
+        psRem = (EHEAP_BLK_T *)((uint8_t *)EHEAP_PAYLOAD(psBlk) + u32Size);
+        psRem->u32Size = (EHEAP_BLK_SIZE(psBlk) - u32Size - EHEAP_HDR) | EHEAP_BLK_FREE;
+        psRem->psPrevPhys = psBlk;
+        EHEAP_NEXT_PHYS(psRem)->psPrevPhys = psRem;
+        psBlk->u32Size = u32Size | (psBlk->u32Size & EHEAP_BLK_PREV_FREE);
+        EHEAP_Insert(psRem);
+    }
+    else
+    {
+        psBlk->u32Size &= ~EHEAP_BLK_FREE;
+        EHEAP_NEXT_PHYS(psBlk)->u32Size &= ~EHEAP_BLK_PREV_FREE;
+    }
+
+    s_sEheapStats.u32UsedBlocks++;
+    if(s_sEheapStats.u32Free < s_sEheapStats.u32MinFree)
+        s_sEheapStats.u32MinFree = s_sEheapStats.u32Free;
+
+    return EHEAP_PAYLOAD(psBlk);
+}
+
+static void EHEAP_TlsfFree(void *pvPtr)
+{
+    EHEAP_BLK_T *psBlk = EHEAP_BLOCK(pvPtr);
+    EHEAP_BLK_T *psNext = EHEAP_NEXT_PHYS(psBlk);
+    EHEAP_BLK_T *psPrev;
+
+    s_sEheapStats.u32UsedBlocks--;
+
+    /* Merge with free neighbours, two free blocks are never adjacent */
+    if(psBlk->u32Size & EHEAP_BLK_PREV_FREE)
+    {
+        psPrev = psBlk->psPrevPhys;
+        EHEAP_Remove(psPrev);
+        psPrev->u32Size += EHEAP_HDR + EHEAP_BLK_SIZE(psBlk);
+        psBlk = psPrev;
+    }
+    if(psNext->u32Size & EHEAP_BLK_FREE)
+    {
+        EHEAP_Remove(psNext);
+        psBlk->u32Size += EHEAP_HDR + EHEAP_BLK_SIZE(psNext);
+        psNext = EHEAP_NEXT_PHYS(psBlk);
+    }
+
+    psBlk->u32Size |= EHEAP_BLK_FREE;
+    psNext->psPrevPhys = psBlk;
+    psNext->u32Size |= EHEAP_BLK_PREV_FREE;
+    EHEAP_Insert(psBlk);
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_EHEAP_EXPORTED_FUNCTIONS EHEAP Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Initialize heap
+  *
+  * @param[in]  pvBase      Start of heap area, e.g. EBI_BASE_ADDR or an array declared with \ref EBI_RAM_SECTION
+  * @param[in]  u32Size     Size of heap area in bytes
+  *
+  * @retval     0   Success
+  * @retval     -1  Area too small for control data and pools
+  *
+  * @details    The area holds TLSF control data (about 430 bytes), then \ref EHEAP_POOL_NUM pools of
+  *             \ref EHEAP_POOL_BLOCKS blocks each, then the TLSF area. EBI must be opened before calling this
+  *             function. All previous allocations are discarded.
+  */
+int32_t EHEAP_Init(void *pvBase, uint32_t u32Size)
+{
+    uint8_t *pu8Addr = (uint8_t *)(((uintptr_t)pvBase + 3) & ~(uintptr_t)3);
+    uint8_t *pu8End = (uint8_t *)(((uintptr_t)pvBase + u32Size) & ~(uintptr_t)3);
+    EHEAP_CTRL_T *psCtrl;
+    EHEAP_BLK_T *psBlk, *psLast;
+    EHEAP_STATS_T sZero = {0};
+    uint32_t u32Pool, u32PriMask, u32Avail, i, j;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    s_psEheapCtrl = NULL;
+    s_sEheapStats = sZero;
+
+    /* Control data */
+    psCtrl = (EHEAP_CTRL_T *)pu8Addr;
+    pu8Addr += (sizeof(EHEAP_CTRL_T) + 3) & ~3UL;
+
+    /* Segregated pools */
+    for(u32Pool = 0; u32Pool < EHEAP_POOL_NUM; u32Pool++)
+    {
+        if(pu8Addr + ((16UL << u32Pool) * EHEAP_POOL_BLOCKS) > pu8End)
+        {
+            __set_PRIMASK(u32PriMask);
+            return -1;
+        }
+        POOL_Init(&s_asEheapPool[u32Pool], pu8Addr, 16UL << u32Pool, EHEAP_POOL_BLOCKS);
+        pu8Addr += (16UL << u32Pool) * EHEAP_POOL_BLOCKS;
+    }
+
+#if (EHEAP_FAST_BLOCKS > 0)
+    POOL_Init(&s_asEheapPool[EHEAP_POOL_NUM], s_au32EheapFast, EHEAP_FAST_SIZE, EHEAP_FAST_BLOCKS);
+#else
+    POOL_Init(&s_asEheapPool[EHEAP_POOL_NUM], NULL, EHEAP_FAST_SIZE, 0);
+#endif
+
+    /* TLSF area: one free block followed by a zero size sentinel that is never free */
+    u32Avail = (uint32_t)(pu8End - pu8Addr);
+    if((pu8Addr > pu8End) || (u32Avail < 2 * EHEAP_HDR + EHEAP_MIN))
+    {
+        __set_PRIMASK(u32PriMask);
+        return -1;
+    }
+    if(u32Avail > EHEAP_MAX_BLOCK + 2 * EHEAP_HDR)
+        u32Avail = EHEAP_MAX_BLOCK + 2 * EHEAP_HDR;
+
+    psCtrl->u32FlMap = 0;
+    for(i = 0; i < EHEAP_FL_NUM; i++)
+    {
+        psCtrl->au8SlMap[i] = 0;
+        for(j = 0; j < EHEAP_SL_NUM; j++)
+            psCtrl->apsFree[i][j] = NULL;
+    }
+    s_psEheapCtrl = psCtrl;
+
+    psBlk = (EHEAP_BLK_T *)pu8Addr;
+    psBlk->psPrevPhys = NULL;
+    psBlk->u32Size = (u32Avail - 2 * EHEAP_HDR) | EHEAP_BLK_FREE;
+    psLast = EHEAP_NEXT_PHYS(psBlk);
+    psLast->psPrevPhys = psBlk;
+    psLast->u32Size = EHEAP_BLK_PREV_FREE;
+    s_psEheapFirst = psBlk;
+
+    EHEAP_Insert(psBlk);
+    s_sEheapStats.u32Size = u32Avail;
+    s_sEheapStats.u32MinFree = s_sEheapStats.u32Free;
+
+    __set_PRIMASK(u32PriMask);
+
+    return 0;
+}
+
+/**
+  * @brief      Allocate memory
+  *
+  * @param[in]  u32Size     Requested size in bytes
+  * @param[in]  u32Flags    Combination of \ref EHEAP_FLAG_FAST and \ref EHEAP_FLAG_NOPOOL, or 0
+  *
+  * @return     Pointer aligned to 4 bytes, NULL if no memory
+  *
+  * @details    Requests up to \ref EHEAP_POOL_MAX_SIZE are served by the smallest fitting pool. If that
+  *             pool is empty, or the request is larger, the TLSF area is used. With \ref EHEAP_FLAG_FAST,
+  *             requests up to \ref EHEAP_FAST_SIZE try the internal SRAM fast pool first.
+  *             Execution time is bounded and does not depend on the number of allocations.
+  *             Can be called from interrupt handlers.
+  */
+void *EHEAP_Alloc(uint32_t u32Size, uint32_t u32Flags)
+{
+    void *pvPtr = NULL;
+    uint32_t u32Pool, u32PriMask;
+
+    if((u32Size == 0) || (s_psEheapCtrl == NULL))
+        return NULL;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    if((u32Flags & EHEAP_FLAG_FAST) && (u32Size <= EHEAP_FAST_SIZE))
+        pvPtr = POOL_Alloc(&s_asEheapPool[EHEAP_POOL_NUM]);
+
+    if((pvPtr == NULL) && !(u32Flags & EHEAP_FLAG_NOPOOL) && (u32Size <= EHEAP_POOL_MAX_SIZE))
+    {
+        for(u32Pool = 0; (16UL << u32Pool) < u32Size; u32Pool++);
+        pvPtr = POOL_Alloc(&s_asEheapPool[u32Pool]);
+    }
+
+    if(pvPtr == NULL)
+    {
+        pvPtr = EHEAP_TlsfAlloc(u32Size);
+        if(pvPtr == NULL)
+            s_sEheapStats.u32Fail++;
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    return pvPtr;
+}
+
+/**
+  * @brief      Free memory
+  *
+  * @param[in]  pvPtr       Pointer returned by \ref EHEAP_Alloc, or NULL
+  *
+  * @return     None
+  *
+  * @details    The owner pool is found from the address. Adjacent free TLSF blocks are merged at once.
+  *             Can be called from interrupt handlers.
+  */
+void EHEAP_Free(void *pvPtr)
+{
+    uint32_t u32Pool, u32PriMask;
+
+    if((pvPtr == NULL) || (s_psEheapCtrl == NULL))
+        return;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    for(u32Pool = 0; u32Pool <= EHEAP_POOL_NUM; u32Pool++)
+    {
+        if(POOL_IS_BLOCK(&s_asEheapPool[u32Pool], pvPtr))
+        {
+            POOL_Free(&s_asEheapPool[u32Pool], pvPtr);
+            break;
+        }
+    }
+
+    if(u32Pool > EHEAP_POOL_NUM)
+        EHEAP_TlsfFree(pvPtr);
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Get statistics of a fixed-size pool
+  *
+  * @param[in]  u32Pool     Pool index, 0 ~ (\ref EHEAP_POOL_NUM - 1). \ref EHEAP_POOL_NUM is the fast pool.
+  * @param[out] psStats     Statistics
+  *
+  * @retval     0   Success
+  * @retval     -1  Pool index out of range
+  */
+int32_t EHEAP_GetPoolStats(uint32_t u32Pool, EHEAP_POOL_STATS_T *psStats)
+{
+    POOL_T *psPool;
+    uint32_t u32PriMask;
+
+    if(u32Pool > EHEAP_POOL_NUM)
+        return -1;
+
+    psPool = &s_asEheapPool[u32Pool];
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    psStats->u32BlockSize = psPool->u16BlockSize;
+    psStats->u32Blocks = psPool->u16Blocks;
+    psStats->u32Used = psPool->u16Used;
+    psStats->u32Peak = psPool->u16Peak;
+    psStats->u32Fail = psPool->u32Fail;
+    __set_PRIMASK(u32PriMask);
+
+    return 0;
+}
+
+/**
+  * @brief      Get statistics of TLSF area
+  *
+  * @param[out] psStats     Statistics
+  *
+  * @return     None
+  *
+  * @details    The largest free block is searched in the highest non-empty free list only, so the time
+  *             depends on the length of that list. Do not call from time critical code.
+  */
+void EHEAP_GetStats(EHEAP_STATS_T *psStats)
+{
+    EHEAP_CTRL_T *psCtrl = s_psEheapCtrl;
+    EHEAP_BLK_T *psBlk;
+    uint32_t u32Fl, u32Sl, u32Largest = 0, u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    *psStats = s_sEheapStats;
+
+    if((psCtrl != NULL) && (psCtrl->u32FlMap != 0))
+    {
+        u32Fl = EHEAP_Msb(psCtrl->u32FlMap);
+        u32Sl = EHEAP_Msb(psCtrl->au8SlMap[u32Fl]);
+        for(psBlk = psCtrl->apsFree[u32Fl][u32Sl]; psBlk != NULL; psBlk = psBlk->psNextFree)
+        {
+            if(EHEAP_BLK_SIZE(psBlk) > u32Largest)
+                u32Largest = EHEAP_BLK_SIZE(psBlk);
+        }
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    psStats->u32LargestFree = u32Largest;
+    psStats->u32Frag = (psStats->u32Free == 0) ? 0 : (100 - (u32Largest * 100) / psStats->u32Free);
+}
+
+/**
+  * @brief      Check heap consistency
+  *
+  * @param      None
+  *
+  * @retval     0   Heap is consistent
+  * @retval     -1  Block headers or free lists are corrupted
+  *
+  * @details    Walk all TLSF blocks and free lists. Interrupts are disabled during the walk, which takes time
+  *             proportional to the number of blocks. Intended for debugging.
+  */
+int32_t EHEAP_Check(void)
+{
+    EHEAP_CTRL_T *psCtrl = s_psEheapCtrl;
+    EHEAP_BLK_T *psBlk, *psPrev = NULL;
+    uint32_t u32Fl, u32Sl, u32FreeBlk = 0, u32UsedBlk = 0, u32Free = 0, u32ListBlk = 0;
+    uint32_t u32PrevFree = 0, u32PriMask;
+    int32_t i32Ret = 0;
+
+    if(psCtrl == NULL)
+        return -1;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    /* Physical order. Sentinel has size 0. */
+    for(psBlk = s_psEheapFirst; ; psBlk = EHEAP_NEXT_PHYS(psBlk))
+    {
+        if((psBlk->psPrevPhys != psPrev) || (((psBlk->u32Size & EHEAP_BLK_PREV_FREE) != 0) != u32PrevFree))
+        {
+            i32Ret = -1;
+            break;
+        }
+        if(EHEAP_BLK_SIZE(psBlk) == 0)
+            break;
+        if((uint8_t *)EHEAP_NEXT_PHYS(psBlk) > (uint8_t *)s_psEheapFirst + s_sEheapStats.u32Size)
+        {
+            i32Ret = -1;
+            break;
+        }
+
+        u32PrevFree = ((psBlk->u32Size & EHEAP_BLK_FREE) != 0);
+        if(u32PrevFree)
+        {
+            if(psBlk->u32Size & EHEAP_BLK_PREV_FREE)
+            {
+                i32Ret = -1;
+                break;
+            }
+            u32FreeBlk++;
+            u32Free += EHEAP_BLK_SIZE(psBlk);
+        }
+        else
+            u32UsedBlk++;
+        psPrev = psBlk;
+    }
+
+    /* Free lists and bitmaps */
+    for(u32Fl = 0; (i32Ret == 0) && (u32Fl < EHEAP_FL_NUM); u32Fl++)
+    {
+        if(((psCtrl->u32FlMap >> u32Fl) & 1) != (psCtrl->au8SlMap[u32Fl] != 0))
+            i32Ret = -1;
+
+        for(u32Sl = 0; u32Sl < EHEAP_SL_NUM; u32Sl++)
+        {
+            if(((psCtrl->au8SlMap[u32Fl] >> u32Sl) & 1) != (psCtrl->apsFree[u32Fl][u32Sl] != NULL))
+                i32Ret = -1;
+
+            for(psBlk = psCtrl->apsFree[u32Fl][u32Sl]; (psBlk != NULL) && (u32ListBlk <= u32FreeBlk); psBlk = psBlk->psNextFree)
+            {
+                uint32_t u32BlkFl, u32BlkSl;
+
+                EHEAP_Mapping(EHEAP_BLK_SIZE(psBlk), &u32BlkFl, &u32BlkSl);
+                if(!(psBlk->u32Size & EHEAP_BLK_FREE) || (u32BlkFl != u32Fl) || (u32BlkSl != u32Sl))
+                    i32Ret = -1;
+                u32ListBlk++;
+            }
+        }
+    }
+
+    if((u32ListBlk != u32FreeBlk) || (u32FreeBlk != s_sEheapStats.u32FreeBlocks) ||
+            (u32UsedBlk != s_sEheapStats.u32UsedBlocks) || (u32Free != s_sEheapStats.u32Free))
+        i32Ret = -1;
+
+    __set_PRIMASK(u32PriMask);
+
+    return i32Ret;
+}
+
+/*@}*/ /* end of group NUC029_EHEAP_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_EHEAP_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -24,6 +24,42 @@
 
 int32_t g_FMC_i32ErrCode = 0; /*!< FMC global error code */
 
+/** @cond HIDDEN_SYMBOLS */
+
+/* Program loop of FMC_WriteMultiple. Runs from SRAM and touches FMC registers only, so the CPU keeps going
+   while the flash is busy. ISPCMD stays set for all words, erased words are not programmed. */
+static FMC_RAMFUNC int32_t FMC_ProgramWords(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Words, uint32_t u32TimeOut)
+{
+    uint32_t u32Data, u32TimeOutCnt;
+    int32_t i32Cnt = 0;
+
+    FMC->ISPCMD = FMC_ISPCMD_PROGRAM;
+
+    for(; u32Words; u32Words--, u32Addr += 4)
+    {
+        u32Data = *pu32Buf++;
+        if(u32Data == 0xFFFFFFFF)
+            continue;
+
+        FMC->ISPADR = u32Addr;
+        FMC->ISPDAT = u32Data;
+        FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+        __ISB();
+
+        u32TimeOutCnt = u32TimeOut;
+        while(FMC->ISPTRG)
+        {
+            if(--u32TimeOutCnt == 0)
+                return -1;
+        }
+        i32Cnt++;
+    }
+
+    return i32Cnt;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
 /** @addtogroup NUC029_FMC_EXPORTED_FUNCTIONS FMC Exported Functions
   @{
 */
@@ -237,7 +273,7 @@ uint32_t FMC_ReadDataFlashBaseAddr(void)
   */
 int32_t FMC_ReadConfig(uint32_t *u32Config, uint32_t u32Count)
 {
-    int32_t i;
+    uint32_t i;
 
     g_FMC_i32ErrCode = 0;
 
@@ -270,7 +306,7 @@ int32_t FMC_ReadConfig(uint32_t *u32Config, uint32_t u32Count)
   */
 int32_t FMC_WriteConfig(uint32_t *u32Config, uint32_t u32Count)
 {
-    int32_t i;
+    uint32_t i;
 
     g_FMC_i32ErrCode = 0;
 
@@ -286,6 +322,91 @@ int32_t FMC_WriteConfig(uint32_t *u32Config, uint32_t u32Count)
     return 0;
 }
 
+/**
+  * @brief      Program consecutive words of flash
+  *
+  * @param[in]  u32Addr     Start address, word aligned. Flash must be erased.
+  * @param[in]  pu32Buf     Word buffer with the data to program
+  * @param[in]  u32Len      Length in bytes, multiple of 4
+  * @param[in]  u32Flags    0 or \ref FMC_WRITE_VERIFY
+  *
+  * @return     Number of words programmed, -1 if failed
+  *
+  * @details    ISP command is set once and the words are streamed by a loop in SRAM. Words of 0xFFFFFFFF
+  *             are left out since erased flash already holds them, so the count can be less than u32Len / 4.
+  *             With \ref FMC_WRITE_VERIFY the whole range is compared with the buffer by reading the memory
+  *             map, which is valid for APROM and Data Flash but not for LDROM or User Configuration.
+  *             The matching update function like \ref FMC_ENABLE_AP_UPDATE must be called first.
+  *             Interrupt handlers in flash stall until the current word is programmed.
+  *
+  * @note       Global error code g_FMC_i32ErrCode
+  *             -1  Program failed or time-out
+  *             -2  Verify failed
+  */
+int32_t FMC_WriteMultiple(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len, uint32_t u32Flags)
+{
+    int32_t i32Cnt;
+    uint32_t i;
+
+    TRACE_DRV_ENTER(TRACE_ID_FMC_WRITE, u32Addr >> 9);
+
+    g_FMC_i32ErrCode = 0;
+
+    FMC->ISPCON |= FMC_ISPCON_ISPFF_Msk;    /* Clear fail flag of an earlier command */
+
+    i32Cnt = FMC_ProgramWords(u32Addr, pu32Buf, u32Len / 4, FMC_TIMEOUT_WRITE);
+    if((i32Cnt < 0) || FMC_GET_FAIL_FLAG())
+    {
+        FMC->ISPCON |= FMC_ISPCON_ISPFF_Msk;
+        g_FMC_i32ErrCode = -1;
+        TRACE_DRV_EXIT(TRACE_ID_FMC_WRITE, -1);
+        return -1;
+    }
+
+    if(u32Flags & FMC_WRITE_VERIFY)
+    {
+        for(i = 0; i < u32Len / 4; i++)
+        {
+            if(M32(u32Addr + i * 4) != pu32Buf[i])
+            {
+                g_FMC_i32ErrCode = -2;
+                TRACE_DRV_EXIT(TRACE_ID_FMC_WRITE, -2);
+                return -1;
+            }
+        }
+    }
+
+    TRACE_DRV_EXIT(TRACE_ID_FMC_WRITE, i32Cnt);
+    return i32Cnt;
+}
+
+
+/**
+  * @brief      Program one flash page
+  *
+  * @param[in]  u32PageAddr Page address, multiple of \ref FMC_FLASH_PAGE_SIZE. Page must be erased.
+  * @param[in]  pu32Buf     Buffer of FMC_FLASH_PAGE_SIZE bytes
+  * @param[in]  u32Flags    0 or \ref FMC_WRITE_VERIFY
+  *
+  * @return     Number of words programmed, -1 if failed
+  *
+  * @details    See \ref FMC_WriteMultiple.
+  *
+  * @note       Global error code g_FMC_i32ErrCode
+  *             -1  Program failed, time-out or address not page aligned
+  *             -2  Verify failed
+  */
+int32_t FMC_WritePage(uint32_t u32PageAddr, const uint32_t *pu32Buf, uint32_t u32Flags)
+{
+    if(u32PageAddr & (FMC_FLASH_PAGE_SIZE - 1))
+    {
+        g_FMC_i32ErrCode = -1;
+        return -1;
+    }
+
+    return FMC_WriteMultiple(u32PageAddr, pu32Buf, FMC_FLASH_PAGE_SIZE, u32Flags);
+}
+
 
 /*@}*/ /* end of group NUC029_FMC_EXPORTED_FUNCTIONS */
 
@@ -0,0 +1,348 @@
+/**************************************************************************//**
+ * @file     freq.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series frequency and duty meter source file
+ *
+ * @note     Low frequencies are measured by period. \ref FREQ_TIMER counts its module clock in continuous mode and
+ *           captures the counter on the TxEX pin, alternating between rising and falling edge so each capture
+ *           has a known edge. The compare match at 0xFFFFFF counts the wraps, which extends the 24-bit counter
+ *           to 32 bits and periods up to 85 s at 50 MHz.
+ *           Above \ref FREQ_SWITCH_HZ the edges come too fast for one interrupt each. The timer then counts the
+ *           rising edges on the Tx pin and \ref FREQ_GATE reads the count each \ref FREQ_GATE_MS.
+ *           Both write samples of events and time into a ring, \ref FREQ_Read averages them. The result is
+ *           exact to one timer clock over the periods averaged, or to one edge over the gates averaged.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_FREQ_Driver FREQ Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#if (FREQ_RING_SIZE & (FREQ_RING_SIZE - 1))
+#error "FREQ_RING_SIZE must be a power of 2"
+#endif
+
+#define FREQ_COUNTER_MAX    0xFFFFFF
+#define FREQ_FAST_PERIODS   4       /* Short periods in a row before event counting */
+
+typedef struct
+{
+    uint32_t u32Events;             /* Periods or edges */
+    uint32_t u32Time;               /* In clocks of the measuring or the gate timer */
+    uint32_t u32High;               /* High time of the period, or FREQ_DUTY_UNKNOWN */
+} FREQ_SAMPLE_T;
+
+static FREQ_SAMPLE_T s_asFreqRing[FREQ_RING_SIZE];
+static uint32_t s_u32FreqHead;      /* Next sample written */
+static uint32_t s_u32FreqNum;       /* Samples in the ring */
+static uint32_t s_u32FreqMode;
+static uint32_t s_u32FreqClk;       /* Time unit of the samples in Hz */
+
+/* Period measurement */
+static uint32_t s_u32FreqWraps;     /* Upper bits of the counter */
+static uint32_t s_u32FreqRising;    /* Next capture is a rising edge */
+static uint32_t s_u32FreqPrimed;    /* s_u32FreqRise holds an edge */
+static uint32_t s_u32FreqRise;
+static uint32_t s_u32FreqHigh;      /* High time since s_u32FreqRise */
+static uint32_t s_u32FreqFast;
+static uint32_t s_u32FreqIdle;      /* Gates without a rising edge */
+
+/* Event counting */
+static uint32_t s_u32FreqLast;      /* Counter at the last gate */
+static uint32_t s_u32FreqSkip;      /* First gate after the switch is partial */
+static uint32_t s_u32FreqGateTicks;
+static uint32_t s_u32FreqGateClk;
+
+static void FREQ_Push(uint32_t u32Events, uint32_t u32Time, uint32_t u32High)
+{
+    FREQ_SAMPLE_T *psSample = &s_asFreqRing[s_u32FreqHead];
+
+    psSample->u32Events = u32Events;
+    psSample->u32Time = u32Time;
+    psSample->u32High = u32High;
+    s_u32FreqHead = (s_u32FreqHead + 1) & (FREQ_RING_SIZE - 1);
+    if(s_u32FreqNum < FREQ_RING_SIZE)
+        s_u32FreqNum++;
+}
+
+static void FREQ_SetMode(uint32_t u32Mode)
+{
+    FREQ_TIMER->TCSR = 0;
+    FREQ_TIMER->TEXCON = 0;
+    FREQ_TIMER->TCMPR = FREQ_COUNTER_MAX;
+    FREQ_TIMER->TISR = TIMER_TISR_TIF_Msk;
+    FREQ_TIMER->TEXISR = TIMER_TEXISR_TEXIF_Msk;
+
+    s_u32FreqMode = u32Mode;
+    s_u32FreqNum = 0;
+    s_u32FreqIdle = 0;
+
+    if(u32Mode == FREQ_MODE_PERIOD)
+    {
+        s_u32FreqClk = TIMER_GetModuleClock(FREQ_TIMER);
+        s_u32FreqRising = 1;
+        s_u32FreqPrimed = 0;
+        s_u32FreqFast = 0;
+
+        FREQ_TIMER->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_IE_Msk | TIMER_TCSR_TDR_EN_Msk;
+        TIMER_EnableCapture(FREQ_TIMER, TIMER_CAPTURE_FREE_COUNTING_MODE, TIMER_CAPTURE_RISING_EDGE);
+        TIMER_EnableCaptureInt(FREQ_TIMER);
+    }
+    else
+    {
+        s_u32FreqClk = s_u32FreqGateClk;
+        s_u32FreqSkip = 1;
+
+        FREQ_TIMER->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk;
+        TIMER_EnableEventCounter(FREQ_TIMER, TIMER_COUNTER_RISING_EDGE);
+    }
+
+    TIMER_Start(FREQ_TIMER);
+}
+
+static void FREQ_Edge(uint32_t u32Time)
+{
+    uint32_t u32Period;
+
+    if(s_u32FreqRising)
+    {
+        s_u32FreqRising = 0;
+        FREQ_TIMER->TEXCON = (FREQ_TIMER->TEXCON & ~TIMER_TEXCON_TEX_EDGE_Msk) | TIMER_CAPTURE_FALLING_EDGE;
+        s_u32FreqIdle = 0;
+
+        if(s_u32FreqPrimed)
+        {
+            u32Period = u32Time - s_u32FreqRise;
+            FREQ_Push(1, u32Period, s_u32FreqHigh);
+
+            if(u32Period >= s_u32FreqClk / FREQ_SWITCH_HZ)
+                s_u32FreqFast = 0;
+            else if(++s_u32FreqFast >= FREQ_FAST_PERIODS)
+            {
+                FREQ_SetMode(FREQ_MODE_COUNT);
+                return;
+            }
+        }
+
+        s_u32FreqRise = u32Time;
+        s_u32FreqHigh = FREQ_DUTY_UNKNOWN;
+        s_u32FreqPrimed = 1;
+    }
+    else
+    {
+        s_u32FreqRising = 1;
+        FREQ_TIMER->TEXCON = (FREQ_TIMER->TEXCON & ~TIMER_TEXCON_TEX_EDGE_Msk) | TIMER_CAPTURE_RISING_EDGE;
+        if(s_u32FreqPrimed)
+            s_u32FreqHigh = u32Time - s_u32FreqRise;
+    }
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_FREQ_EXPORTED_FUNCTIONS FREQ Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start measuring
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Starts in period measurement. The clocks of both timers and the Tx and TxEX pins of
+  *             \ref FREQ_TIMER are set up by the application, with the signal connected to both pins. A fast
+  *             timer clock such as HCLK gives the best resolution and the highest countable frequency. The IRQ
+  *             handlers must call \ref FREQ_TimerHandler and \ref FREQ_GateHandler.
+  *             Both handlers switch the mode and write the ring, so they must not preempt each other. The
+  *             priority of \ref FREQ_GATE_IRQn is set to the one of \ref FREQ_TIMER_IRQn here, change the two
+  *             together afterwards.
+  */
+void FREQ_Open(void)
+{
+    TIMER_Open(FREQ_GATE, TIMER_PERIODIC_MODE, 1000 / FREQ_GATE_MS);
+    s_u32FreqGateClk = TIMER_GetModuleClock(FREQ_GATE);
+    s_u32FreqGateTicks = FREQ_GATE->TCMPR * ((FREQ_GATE->TCSR & TIMER_TCSR_PRESCALE_Msk) + 1);
+    TIMER_EnableInt(FREQ_GATE);
+
+    s_u32FreqHead = 0;
+    FREQ_SetMode(FREQ_MODE_PERIOD);
+
+    NVIC_SetPriority(FREQ_GATE_IRQn, NVIC_GetPriority(FREQ_TIMER_IRQn));
+    NVIC_EnableIRQ(FREQ_TIMER_IRQn);
+    NVIC_EnableIRQ(FREQ_GATE_IRQn);
+    TIMER_Start(FREQ_GATE);
+}
+
+/**
+  * @brief      Stop measuring
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void FREQ_Close(void)
+{
+    NVIC_DisableIRQ(FREQ_TIMER_IRQn);
+    NVIC_DisableIRQ(FREQ_GATE_IRQn);
+    TIMER_Close(FREQ_TIMER);
+    TIMER_Close(FREQ_GATE);
+}
+
+/**
+  * @brief      Measuring timer interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref FREQ_TIMER. A capture taken in the same interrupt as
+  *             the wrap belongs after the wrap if the captured value is in the lower half of the counter.
+  *             Each edge must be at least the interrupt latency apart for the duty to be measured.
+  */
+void FREQ_TimerHandler(void)
+{
+    uint32_t u32Wraps = s_u32FreqWraps;
+    uint32_t u32Cap = 0, u32Captured = 0;
+
+    if(TIMER_GetCaptureIntFlag(FREQ_TIMER))
+    {
+        u32Cap = TIMER_GetCaptureData(FREQ_TIMER) & FREQ_COUNTER_MAX;
+        TIMER_ClearCaptureIntFlag(FREQ_TIMER);
+        u32Captured = 1;
+    }
+
+    if(TIMER_GetIntFlag(FREQ_TIMER))
+    {
+        TIMER_ClearIntFlag(FREQ_TIMER);
+        s_u32FreqWraps++;
+        if(u32Cap < (FREQ_COUNTER_MAX + 1) / 2)
+            u32Wraps++;
+    }
+
+    if(u32Captured && (s_u32FreqMode == FREQ_MODE_PERIOD))
+        FREQ_Edge((u32Wraps << 24) | u32Cap);
+}
+
+/**
+  * @brief      Gate timer interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref FREQ_GATE. Samples the edge count, switches back to
+  *             period measurement at low frequencies and clears the samples when the signal stops.
+  */
+void FREQ_GateHandler(void)
+{
+    uint32_t u32Count, u32Events;
+
+    TIMER_ClearIntFlag(FREQ_GATE);
+
+    if(s_u32FreqMode == FREQ_MODE_PERIOD)
+    {
+        if(++s_u32FreqIdle >= FREQ_TIMEOUT_MS / FREQ_GATE_MS)
+        {
+            s_u32FreqIdle = 0;
+            s_u32FreqNum = 0;
+            s_u32FreqPrimed = 0;
+        }
+        return;
+    }
+
+    u32Count = TIMER_GetCounter(FREQ_TIMER);
+    u32Events = (u32Count - s_u32FreqLast) & FREQ_COUNTER_MAX;
+    s_u32FreqLast = u32Count;
+    if(s_u32FreqSkip)
+    {
+        s_u32FreqSkip = 0;
+        return;
+    }
+
+    if(u32Events < FREQ_SWITCH_HZ / 2 * FREQ_GATE_MS / 1000)
+        FREQ_SetMode(FREQ_MODE_PERIOD);
+    else
+        FREQ_Push(u32Events, s_u32FreqGateTicks, FREQ_DUTY_UNKNOWN);
+}
+
+/**
+  * @brief      Read the frequency
+  *
+  * @param[out] psResult    Measurement
+  * @param[in]  u32Num      Latest samples to average, 0 for all in the ring
+  *
+  * @retval     0   Measured
+  * @retval     -1  No sample yet, or no signal for \ref FREQ_TIMEOUT_MS. The result is 0 Hz.
+  *
+  * @details    Samples are periods below \ref FREQ_SWITCH_HZ and gates above. The resolution is the frequency
+  *             change of one timer clock over all periods averaged, or of one edge over all gates averaged.
+  */
+int32_t FREQ_Read(FREQ_RESULT_T *psResult, uint32_t u32Num)
+{
+    FREQ_SAMPLE_T asSample[FREQ_RING_SIZE];
+    uint64_t u64Events = 0, u64Time = 0, u64High = 0;
+    uint32_t u32PriMask, u32Head, u32Clk, u32DutyValid = 1, i;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    if((u32Num == 0) || (u32Num > s_u32FreqNum))
+        u32Num = s_u32FreqNum;
+    u32Head = s_u32FreqHead;
+    for(i = 0; i < u32Num; i++)
+        asSample[i] = s_asFreqRing[(u32Head - 1 - i) & (FREQ_RING_SIZE - 1)];
+    psResult->u32Mode = s_u32FreqMode;
+    u32Clk = s_u32FreqClk;
+
+    __set_PRIMASK(u32PriMask);
+
+    psResult->u32Samples = u32Num;
+    psResult->u32Duty = FREQ_DUTY_UNKNOWN;
+    if(u32Num == 0)
+    {
+        psResult->u32MilliHz = 0;
+        psResult->u32ResMilliHz = 0;
+        return -1;
+    }
+
+    for(i = 0; i < u32Num; i++)
+    {
+        u64Events += asSample[i].u32Events;
+        u64Time += asSample[i].u32Time;
+        if(asSample[i].u32High == FREQ_DUTY_UNKNOWN)
+            u32DutyValid = 0;
+        else
+            u64High += asSample[i].u32High;
+    }
+
+    psResult->u32MilliHz = (uint32_t)((u64Events * u32Clk * 1000 + u64Time / 2) / u64Time);
+    if(psResult->u32Mode == FREQ_MODE_PERIOD)
+        psResult->u32ResMilliHz = (uint32_t)((psResult->u32MilliHz + u64Time - 1) / u64Time);
+    else
+        psResult->u32ResMilliHz = (uint32_t)(((uint64_t)u32Clk * 1000 + u64Time - 1) / u64Time);
+    if(u32DutyValid)
+        psResult->u32Duty = (uint32_t)((u64High * 10000 + u64Time / 2) / u64Time);
+
+    return 0;
+}
+
+/*@}*/ /* end of group NUC029_FREQ_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_FREQ_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -41,12 +41,15 @@ uint32_t I2C_Open(I2C_T *i2c, uint32_t u32BusClock)
 {
     uint32_t u32Div;
 
+    TRACE_DRV_ENTER(TRACE_ID_I2C_OPEN, u32BusClock / 1000);
+
     u32Div = (uint32_t)(((SystemCoreClock * 10) / (u32BusClock * 4) + 5) / 10 - 1); /* Compute proper divider for I2C clock */
     i2c->I2CLK = u32Div;
 
     /* Enable I2C */
     i2c->I2CON |= I2C_I2CON_ENS1_Msk;
 
+    TRACE_DRV_EXIT(TRACE_ID_I2C_OPEN, u32Div);
     return (SystemCoreClock / ((u32Div + 1) << 2));
 }
 
@@ -63,6 +66,8 @@ uint32_t I2C_Open(I2C_T *i2c, uint32_t u32BusClock)
 
 void I2C_Close(I2C_T *i2c)
 {
+    TRACE_DRV_ENTER(TRACE_ID_I2C_CLOSE, 0);
+
     /* Reset I2C Controller */
     if((uint32_t)i2c == I2C0_BASE)
     {
@@ -77,6 +82,8 @@ void I2C_Close(I2C_T *i2c)
 
     /* Disable I2C */
     i2c->I2CON &= ~I2C_I2CON_ENS1_Msk;
+
+    TRACE_DRV_EXIT(TRACE_ID_I2C_CLOSE, 0);
 }
 
 /**
@@ -184,9 +191,12 @@ uint32_t I2C_SetBusClockFreq(I2C_T *i2c, uint32_t u32BusClock)
 {
     uint32_t u32Div;
 
+    TRACE_DRV_ENTER(TRACE_ID_I2C_SETBUSCLOCK, u32BusClock / 1000);
+
     u32Div = (uint32_t)(((SystemCoreClock * 10) / (u32BusClock * 4) + 5) / 10 - 1); /* Compute proper divider for I2C clock */
     i2c->I2CLK = u32Div;
 
+    TRACE_DRV_EXIT(TRACE_ID_I2C_SETBUSCLOCK, u32Div);
     return (SystemCoreClock / ((u32Div + 1) << 2));
 }
 
@@ -0,0 +1,506 @@
+/**************************************************************************//**
+ * @file     lin.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series LIN protocol stack source file
+ *
+ * @note     The UART runs in LIN mode with break detection. Every node, the master included, reads the bus back
+ *           through the transceiver, so one receive state machine handles all frames: break, sync, PID, then
+ *           the response is either received or sent and checked byte by byte against the read back. The
+ *           master only adds the schedule timer, which sends a header at the start of each slot.
+ *           Frames are looked up by ID in a 64 entry index, PID parity comes from a constant table and the
+ *           checksum start value of each frame is computed in LIN_Open(), so the interrupt does no searching.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_LIN_Driver LIN Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define LIN_SYNC            0x55
+
+/* Receive states */
+#define LIN_ST_IDLE         0       /* Wait for break */
+#define LIN_ST_SYNC         1
+#define LIN_ST_PID          2
+#define LIN_ST_DATA         3       /* Response bytes and checksum */
+
+/* PID of each frame identifier, parity bits P0 = ID0^ID1^ID2^ID4 and P1 = ~(ID1^ID3^ID4^ID5) */
+static const uint8_t s_au8LinPid[LIN_ID_NUM] =
+{
+    0x80, 0xC1, 0x42, 0x03, 0xC4, 0x85, 0x06, 0x47, 0x08, 0x49, 0xCA, 0x8B, 0x4C, 0x0D, 0x8E, 0xCF,
+    0x50, 0x11, 0x92, 0xD3, 0x14, 0x55, 0xD6, 0x97, 0xD8, 0x99, 0x1A, 0x5B, 0x9C, 0xDD, 0x5E, 0x1F,
+    0x20, 0x61, 0xE2, 0xA3, 0x64, 0x25, 0xA6, 0xE7, 0xA8, 0xE9, 0x6A, 0x2B, 0xEC, 0xAD, 0x2E, 0x6F,
+    0xF0, 0xB1, 0x32, 0x73, 0xB4, 0xF5, 0x76, 0x37, 0x78, 0x39, 0xBA, 0xFB, 0x3C, 0x7D, 0xFE, 0xBF,
+};
+
+static LIN_FRAME_T *s_psLinFrames;
+static uint8_t s_au8LinIdx[LIN_ID_NUM];         /* Frame index + 1 of each ID, 0 if not used by this node */
+static uint8_t s_au8LinBuf[LIN_MAX_DATA];       /* Response being received or sent */
+static LIN_FRAME_T *s_psLinCur;
+static uint32_t s_u32LinState = LIN_ST_IDLE;
+static uint32_t s_u32LinCnt;
+static uint32_t s_u32LinSum;
+static uint32_t s_u32LinMode;
+static LIN_STATS_T s_sLinStats;
+
+/* Master schedule. The table given to LIN_SetSchedule() is taken over at the end of the current slot. */
+static const LIN_SCHED_T *s_psLinSched = NULL;
+static uint32_t s_u32LinSchedNum;
+static const LIN_SCHED_T *s_psLinNext;
+static uint32_t s_u32LinNextNum;
+static volatile uint32_t s_u32LinSwitch = 0;
+static uint32_t s_u32LinEntry;
+static uint32_t s_u32LinSlot = 0;
+
+/* Add a byte to the checksum, sum with carry */
+static __INLINE uint32_t LIN_Sum(uint32_t u32Sum, uint32_t u32Data)
+{
+    u32Sum += u32Data;
+    if(u32Sum >= 256)
+        u32Sum -= 255;
+    return u32Sum;
+}
+
+/* A new header or a line error ends the current frame. Count what is missing. */
+static void LIN_EndFrame(void)
+{
+    if(s_u32LinState == LIN_ST_DATA)
+    {
+        if(s_u32LinCnt == 0)
+            s_sLinStats.u32NoResponse++;
+        else
+            s_sLinStats.u32Incomplete++;
+    }
+    s_u32LinState = LIN_ST_IDLE;
+}
+
+static void LIN_StartResponse(uint32_t u32Pid)
+{
+    LIN_FRAME_T *psFrame;
+    uint32_t i, u32Sum;
+
+    if(s_au8LinIdx[u32Pid & 0x3F] == 0)
+    {
+        s_u32LinState = LIN_ST_IDLE;
+        return;
+    }
+
+    psFrame = &s_psLinFrames[s_au8LinIdx[u32Pid & 0x3F] - 1];
+    s_psLinCur = psFrame;
+    s_u32LinCnt = 0;
+    s_u32LinSum = psFrame->u8Seed;
+    s_u32LinState = LIN_ST_DATA;
+
+    if(psFrame->u8Flags & LIN_FRAME_PUBLISH)
+    {
+        /* Copy, the application may update the frame after this */
+        u32Sum = psFrame->u8Seed;
+        for(i = 0; i < psFrame->u8Len; i++)
+        {
+            s_au8LinBuf[i] = psFrame->au8Data[i];
+            u32Sum = LIN_Sum(u32Sum, s_au8LinBuf[i]);
+            LIN_UART->THR = s_au8LinBuf[i];
+        }
+        LIN_UART->THR = ~u32Sum;
+    }
+}
+
+static void LIN_RxByte(uint32_t u32Data)
+{
+    LIN_FRAME_T *psFrame = s_psLinCur;
+
+    switch(s_u32LinState)
+    {
+        case LIN_ST_SYNC:
+            if(u32Data == LIN_SYNC)
+            {
+                s_u32LinState = LIN_ST_PID;
+            }
+            else
+            {
+                s_sLinStats.u32Sync++;
+                s_u32LinState = LIN_ST_IDLE;
+            }
+            break;
+
+        case LIN_ST_PID:
+            if(s_au8LinPid[u32Data & 0x3F] != u32Data)
+            {
+                s_sLinStats.u32Parity++;
+                s_u32LinState = LIN_ST_IDLE;
+            }
+            else
+            {
+                LIN_StartResponse(u32Data);
+            }
+            break;
+
+        case LIN_ST_DATA:
+            s_u32LinSum = LIN_Sum(s_u32LinSum, u32Data);
+            if(s_u32LinCnt < psFrame->u8Len)
+            {
+                if(psFrame->u8Flags & LIN_FRAME_PUBLISH)
+                {
+                    if(s_au8LinBuf[s_u32LinCnt] != u32Data)
+                    {
+                        s_sLinStats.u32BitError++;
+                        s_u32LinState = LIN_ST_IDLE;
+                    }
+                }
+                else
+                {
+                    s_au8LinBuf[s_u32LinCnt] = u32Data;
+                }
+                s_u32LinCnt++;
+                break;
+            }
+
+            /* Checksum byte included, the sum of a good frame is 0xFF */
+            s_u32LinState = LIN_ST_IDLE;
+            if(s_u32LinSum != 0xFF)
+            {
+                s_sLinStats.u32Checksum++;
+                break;
+            }
+            if(!(psFrame->u8Flags & LIN_FRAME_PUBLISH))
+                memcpy(psFrame->au8Data, s_au8LinBuf, psFrame->u8Len);
+            psFrame->u8Updated = 1;
+            s_sLinStats.u32Frames++;
+            if(psFrame->pfnFunc != NULL)
+                psFrame->pfnFunc(psFrame);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_LIN_EXPORTED_FUNCTIONS LIN Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open LIN
+  *
+  * @param[in]  u32BaudRate LIN bit rate, up to 20000
+  * @param[in]  u32Mode     \ref LIN_MODE_MASTER or \ref LIN_MODE_SLAVE
+  * @param[in]  psFrames    Frames this node publishes or subscribes to
+  * @param[in]  u32Num      Number of frames, up to 64
+  *
+  * @retval     0   Success
+  * @retval     -1  Invalid frame ID or length
+  *
+  * @details    Set up \ref LIN_UART in LIN mode with receive, break and line status interrupts. The master also
+  *             starts \ref LIN_TIMER with period \ref LIN_TIME_BASE_US for the schedule.
+  *             Clock source and enable of the UART and the timer are set by the application, and the IRQ handlers
+  *             must call \ref LIN_IRQHandler and \ref LIN_TimerHandler. Both IRQs must have the same priority.
+  *             The UART RX must see the bus, i.e. the TX read back of the transceiver.
+  */
+int32_t LIN_Open(uint32_t u32BaudRate, uint32_t u32Mode, LIN_FRAME_T *psFrames, uint32_t u32Num)
+{
+    LIN_FRAME_T *psFrame;
+    uint32_t i;
+
+    if(u32Num > LIN_ID_NUM)
+        return -1;
+
+    memset(s_au8LinIdx, 0, sizeof(s_au8LinIdx));
+    for(i = 0; i < u32Num; i++)
+    {
+        psFrame = &psFrames[i];
+        if((psFrame->u8Id >= LIN_ID_NUM) || (psFrame->u8Len == 0) || (psFrame->u8Len > LIN_MAX_DATA))
+            return -1;
+
+        s_au8LinIdx[psFrame->u8Id] = i + 1;
+        psFrame->u8Pid = s_au8LinPid[psFrame->u8Id];
+        psFrame->u8Seed = ((psFrame->u8Flags & LIN_FRAME_CLASSIC) || (psFrame->u8Id >= 0x3C)) ? 0 : psFrame->u8Pid;
+        psFrame->u8Updated = 0;
+    }
+
+    s_psLinFrames = psFrames;
+    s_u32LinMode = u32Mode;
+    s_u32LinState = LIN_ST_IDLE;
+    s_psLinSched = NULL;
+    s_u32LinSwitch = 0;
+    s_u32LinSlot = 0;
+    LIN_ResetStats();
+
+    UART_Open(LIN_UART, u32BaudRate);
+    UART_SelectLINMode(LIN_UART, UART_ALT_CSR_LIN_RX_EN_Msk, LIN_BREAK_LEN - 1);
+    LIN_UART->FCR |= UART_FCR_RFR_Msk | UART_FCR_TFR_Msk;
+    LIN_UART->FSR = UART_FSR_BIF_Msk | UART_FSR_FEF_Msk | UART_FSR_PEF_Msk | UART_FSR_RX_OVER_IF_Msk;
+    LIN_UART->ISR = UART_ISR_LIN_RX_BREAK_IF_Msk;
+    UART_ENABLE_INT(LIN_UART, UART_IER_RDA_IEN_Msk | UART_IER_RLS_IEN_Msk | UART_IER_LIN_RX_BRK_IEN_Msk);
+    NVIC_EnableIRQ(LIN_UART_IRQn);
+
+    if(u32Mode == LIN_MODE_MASTER)
+    {
+        TIMER_Open(LIN_TIMER, TIMER_PERIODIC_MODE, 1000000 / LIN_TIME_BASE_US);
+        TIMER_EnableInt(LIN_TIMER);
+        NVIC_EnableIRQ(LIN_TIMER_IRQn);
+        TIMER_Start(LIN_TIMER);
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Close LIN
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Stop the schedule timer and disable the UART interrupts.
+  */
+void LIN_Close(void)
+{
+    if(s_u32LinMode == LIN_MODE_MASTER)
+    {
+        NVIC_DisableIRQ(LIN_TIMER_IRQn);
+        TIMER_Close(LIN_TIMER);
+    }
+
+    NVIC_DisableIRQ(LIN_UART_IRQn);
+    UART_DISABLE_INT(LIN_UART, UART_IER_RDA_IEN_Msk | UART_IER_RLS_IEN_Msk | UART_IER_LIN_RX_BRK_IEN_Msk);
+    UART_Close(LIN_UART);
+
+    s_psLinSched = NULL;
+    s_u32LinSlot = 0;
+}
+
+/**
+  * @brief      Select the schedule table
+  *
+  * @param[in]  psTable     Schedule table, NULL to stop sending headers
+  * @param[in]  u32Num      Number of entries
+  *
+  * @return     None
+  *
+  * @details    Master only. The table is run from its first entry when the current slot ends, or at the next
+  *             time base tick if no table is running. The table must stay valid while it is used.
+  */
+void LIN_SetSchedule(const LIN_SCHED_T *psTable, uint32_t u32Num)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    s_psLinNext = psTable;
+    s_u32LinNextNum = u32Num;
+    s_u32LinSwitch = 1;
+    if(s_u32LinSlot == 0)
+        s_u32LinSlot = 1;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      LIN UART interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref LIN_UART.
+  */
+void LIN_IRQHandler(void)
+{
+    uint32_t u32Fsr;
+
+    while(1)
+    {
+        u32Fsr = LIN_UART->FSR;
+
+        if(u32Fsr & (UART_FSR_BIF_Msk | UART_FSR_FEF_Msk | UART_FSR_PEF_Msk | UART_FSR_RX_OVER_IF_Msk))
+        {
+            /* The break reads as a 0x00 byte with break flag, anything else is a line error */
+            LIN_UART->FSR = u32Fsr & (UART_FSR_BIF_Msk | UART_FSR_FEF_Msk | UART_FSR_PEF_Msk | UART_FSR_RX_OVER_IF_Msk);
+            if(!(u32Fsr & UART_FSR_BIF_Msk))
+            {
+                s_sLinStats.u32Framing++;
+                LIN_EndFrame();
+            }
+            else if(s_u32LinState != LIN_ST_SYNC)
+            {
+                LIN_EndFrame();
+            }
+            if(!(u32Fsr & UART_FSR_RX_EMPTY_Msk))
+                LIN_UART->RBR;
+            continue;
+        }
+
+        if(u32Fsr & UART_FSR_RX_EMPTY_Msk)
+            break;
+
+        LIN_RxByte(LIN_UART->RBR);
+    }
+
+    if(LIN_UART->ISR & UART_ISR_LIN_RX_BREAK_IF_Msk)
+    {
+        LIN_UART->ISR = UART_ISR_LIN_RX_BREAK_IF_Msk;
+        LIN_EndFrame();
+        s_u32LinState = LIN_ST_SYNC;
+    }
+}
+
+/**
+  * @brief      Schedule timer interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref LIN_TIMER. Sends the header of the next schedule
+  *             entry when the current slot ends.
+  */
+void LIN_TimerHandler(void)
+{
+    uint32_t u32Id;
+
+    LIN_TIMER->TISR = TIMER_TISR_TIF_Msk;
+
+    if((s_u32LinSlot == 0) || (--s_u32LinSlot != 0))
+        return;
+
+    if(s_u32LinSwitch)
+    {
+        s_u32LinSwitch = 0;
+        s_psLinSched = s_psLinNext;
+        s_u32LinSchedNum = s_u32LinNextNum;
+        s_u32LinEntry = 0;
+        if((s_psLinSched == NULL) || (s_u32LinSchedNum == 0))
+        {
+            s_psLinSched = NULL;
+            return;
+        }
+    }
+    else if(++s_u32LinEntry >= s_u32LinSchedNum)
+    {
+        s_u32LinEntry = 0;
+    }
+
+    s_u32LinSlot = s_psLinSched[s_u32LinEntry].u8Ticks;
+    u32Id = s_psLinSched[s_u32LinEntry].u8Id;
+    if(u32Id < LIN_ID_NUM)
+    {
+        /* Break is sent before the next byte written */
+        LIN_UART->ALT_CSR |= UART_ALT_CSR_LIN_TX_EN_Msk;
+        LIN_UART->THR = LIN_SYNC;
+        LIN_UART->THR = s_au8LinPid[u32Id];
+    }
+}
+
+/**
+  * @brief      Read a completed frame
+  *
+  * @param[in]  psFrame     Frame
+  * @param[out] pu8Data     Buffer of psFrame->u8Len bytes
+  *
+  * @return     Bytes copied, 0 if the frame did not complete since the last read
+  *
+  * @details    For a subscribed frame this gets the last response received. For a published frame it tells
+  *             the response has been sent.
+  */
+uint32_t LIN_ReadFrame(LIN_FRAME_T *psFrame, uint8_t *pu8Data)
+{
+    uint32_t u32PriMask, u32Len = 0;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    if(psFrame->u8Updated)
+    {
+        psFrame->u8Updated = 0;
+        u32Len = psFrame->u8Len;
+        memcpy(pu8Data, psFrame->au8Data, u32Len);
+    }
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Len;
+}
+
+/**
+  * @brief      Update the response of a published frame
+  *
+  * @param[in]  psFrame     Frame
+  * @param[in]  pu8Data     psFrame->u8Len bytes
+  *
+  * @return     None
+  *
+  * @details    The next header of the frame sends the new data.
+  */
+void LIN_WriteFrame(LIN_FRAME_T *psFrame, const uint8_t *pu8Data)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    memcpy(psFrame->au8Data, pu8Data, psFrame->u8Len);
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Get error counters
+  *
+  * @param[out] psStats     Counters
+  *
+  * @return     None
+  */
+void LIN_GetStats(LIN_STATS_T *psStats)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    *psStats = s_sLinStats;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Clear error counters
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void LIN_ResetStats(void)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    memset(&s_sLinStats, 0, sizeof(s_sLinStats));
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/*@}*/ /* end of group NUC029_LIN_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_LIN_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,525 @@
+/**************************************************************************//**
+ * @file     modbus.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series Modbus RTU slave source file
+ *
+ * @note     Frames are delimited by the UART RX time-out, set to the 3.5 character silence of the RTU framing. The
+ *           RX FIFO interrupts at 8 bytes and the handler always leaves one byte in the FIFO, so the time-out
+ *           fires once after the last byte of each frame. The CRC is updated as the bytes are read from the FIFO
+ *           and frames to other nodes are only counted, so checking a frame costs no time once it has ended.
+ *           The request is executed in the same interrupt on the application arrays given by \ref MB_MAP_T and
+ *           the response is built in the receive buffer and sent from the THRE interrupt.
+ *           The time-out counter is 8 bits wide. Above 19200 bit/s the fixed 1.75 ms silence is longer than
+ *           255 bit times from 145700 bit/s on, so the gap is cut to 255 bit times there, 277 us at 921600 bit/s.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_MODBUS_Driver MODBUS Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#if (MB_MAX_FRAME < 16) || (MB_MAX_FRAME > 256)
+#error "MB_MAX_FRAME must be 16 ~ 256"
+#endif
+
+#define MB_FIFO_SIZE        16
+#define MB_CHAR_BITS        11      /* Start, 8 data, parity or second stop, stop bit */
+#define MB_GAP_MAX          255     /* Width of the time-out comparator */
+
+#define MB_RX_IDLE          0       /* Next byte is the address */
+#define MB_RX_DATA          1
+#define MB_RX_OTHER         2       /* Frame to another node */
+#define MB_RX_ERROR         3       /* Parity or framing error */
+#define MB_RX_OVERRUN       4
+
+#define MB_GET16(p)         (((uint32_t)(p)[0] << 8) | (p)[1])
+#define MB_PUT16(p, v)      do { (p)[0] = (uint8_t)((v) >> 8); (p)[1] = (uint8_t)(v); } while(0)
+
+/* CRC-16, polynomial 0xA001 reflected */
+static const uint16_t s_au16MbCrc[256] =
+{
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+static uint8_t s_au8MbBuf[MB_MAX_FRAME];
+static uint32_t s_u32MbLen;
+static uint32_t s_u32MbCrc;
+static uint32_t s_u32MbRxState = MB_RX_IDLE;
+static uint32_t s_u32MbAddr;
+static const MB_MAP_T *s_psMbMap;
+
+static uint32_t s_u32MbTxPos;
+static volatile uint32_t s_u32MbTxLen = 0;
+
+static MB_STATS_T s_sMbStats;
+
+static uint32_t MB_InRange(uint32_t u32Addr, uint32_t u32Num, uint32_t u32Start, uint32_t u32Size)
+{
+    return (u32Addr >= u32Start) && (u32Addr + u32Num <= u32Start + u32Size);
+}
+
+static uint32_t MB_Exception(uint32_t u32Code)
+{
+    s_au8MbBuf[1] |= 0x80;
+    s_au8MbBuf[2] = u32Code;
+    return 3;
+}
+
+static void MB_ReadBits(const uint8_t *pu8Src, uint32_t u32First, uint32_t u32Num, uint8_t *pu8Dst)
+{
+    uint32_t i;
+
+    memset(pu8Dst, 0, (u32Num + 7) / 8);
+    for(i = 0; i < u32Num; i++, u32First++)
+    {
+        if(pu8Src[u32First >> 3] & (1 << (u32First & 7)))
+            pu8Dst[i >> 3] |= 1 << (i & 7);
+    }
+}
+
+static void MB_WriteBits(uint8_t *pu8Dst, uint32_t u32First, uint32_t u32Num, const uint8_t *pu8Src)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32Num; i++, u32First++)
+    {
+        if(pu8Src[i >> 3] & (1 << (i & 7)))
+            pu8Dst[u32First >> 3] |= 1 << (u32First & 7);
+        else
+            pu8Dst[u32First >> 3] &= ~(1 << (u32First & 7));
+    }
+}
+
+/* Execute the request in s_au8MbBuf, u32Len without CRC. Returns the response length without CRC. */
+static uint32_t MB_Execute(uint32_t u32Len)
+{
+    const MB_MAP_T *psMap = s_psMbMap;
+    uint8_t *pu8Buf = s_au8MbBuf;
+    uint32_t u32Func = pu8Buf[1];
+    uint32_t u32Addr = MB_GET16(&pu8Buf[2]);
+    uint32_t u32Num = MB_GET16(&pu8Buf[4]);
+    uint32_t i, u32Cnt;
+
+    switch(u32Func)
+    {
+        case MB_FC_READ_COILS:
+        case MB_FC_READ_INPUTS:
+            /* Response carries the bits packed, address, function, count, data and CRC */
+            if((u32Len != 6) || (u32Num == 0) || (u32Num > 2000) || ((u32Num + 7) / 8 + 5 > MB_MAX_FRAME))
+                return MB_Exception(MB_EX_ILLEGAL_VALUE);
+
+            if(u32Func == MB_FC_READ_COILS)
+            {
+                if(!MB_InRange(u32Addr, u32Num, psMap->u16CoilStart, psMap->u16CoilNum))
+                    return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+                MB_ReadBits(psMap->pu8Coils, u32Addr - psMap->u16CoilStart, u32Num, &pu8Buf[3]);
+            }
+            else
+            {
+                if(!MB_InRange(u32Addr, u32Num, psMap->u16InputStart, psMap->u16InputNum))
+                    return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+                MB_ReadBits(psMap->pu8Inputs, u32Addr - psMap->u16InputStart, u32Num, &pu8Buf[3]);
+            }
+            pu8Buf[2] = (u32Num + 7) / 8;
+            return 3 + pu8Buf[2];
+
+        case MB_FC_READ_HOLDING:
+        case MB_FC_READ_INPUT_REGS:
+            if((u32Len != 6) || (u32Num == 0) || (u32Num > 125) || (u32Num * 2 + 5 > MB_MAX_FRAME))
+                return MB_Exception(MB_EX_ILLEGAL_VALUE);
+
+            if(u32Func == MB_FC_READ_HOLDING)
+            {
+                if(!MB_InRange(u32Addr, u32Num, psMap->u16HoldingStart, psMap->u16HoldingNum))
+                    return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+                u32Addr -= psMap->u16HoldingStart;
+                for(i = 0; i < u32Num; i++)
+                    MB_PUT16(&pu8Buf[3 + i * 2], psMap->pu16Holding[u32Addr + i]);
+            }
+            else
+            {
+                if(!MB_InRange(u32Addr, u32Num, psMap->u16InputRegStart, psMap->u16InputRegNum))
+                    return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+                u32Addr -= psMap->u16InputRegStart;
+                for(i = 0; i < u32Num; i++)
+                    MB_PUT16(&pu8Buf[3 + i * 2], psMap->pu16InputRegs[u32Addr + i]);
+            }
+            pu8Buf[2] = u32Num * 2;
+            return 3 + pu8Buf[2];
+
+        case MB_FC_WRITE_COIL:
+            /* u32Num holds the value, bit 0 of its high byte is the coil. The response echoes the request. */
+            if((u32Len != 6) || ((u32Num != 0xFF00) && (u32Num != 0x0000)))
+                return MB_Exception(MB_EX_ILLEGAL_VALUE);
+            if(!MB_InRange(u32Addr, 1, psMap->u16CoilStart, psMap->u16CoilNum))
+                return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+            MB_WriteBits(psMap->pu8Coils, u32Addr - psMap->u16CoilStart, 1, &pu8Buf[4]);
+            u32Num = 1;
+            break;
+
+        case MB_FC_WRITE_REG:
+            if(u32Len != 6)
+                return MB_Exception(MB_EX_ILLEGAL_VALUE);
+            if(!MB_InRange(u32Addr, 1, psMap->u16HoldingStart, psMap->u16HoldingNum))
+                return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+            psMap->pu16Holding[u32Addr - psMap->u16HoldingStart] = u32Num;
+            u32Num = 1;
+            break;
+
+        case MB_FC_WRITE_COILS:
+            u32Cnt = (u32Num + 7) / 8;
+            if((u32Len < 7) || (u32Num == 0) || (u32Num > 1968) || (pu8Buf[6] != u32Cnt) || (u32Len != 7 + u32Cnt))
+                return MB_Exception(MB_EX_ILLEGAL_VALUE);
+            if(!MB_InRange(u32Addr, u32Num, psMap->u16CoilStart, psMap->u16CoilNum))
+                return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+            MB_WriteBits(psMap->pu8Coils, u32Addr - psMap->u16CoilStart, u32Num, &pu8Buf[7]);
+            break;
+
+        case MB_FC_WRITE_REGS:
+            u32Cnt = u32Num * 2;
+            if((u32Len < 7) || (u32Num == 0) || (u32Num > 123) || (pu8Buf[6] != u32Cnt) || (u32Len != 7 + u32Cnt))
+                return MB_Exception(MB_EX_ILLEGAL_VALUE);
+            if(!MB_InRange(u32Addr, u32Num, psMap->u16HoldingStart, psMap->u16HoldingNum))
+                return MB_Exception(MB_EX_ILLEGAL_ADDRESS);
+            u32Addr -= psMap->u16HoldingStart;
+            for(i = 0; i < u32Num; i++)
+                psMap->pu16Holding[u32Addr + i] = MB_GET16(&pu8Buf[7 + i * 2]);
+            u32Addr += psMap->u16HoldingStart;
+            break;
+
+        default:
+            return MB_Exception(MB_EX_ILLEGAL_FUNCTION);
+    }
+
+    /* Writes answer with address and quantity, or address and value for a single one */
+    if(psMap->pfnWrite != NULL)
+        psMap->pfnWrite(u32Func, u32Addr, u32Num);
+
+    return 6;
+}
+
+static void MB_EndFrame(void)
+{
+    uint32_t u32Len, u32Crc;
+
+    switch(s_u32MbRxState)
+    {
+        case MB_RX_DATA:
+            /* CRC over the whole frame, its own CRC included, is 0 */
+            if((s_u32MbLen < 4) || (s_u32MbCrc != 0))
+            {
+                s_sMbStats.u32CrcError++;
+                break;
+            }
+
+            u32Len = MB_Execute(s_u32MbLen - 2);
+            s_sMbStats.u32Frames++;
+            if(s_au8MbBuf[0] == MB_BROADCAST)
+            {
+                s_sMbStats.u32Broadcast++;
+                break;
+            }
+            if(s_au8MbBuf[1] & 0x80)
+                s_sMbStats.u32Exception++;
+
+            u32Crc = MB_Crc16(s_au8MbBuf, u32Len);
+            s_au8MbBuf[u32Len++] = u32Crc & 0xFF;
+            s_au8MbBuf[u32Len++] = u32Crc >> 8;
+
+            /* Time-out already gave the 3.5 character gap before the response */
+            s_u32MbTxPos = 0;
+            s_u32MbTxLen = u32Len;
+            UART_ENABLE_INT(MB_UART, UART_IER_THRE_IEN_Msk);
+            break;
+
+        case MB_RX_OTHER:
+            s_sMbStats.u32Other++;
+            break;
+
+        case MB_RX_ERROR:
+            s_sMbStats.u32CrcError++;
+            break;
+
+        case MB_RX_OVERRUN:
+            s_sMbStats.u32Overrun++;
+            break;
+
+        default:
+            break;
+    }
+
+    s_u32MbRxState = MB_RX_IDLE;
+}
+
+static void MB_RxByte(uint32_t u32Data)
+{
+    switch(s_u32MbRxState)
+    {
+        case MB_RX_IDLE:
+            /* Buffer still holds the response being sent */
+            if(s_u32MbTxLen)
+                s_u32MbRxState = MB_RX_OVERRUN;
+            else if((u32Data != s_u32MbAddr) && (u32Data != MB_BROADCAST))
+                s_u32MbRxState = MB_RX_OTHER;
+            else
+            {
+                s_au8MbBuf[0] = u32Data;
+                s_u32MbLen = 1;
+                s_u32MbCrc = 0xFFFF;
+                s_u32MbCrc = (s_u32MbCrc >> 8) ^ s_au16MbCrc[(s_u32MbCrc ^ u32Data) & 0xFF];
+                s_u32MbRxState = MB_RX_DATA;
+            }
+            break;
+
+        case MB_RX_DATA:
+            if(s_u32MbLen < MB_MAX_FRAME)
+            {
+                s_au8MbBuf[s_u32MbLen++] = u32Data;
+                s_u32MbCrc = (s_u32MbCrc >> 8) ^ s_au16MbCrc[(s_u32MbCrc ^ u32Data) & 0xFF];
+            }
+            else
+                s_u32MbRxState = MB_RX_OVERRUN;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_MODBUS_EXPORTED_FUNCTIONS MODBUS Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open the Modbus RTU slave
+  *
+  * @param[in]  u32BaudRate Baud rate
+  * @param[in]  u32Parity   UART_PARITY_EVEN, UART_PARITY_ODD, or UART_PARITY_NONE which uses 2 stop bits
+  * @param[in]  u32Addr     Slave address, 1 ~ 247
+  * @param[in]  psMap       Data map, must stay valid until \ref MB_Close
+  *
+  * @return     None
+  *
+  * @details    Set up \ref MB_UART with 11-bit characters and the RX time-out at 3.5 characters, or 1.75 ms above
+  *             19200 bit/s. With \ref MB_RS485 the UART runs in RS485 AUD mode and RTS enables the driver while
+  *             sending. The UART clock and pins are set up by the application, and the UART IRQ handler must
+  *             call \ref MB_IRQHandler. Arrays of the map are written from the interrupt, read values wider
+  *             than one register with the interrupt disabled.
+  */
+void MB_Open(uint32_t u32BaudRate, uint32_t u32Parity, uint32_t u32Addr, const MB_MAP_T *psMap)
+{
+    uint32_t u32Gap;
+
+    s_u32MbAddr = u32Addr;
+    s_psMbMap = psMap;
+    s_u32MbRxState = MB_RX_IDLE;
+    s_u32MbTxLen = 0;
+    MB_ResetStats();
+
+    /* Round up */
+    if(u32BaudRate <= 19200)
+        u32Gap = (7 * MB_CHAR_BITS + 1) / 2;
+    else
+        u32Gap = (1750 * u32BaudRate + 999999) / 1000000;
+    if(u32Gap > MB_GAP_MAX)
+        u32Gap = MB_GAP_MAX;
+
+    UART_Open(MB_UART, u32BaudRate);
+    UART_SetLine_Config(MB_UART, 0, UART_WORD_LEN_8, u32Parity,
+                        (u32Parity == UART_PARITY_NONE) ? UART_STOP_BIT_2 : UART_STOP_BIT_1);
+#if MB_RS485
+    MB_UART->MCR = (MB_UART->MCR & ~UART_MCR_LEV_RTS_Msk) | MB_RTS_LEVEL;
+    UART_SelectRS485Mode(MB_UART, UART_ALT_CSR_RS485_AUD_Msk, 0);
+#endif
+
+    MB_UART->FCR = (MB_UART->FCR & ~UART_FCR_RFITL_Msk) | UART_FCR_RFITL_8BYTES | UART_FCR_RFR_Msk | UART_FCR_TFR_Msk;
+    UART_SetTimeoutCnt(MB_UART, u32Gap);
+    UART_ClearIntFlag(MB_UART, UART_ISR_RLS_INT_Msk | UART_ISR_BUF_ERR_INT_Msk);
+
+    UART_ENABLE_INT(MB_UART, UART_IER_RDA_IEN_Msk | UART_IER_RTO_IEN_Msk | UART_IER_RLS_IEN_Msk |
+                    UART_IER_BUF_ERR_IEN_Msk);
+    NVIC_EnableIRQ(MB_UART_IRQn);
+}
+
+/**
+  * @brief      Close the Modbus RTU slave
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void MB_Close(void)
+{
+    NVIC_DisableIRQ(MB_UART_IRQn);
+    UART_DISABLE_INT(MB_UART, UART_IER_RDA_IEN_Msk | UART_IER_RTO_IEN_Msk | UART_IER_RLS_IEN_Msk |
+                     UART_IER_BUF_ERR_IEN_Msk | UART_IER_THRE_IEN_Msk | UART_IER_TIME_OUT_EN_Msk);
+    UART_Close(MB_UART);
+    s_u32MbTxLen = 0;
+}
+
+/**
+  * @brief      Modbus interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref MB_UART. Requests are executed here, including the
+  *             write notification of the map.
+  */
+void MB_IRQHandler(void)
+{
+    uint32_t u32Isr = MB_UART->ISR;
+    uint32_t u32Fsr = MB_UART->FSR;
+    uint32_t u32Cnt;
+
+    if(u32Fsr & (UART_FSR_BIF_Msk | UART_FSR_FEF_Msk | UART_FSR_PEF_Msk))
+    {
+        if((s_u32MbRxState == MB_RX_IDLE) || (s_u32MbRxState == MB_RX_DATA))
+            s_u32MbRxState = MB_RX_ERROR;
+    }
+    if(u32Fsr & UART_FSR_RX_OVER_IF_Msk)
+    {
+        if(s_u32MbRxState != MB_RX_OTHER)
+            s_u32MbRxState = MB_RX_OVERRUN;
+    }
+    UART_ClearIntFlag(MB_UART, UART_ISR_RLS_INT_Msk | UART_ISR_BUF_ERR_INT_Msk);
+
+    if(u32Isr & (UART_ISR_RDA_INT_Msk | UART_ISR_TOUT_INT_Msk))
+    {
+        u32Fsr = MB_UART->FSR;
+        u32Cnt = (u32Fsr & UART_FSR_RX_FULL_Msk) ? MB_FIFO_SIZE :
+                 (u32Fsr & UART_FSR_RX_POINTER_Msk) >> UART_FSR_RX_POINTER_Pos;
+
+        /* Keep one byte, so the time-out reports the end of the frame */
+        if(!(u32Isr & UART_ISR_TOUT_INT_Msk) && u32Cnt)
+            u32Cnt--;
+
+        while(u32Cnt--)
+            MB_RxByte(MB_UART->RBR);
+
+        if(u32Isr & UART_ISR_TOUT_INT_Msk)
+            MB_EndFrame();
+    }
+
+    if(u32Isr & UART_ISR_THRE_INT_Msk)
+    {
+        for(u32Cnt = 0; (u32Cnt < MB_FIFO_SIZE) && (s_u32MbTxPos < s_u32MbTxLen); u32Cnt++)
+            MB_UART->THR = s_au8MbBuf[s_u32MbTxPos++];
+        if(s_u32MbTxPos == s_u32MbTxLen)
+        {
+            UART_DISABLE_INT(MB_UART, UART_IER_THRE_IEN_Msk);
+            s_u32MbTxLen = 0;
+        }
+    }
+}
+
+/**
+  * @brief      Calculate the Modbus CRC
+  *
+  * @param[in]  pu8Data     Data
+  * @param[in]  u32Len      Data length
+  *
+  * @return     CRC-16, sent low byte first
+  */
+uint32_t MB_Crc16(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32Crc = 0xFFFF;
+
+    while(u32Len--)
+        u32Crc = (u32Crc >> 8) ^ s_au16MbCrc[(u32Crc ^ *pu8Data++) & 0xFF];
+
+    return u32Crc;
+}
+
+/**
+  * @brief      Get statistics
+  *
+  * @param[out] psStats     Statistics
+  *
+  * @return     None
+  */
+void MB_GetStats(MB_STATS_T *psStats)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    *psStats = s_sMbStats;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Clear statistics
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void MB_ResetStats(void)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    memset(&s_sMbStats, 0, sizeof(s_sMbStats));
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/*@}*/ /* end of group NUC029_MODBUS_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_MODBUS_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,476 @@
+/**************************************************************************//**
+ * @file     pm.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series tickless power manager source file
+ *
+ * @note     The timebase timer counts LIRC in continuous mode and is never stopped or reloaded, so time stays
+ *           consistent across Idle and Power-down. Its compare register is set to the earliest software timer
+ *           expiry. PM_Idle() sleeps until then, in Power-down mode if the sleep is long enough to pay back the
+ *           wake-up time, otherwise in Idle mode.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_PM_Driver PM Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+static PM_TIMER_T *s_psPmHead = NULL;   /* Running timers sorted by expiry */
+static uint32_t s_u32PmTicks = 0;       /* Last tick read, upper 8 bits extend the 24-bit counter */
+static uint32_t s_u32PmTickHz = PM_TICK_HZ;
+static volatile uint32_t s_u32PmLock = 0;
+static PM_STATS_T s_sPmStats;
+
+/* Interrupts must be masked */
+static uint32_t PM_ReadTicks(void)
+{
+    uint32_t u32Cnt = PM_TIMEBASE->TDR;
+
+    if(u32Cnt < (s_u32PmTicks & 0xFFFFFF))
+        s_u32PmTicks += 0x1000000;
+    s_u32PmTicks = (s_u32PmTicks & 0xFF000000) | u32Cnt;
+
+    return s_u32PmTicks;
+}
+
+/* Set compare match to u32Tick, or earlier to keep the counter extension valid. Interrupts must be masked. */
+static void PM_SetCompare(uint32_t u32Tick)
+{
+    uint32_t u32Now = PM_ReadTicks();
+
+    if((int32_t)(u32Tick - u32Now) > (int32_t)PM_MAX_SLEEP)
+        u32Tick = u32Now + PM_MAX_SLEEP;
+
+    /* Counter must be at least 2 below the compare value */
+    if((int32_t)(u32Tick - u32Now) < 2)
+        u32Tick = u32Now + 2;
+
+    PM_TIMEBASE->TCMPR = u32Tick & 0xFFFFFF;
+
+    /* Match may have been passed while it was set */
+    if((int32_t)(u32Tick - PM_ReadTicks()) <= 0)
+        NVIC_SetPendingIRQ(PM_TIMEBASE_IRQn);
+}
+
+/* Interrupts must be masked */
+static void PM_Insert(PM_TIMER_T *psTimer)
+{
+    PM_TIMER_T **ppsLink = &s_psPmHead;
+
+    while((*ppsLink != NULL) && ((int32_t)((*ppsLink)->u32Expire - psTimer->u32Expire) <= 0))
+        ppsLink = &(*ppsLink)->psNext;
+
+    psTimer->psNext = *ppsLink;
+    *ppsLink = psTimer;
+}
+
+/* Interrupts must be masked */
+static void PM_Remove(PM_TIMER_T *psTimer)
+{
+    PM_TIMER_T **ppsLink = &s_psPmHead;
+
+    while(*ppsLink != NULL)
+    {
+        if(*ppsLink == psTimer)
+        {
+            *ppsLink = psTimer->psNext;
+            break;
+        }
+        ppsLink = &(*ppsLink)->psNext;
+    }
+}
+
+/* Enter Power-down with HCLK on HIRC, then restore clocks. Interrupts must be masked, registers unlocked. */
+static void PM_PowerDown(void)
+{
+    uint32_t u32ClkSel0 = CLK->CLKSEL0;
+    uint32_t u32PwrCon = CLK->PWRCON;
+    uint32_t u32Stable = 0;
+
+    /* PLL and HXT need ms to restart. HIRC is ready a few us after wake-up, run from it in the meantime. */
+    if((u32ClkSel0 & CLK_CLKSEL0_HCLK_S_Msk) == CLK_CLKSEL0_HCLK_S_PLL)
+        u32Stable = CLK_CLKSTATUS_PLL_STB_Msk;
+    else if((u32ClkSel0 & CLK_CLKSEL0_HCLK_S_Msk) == CLK_CLKSEL0_HCLK_S_HXT)
+        u32Stable = CLK_CLKSTATUS_XTL12M_STB_Msk;
+
+    if(u32Stable)
+    {
+        if(!(u32PwrCon & CLK_PWRCON_IRC22M_EN_Msk))
+        {
+            CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+            CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+        }
+        CLK->CLKSEL0 = (u32ClkSel0 & ~CLK_CLKSEL0_HCLK_S_Msk) | CLK_CLKSEL0_HCLK_S_HIRC;
+    }
+
+    CLK_PowerDown();
+
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    if(u32Stable)
+    {
+        CLK_WaitClockReady(u32Stable);
+        CLK->CLKSEL0 = u32ClkSel0;
+        if(!(u32PwrCon & CLK_PWRCON_IRC22M_EN_Msk))
+            CLK->PWRCON &= ~CLK_PWRCON_IRC22M_EN_Msk;
+    }
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_PM_EXPORTED_FUNCTIONS PM Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start the timebase
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Enable LIRC and start \ref PM_TIMEBASE counting LIRC with interrupt and wake-up enabled.
+  *             The IRQ handler of the timer must call \ref PM_IRQHandler.
+  *             The register write-protection function should be disabled before using this function.
+  */
+void PM_Open(void)
+{
+    CLK->PWRCON |= CLK_PWRCON_IRC10K_EN_Msk;
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC10K_STB_Msk);
+
+    CLK_SetModuleClock(PM_TIMEBASE_MODULE, PM_TIMEBASE_CLKSEL, 0);
+    CLK_EnableModuleClock(PM_TIMEBASE_MODULE);
+
+    PM_TIMEBASE->TCSR = TIMER_TCSR_CRST_Msk;
+    PM_TIMEBASE->TCMPR = PM_MAX_SLEEP;
+    PM_TIMEBASE->TISR = TIMER_TISR_TIF_Msk | TIMER_TISR_TWF_Msk;
+    PM_TIMEBASE->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk | TIMER_TCSR_IE_Msk |
+                        TIMER_TCSR_WAKE_EN_Msk | TIMER_TCSR_CEN_Msk;
+
+    s_psPmHead = NULL;
+    s_u32PmTicks = 0;
+    s_u32PmLock = 0;
+    PM_ResetStats();
+
+    NVIC_EnableIRQ(PM_TIMEBASE_IRQn);
+}
+
+/**
+  * @brief      Measure the tick rate
+  *
+  * @param[in]  u32Ticks    Ticks to measure, 1 ~ 2000. More ticks give better resolution.
+  *
+  * @return     Tick rate in Hz, also used by \ref PM_MsToTicks
+  *
+  * @details    LIRC is accurate to some 10%. This function counts HCLK cycles with SysTick over u32Ticks
+  *             ticks with interrupts masked, so the result is as accurate as HCLK. SysTick is stopped afterwards.
+  *             u32Ticks * HCLK / LIRC must stay below 2^24, e.g. up to 2000 ticks at 50 MHz.
+  */
+uint32_t PM_Calibrate(uint32_t u32Ticks)
+{
+    uint32_t u32Start, u32Cycles, u32Tick, u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    /* Start on a tick edge */
+    u32Tick = PM_ReadTicks();
+    while(PM_ReadTicks() == u32Tick);
+    u32Start = SysTick->VAL;
+    u32Tick += 1 + u32Ticks;
+
+    while(PM_ReadTicks() != u32Tick);
+    u32Cycles = (u32Start - SysTick->VAL) & 0xFFFFFF;
+
+    SysTick->CTRL = 0;
+    __set_PRIMASK(u32PriMask);
+
+    s_u32PmTickHz = (uint32_t)(((uint64_t)SystemCoreClock * u32Ticks + u32Cycles / 2) / u32Cycles);
+
+    return s_u32PmTickHz;
+}
+
+/**
+  * @brief      Get timebase tick count
+  *
+  * @param      None
+  *
+  * @return     Ticks since \ref PM_Open, wraps around after 2^32 ticks
+  *
+  * @details    The count runs on in Idle and Power-down mode.
+  */
+uint32_t PM_GetTicks(void)
+{
+    uint32_t u32Ticks, u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    u32Ticks = PM_ReadTicks();
+    __set_PRIMASK(u32PriMask);
+
+    return u32Ticks;
+}
+
+/**
+  * @brief      Convert milliseconds to ticks
+  *
+  * @param[in]  u32Ms   Milliseconds
+  *
+  * @return     Ticks, rounded up, based on the rate found by \ref PM_Calibrate or \ref PM_TICK_HZ
+  */
+uint32_t PM_MsToTicks(uint32_t u32Ms)
+{
+    return (u32Ms / 1000) * s_u32PmTickHz + ((u32Ms % 1000) * s_u32PmTickHz + 999) / 1000;
+}
+
+/**
+  * @brief      Start or restart a software timer
+  *
+  * @param[in]  psTimer     Timer storage
+  * @param[in]  u32Ticks    Ticks to first expiry, 1 ~ 0x7FFFFFFF
+  * @param[in]  u32Period   Ticks between following expiries, 0 for one-shot
+  * @param[in]  pfnFunc     Callback, runs in interrupt context
+  * @param[in]  pvArg       Callback argument
+  *
+  * @return     None
+  *
+  * @details    Can be called from interrupt handlers and from the callback of any timer.
+  *             A periodic timer is scheduled from its previous expiry, so it does not drift.
+  */
+void PM_StartTimer(PM_TIMER_T *psTimer, uint32_t u32Ticks, uint32_t u32Period, PM_FUNC_T pfnFunc, void *pvArg)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    PM_Remove(psTimer);
+    psTimer->u32Expire = PM_ReadTicks() + u32Ticks;
+    psTimer->u32Period = u32Period;
+    psTimer->pfnFunc = pfnFunc;
+    psTimer->pvArg = pvArg;
+    PM_Insert(psTimer);
+
+    if(s_psPmHead == psTimer)
+        PM_SetCompare(psTimer->u32Expire);
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Stop a software timer
+  *
+  * @param[in]  psTimer     Timer storage
+  *
+  * @return     None
+  *
+  * @details    Stopping a timer that is not running has no effect.
+  */
+void PM_StopTimer(PM_TIMER_T *psTimer)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    PM_Remove(psTimer);
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Timebase interrupt service
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Call from the IRQ handler of \ref PM_TIMEBASE, e.g. TMR1_IRQHandler. Runs the callback of each
+  *             expired timer and sets the compare match to the next expiry.
+  */
+void PM_IRQHandler(void)
+{
+    PM_TIMER_T *psTimer;
+    uint32_t u32PriMask;
+
+    PM_TIMEBASE->TISR = TIMER_TISR_TIF_Msk | TIMER_TISR_TWF_Msk;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    while(((psTimer = s_psPmHead) != NULL) && ((int32_t)(psTimer->u32Expire - PM_ReadTicks()) <= 0))
+    {
+        s_psPmHead = psTimer->psNext;
+        if(psTimer->u32Period)
+        {
+            psTimer->u32Expire += psTimer->u32Period;
+            PM_Insert(psTimer);
+        }
+
+        /* Callback may start or stop timers */
+        __set_PRIMASK(u32PriMask);
+        psTimer->pfnFunc(psTimer->pvArg);
+        __disable_irq();
+    }
+
+    PM_SetCompare((psTimer != NULL) ? psTimer->u32Expire : PM_ReadTicks() + PM_MAX_SLEEP);
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Prevent Power-down mode
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Calls nest. Use while a peripheral without LIRC clock is busy, e.g. UART transmitting.
+  *             \ref PM_Idle uses Idle mode until the same number of \ref PM_Unlock calls.
+  */
+void PM_Lock(void)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    s_u32PmLock++;
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Allow Power-down mode again
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void PM_Unlock(void)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    if(s_u32PmLock)
+        s_u32PmLock--;
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Sleep until the next timer expiry or interrupt
+  *
+  * @param      None
+  *
+  * @retval     PM_MODE_IDLE    Idle mode was used
+  * @retval     PM_MODE_PD      Power-down mode was used
+  *
+  * @details    Call with interrupts masked, e.g. as \ref SCHED_IDLE with "#define SCHED_IDLE() PM_Idle()".
+  *             Any interrupt wakes the chip up and is serviced after interrupts are unmasked.
+  *             Power-down is used if no \ref PM_Lock is held and the next expiry is at least \ref PM_PD_MIN_TICKS
+  *             away. The chip then wakes up \ref PM_PD_WAKEUP_TICKS early and restores PLL/HXT and HCLK source,
+  *             and the remaining ticks are spent in Idle mode on the next call.
+  *             Register write-protection is disabled for the call and restored afterwards.
+  */
+uint32_t PM_Idle(void)
+{
+    uint32_t u32Start, u32Sleep, u32Mode, u32Locked, u32Ticks;
+
+    u32Start = PM_ReadTicks();
+    u32Sleep = PM_MAX_SLEEP;
+    if(s_psPmHead != NULL)
+    {
+        u32Sleep = s_psPmHead->u32Expire - u32Start;
+        if((int32_t)u32Sleep < 0)
+            u32Sleep = 0;
+    }
+
+    u32Locked = SYS_IsRegLocked();
+    if(u32Locked)
+        SYS_UnlockReg();
+
+    if(s_u32PmLock || (u32Sleep < PM_PD_MIN_TICKS))
+    {
+        u32Mode = PM_MODE_IDLE;
+        CLK_Idle();
+    }
+    else
+    {
+        u32Mode = PM_MODE_PD;
+        PM_SetCompare(u32Start + u32Sleep - PM_PD_WAKEUP_TICKS);
+        PM_PowerDown();
+
+        u32Ticks = PM_ReadTicks() - (u32Start + u32Sleep - PM_PD_WAKEUP_TICKS);
+        if(((int32_t)u32Ticks >= 0) && (u32Ticks > s_sPmStats.u32MaxWakeup))
+            s_sPmStats.u32MaxWakeup = u32Ticks;
+    }
+
+    if(u32Locked)
+        SYS_LockReg();
+
+    s_sPmStats.au32Count[u32Mode]++;
+    s_sPmStats.au32Ticks[u32Mode] += PM_ReadTicks() - u32Start;
+
+    return u32Mode;
+}
+
+/**
+  * @brief      Get residency counters
+  *
+  * @param[out] psStats     Copy of counters since \ref PM_Open or \ref PM_ResetStats
+  *
+  * @return     None
+  *
+  * @details    Ticks not spent in a low power mode were spent running.
+  */
+void PM_GetStats(PM_STATS_T *psStats)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    *psStats = s_sPmStats;
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Clear residency counters
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void PM_ResetStats(void)
+{
+    uint32_t u32PriMask, i;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    for(i = 0; i < PM_MODE_NUM; i++)
+    {
+        s_sPmStats.au32Count[i] = 0;
+        s_sPmStats.au32Ticks[i] = 0;
+    }
+    s_sPmStats.u32MaxWakeup = 0;
+    __set_PRIMASK(u32PriMask);
+}
+
+/*@}*/ /* end of group NUC029_PM_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_PM_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
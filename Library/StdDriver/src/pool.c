@@ -0,0 +1,151 @@
+/**************************************************************************//**
+ * @file     pool.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/07 3:40p $
+ * @brief    NUC029 series fixed-block memory pool source file
+ *
+ * @note     Blocks of one size are handed out in O(1) from a free list. The list is updated with interrupts
+ *           masked for a few instructions only, so pools can be shared by thread and interrupt context.
+ *           Drivers and application pass block pointers around instead of copying data.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_POOL_Driver POOL Driver
+  @{
+*/
+
+
+/** @addtogroup NUC029_POOL_EXPORTED_FUNCTIONS POOL Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Initialize a pool at run time
+  *
+  * @param[in]  psPool          Pool control block
+  * @param[in]  pvBuf           Storage, word aligned, at least POOL_BLOCK_SIZE(u32BlockSize) * u32Blocks bytes
+  * @param[in]  u32BlockSize    Block size in bytes, 4 ~ 65532. Rounded up to a multiple of 4.
+  * @param[in]  u32Blocks       Number of blocks, 0 ~ 65535
+  *
+  * @retval     0   Success
+  * @retval     -1  Parameter out of range
+  *
+  * @details    Pools with storage known at compile time can use \ref POOL_DEFINE instead.
+  */
+int32_t POOL_Init(POOL_T *psPool, void *pvBuf, uint32_t u32BlockSize, uint32_t u32Blocks)
+{
+    u32BlockSize = POOL_BLOCK_SIZE(u32BlockSize);
+    if((u32BlockSize < 4) || (u32BlockSize > 0xFFFF) || (u32Blocks > 0xFFFF) || ((uintptr_t)pvBuf & 3))
+        return -1;
+
+    psPool->pvFree = NULL;
+    psPool->pu8Start = (uint8_t *)pvBuf;
+    psPool->pu8End = (uint8_t *)pvBuf + u32BlockSize * u32Blocks;
+    psPool->u16BlockSize = (uint16_t)u32BlockSize;
+    psPool->u16Blocks = (uint16_t)u32Blocks;
+    psPool->u16Next = 0;
+    psPool->u16Used = 0;
+    psPool->u16Peak = 0;
+    psPool->u32Fail = 0;
+
+    return 0;
+}
+
+/**
+  * @brief      Allocate a block
+  *
+  * @param[in]  psPool      Pool control block
+  *
+  * @return     Word aligned block of psPool->u16BlockSize bytes, NULL if the pool is empty
+  *
+  * @details    Takes constant time. Can be called from interrupt handlers.
+  */
+void *POOL_Alloc(POOL_T *psPool)
+{
+    void *pvBlk;
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    pvBlk = psPool->pvFree;
+    if(pvBlk != NULL)
+        psPool->pvFree = *(void **)pvBlk;
+    else if(psPool->u16Next < psPool->u16Blocks)
+        pvBlk = psPool->pu8Start + (uint32_t)psPool->u16Next++ * psPool->u16BlockSize;
+    else
+    {
+        psPool->u32Fail++;
+        __set_PRIMASK(u32PriMask);
+        return NULL;
+    }
+
+    if(++psPool->u16Used > psPool->u16Peak)
+        psPool->u16Peak = psPool->u16Used;
+
+    __set_PRIMASK(u32PriMask);
+
+    return pvBlk;
+}
+
+/**
+  * @brief      Return a block to its pool
+  *
+  * @param[in]  psPool      Pool control block
+  * @param[in]  pvBlk       Block returned by \ref POOL_Alloc on the same pool, or NULL
+  *
+  * @return     None
+  *
+  * @details    Takes constant time. Can be called from interrupt handlers, also by another context than the
+  *             one that allocated the block. Pointers outside the pool storage are ignored.
+  */
+void POOL_Free(POOL_T *psPool, void *pvBlk)
+{
+    uint32_t u32PriMask;
+
+    if(!POOL_IS_BLOCK(psPool, pvBlk))
+        return;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    *(void **)pvBlk = psPool->pvFree;
+    psPool->pvFree = pvBlk;
+    psPool->u16Used--;
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Restart peak and failure counters
+  *
+  * @param[in]  psPool      Pool control block
+  *
+  * @return     None
+  *
+  * @details    Peak usage is set to current usage.
+  */
+void POOL_ResetStats(POOL_T *psPool)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    psPool->u16Peak = psPool->u16Used;
+    psPool->u32Fail = 0;
+    __set_PRIMASK(u32PriMask);
+}
+
+/*@}*/ /* end of group NUC029_POOL_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_POOL_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -71,16 +71,56 @@ int ferror(FILE *stream);
 #endif
 
 char GetChar(void);
+int GetCharNonBlock(void);
+void FlushDebugFifo(void);
+uint32_t GetDebugDropCount(void);
 void SendChar_ToUART(int ch);
 void SendChar(int ch);
 
+#if defined(DEBUG_INT_CONSOLE)
+#if (DEBUG_TX_BUF_SIZE & (DEBUG_TX_BUF_SIZE - 1)) || (DEBUG_RX_BUF_SIZE & (DEBUG_RX_BUF_SIZE - 1))
+#error "DEBUG_TX_BUF_SIZE and DEBUG_RX_BUF_SIZE must be power of 2"
+#endif
+static uint8_t s_au8DbgTxBuf[DEBUG_TX_BUF_SIZE];
+static volatile uint32_t s_u32DbgTxHead = 0;    /* Free running, written by thread */
+static volatile uint32_t s_u32DbgTxTail = 0;    /* Free running, written by IRQ handler */
+static uint8_t s_au8DbgRxBuf[DEBUG_RX_BUF_SIZE];
+static volatile uint32_t s_u32DbgRxHead = 0;    /* Free running, written by IRQ handler */
+static volatile uint32_t s_u32DbgRxTail = 0;    /* Free running, written by thread */
+static volatile uint32_t s_u32DbgDrop = 0;      /* TX characters dropped or overwritten, RX characters lost */
+static volatile uint32_t s_u32DbgStarted = 0;
+#endif
+
 #if defined(DEBUG_ENABLE_SEMIHOST)
 #if (defined(__ARMCC_VERSION) || defined(__ICCARM__))
+#if (DEBUG_SEMIHOST_RAM_LOG_SIZE & (DEBUG_SEMIHOST_RAM_LOG_SIZE - 1))
+#error "DEBUG_SEMIHOST_RAM_LOG_SIZE must be power of 2"
+#endif
+
+#define SH_SYS_OPEN     0x01
+#define SH_SYS_WRITE0   0x04
+#define SH_SYS_WRITE    0x05
+
 /* The static buffer is used to speed up the semihost */
-static char g_buf[16];
-static char g_buf_len = 0;
+static char g_buf[DEBUG_SEMIHOST_BUF_SIZE + 1];
+static uint32_t g_buf_len = 0;
+static uint32_t g_buf_tick = 0;     /* SH_GetTickMs() when first character was buffered */
+static int32_t g_sh_handle = -1;    /* Debugger console handle for SYS_WRITE */
 static volatile int32_t g_ICE_Conneced = 1;
 
+/* Semihost output kept here when ICE is not connected. Read it with debugger or after reset. */
+char g_acSHRamLog[DEBUG_SEMIHOST_RAM_LOG_SIZE];
+volatile uint32_t g_u32SHRamLogHead = 0;   /* Free running write index */
+
+void SH_Flush(void);
+uint32_t SH_GetTickMs(void);
+
+static void SH_SaveToRam(const char *pcBuf, uint32_t u32Len)
+{
+    while(u32Len--)
+        g_acSHRamLog[(g_u32SHRamLogHead++) & (DEBUG_SEMIHOST_RAM_LOG_SIZE - 1)] = *pcBuf++;
+}
+
 /**
  * @brief    This function is called by Hardfault handler.
  * @param    None
@@ -140,7 +180,18 @@ uint32_t ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp)
     /* It is casued by hardfault (Not semihost). Just process the hard fault here. */
     /* TODO: Implement your hardfault handle code here */
 
+    /* Semihost cannot be used in HardFault. Keep pending output in RAM log. */
+    SH_SaveToRam(g_buf, g_buf_len);
+    g_buf_len = 0;
+
+#if defined(DEBUG_INT_CONSOLE)
+    /* Push out buffered messages. IRQ handler of debug port cannot run here. */
+    FlushDebugFifo();
     printf("  HardFault!\n\n");
+    FlushDebugFifo();
+#else
+    printf("  HardFault!\n\n");
+#endif
 
     /*
     printf("  HardFault!\n\n");
@@ -184,6 +235,92 @@ int32_t SH_Return(int32_t n32In_R0, int32_t n32In_R1, int32_t *pn32Out_R0)
 }
 
 
+/**
+ * @brief    Get millisecond tick for semihost output batching
+ *
+ * @param    None
+ *
+ * @returns  Free running millisecond counter
+ *
+ * @details  Used only if DEBUG_SEMIHOST_FLUSH_MS is not 0. The default implementation returns 0, so buffered
+ *           output is written only when the buffer is full or SH_Flush() is called.
+ *           Override it with the application time base.
+ */
+#if defined( __ICCARM__ )
+__WEAK
+#else
+__attribute__((weak))
+#endif
+uint32_t SH_GetTickMs(void)
+{
+    return 0;
+}
+
+
+/**
+ * @brief    Write buffered semihost output
+ *
+ * @param    None
+ *
+ * @returns  None
+ *
+ * @details  Write the whole buffer with one SYS_WRITE call to the debugger console, so output is binary safe.
+ *           If the debugger cannot open its console, SYS_WRITE0 is used instead.
+ *           Without ICE, output goes to DEBUG_PORT if DEBUG_ENABLE_SEMIHOST is 2, or to g_acSHRamLog otherwise.
+ *           Call it from idle loop to bound output latency when DEBUG_SEMIHOST_FLUSH_MS is used.
+ */
+void SH_Flush(void)
+{
+    int32_t ai32Param[3];
+    int32_t i32Ret;
+
+    if(g_buf_len == 0)
+        return;
+
+    if(g_ICE_Conneced && (g_sh_handle < 0))
+    {
+        /* Open debugger console ":tt" for write. Fails to ICE offline on first call without ICE. */
+        ai32Param[0] = (int32_t)":tt";
+        ai32Param[1] = 4;
+        ai32Param[2] = 3;
+        if(SH_DoCommand(SH_SYS_OPEN, (int32_t)ai32Param, &i32Ret) != 0)
+            g_sh_handle = i32Ret;
+    }
+
+    if(g_ICE_Conneced)
+    {
+        if(g_sh_handle >= 0)
+        {
+            ai32Param[0] = g_sh_handle;
+            ai32Param[1] = (int32_t)g_buf;
+            ai32Param[2] = (int32_t)g_buf_len;
+            i32Ret = SH_DoCommand(SH_SYS_WRITE, (int32_t)ai32Param, NULL);
+        }
+        else
+        {
+            g_buf[g_buf_len] = '\0';
+            i32Ret = SH_DoCommand(SH_SYS_WRITE0, (int32_t)g_buf, NULL);
+        }
+
+        if(i32Ret != 0)
+        {
+            g_buf_len = 0;
+            return;
+        }
+    }
+
+# if (DEBUG_ENABLE_SEMIHOST == 2) // Re-direct to UART Debug Port only when DEBUG_ENABLE_SEMIHOST=2
+    {
+        uint32_t i;
+
+        for(i = 0; i < g_buf_len; i++)
+            SendChar_ToUART(g_buf[i]);
+    }
+# else
+    SH_SaveToRam(g_buf, g_buf_len);
+# endif
+    g_buf_len = 0;
+}
 
 #endif
 #else // defined(DEBUG_ENABLE_SEMIHOST)
@@ -229,7 +366,14 @@ uint32_t ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp)
     }
 #endif
 
+#if defined(DEBUG_INT_CONSOLE)
+    /* Push out buffered messages. IRQ handler of debug port cannot run here. */
+    FlushDebugFifo();
+    printf("  HardFault!\n\n");
+    FlushDebugFifo();
+#else
     printf("  HardFault!\n\n");
+#endif
 
     /*
     printf("  HardFault!\n\n");
@@ -267,7 +411,119 @@ int32_t SH_Return(int32_t n32In_R0, int32_t n32In_R1, int32_t *pn32Out_R0)
  *
  * @details  Send a target char to UART debug port .
  */
-#ifndef NONBLOCK_PRINTF
+#if defined(DEBUG_INT_CONSOLE)
+
+/* Start interrupt driven debug console on first use, after application has opened DEBUG_PORT */
+static void DebugConsole_Start(void)
+{
+    if(s_u32DbgStarted)
+        return;
+
+    s_u32DbgStarted = 1;
+    DEBUG_PORT->IER |= UART_IER_RDA_IEN_Msk;
+    NVIC_EnableIRQ(DEBUG_PORT_IRQn);
+}
+
+/* Move TX ring to UART FIFO. Must not be preempted by DEBUG_PORT_IRQHandler. */
+static void DebugConsole_DrainTx(void)
+{
+    uint32_t u32Tail = s_u32DbgTxTail;
+
+    while((u32Tail != s_u32DbgTxHead) && !(DEBUG_PORT->FSR & UART_FSR_TX_FULL_Msk))
+        DEBUG_PORT->DATA = s_au8DbgTxBuf[(u32Tail++) & (DEBUG_TX_BUF_SIZE - 1)];
+
+    s_u32DbgTxTail = u32Tail;
+}
+
+static void DebugConsole_PutTx(uint8_t u8Ch)
+{
+    uint32_t u32PriMask;
+
+    while(1)
+    {
+        u32PriMask = __get_PRIMASK();
+        __disable_irq();
+
+        if((s_u32DbgTxHead - s_u32DbgTxTail) < DEBUG_TX_BUF_SIZE)
+            break;
+
+#if (DEBUG_TX_OVERFLOW == DEBUG_OVERFLOW_OVERWRITE)
+        /* Discard the oldest character */
+        s_u32DbgTxTail++;
+        s_u32DbgDrop++;
+        break;
+#elif (DEBUG_TX_OVERFLOW == DEBUG_OVERFLOW_BLOCK)
+        /* IRQ handler drains the ring. If it cannot run (IRQ masked or called from handler), drain here. */
+        if(u32PriMask || (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk))
+            DebugConsole_DrainTx();
+        __set_PRIMASK(u32PriMask);
+#else
+        s_u32DbgDrop++;
+        __set_PRIMASK(u32PriMask);
+        return;
+#endif
+    }
+
+    s_au8DbgTxBuf[(s_u32DbgTxHead) & (DEBUG_TX_BUF_SIZE - 1)] = u8Ch;
+    s_u32DbgTxHead++;
+    DEBUG_PORT->IER |= UART_IER_THRE_IEN_Msk;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+ * @brief    Debug port IRQ handler
+ *
+ * @param    None
+ *
+ * @returns  None
+ *
+ * @details  Move received characters to RX ring and refill TX FIFO from TX ring.
+ *           THRE interrupt is disabled when TX ring is empty.
+ */
+void DEBUG_PORT_IRQHandler(void)
+{
+    uint32_t u32IntSts = DEBUG_PORT->ISR;
+    uint8_t u8Ch;
+
+    if(u32IntSts & UART_ISR_RDA_INT_Msk)
+    {
+        while(!(DEBUG_PORT->FSR & UART_FSR_RX_EMPTY_Msk))
+        {
+            u8Ch = (uint8_t)DEBUG_PORT->DATA;
+            if((s_u32DbgRxHead - s_u32DbgRxTail) < DEBUG_RX_BUF_SIZE)
+            {
+                s_au8DbgRxBuf[s_u32DbgRxHead & (DEBUG_RX_BUF_SIZE - 1)] = u8Ch;
+                s_u32DbgRxHead++;
+            }
+            else
+                s_u32DbgDrop++;
+        }
+    }
+
+    if(u32IntSts & UART_ISR_THRE_INT_Msk)
+    {
+        DebugConsole_DrainTx();
+        if(s_u32DbgTxTail == s_u32DbgTxHead)
+            DEBUG_PORT->IER &= ~UART_IER_THRE_IEN_Msk;
+    }
+}
+
+void SendChar_ToUART(int ch)
+{
+    /* ch == 0 is a flush request of non-block printf. IRQ handler drains the ring anyway. */
+    if(ch == 0)
+        return;
+
+    DebugConsole_Start();
+
+    if((char)ch == '\n')
+        DebugConsole_PutTx('\r');
+
+    DebugConsole_PutTx((uint8_t)ch);
+}
+
+#elif !defined(NONBLOCK_PRINTF)
 void SendChar_ToUART(int ch)
 {
     if((char)ch == '\n')
@@ -350,32 +606,20 @@ void SendChar(int ch)
 {
 #if defined(DEBUG_ENABLE_SEMIHOST)
 
-    g_buf[g_buf_len++] = (char)ch;
-    g_buf[g_buf_len] = '\0';
-    if(g_buf_len + 1 >= sizeof(g_buf) || ch == '\n' || ch == '\0')
-    {
-        /* Send the char */
-        if(g_ICE_Conneced)
-        {
+    if(g_buf_len == 0)
+        g_buf_tick = SH_GetTickMs();
 
-            if(SH_DoCommand(0x04, (int)g_buf, NULL) != 0)
-            {
-                g_buf_len = 0;
-
-                return;
-            }
-        }
-        else
-        {
-# if (DEBUG_ENABLE_SEMIHOST == 2) // Re-direct to UART Debug Port only when DEBUG_ENABLE_SEMIHOST=2           
-            int i;
+    g_buf[g_buf_len++] = (char)ch;
 
-            for(i = 0; i < g_buf_len; i++)
-                SendChar_ToUART(g_buf[i]);
-            g_buf_len = 0;
+    if(g_buf_len >= DEBUG_SEMIHOST_BUF_SIZE)
+        SH_Flush();
+# if (DEBUG_SEMIHOST_FLUSH_MS == 0)
+    else if(ch == '\n')
+        SH_Flush();
+# else
+    else if((SH_GetTickMs() - g_buf_tick) >= DEBUG_SEMIHOST_FLUSH_MS)
+        SH_Flush();
 # endif
-        }
-    }
 #else
     SendChar_ToUART(ch);
 #endif
@@ -395,6 +639,8 @@ char GetChar(void)
 #ifdef DEBUG_ENABLE_SEMIHOST
 # if defined (__ICCARM__)
     int nRet;
+    /* Show pending prompt before waiting for input */
+    SH_Flush();
     while(SH_DoCommand(0x7, 0, &nRet) != 0)
     {
         if(nRet != 0)
@@ -402,6 +648,8 @@ char GetChar(void)
     }
 # else
     int nRet;
+    /* Show pending prompt before waiting for input */
+    SH_Flush();
     while(SH_DoCommand(0x101, 0, &nRet) != 0)
     {
         if(nRet != 0)
@@ -419,13 +667,19 @@ char GetChar(void)
     {
         if((DEBUG_PORT->FSR & UART_FSR_RX_EMPTY_Msk) == 0)
         {
-            return (DEBUG_PORT->DAT);
+            return (DEBUG_PORT->DATA);
         }
     }
 # endif
 
 # endif
     return (0);
+#elif defined(DEBUG_INT_CONSOLE)
+    int ch;
+
+    while((ch = GetCharNonBlock()) < 0) {}
+
+    return (char)ch;
 #else
 
     while(1)
@@ -439,6 +693,37 @@ char GetChar(void)
 #endif
 }
 
+/**
+ * @brief    Routine to get a char without waiting
+ *
+ * @param    None
+ *
+ * @returns  Received character, or -1 if no character is available
+ *
+ * @details  Read one character from debug port RX ring (DEBUG_INT_CONSOLE) or RX FIFO.
+ */
+int GetCharNonBlock(void)
+{
+#if defined(DEBUG_INT_CONSOLE)
+    int ch;
+
+    DebugConsole_Start();
+
+    if(s_u32DbgRxTail == s_u32DbgRxHead)
+        return -1;
+
+    ch = s_au8DbgRxBuf[s_u32DbgRxTail & (DEBUG_RX_BUF_SIZE - 1)];
+    s_u32DbgRxTail++;
+
+    return ch;
+#else
+    if(DEBUG_PORT->FSR & UART_FSR_RX_EMPTY_Msk)
+        return -1;
+
+    return (int)(DEBUG_PORT->DATA & 0xFF);
+#endif
+}
+
 /**
  * @brief    Check any char input from UART
  *
@@ -452,7 +737,12 @@ char GetChar(void)
 
 int kbhit(void)
 {
+#if defined(DEBUG_INT_CONSOLE)
+    DebugConsole_Start();
+    return (s_u32DbgRxTail == s_u32DbgRxHead);
+#else
     return !((DEBUG_PORT->FSR & UART_FSR_RX_EMPTY_Msk) == 0U);
+#endif
 }
 /**
  * @brief    Check if debug message finished
@@ -467,9 +757,53 @@ int kbhit(void)
 
 int IsDebugFifoEmpty(void)
 {
+#if defined(DEBUG_INT_CONSOLE)
+    if(s_u32DbgTxTail != s_u32DbgTxHead)
+        return 0;
+#endif
     return ((DEBUG_PORT->FSR & UART_FSR_TE_FLAG_Msk) != 0U);
 }
 
+/**
+ * @brief    Send out all buffered debug messages
+ *
+ * @param    None
+ *
+ * @returns  None
+ *
+ * @details  Drain TX ring by polling with interrupts masked and wait until debug port is idle.
+ *           Safe to call from fault handlers, where the debug port IRQ handler cannot run.
+ */
+void FlushDebugFifo(void)
+{
+#if defined(DEBUG_INT_CONSOLE)
+    uint32_t u32PriMask = __get_PRIMASK();
+
+    __disable_irq();
+    while(s_u32DbgTxTail != s_u32DbgTxHead)
+        DebugConsole_DrainTx();
+    __set_PRIMASK(u32PriMask);
+#endif
+    while((DEBUG_PORT->FSR & UART_FSR_TE_FLAG_Msk) == 0U) {}
+}
+
+/**
+ * @brief    Get number of lost debug characters
+ *
+ * @param    None
+ *
+ * @returns  Number of TX characters dropped or overwritten and RX characters lost because a ring was full.
+ *           Always 0 if DEBUG_INT_CONSOLE is not defined.
+ */
+uint32_t GetDebugDropCount(void)
+{
+#if defined(DEBUG_INT_CONSOLE)
+    return s_u32DbgDrop;
+#else
+    return 0;
+#endif
+}
+
 /**
  * @brief    C library retargetting
  *
@@ -520,6 +854,10 @@ int _write (int fd, char *ptr, int len)
 {
     int i = len;
 
+#if defined(DEBUG_INT_CONSOLE)
+    while(i--)
+        SendChar_ToUART(*ptr++);
+#else
     while(i--) {
         if(*ptr == '\n') {
             while(DEBUG_PORT->FSR & UART_FSR_TX_FULL_Msk);
@@ -530,14 +868,18 @@ int _write (int fd, char *ptr, int len)
         DEBUG_PORT->DATA = *ptr++;
 
     }
+#endif
     return len;
 }
 
 int _read (int fd, char *ptr, int len)
 {
-
+#if defined(DEBUG_INT_CONSOLE)
+    *ptr = GetChar();
+#else
     while((DEBUG_PORT->FSR & UART_FSR_RX_EMPTY_Msk) != 0);
     *ptr = DEBUG_PORT->DATA;
+#endif
     return 1;
 
 
@@ -588,6 +930,7 @@ int ferror(FILE *stream)
 # ifdef __ICCARM__
 void __exit(int return_code)
 {
+    SH_Flush();
 
     /* Check if link with ICE */
     if(SH_DoCommand(0x18, 0x20026, NULL) == 0)
@@ -602,6 +945,7 @@ label:
 void _sys_exit(int return_code)
 {
     (void)return_code;
+    SH_Flush();
     /* Check if link with ICE */
     if(SH_DoCommand(0x18, 0x20026, NULL) == 0)
     {
@@ -0,0 +1,354 @@
+/**************************************************************************//**
+ * @file     rs485.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series RS485 multi-drop link layer source file
+ *
+ * @note     A frame is an address byte, sent with the 9th bit set, followed by the payload. The UART runs in RS485
+ *           auto address detection (AAD) mode, so bytes of frames to other nodes never reach the RX FIFO and
+ *           cause no interrupt. RTS is driven by the hardware (AUD) while sending.
+ *           The RX FIFO interrupts at 8 bytes and the handler always leaves one byte in the FIFO. The RX
+ *           time-out then fires \ref RS485_GAP_CHARS after the last byte of a frame and ends it, so a frame of
+ *           n bytes takes about n / 7 + 1 interrupts.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_RS485_Driver RS485 Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define RS485_FIFO_SIZE     16
+
+#define RS485_RX_ADDR       0       /* Next byte is the address byte */
+#define RS485_RX_DATA       1
+#define RS485_RX_ERROR      2       /* Discard until the frame ends */
+#define RS485_RX_LONG       3
+#define RS485_RX_DROP       4       /* Previous frame not read yet */
+
+static uint8_t s_au8Rs485Rx[RS485_MAX_FRAME];
+static uint32_t s_u32Rs485RxLen;
+static uint32_t s_u32Rs485RxState = RS485_RX_ADDR;
+static volatile uint32_t s_u32Rs485Ready = 0;   /* Frame waits in s_au8Rs485Rx for RS485_Receive() */
+static RS485_FUNC_T s_pfnRs485Func;
+
+static const uint8_t *s_pu8Rs485Tx;
+static volatile uint32_t s_u32Rs485TxLen = 0;
+static uint32_t s_u32Rs485Delay;                /* Turnaround in bit times */
+
+static RS485_STATS_T s_sRs485Stats;
+
+static void RS485_EndFrame(void)
+{
+    switch(s_u32Rs485RxState)
+    {
+        case RS485_RX_DATA:
+            s_sRs485Stats.u32RxFrames++;
+            s_sRs485Stats.u32RxBytes += s_u32Rs485RxLen;
+            if(s_pfnRs485Func != NULL)
+                s_pfnRs485Func(s_au8Rs485Rx, s_u32Rs485RxLen);
+            else
+                s_u32Rs485Ready = 1;
+            break;
+
+        case RS485_RX_ERROR:
+            s_sRs485Stats.u32LineError++;
+            break;
+
+        case RS485_RX_LONG:
+            s_sRs485Stats.u32TooLong++;
+            break;
+
+        case RS485_RX_DROP:
+            s_sRs485Stats.u32Dropped++;
+            break;
+
+        default:
+            break;
+    }
+
+    s_u32Rs485RxState = RS485_RX_ADDR;
+}
+
+static void RS485_RxByte(uint32_t u32Data)
+{
+    switch(s_u32Rs485RxState)
+    {
+        case RS485_RX_ADDR:
+            /* Hardware matched the address, only the payload is kept */
+            s_u32Rs485RxState = s_u32Rs485Ready ? RS485_RX_DROP : RS485_RX_DATA;
+            s_u32Rs485RxLen = 0;
+            break;
+
+        case RS485_RX_DATA:
+            if(s_u32Rs485RxLen < RS485_MAX_FRAME)
+                s_au8Rs485Rx[s_u32Rs485RxLen++] = u32Data;
+            else
+                s_u32Rs485RxState = RS485_RX_LONG;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_RS485_EXPORTED_FUNCTIONS RS485 Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Open the RS485 link
+  *
+  * @param[in]  u32BaudRate Baud rate
+  * @param[in]  u32Addr     Address of this node, 0 ~ 255
+  * @param[in]  pfnFunc     Called from the interrupt with each frame received, or NULL to read frames with
+  *                         \ref RS485_Receive
+  *
+  * @return     None
+  *
+  * @details    Set up \ref RS485_UART in RS485 AAD and AUD mode with 9-bit characters, the RX time-out at
+  *             \ref RS485_GAP_CHARS characters and the TX delay at \ref RS485_TURNAROUND_US.
+  *             The UART clock and the RXD, TXD and RTS pins are set up by the application, and the UART IRQ
+  *             handler must call \ref RS485_IRQHandler.
+  */
+void RS485_Open(uint32_t u32BaudRate, uint32_t u32Addr, RS485_FUNC_T pfnFunc)
+{
+    s_pfnRs485Func = pfnFunc;
+    s_u32Rs485RxState = RS485_RX_ADDR;
+    s_u32Rs485Ready = 0;
+    s_u32Rs485TxLen = 0;
+    RS485_ResetStats();
+
+    /* Round up, at least one bit */
+    s_u32Rs485Delay = (RS485_TURNAROUND_US * u32BaudRate + 999999) / 1000000;
+    if(s_u32Rs485Delay == 0)
+        s_u32Rs485Delay = 1;
+    else if(s_u32Rs485Delay > 0xFF)
+        s_u32Rs485Delay = 0xFF;
+
+    UART_Open(RS485_UART, u32BaudRate);
+    UART_SetLine_Config(RS485_UART, 0, UART_WORD_LEN_8, UART_PARITY_SPACE, UART_STOP_BIT_1);
+    RS485_UART->MCR = (RS485_UART->MCR & ~UART_MCR_LEV_RTS_Msk) | RS485_RTS_LEVEL;
+    UART_SelectRS485Mode(RS485_UART, UART_ALT_CSR_RS485_AAD_Msk | UART_ALT_CSR_RS485_AUD_Msk, u32Addr);
+    RS485_UART->ALT_CSR |= UART_ALT_CSR_RS485_ADD_EN_Msk;
+
+    RS485_UART->FCR = (RS485_UART->FCR & ~UART_FCR_RFITL_Msk) | UART_FCR_RFITL_8BYTES |
+                      UART_FCR_RFR_Msk | UART_FCR_TFR_Msk;
+    UART_SetTimeoutCnt(RS485_UART, RS485_GAP_CHARS * RS485_CHAR_BITS);
+    UART_ClearIntFlag(RS485_UART, UART_ISR_RLS_INT_Msk | UART_ISR_BUF_ERR_INT_Msk);
+
+    UART_ENABLE_INT(RS485_UART, UART_IER_RDA_IEN_Msk | UART_IER_RTO_IEN_Msk | UART_IER_RLS_IEN_Msk |
+                    UART_IER_BUF_ERR_IEN_Msk);
+    NVIC_EnableIRQ(RS485_UART_IRQn);
+}
+
+/**
+  * @brief      Close the RS485 link
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void RS485_Close(void)
+{
+    NVIC_DisableIRQ(RS485_UART_IRQn);
+    UART_DISABLE_INT(RS485_UART, UART_IER_RDA_IEN_Msk | UART_IER_RTO_IEN_Msk | UART_IER_RLS_IEN_Msk |
+                     UART_IER_BUF_ERR_IEN_Msk | UART_IER_THRE_IEN_Msk | UART_IER_TIME_OUT_EN_Msk);
+    UART_Close(RS485_UART);
+    s_u32Rs485TxLen = 0;
+}
+
+/**
+  * @brief      Send a frame
+  *
+  * @param[in]  u32Addr     Destination address
+  * @param[in]  pu8Data     Payload, must stay valid until \ref RS485_IsTxBusy returns 0
+  * @param[in]  u32Len      Payload length
+  *
+  * @retval     0   Frame started
+  * @retval     -1  Previous frame still being sent
+  *
+  * @details    The address byte is sent after the turnaround delay, this function waits until it is out
+  *             because the 9th bit is changed for the payload. The payload is sent from the THRE interrupt.
+  * @note       The wait polls TE_FLAG with interrupts enabled, for the turnaround delay plus one character,
+  *             about 200 us at 115200 bps. Callers in an interrupt, like a frame callback, block that long.
+  */
+int32_t RS485_Send(uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    if(RS485_IsTxBusy())
+        return -1;
+
+    RS485_UART->TOR = (RS485_UART->TOR & ~UART_TOR_DLY_Msk) | (s_u32Rs485Delay << UART_TOR_DLY_Pos);
+    RS485_UART->LCR = UART_WORD_LEN_8 | UART_PARITY_MARK | UART_STOP_BIT_1;
+    RS485_UART->THR = u32Addr;
+    while(!(RS485_UART->FSR & UART_FSR_TE_FLAG_Msk));
+
+    RS485_UART->TOR &= ~UART_TOR_DLY_Msk;
+    RS485_UART->LCR = UART_WORD_LEN_8 | UART_PARITY_SPACE | UART_STOP_BIT_1;
+
+    s_sRs485Stats.u32TxFrames++;
+    if(u32Addr < RS485_PEER_NUM)
+        s_sRs485Stats.au32PeerTx[u32Addr]++;
+    if(u32Len)
+    {
+        s_pu8Rs485Tx = pu8Data;
+        s_u32Rs485TxLen = u32Len;
+        UART_ENABLE_INT(RS485_UART, UART_IER_THRE_IEN_Msk);
+    }
+
+    return 0;
+}
+
+/**
+  * @brief      Check if a frame is being sent
+  *
+  * @param      None
+  *
+  * @return     0 if the transmitter is idle and RTS released, otherwise not 0
+  */
+uint32_t RS485_IsTxBusy(void)
+{
+    return s_u32Rs485TxLen || !(RS485_UART->FSR & UART_FSR_TE_FLAG_Msk);
+}
+
+/**
+  * @brief      Get a received frame
+  *
+  * @param[out] pu8Buf      Buffer
+  * @param[in]  u32Size     Buffer size, longer payloads are truncated
+  *
+  * @return     Payload length, 0 if no frame is waiting
+  *
+  * @details    Only used without callback. Frames that arrive before the last one is read are dropped.
+  */
+uint32_t RS485_Receive(uint8_t *pu8Buf, uint32_t u32Size)
+{
+    uint32_t u32Len;
+
+    if(!s_u32Rs485Ready)
+        return 0;
+
+    u32Len = s_u32Rs485RxLen;
+    memcpy(pu8Buf, s_au8Rs485Rx, (u32Len < u32Size) ? u32Len : u32Size);
+    s_u32Rs485Ready = 0;
+
+    return u32Len;
+}
+
+/**
+  * @brief      RS485 interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref RS485_UART.
+  */
+void RS485_IRQHandler(void)
+{
+    uint32_t u32Isr = RS485_UART->ISR;
+    uint32_t u32Fsr = RS485_UART->FSR;
+    uint32_t u32Cnt;
+
+    s_sRs485Stats.u32Interrupts++;
+
+    if(u32Fsr & (UART_FSR_BIF_Msk | UART_FSR_FEF_Msk | UART_FSR_PEF_Msk))
+    {
+        if(s_u32Rs485RxState == RS485_RX_DATA)
+            s_u32Rs485RxState = RS485_RX_ERROR;
+    }
+    if(u32Fsr & UART_FSR_RX_OVER_IF_Msk)
+    {
+        s_sRs485Stats.u32Overflow++;
+        if(s_u32Rs485RxState == RS485_RX_DATA)
+            s_u32Rs485RxState = RS485_RX_ERROR;
+    }
+    UART_ClearIntFlag(RS485_UART, UART_ISR_RLS_INT_Msk | UART_ISR_BUF_ERR_INT_Msk);
+
+    if(u32Isr & (UART_ISR_RDA_INT_Msk | UART_ISR_TOUT_INT_Msk))
+    {
+        u32Fsr = RS485_UART->FSR;
+        u32Cnt = (u32Fsr & UART_FSR_RX_FULL_Msk) ? RS485_FIFO_SIZE :
+                 (u32Fsr & UART_FSR_RX_POINTER_Msk) >> UART_FSR_RX_POINTER_Pos;
+
+        /* Keep one byte, so the time-out reports the end of the frame */
+        if(!(u32Isr & UART_ISR_TOUT_INT_Msk) && u32Cnt)
+            u32Cnt--;
+
+        while(u32Cnt--)
+            RS485_RxByte(RS485_UART->RBR);
+
+        if(u32Isr & UART_ISR_TOUT_INT_Msk)
+            RS485_EndFrame();
+    }
+
+    if(u32Isr & UART_ISR_THRE_INT_Msk)
+    {
+        for(u32Cnt = 0; (u32Cnt < RS485_FIFO_SIZE) && s_u32Rs485TxLen; u32Cnt++)
+        {
+            RS485_UART->THR = *s_pu8Rs485Tx++;
+            s_u32Rs485TxLen--;
+        }
+        if(s_u32Rs485TxLen == 0)
+            UART_DISABLE_INT(RS485_UART, UART_IER_THRE_IEN_Msk);
+    }
+}
+
+/**
+  * @brief      Get statistics
+  *
+  * @param[out] psStats     Statistics
+  *
+  * @return     None
+  */
+void RS485_GetStats(RS485_STATS_T *psStats)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    *psStats = s_sRs485Stats;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Clear statistics
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void RS485_ResetStats(void)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    memset(&s_sRs485Stats, 0, sizeof(s_sRs485Stats));
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/*@}*/ /* end of group NUC029_RS485_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_RS485_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,193 @@
+/**************************************************************************//**
+ * @file     sched.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:49p $
+ * @brief    NUC029 series cooperative run-to-completion scheduler source file
+ *
+ * @note     Tasks are identified by priority, 0 is the highest. A task runs to completion and is made ready
+ *           again only by SCHED_PostEvent(), which may be called from interrupt handlers.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+#if (SCHED_MAX_TASKS < 1) || (SCHED_MAX_TASKS > 32)
+#error "SCHED_MAX_TASKS must be 1 ~ 32"
+#endif
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_SCHED_Driver SCHED Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+typedef struct
+{
+    SCHED_FUNC_T pfnTask;
+    void *pvArg;
+    volatile uint32_t u32Events;    /* Events posted and not yet delivered */
+    uint32_t u32RunCount;
+} SCHED_TASK_T;
+
+static SCHED_TASK_T s_asSchedTask[SCHED_MAX_TASKS];
+static volatile uint32_t s_u32SchedReady = 0;   /* Bit n set if task of priority n is ready */
+
+/* Cortex-M0 has no CLZ. Index of lowest set bit by de Bruijn multiply, constant time. */
+static const uint8_t s_au8SchedLsb[32] =
+{
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+#define SCHED_LSB(x)    (s_au8SchedLsb[(uint32_t)(((x) & (0UL - (x))) * 0x077CB531UL) >> 27])
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_SCHED_EXPORTED_FUNCTIONS SCHED Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Register a task
+  *
+  * @param[in]  u32Prio     Task priority, 0 ~ (SCHED_MAX_TASKS - 1). 0 is the highest. Each priority holds one task.
+  * @param[in]  pfnTask     Task function
+  * @param[in]  pvArg       Argument passed to task function
+  *
+  * @retval     0   Success
+  * @retval     -1  Priority out of range or already used
+  *
+  * @details    The task is not ready until an event is posted to it.
+  */
+int32_t SCHED_AddTask(uint32_t u32Prio, SCHED_FUNC_T pfnTask, void *pvArg)
+{
+    if((u32Prio >= SCHED_MAX_TASKS) || (pfnTask == NULL) || (s_asSchedTask[u32Prio].pfnTask != NULL))
+        return -1;
+
+    s_asSchedTask[u32Prio].pvArg = pvArg;
+    s_asSchedTask[u32Prio].u32Events = 0;
+    s_asSchedTask[u32Prio].u32RunCount = 0;
+    s_asSchedTask[u32Prio].pfnTask = pfnTask;
+
+    return 0;
+}
+
+/**
+  * @brief      Post events to a task
+  *
+  * @param[in]  u32Prio     Priority of target task
+  * @param[in]  u32Events   Event flags OR'ed into pending events of the task
+  *
+  * @return     None
+  *
+  * @details    Make the task ready. Safe to call from thread and interrupt context.
+  *             Events posted several times before the task runs are delivered once.
+  */
+void SCHED_PostEvent(uint32_t u32Prio, uint32_t u32Events)
+{
+    uint32_t u32PriMask;
+
+    if(u32Prio >= SCHED_MAX_TASKS)
+        return;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    s_asSchedTask[u32Prio].u32Events |= u32Events;
+    s_u32SchedReady |= (1UL << u32Prio);
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Run the highest priority ready task
+  *
+  * @param      None
+  *
+  * @retval     0   No task was ready
+  * @retval     1   One task was run
+  *
+  * @details    Use this function to add the scheduler to an existing super-loop. It never enters idle mode.
+  */
+uint32_t SCHED_RunOnce(void)
+{
+    uint32_t u32Ready, u32Prio, u32Events, u32PriMask;
+    SCHED_TASK_T *psTask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    u32Ready = s_u32SchedReady;
+    if(u32Ready == 0)
+    {
+        __set_PRIMASK(u32PriMask);
+        return 0;
+    }
+
+    u32Prio = SCHED_LSB(u32Ready);
+    psTask = &s_asSchedTask[u32Prio];
+    u32Events = psTask->u32Events;
+    psTask->u32Events = 0;
+    s_u32SchedReady = u32Ready & ~(1UL << u32Prio);
+    __set_PRIMASK(u32PriMask);
+
+    if(psTask->pfnTask != NULL)
+    {
+        psTask->u32RunCount++;
+        psTask->pfnTask(u32Events, psTask->pvArg);
+    }
+
+    return 1;
+}
+
+/**
+  * @brief      Run scheduler forever
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Dispatch ready tasks in priority order. When no task is ready, \ref SCHED_IDLE is called
+  *             with interrupts masked, so an event posted by an interrupt just before cannot be missed:
+  *             the pending interrupt wakes the CPU up and is serviced after interrupts are unmasked.
+  */
+void SCHED_Run(void)
+{
+    while(1)
+    {
+        if(SCHED_RunOnce())
+            continue;
+
+        __disable_irq();
+        if(s_u32SchedReady == 0)
+            SCHED_IDLE();
+        __enable_irq();
+    }
+}
+
+/**
+  * @brief      Get number of times a task has run
+  *
+  * @param[in]  u32Prio     Task priority
+  *
+  * @return     Run count of task, 0 if priority is out of range
+  */
+uint32_t SCHED_GetRunCount(uint32_t u32Prio)
+{
+    if(u32Prio >= SCHED_MAX_TASKS)
+        return 0;
+
+    return s_asSchedTask[u32Prio].u32RunCount;
+}
+
+/*@}*/ /* end of group NUC029_SCHED_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_SCHED_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -48,6 +48,8 @@ uint32_t SPI_Open(SPI_T *spi,
 {
     uint32_t u32ClkSrc = 0, u32Div;
 
+    TRACE_DRV_ENTER(TRACE_ID_SPI_OPEN, u32BusClock / 1000);
+
     if(u32DataWidth == 32)
         u32DataWidth = 0;
 
@@ -82,6 +84,7 @@ uint32_t SPI_Open(SPI_T *spi,
         {
             /* Set DIVIDER = 0 */
             spi->DIVIDER = 0;
+            TRACE_DRV_EXIT(TRACE_ID_SPI_OPEN, spi->DIVIDER);
             /* Return master peripheral clock rate */
             return u32ClkSrc;
         }
@@ -91,6 +94,7 @@ uint32_t SPI_Open(SPI_T *spi,
             spi->CNTRL2 &= (~SPI_CNTRL2_BCn_Msk);
             /* Set DIVIDER to the maximum value 0xFF */
             spi->DIVIDER = (spi->DIVIDER & (~SPI_DIVIDER_DIVIDER_Msk)) | (0xFF << SPI_DIVIDER_DIVIDER_Pos);
+            TRACE_DRV_EXIT(TRACE_ID_SPI_OPEN, spi->DIVIDER);
             /* Return master peripheral clock rate */
             return (u32ClkSrc / ((0xFF + 1) * 2));
         }
@@ -105,12 +109,14 @@ uint32_t SPI_Open(SPI_T *spi,
                 if(u32Div > 0xFF)
                     u32Div = 0xFF;
                 spi->DIVIDER = (spi->DIVIDER & (~SPI_DIVIDER_DIVIDER_Msk)) | (u32Div << SPI_DIVIDER_DIVIDER_Pos);
+                TRACE_DRV_EXIT(TRACE_ID_SPI_OPEN, spi->DIVIDER);
                 /* Return master peripheral clock rate */
                 return (u32ClkSrc / ((u32Div + 1) * 2));
             }
             else
             {
                 spi->DIVIDER = (spi->DIVIDER & (~SPI_DIVIDER_DIVIDER_Msk)) | (u32Div << SPI_DIVIDER_DIVIDER_Pos);
+                TRACE_DRV_EXIT(TRACE_ID_SPI_OPEN, spi->DIVIDER);
                 /* Return master peripheral clock rate */
                 return (u32ClkSrc / (u32Div + 1));
             }
@@ -131,6 +137,7 @@ uint32_t SPI_Open(SPI_T *spi,
 
         /* Set DIVIDER = 0 */
         spi->DIVIDER = 0;
+        TRACE_DRV_EXIT(TRACE_ID_SPI_OPEN, spi->DIVIDER);
         /* Return slave peripheral clock rate */
         return u32ClkSrc;
     }
@@ -145,6 +152,8 @@ uint32_t SPI_Open(SPI_T *spi,
   */
 void SPI_Close(SPI_T *spi)
 {
+    TRACE_DRV_ENTER(TRACE_ID_SPI_CLOSE, 0);
+
     if(spi == SPI0)
     {
         /* Reset SPI */
@@ -157,6 +166,8 @@ void SPI_Close(SPI_T *spi)
         SYS->IPRSTC2 |= SYS_IPRSTC2_SPI1_RST_Msk;
         SYS->IPRSTC2 &= ~SYS_IPRSTC2_SPI1_RST_Msk;
     }
+
+    TRACE_DRV_EXIT(TRACE_ID_SPI_CLOSE, 0);
 }
 
 /**
@@ -222,6 +233,8 @@ uint32_t SPI_SetBusClock(SPI_T *spi, uint32_t u32BusClock)
     uint32_t u32ClkSrc;
     uint32_t u32Div;
 
+    TRACE_DRV_ENTER(TRACE_ID_SPI_SETBUSCLOCK, u32BusClock / 1000);
+
     /* Set BCn = 1: f_spi = f_spi_clk_src / (DIVIDER + 1) */
     spi->CNTRL2 |= SPI_CNTRL2_BCn_Msk;
 
@@ -245,6 +258,7 @@ uint32_t SPI_SetBusClock(SPI_T *spi, uint32_t u32BusClock)
     {
         /* Set DIVIDER = 0 */
         spi->DIVIDER = 0;
+        TRACE_DRV_EXIT(TRACE_ID_SPI_SETBUSCLOCK, spi->DIVIDER);
         /* Return master peripheral clock rate */
         return u32ClkSrc;
     }
@@ -254,6 +268,7 @@ uint32_t SPI_SetBusClock(SPI_T *spi, uint32_t u32BusClock)
         spi->CNTRL2 &= (~SPI_CNTRL2_BCn_Msk);
         /* Set DIVIDER to the maximum value 0xFF */
         spi->DIVIDER = (spi->DIVIDER & (~SPI_DIVIDER_DIVIDER_Msk)) | (0xFF << SPI_DIVIDER_DIVIDER_Pos);
+        TRACE_DRV_EXIT(TRACE_ID_SPI_SETBUSCLOCK, spi->DIVIDER);
         /* Return master peripheral clock rate */
         return (u32ClkSrc / ((0xFF + 1) * 2));
     }
@@ -268,12 +283,14 @@ uint32_t SPI_SetBusClock(SPI_T *spi, uint32_t u32BusClock)
             if(u32Div > 0xFF)
                 u32Div = 0xFF;
             spi->DIVIDER = (spi->DIVIDER & (~SPI_DIVIDER_DIVIDER_Msk)) | (u32Div << SPI_DIVIDER_DIVIDER_Pos);
+            TRACE_DRV_EXIT(TRACE_ID_SPI_SETBUSCLOCK, spi->DIVIDER);
             /* Return master peripheral clock rate */
             return (u32ClkSrc / ((u32Div + 1) * 2));
         }
         else
         {
             spi->DIVIDER = (spi->DIVIDER & (~SPI_DIVIDER_DIVIDER_Msk)) | (u32Div << SPI_DIVIDER_DIVIDER_Pos);
+            TRACE_DRV_EXIT(TRACE_ID_SPI_SETBUSCLOCK, spi->DIVIDER);
             /* Return master peripheral clock rate */
             return (u32ClkSrc / (u32Div + 1));
         }
@@ -0,0 +1,178 @@
+/**************************************************************************//**
+ * @file     tlog.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:49p $
+ * @brief    NUC029 series tokenized deferred log source file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdarg.h>
+#include "NUC029xAN.h"
+
+#if (TLOG_BUF_SIZE & (TLOG_BUF_SIZE - 1))
+#error "TLOG_BUF_SIZE must be power of 2"
+#endif
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_TLOG_Driver TLOG Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+static uint8_t s_au8TlogBuf[TLOG_BUF_SIZE];
+static volatile uint32_t s_u32TlogHead = 0;     /* Free running write index */
+static volatile uint32_t s_u32TlogTail = 0;     /* Free running read index */
+static uint32_t s_u32TlogDrop = 0;              /* Frames dropped, not reported yet */
+static uint32_t s_u32TlogDropTotal = 0;
+
+static uint32_t TLOG_PutVarint(uint8_t *pu8Buf, uint32_t u32Value)
+{
+    uint32_t u32Len = 0;
+
+    while(u32Value >= 0x80)
+    {
+        pu8Buf[u32Len++] = (uint8_t)(u32Value | 0x80);
+        u32Value >>= 7;
+    }
+    pu8Buf[u32Len++] = (uint8_t)u32Value;
+
+    return u32Len;
+}
+
+/* Must be called with interrupts masked */
+static void TLOG_Put(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32Head = s_u32TlogHead;
+
+    while(u32Len--)
+        s_au8TlogBuf[(u32Head++) & (TLOG_BUF_SIZE - 1)] = *pu8Data++;
+
+    s_u32TlogHead = u32Head;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_TLOG_EXPORTED_FUNCTIONS TLOG Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Queue a log frame
+  *
+  * @param[in]  u32Id       Format ID
+  * @param[in]  u32Argc     Number of 32-bit arguments that follow, up to \ref TLOG_MAX_ARGS
+  *
+  * @return     None
+  *
+  * @details    Normally called through \ref LOG. The frame is encoded on stack first, so interrupts are masked
+  *             only while it is copied into the ring. If the ring cannot hold the whole frame, the frame is
+  *             dropped and a drop frame with the count is queued ahead of the next frame that fits.
+  *             Safe to call from thread and interrupt context.
+  */
+void TLOG_Write(uint32_t u32Id, uint32_t u32Argc, ...)
+{
+    uint8_t au8Frame[3 + TLOG_MAX_ARGS * 5];
+    uint8_t au8Drop[1 + 5];
+    uint32_t u32Len, u32DropLen, u32Free, i, u32PriMask;
+    va_list args;
+
+    if(u32Argc > TLOG_MAX_ARGS)
+        u32Argc = TLOG_MAX_ARGS;
+
+    au8Frame[0] = (uint8_t)(TLOG_FRAME_LOG | u32Argc);
+    au8Frame[1] = (uint8_t)u32Id;
+    au8Frame[2] = (uint8_t)(u32Id >> 8);
+    u32Len = 3;
+
+    va_start(args, u32Argc);
+    for(i = 0; i < u32Argc; i++)
+        u32Len += TLOG_PutVarint(&au8Frame[u32Len], va_arg(args, uint32_t));
+    va_end(args);
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    u32Free = TLOG_BUF_SIZE - (s_u32TlogHead - s_u32TlogTail);
+    u32DropLen = 0;
+    if(s_u32TlogDrop)
+    {
+        au8Drop[0] = TLOG_FRAME_DROP;
+        u32DropLen = 1 + TLOG_PutVarint(&au8Drop[1], s_u32TlogDrop);
+    }
+
+    if(u32Free >= u32Len + u32DropLen)
+    {
+        if(u32DropLen)
+        {
+            TLOG_Put(au8Drop, u32DropLen);
+            s_u32TlogDrop = 0;
+        }
+        TLOG_Put(au8Frame, u32Len);
+    }
+    else
+    {
+        s_u32TlogDrop++;
+        s_u32TlogDropTotal++;
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Drain queued log bytes to UART
+  *
+  * @param[in]  uart    The pointer of the specified UART module.
+  *
+  * @return     Number of bytes still queued
+  *
+  * @details    Copy bytes to UART TX FIFO until it is full or the ring is empty. This function never waits,
+  *             so it can be called from the main loop, an idle hook or the UART THRE interrupt, also from
+  *             more than one of them. Interrupts are masked while the tail moves, at most one TX FIFO fill.
+  */
+uint32_t TLOG_Flush(UART_T *uart)
+{
+    uint32_t u32Tail, u32Left, u32PriMask;
+
+    /* A flush preempted by another one would send the same bytes twice */
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    u32Tail = s_u32TlogTail;
+    while((u32Tail != s_u32TlogHead) && !(uart->FSR & UART_FSR_TX_FULL_Msk))
+        uart->THR = s_au8TlogBuf[(u32Tail++) & (TLOG_BUF_SIZE - 1)];
+
+    s_u32TlogTail = u32Tail;
+    u32Left = s_u32TlogHead - u32Tail;
+
+    __set_PRIMASK(u32PriMask);
+
+    return u32Left;
+}
+
+/**
+  * @brief      Get number of dropped log frames
+  *
+  * @param      None
+  *
+  * @return     Total number of frames dropped because the ring was full
+  */
+uint32_t TLOG_GetDropCount(void)
+{
+    return s_u32TlogDropTotal;
+}
+
+/*@}*/ /* end of group NUC029_TLOG_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_TLOG_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
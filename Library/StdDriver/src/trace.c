@@ -0,0 +1,282 @@
+/**************************************************************************//**
+ * @file     trace.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/03 5:49p $
+ * @brief    NUC029 series binary event trace source file
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+#if (TRACE_BUF_SIZE & (TRACE_BUF_SIZE - 1))
+#error "TRACE_BUF_SIZE must be power of 2"
+#endif
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_TRACE_Driver TRACE Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+TRACE_BUF_T g_sTraceBuf;
+
+static TIMER_T *s_pTraceTimer = NULL;
+static uint32_t s_u32TraceLast = 0;     /* Last 24-bit counter value */
+static uint32_t s_u32TraceEpoch = 0;    /* Upper bits of the extended timestamp */
+
+/* Must be called with interrupts masked */
+static uint32_t TRACE_Now(void)
+{
+    uint32_t u32Cnt = s_pTraceTimer->TDR & TIMER_TDR_TDR_Msk;
+
+    if(u32Cnt < s_u32TraceLast)
+        s_u32TraceEpoch += (TIMER_TDR_TDR_Msk + 1UL);
+    s_u32TraceLast = u32Cnt;
+
+    return (s_u32TraceEpoch | u32Cnt);
+}
+
+/* Must be called with interrupts masked. Overwrite the oldest record if ring is full. */
+static void TRACE_Put(uint32_t u32Time, uint32_t u32Event, uint32_t u32Arg)
+{
+    uint32_t u32Head = g_sTraceBuf.u32Head;
+    TRACE_REC_T *psRec;
+
+    if((u32Head - g_sTraceBuf.u32Tail) >= TRACE_BUF_SIZE)
+    {
+        g_sTraceBuf.u32Tail++;
+        g_sTraceBuf.u32Lost++;
+    }
+
+    psRec = &g_sTraceBuf.asRec[u32Head & (TRACE_BUF_SIZE - 1)];
+    psRec->u32Time = u32Time;
+    psRec->u16Event = (uint16_t)u32Event;
+    psRec->u16Arg = (uint16_t)u32Arg;
+
+    g_sTraceBuf.u32Head = u32Head + 1;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_TRACE_EXPORTED_FUNCTIONS TRACE Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start trace timestamp timer and clear trace buffer
+  *
+  * @param[in]  timer       The pointer of the specified Timer module used as timestamp source. It could be TIMER0, TIMER1, TIMER2, TIMER3.
+  * @param[in]  u32Freq     Target timestamp frequency in Hz. The timer clock is divided by the 8-bit prescaler only,
+  *                         so the actual frequency may be higher than requested.
+  *
+  * @return     Actual timestamp frequency in Hz
+  *
+  * @details    The timer is configured in continuous counting mode and must not be used by the application.
+  *             Its module clock must be enabled before calling this function.
+  *             The 24-bit counter is extended to 32 bits in software, so at least one event must be recorded
+  *             per counter wrap period (2^24 / frequency) to keep timestamps monotonic.
+  */
+uint32_t TRACE_Open(TIMER_T *timer, uint32_t u32Freq)
+{
+    uint32_t u32Clk = TIMER_GetModuleClock(timer);
+    uint32_t u32Prescale = 0;
+
+    if((u32Freq != 0) && (u32Freq < u32Clk))
+    {
+        u32Prescale = (u32Clk / u32Freq) - 1;
+        if(u32Prescale > 0xFF)
+            u32Prescale = 0xFF;
+    }
+
+    timer->TCSR = 0;
+    timer->TCMPR = TIMER_TDR_TDR_Msk;
+    timer->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk | u32Prescale;
+    timer->TCSR |= TIMER_TCSR_CEN_Msk;
+
+    s_pTraceTimer = timer;
+    s_u32TraceLast = 0;
+    s_u32TraceEpoch = 0;
+
+    g_sTraceBuf.u32Freq = u32Clk / (u32Prescale + 1);
+    g_sTraceBuf.u32Size = TRACE_BUF_SIZE;
+    g_sTraceBuf.u32Head = 0;
+    g_sTraceBuf.u32Tail = 0;
+    g_sTraceBuf.u32Lost = 0;
+    g_sTraceBuf.u32Magic = TRACE_MAGIC;
+
+    return g_sTraceBuf.u32Freq;
+}
+
+/**
+  * @brief      Stop trace
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Stop the timestamp timer. Events recorded after this call are discarded.
+  *             Records already in the buffer are kept for read out.
+  */
+void TRACE_Close(void)
+{
+    g_sTraceBuf.u32Magic = 0;
+    if(s_pTraceTimer != NULL)
+        s_pTraceTimer->TCSR = 0;
+    s_pTraceTimer = NULL;
+}
+
+/**
+  * @brief      Get current trace timestamp
+  *
+  * @param      None
+  *
+  * @return     32-bit timestamp in trace timer ticks. 0 if trace is not opened.
+  */
+uint32_t TRACE_GetTime(void)
+{
+    uint32_t u32PriMask, u32Time;
+
+    if(s_pTraceTimer == NULL)
+        return 0;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    u32Time = TRACE_Now();
+    __set_PRIMASK(u32PriMask);
+
+    return u32Time;
+}
+
+/**
+  * @brief      Record an event with 16-bit argument
+  *
+  * @param[in]  u32Event    Record type (TRACE_TYPE_*) OR'ed with event ID
+  * @param[in]  u32Arg      Event argument. Only bits [15:0] are recorded.
+  *
+  * @return     None
+  *
+  * @details    Safe to call from thread and interrupt context. Interrupts are masked only while the
+  *             timestamp is sampled and the record is stored.
+  */
+void TRACE_Event(uint32_t u32Event, uint32_t u32Arg)
+{
+    uint32_t u32PriMask;
+
+    if(g_sTraceBuf.u32Magic != TRACE_MAGIC)
+        return;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    TRACE_Put(TRACE_Now(), u32Event, u32Arg);
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Record an event with 32-bit argument
+  *
+  * @param[in]  u32Event    Record type (TRACE_TYPE_*) OR'ed with event ID
+  * @param[in]  u32Arg      Event argument
+  *
+  * @return     None
+  *
+  * @details    The event takes two records: the event with arg[15:0], followed by a
+  *             \ref TRACE_TYPE_ARGHI record with arg[31:16] and the same timestamp.
+  */
+void TRACE_Event32(uint32_t u32Event, uint32_t u32Arg)
+{
+    uint32_t u32PriMask, u32Time;
+
+    if(g_sTraceBuf.u32Magic != TRACE_MAGIC)
+        return;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+    u32Time = TRACE_Now();
+    TRACE_Put(u32Time, u32Event, u32Arg);
+    TRACE_Put(u32Time, TRACE_TYPE_ARGHI | (u32Event & TRACE_ID_Msk), u32Arg >> 16);
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Drain trace records to UART
+  *
+  * @param[in]  uart    The pointer of the specified UART module.
+  *
+  * @return     Number of records still waiting in trace buffer
+  *
+  * @details    Send records as \ref TRACE_FRAME_LEN byte frames until the TX FIFO is full or the buffer is empty.
+  *             This function never waits, so it can be called from the main loop or idle hook.
+  *             A partly sent frame is continued on next call. If records were overwritten, a \ref TRACE_ID_LOST
+  *             record is sent first with the number of lost records as argument.
+  */
+uint32_t TRACE_Flush(UART_T *uart)
+{
+    static uint8_t s_au8Frame[TRACE_FRAME_LEN];
+    static uint32_t s_u32FrameIdx = TRACE_FRAME_LEN;
+    TRACE_REC_T sRec;
+    uint32_t u32PriMask;
+
+    while(1)
+    {
+        if(s_u32FrameIdx >= TRACE_FRAME_LEN)
+        {
+            u32PriMask = __get_PRIMASK();
+            __disable_irq();
+            if(g_sTraceBuf.u32Lost)
+            {
+                /* Report loss at the time of the oldest surviving record */
+                sRec.u32Time = g_sTraceBuf.asRec[g_sTraceBuf.u32Tail & (TRACE_BUF_SIZE - 1)].u32Time;
+                sRec.u16Event = TRACE_TYPE_POINT | TRACE_ID_LOST;
+                sRec.u16Arg = (g_sTraceBuf.u32Lost > 0xFFFF) ? 0xFFFF : (uint16_t)g_sTraceBuf.u32Lost;
+                g_sTraceBuf.u32Lost = 0;
+            }
+            else if(g_sTraceBuf.u32Head != g_sTraceBuf.u32Tail)
+            {
+                sRec = g_sTraceBuf.asRec[g_sTraceBuf.u32Tail & (TRACE_BUF_SIZE - 1)];
+                g_sTraceBuf.u32Tail++;
+            }
+            else
+            {
+                __set_PRIMASK(u32PriMask);
+                break;
+            }
+            __set_PRIMASK(u32PriMask);
+
+            s_au8Frame[0] = TRACE_FRAME_SYNC0;
+            s_au8Frame[1] = TRACE_FRAME_SYNC1;
+            s_au8Frame[2] = (uint8_t)(sRec.u32Time);
+            s_au8Frame[3] = (uint8_t)(sRec.u32Time >> 8);
+            s_au8Frame[4] = (uint8_t)(sRec.u32Time >> 16);
+            s_au8Frame[5] = (uint8_t)(sRec.u32Time >> 24);
+            s_au8Frame[6] = (uint8_t)(sRec.u16Event);
+            s_au8Frame[7] = (uint8_t)(sRec.u16Event >> 8);
+            s_au8Frame[8] = (uint8_t)(sRec.u16Arg);
+            s_au8Frame[9] = (uint8_t)(sRec.u16Arg >> 8);
+            s_u32FrameIdx = 0;
+        }
+
+        while((s_u32FrameIdx < TRACE_FRAME_LEN) && !(uart->FSR & UART_FSR_TX_FULL_Msk))
+            uart->THR = s_au8Frame[s_u32FrameIdx++];
+
+        if(s_u32FrameIdx < TRACE_FRAME_LEN)
+            break;
+    }
+
+    return (g_sTraceBuf.u32Head - g_sTraceBuf.u32Tail);
+}
+
+/*@}*/ /* end of group NUC029_TRACE_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_TRACE_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -195,6 +195,8 @@ void UART_Open(UART_T* uart, uint32_t u32baudrate)
     uint32_t au32ClkTbl[4] = {__HXT, 0, 0, __HIRC};
     uint32_t u32Baud_Div = 0;
 
+    TRACE_DRV_ENTER(TRACE_ID_UART_OPEN, u32baudrate / 100);
+
     /* Get UART clock source selection */
     u8UartClkSrcSel = (CLK->CLKSEL1 & CLK_CLKSEL1_UART_S_Msk) >> CLK_CLKSEL1_UART_S_Pos;
 
@@ -224,6 +226,8 @@ void UART_Open(UART_T* uart, uint32_t u32baudrate)
         else
             uart->BAUD = (UART_BAUD_MODE2 | u32Baud_Div);
     }
+
+    TRACE_DRV_EXIT(TRACE_ID_UART_OPEN, 0);
 }
 
 
@@ -242,6 +246,8 @@ uint32_t UART_Read(UART_T* uart, uint8_t *pu8RxBuf, uint32_t u32ReadBytes)
 {
     uint32_t  u32Count, u32delayno;
 
+    TRACE_DRV_ENTER(TRACE_ID_UART_READ, u32ReadBytes);
+
     for(u32Count = 0; u32Count < u32ReadBytes; u32Count++)
     {
         u32delayno = 0;
@@ -250,11 +256,15 @@ uint32_t UART_Read(UART_T* uart, uint8_t *pu8RxBuf, uint32_t u32ReadBytes)
         {
             u32delayno++;
             if(u32delayno >= 0x40000000)
+            {
+                TRACE_DRV_EXIT(TRACE_ID_UART_READ, u32Count);
                 return u32Count;
+            }
         }
         pu8RxBuf[u32Count] = uart->RBR;    /* Get Data from UART RX  */
     }
 
+    TRACE_DRV_EXIT(TRACE_ID_UART_READ, u32Count);
     return u32Count;
 
 }
@@ -292,6 +302,8 @@ void UART_SetLine_Config(UART_T* uart, uint32_t u32baudrate, uint32_t u32data_wi
     uint32_t au32ClkTbl[4] = {__HXT, 0, 0, __HIRC};
     uint32_t u32Baud_Div = 0;
 
+    TRACE_DRV_ENTER(TRACE_ID_UART_SETLINE, u32baudrate / 100);
+
     /* Get UART clock source selection */
     u8UartClkSrcSel = (CLK->CLKSEL1 & CLK_CLKSEL1_UART_S_Msk) >> CLK_CLKSEL1_UART_S_Pos;
 
@@ -315,6 +327,8 @@ void UART_SetLine_Config(UART_T* uart, uint32_t u32baudrate, uint32_t u32data_wi
 
     /* Set UART line configuration */
     uart->LCR = u32data_width | u32parity | u32stop_bits;
+
+    TRACE_DRV_EXIT(TRACE_ID_UART_SETLINE, 0);
 }
 
 
@@ -457,6 +471,8 @@ uint32_t UART_Write(UART_T* uart, uint8_t *pu8TxBuf, uint32_t u32WriteBytes)
 {
     uint32_t  u32Count, u32delayno;
 
+    TRACE_DRV_ENTER(TRACE_ID_UART_WRITE, u32WriteBytes);
+
     for(u32Count = 0; u32Count != u32WriteBytes; u32Count++)
     {
         u32delayno = 0;
@@ -464,11 +480,15 @@ uint32_t UART_Write(UART_T* uart, uint8_t *pu8TxBuf, uint32_t u32WriteBytes)
         {
             u32delayno++;
             if(u32delayno >= 0x40000000)
+            {
+                TRACE_DRV_EXIT(TRACE_ID_UART_WRITE, u32Count);
                 return u32Count;
+            }
         }
         uart->THR = pu8TxBuf[u32Count];    /* Send UART Data from buffer */
     }
 
+    TRACE_DRV_EXIT(TRACE_ID_UART_WRITE, u32Count);
     return u32Count;
 
 }
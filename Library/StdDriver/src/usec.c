@@ -0,0 +1,263 @@
+/**************************************************************************//**
+ * @file     usec.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series microsecond timebase and delay source file
+ *
+ * @note     \ref USEC_TIMER runs in continuous mode at about 1 MHz and is never stopped or reprogrammed after
+ *           \ref USEC_Open. Its compare match at 0xFFFFFF counts the wraps, which extend the 24-bit counter to
+ *           64 bits. The prescaler gives exactly 1 MHz from any clock of whole MHz, other clocks are scaled
+ *           by a 8.24 fixed point factor.
+ *           Accuracy of the timebase is that of the timer clock:
+ *           - HXT, the crystal tolerance. Recommended.
+ *           - HIRC, 22.1184 MHz counted at 22118400 / 22 Hz and scaled, the trim accuracy of HIRC.
+ *           - HCLK from PLL, as accurate as HXT, but only valid while HCLK does not change.
+ *           - LIRC, 10 kHz, time advances in 100 us steps with the large tolerance of LIRC.
+ *           Short delays count CPU cycles in a loop calibrated against the timebase, so they stay correct with
+ *           flash wait states and any compiler, to about one loop pass of 4 ~ 6 cycles. Interrupts taken during
+ *           a delay extend it. A change of SystemCoreClock, e.g. by \ref DVFS_SetLevel, is followed without a
+ *           new calibration.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_USEC_Driver USEC Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define USEC_COUNTER_MAX    0xFFFFFF
+#define USEC_CAL_US         2000    /* Length of the loop calibration */
+#define USEC_CAL_CALLS      64      /* Calls timed for the call overhead */
+
+static volatile uint32_t s_u32UsecWraps = 0;
+static uint32_t s_u32UsecScale = 1 << 24;  /* us per tick, 8.24 fixed point */
+static uint32_t s_u32UsecLoopsQ16;         /* Loop passes per CPU cycle, 16.16 fixed point */
+static uint32_t s_u32UsecCyclesQ8;         /* CPU cycles per us, 24.8 fixed point */
+static uint32_t s_u32UsecHclk;             /* SystemCoreClock of s_u32UsecCyclesQ8 */
+static uint32_t s_u32UsecOverhead;         /* Cycles of a USEC_DelayCycles() call without loop */
+
+static void USEC_Spin(uint32_t u32Loops)
+{
+    while(u32Loops--)
+        __NOP();
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_USEC_EXPORTED_FUNCTIONS USEC Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start the timebase
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Set up \ref USEC_TIMER in continuous mode at the highest tick rate up to 1 MHz and calibrate the
+  *             delay loop. The timer clock is selected and enabled by the application, and the IRQ handler must
+  *             call \ref USEC_IRQHandler. The IRQ is set to the highest priority so no reader can see a wrap
+  *             half counted.
+  */
+void USEC_Open(void)
+{
+    uint32_t u32Clk = TIMER_GetModuleClock(USEC_TIMER);
+    uint32_t u32Prescale = 0, u32Hz;
+
+    if(u32Clk > 1000000)
+        u32Prescale = u32Clk / 1000000 - 1;
+    if(u32Prescale > 0xFF)
+        u32Prescale = 0xFF;
+    u32Hz = u32Clk / (u32Prescale + 1);
+    s_u32UsecScale = (uint32_t)((((uint64_t)1000000 << 24) + u32Hz / 2) / u32Hz);
+
+    USEC_TIMER->TCSR = 0;
+    USEC_TIMER->TEXCON = 0;
+    USEC_TIMER->TCMPR = USEC_COUNTER_MAX;
+    TIMER_ClearIntFlag(USEC_TIMER);
+    s_u32UsecWraps = 0;
+    USEC_TIMER->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_IE_Msk | TIMER_TCSR_TDR_EN_Msk | u32Prescale;
+
+    NVIC_SetPriority(USEC_TIMER_IRQn, 0);
+    NVIC_EnableIRQ(USEC_TIMER_IRQn);
+    TIMER_Start(USEC_TIMER);
+
+    USEC_Calibrate();
+}
+
+/**
+  * @brief      Stop the timebase
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void USEC_Close(void)
+{
+    NVIC_DisableIRQ(USEC_TIMER_IRQn);
+    TIMER_Close(USEC_TIMER);
+}
+
+/**
+  * @brief      Calibrate the delay loop
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Times the loop against the timebase for about 2 ms with interrupts disabled. Called by
+  *             \ref USEC_Open, call it again after the flash wait states change. Loop passes and call overhead
+  *             are counted in cycles, so HCLK changes need no new calibration.
+  */
+void USEC_Calibrate(void)
+{
+    uint32_t u32PriMask, u32Loops, u32Start, u32Us, u32Cycles, i;
+
+    s_u32UsecHclk = SystemCoreClock;
+    s_u32UsecCyclesQ8 = (uint32_t)(((uint64_t)SystemCoreClock << 8) / 1000000);
+
+    /* Passes take about 4 cycles */
+    u32Loops = SystemCoreClock / (1000000 / USEC_CAL_US) / 4;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    u32Start = USEC_Get32();
+    USEC_Spin(u32Loops);
+    u32Us = USEC_Get32() - u32Start;
+    u32Cycles = (uint32_t)((uint64_t)u32Us * SystemCoreClock / 1000000);
+    s_u32UsecLoopsQ16 = (uint32_t)(((uint64_t)u32Loops << 16) / (u32Cycles ? u32Cycles : 1));
+
+    /* Call overhead, through the whole path with no loop pass */
+    s_u32UsecOverhead = 0;
+    u32Start = USEC_Get32();
+    for(i = 0; i < USEC_CAL_CALLS; i++)
+        USEC_DelayCycles(0);
+    u32Us = USEC_Get32() - u32Start;
+    s_u32UsecOverhead = (uint32_t)((uint64_t)u32Us * SystemCoreClock / 1000000 / USEC_CAL_CALLS);
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      Get the time
+  *
+  * @param      None
+  *
+  * @return     Microseconds since \ref USEC_Open
+  *
+  * @details    Lock free, may be called from any interrupt. A wrap still pending is counted if the counter was
+  *             read after it. Interrupts must not stay disabled longer than one wrap, 16.7 s at 1 MHz.
+  */
+uint64_t USEC_Get(void)
+{
+    uint32_t u32Wraps, u32Cnt, u32Pending;
+
+    do
+    {
+        u32Wraps = s_u32UsecWraps;
+        u32Cnt = USEC_TIMER->TDR & USEC_COUNTER_MAX;
+        u32Pending = TIMER_GetIntFlag(USEC_TIMER);
+    }
+    while(u32Wraps != s_u32UsecWraps);
+
+    if(u32Pending && (u32Cnt < (USEC_COUNTER_MAX + 1) / 2))
+        u32Wraps++;
+
+    return (uint64_t)u32Wraps * s_u32UsecScale + (((uint64_t)u32Cnt * s_u32UsecScale) >> 24);
+}
+
+/**
+  * @brief      Get the time, lower 32 bits
+  *
+  * @param      None
+  *
+  * @return     Microseconds since \ref USEC_Open, wraps after 71 minutes
+  *
+  * @details    For intervals, take the difference of two readings as uint32_t.
+  */
+uint32_t USEC_Get32(void)
+{
+    return (uint32_t)USEC_Get();
+}
+
+/**
+  * @brief      Wait for a time
+  *
+  * @param[in]  u32Us   Microseconds
+  *
+  * @return     None
+  *
+  * @details    Up to \ref USEC_SPIN_US the calibrated loop is used, longer delays poll the timebase and end
+  *             within one timer tick after the time. No timer is reprogrammed.
+  */
+void USEC_Delay(uint32_t u32Us)
+{
+    uint32_t u32Start;
+
+    if(u32Us <= USEC_SPIN_US)
+    {
+        if(s_u32UsecHclk != SystemCoreClock)
+        {
+            s_u32UsecHclk = SystemCoreClock;
+            s_u32UsecCyclesQ8 = (uint32_t)(((uint64_t)SystemCoreClock << 8) / 1000000);
+        }
+        USEC_DelayCycles((u32Us * s_u32UsecCyclesQ8) >> 8);
+        return;
+    }
+
+    u32Start = USEC_Get32();
+    while(USEC_Get32() - u32Start < u32Us);
+}
+
+/**
+  * @brief      Wait for CPU cycles
+  *
+  * @param[in]  u32Cycles   HCLK cycles, the call included
+  *
+  * @return     None
+  *
+  * @details    Waits at least the call overhead found by \ref USEC_Calibrate, a few ten cycles.
+  */
+void USEC_DelayCycles(uint32_t u32Cycles)
+{
+    if(u32Cycles < s_u32UsecOverhead)
+        return;
+
+    u32Cycles -= s_u32UsecOverhead;
+    USEC_Spin((u32Cycles >> 16) * s_u32UsecLoopsQ16 + (((u32Cycles & 0xFFFF) * s_u32UsecLoopsQ16) >> 16));
+}
+
+/**
+  * @brief      Timebase interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref USEC_TIMER, counts the counter wraps.
+  */
+void USEC_IRQHandler(void)
+{
+    TIMER_ClearIntFlag(USEC_TIMER);
+    s_u32UsecWraps++;
+}
+
+/*@}*/ /* end of group NUC029_USEC_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_USEC_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
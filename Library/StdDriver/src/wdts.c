@@ -0,0 +1,328 @@
+/**************************************************************************//**
+ * @file     wdts.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series watchdog supervisor source file
+ *
+ * @note     Each client registers a deadline and checks in with \ref WDTS_CheckIn, a single byte store. The
+ *           application calls \ref WDTS_Service at a fixed period, normally from a timer interrupt so it keeps
+ *           running while a task hangs. The service reloads the deadline of every client that checked in and
+ *           counts down the others. Only when no deadline expired the watchdog is fed:
+ *           - WDT is reset at once.
+ *           - WWDT is reloaded at once when its counter is inside the window, otherwise by \ref WDTS_IRQHandler
+ *             when the counter reaches the window.
+ *           A client that does not check in for its deadline is logged, the watchdog is never fed again and
+ *           resets the chip. The log is kept in no-init RAM, so the next \ref WDTS_Open can see it and also logs
+ *           watchdog resets without a miss, when the service itself stopped.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_WDTS_Driver WDTS Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define WDTS_LOG_MAGIC      0x57445453UL
+#define WDTS_LOG_WORDS      (sizeof(WDTS_LOG_T) / 4 - 1)    /* Words covered by u32Check */
+
+static NOINIT WDTS_LOG_T s_sWdtsLog;
+
+static volatile uint8_t s_au8WdtsAlive[WDTS_MAX_CLIENTS];  /* Set by check-in, cleared by the service */
+static volatile uint16_t s_au16WdtsDeadline[WDTS_MAX_CLIENTS];  /* Service periods, 0 if the slot is free */
+static uint16_t s_au16WdtsLeft[WDTS_MAX_CLIENTS];
+static uint32_t s_u32WdtsHw = WDTS_HW_WDT;
+static uint32_t s_u32WdtsPeriodMs = 1;
+static uint32_t s_u32WdtsTick = 0;
+static uint32_t s_u32WdtsMiss = 0;
+static volatile uint32_t s_u32WdtsFeed = 0;    /* WWDT reload due when the window opens */
+
+static uint32_t WDTS_LogCheck(void)
+{
+    const uint32_t *pu32Log = (const uint32_t *)&s_sWdtsLog;
+    uint32_t u32Check = WDTS_LOG_MAGIC, i;
+
+    for(i = 0; i < WDTS_LOG_WORDS; i++)
+        u32Check = ((u32Check << 1) | (u32Check >> 31)) ^ pu32Log[i];
+
+    return u32Check;
+}
+
+static void WDTS_LogEntry(uint32_t u32Client, uint32_t u32Reason, uint32_t u32Tick)
+{
+    WDTS_ENTRY_T *psEntry = &s_sWdtsLog.asEntry[s_sWdtsLog.u32Count % WDTS_LOG_SIZE];
+
+    psEntry->u8Client = (uint8_t)u32Client;
+    psEntry->u8Reason = (uint8_t)u32Reason;
+    psEntry->u16Boot = (uint16_t)s_sWdtsLog.u32Boots;
+    psEntry->u32Tick = u32Tick;
+    s_sWdtsLog.u32Count++;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_WDTS_EXPORTED_FUNCTIONS WDTS Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start the supervisor and the watchdog
+  *
+  * @param[in]  u32Hw           Watchdog to feed. Valid values are:
+  *                             - \ref WDTS_HW_WDT
+  *                             - \ref WDTS_HW_WWDT
+  * @param[in]  u32PeriodMs     Period the application calls \ref WDTS_Service at, in ms
+  *
+  * @return     None
+  *
+  * @details    Checks the log kept over the reset and clears it when it is not valid, then counts this boot and
+  *             a watchdog reset. A watchdog reset without a logged miss is logged as \ref WDTS_REASON_STALL.
+  *             The watchdog is started with reset enabled, \ref WDTS_WDT_TIMEOUT or \ref WDTS_WWDT_PRESCALER and
+  *             \ref WDTS_WWDT_WINDOW. Its clock is selected and enabled by the application. For WWDT the
+  *             WDT_IRQHandler must call \ref WDTS_IRQHandler.
+  *             The WDT time-out, or the WWDT time-out for WWDT, must be longer than the service period.
+  * @note       Please make sure that Register Write-Protection Function has been disabled before using this function.
+  *             WWDT can be opened only once after reset.
+  */
+void WDTS_Open(uint32_t u32Hw, uint32_t u32PeriodMs)
+{
+    uint32_t u32Reset, i;
+
+    u32Reset = WDT_GET_RESET_FLAG() | WWDT_GET_RESET_FLAG();
+
+    if((s_sWdtsLog.u32Magic != WDTS_LOG_MAGIC) || (s_sWdtsLog.u32Check != WDTS_LogCheck()))
+        WDTS_ClearLog();
+
+    s_sWdtsLog.u32Boots++;
+    if(u32Reset)
+    {
+        s_sWdtsLog.u32Resets++;
+        if(s_sWdtsLog.u32Pending == 0)
+            WDTS_LogEntry(WDTS_CLIENT_NONE, WDTS_REASON_STALL, 0);
+        WDT_CLEAR_RESET_FLAG();
+        WWDT_CLEAR_RESET_FLAG();
+    }
+    s_sWdtsLog.u32Pending = 0;
+    s_sWdtsLog.u32Check = WDTS_LogCheck();
+
+    for(i = 0; i < WDTS_MAX_CLIENTS; i++)
+        s_au16WdtsDeadline[i] = 0;
+    s_u32WdtsHw = u32Hw;
+    s_u32WdtsPeriodMs = u32PeriodMs ? u32PeriodMs : 1;
+    s_u32WdtsTick = 0;
+    s_u32WdtsMiss = 0;
+    s_u32WdtsFeed = 0;
+
+    if(u32Hw == WDTS_HW_WWDT)
+    {
+        WWDT_Open(WDTS_WWDT_PRESCALER, WDTS_WWDT_WINDOW, TRUE);
+        NVIC_EnableIRQ(WDT_IRQn);
+    }
+    else
+    {
+        WDT_Open(WDTS_WDT_TIMEOUT, WDT_RESET_DELAY_1026CLK, TRUE, FALSE);
+    }
+}
+
+/**
+  * @brief      Register a client
+  *
+  * @param[in]  u32DeadlineMs   Longest time between two check-ins, in ms
+  *
+  * @retval     >=0     Client ID for \ref WDTS_CheckIn
+  * @retval     -1      No free slot
+  *
+  * @details    The deadline is rounded up to whole service periods. A miss is detected within one service period
+  *             after the deadline, counted from the last check-in.
+  */
+int32_t WDTS_Register(uint32_t u32DeadlineMs)
+{
+    uint32_t u32Ticks, i;
+
+    u32Ticks = (u32DeadlineMs + s_u32WdtsPeriodMs - 1) / s_u32WdtsPeriodMs;
+    if(u32Ticks == 0)
+        u32Ticks = 1;
+    if(u32Ticks > 0xFFFF)
+        u32Ticks = 0xFFFF;
+
+    for(i = 0; i < WDTS_MAX_CLIENTS; i++)
+    {
+        if(s_au16WdtsDeadline[i] == 0)
+        {
+            s_au8WdtsAlive[i] = 0;
+            s_au16WdtsLeft[i] = (uint16_t)u32Ticks;
+            /* Written last, the service skips the slot until then */
+            s_au16WdtsDeadline[i] = (uint16_t)u32Ticks;
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+  * @brief      Remove a client
+  *
+  * @param[in]  u32Client   Client ID from \ref WDTS_Register
+  *
+  * @return     None
+  */
+void WDTS_Unregister(uint32_t u32Client)
+{
+    if(u32Client < WDTS_MAX_CLIENTS)
+        s_au16WdtsDeadline[u32Client] = 0;
+}
+
+/**
+  * @brief      Check in
+  *
+  * @param[in]  u32Client   Client ID from \ref WDTS_Register
+  *
+  * @return     None
+  *
+  * @details    A single store, may be called from any context as often as wanted. IDs out of range, like the
+  *             -1 of a failed \ref WDTS_Register, are ignored.
+  */
+void WDTS_CheckIn(uint32_t u32Client)
+{
+    if(u32Client < WDTS_MAX_CLIENTS)
+        s_au8WdtsAlive[u32Client] = 1;
+}
+
+/**
+  * @brief      Verify the check-ins and feed the watchdog
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called every service period given to \ref WDTS_Open. After a miss the watchdog is not fed
+  *             any more, \ref WDTS_ON_MISS is called once and the chip resets by the watchdog.
+  */
+void WDTS_Service(void)
+{
+    uint32_t u32PriMask, u32Locked, i;
+
+    s_u32WdtsTick++;
+    if(s_u32WdtsMiss)
+        return;
+
+    for(i = 0; i < WDTS_MAX_CLIENTS; i++)
+    {
+        if(s_au16WdtsDeadline[i] == 0)
+            continue;
+
+        if(s_au8WdtsAlive[i])
+        {
+            s_au8WdtsAlive[i] = 0;
+            s_au16WdtsLeft[i] = s_au16WdtsDeadline[i];
+        }
+        else if(--s_au16WdtsLeft[i] == 0)
+        {
+            s_u32WdtsMiss = 1;
+            WDTS_LogEntry(i, WDTS_REASON_MISS, s_u32WdtsTick);
+            s_sWdtsLog.u32Pending = 1;
+            s_sWdtsLog.u32Check = WDTS_LogCheck();
+            WDTS_ON_MISS(i);
+            return;
+        }
+    }
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    if(s_u32WdtsHw == WDTS_HW_WWDT)
+    {
+        /* Reload before the window opens resets the chip */
+        if(WWDT_GET_COUNTER() <= WDTS_WWDT_WINDOW)
+        {
+            s_u32WdtsFeed = 0;
+            WWDT_RELOAD_COUNTER();
+        }
+        else
+        {
+            s_u32WdtsFeed = 1;
+        }
+    }
+    else
+    {
+        u32Locked = SYS_IsRegLocked();
+        if(u32Locked)
+            SYS_UnlockReg();
+        WDT_RESET_COUNTER();
+        if(u32Locked)
+            SYS_LockReg();
+    }
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/**
+  * @brief      WWDT interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from WDT_IRQHandler when WWDT is fed. Reloads WWDT when the counter reaches the
+  *             window if the service asked for it since the last reload.
+  */
+void WDTS_IRQHandler(void)
+{
+    if(WWDT_GET_INT_FLAG())
+    {
+        WWDT_CLEAR_INT_FLAG();
+        if(s_u32WdtsFeed)
+        {
+            s_u32WdtsFeed = 0;
+            WWDT_RELOAD_COUNTER();
+        }
+    }
+}
+
+/**
+  * @brief      Get the log
+  *
+  * @param      None
+  *
+  * @return     Log kept over resets
+  */
+const WDTS_LOG_T *WDTS_GetLog(void)
+{
+    return &s_sWdtsLog;
+}
+
+/**
+  * @brief      Clear the log
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void WDTS_ClearLog(void)
+{
+    uint32_t *pu32Log = (uint32_t *)&s_sWdtsLog;
+    uint32_t i;
+
+    for(i = 0; i < WDTS_LOG_WORDS; i++)
+        pu32Log[i] = 0;
+    s_sWdtsLog.u32Magic = WDTS_LOG_MAGIC;
+    s_sWdtsLog.u32Check = WDTS_LogCheck();
+}
+
+/*@}*/ /* end of group NUC029_WDTS_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_WDTS_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
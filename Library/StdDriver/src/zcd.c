@@ -0,0 +1,474 @@
+/**************************************************************************//**
+ * @file     zcd.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 series zero-crossing detector source file
+ *
+ * @note     \ref ZCD_TIMER counts its module clock in continuous mode, its compare match at 0xFFFFFF counts the
+ *           wraps and extends the counter to 32 bits. Each comparator edge is stamped with this time, either by
+ *           the comparator interrupt reading the counter or by the timer capturing the edge. A capture is exact
+ *           to one timer clock, the interrupt adds its latency, which is constant unless other interrupts delay
+ *           it.
+ *           Edges must alternate between rising and falling, and an edge within \ref ZCD_BLANK_PERCENT of a half
+ *           cycle after the last crossing is taken as a bounce. An offset of the reference makes the output rise
+ *           early and fall late or the other way round by the same time, so the middle of the high time is the
+ *           positive peak of the waveform whatever the offset. The rising zero crossing is a quarter period
+ *           before it. Hysteresis delays both edges, and so all results, by the phase asin(Vhys / Vpeak),
+ *           which the application adds to its angles if it matters.
+ *           The peaks feed an alpha-beta tracker. It predicts the next peak from the last one and the period,
+ *           then corrects the phase by 1 / 2^\ref ZCD_ALPHA_SHIFT and the period by 1 / 2^\ref ZCD_BETA_SHIFT
+ *           of the error, which averages the time stamp jitter over several cycles. Until locked, wider gains
+ *           pull in a rough first period within a few ten cycles.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC029xAN.h"
+
+/** @addtogroup NUC029_Device_Driver NUC029 Device Driver
+  @{
+*/
+
+/** @addtogroup NUC029_ZCD_Driver ZCD Driver
+  @{
+*/
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define ZCD_COUNTER_MAX     0xFFFFFF
+#define ZCD_BAD_CYCLES      2       /* Cycles in a row off the estimate before it starts again */
+#define ZCD_ACQ_ALPHA_SHIFT 1       /* Gains until locked */
+#define ZCD_ACQ_BETA_SHIFT  3
+
+static volatile uint32_t s_u32ZcdWraps;
+static uint32_t s_u32ZcdMode;
+static uint32_t s_u32ZcdClk;
+static uint32_t s_u32ZcdMinTicks;   /* Shortest period in timer counts */
+static uint32_t s_u32ZcdMaxTicks;   /* Longest period in timer counts */
+static uint32_t s_u32ZcdBlank;      /* Bounce window in timer counts */
+static uint32_t s_u32ZcdCapRising;  /* Next capture is a rising edge */
+
+/* Edges */
+static uint32_t s_u32ZcdPrimed;     /* An edge was accepted */
+static uint32_t s_u32ZcdLevel;      /* Last accepted edge was rising */
+static uint32_t s_u32ZcdLast;       /* Time of the last accepted edge */
+static uint32_t s_u32ZcdRisen;      /* s_u32ZcdRise holds a crossing */
+static uint32_t s_u32ZcdRise;
+static uint32_t s_u32ZcdHigh;       /* Latest high time */
+
+/* Estimate */
+static uint32_t s_u32ZcdPeaks;      /* Peaks seen since the start, up to 2 */
+static uint32_t s_u32ZcdPeak;       /* Time of the latest peak */
+static uint32_t s_u32ZcdPeakFrac;   /* and its 1/256 counts */
+static uint32_t s_u32ZcdPeriodQ8;   /* Period in 1/256 counts */
+static uint32_t s_u32ZcdErrQ8;      /* Average deviation in 1/256 counts */
+static uint32_t s_u32ZcdGood;       /* Cycles in a row within 1/256 period, up to ZCD_LOCK_CYCLES */
+static uint32_t s_u32ZcdBad;        /* Cycles in a row off the estimate */
+
+static uint32_t s_u32ZcdEdges;
+static uint32_t s_u32ZcdRejected;
+static uint32_t s_u32ZcdResyncs;
+
+static void ZCD_Restart(void)
+{
+    s_u32ZcdPeaks = 0;
+    s_u32ZcdGood = 0;
+    s_u32ZcdBad = 0;
+    s_u32ZcdRisen = 0;
+    s_u32ZcdBlank = s_u32ZcdMinTicks / 2 * ZCD_BLANK_PERCENT / 100;
+}
+
+static void ZCD_Peak(uint32_t u32Peak, uint32_t u32Frac)
+{
+    uint32_t u32Dist = u32Peak - s_u32ZcdPeak, u32Adv, u32Abs;
+    int32_t i32Err;
+
+    if(s_u32ZcdPeaks == 2)
+    {
+        if(u32Dist <= 2 * s_u32ZcdMaxTicks)
+        {
+            i32Err = (int32_t)((u32Dist << 8) + u32Frac - s_u32ZcdPeakFrac - s_u32ZcdPeriodQ8);
+            u32Abs = (i32Err < 0) ? (uint32_t)(-i32Err) : (uint32_t)i32Err;
+
+            if(u32Abs <= (s_u32ZcdPeriodQ8 >> 4))
+            {
+                s_u32ZcdBad = 0;
+
+                /* Wider gains until locked pull in a rough first period quickly */
+                if(s_u32ZcdGood < ZCD_LOCK_CYCLES)
+                {
+                    u32Adv = s_u32ZcdPeriodQ8 + i32Err / (1 << ZCD_ACQ_ALPHA_SHIFT);
+                    s_u32ZcdPeriodQ8 += i32Err / (1 << ZCD_ACQ_BETA_SHIFT);
+                }
+                else
+                {
+                    u32Adv = s_u32ZcdPeriodQ8 + i32Err / (1 << ZCD_ALPHA_SHIFT);
+                    s_u32ZcdPeriodQ8 += i32Err / (1 << ZCD_BETA_SHIFT);
+                }
+                s_u32ZcdErrQ8 += (int32_t)(u32Abs - s_u32ZcdErrQ8) / 8;
+                if(s_u32ZcdGood < ZCD_LOCK_CYCLES)
+                {
+                    if(u32Abs > (s_u32ZcdPeriodQ8 >> 8))
+                        s_u32ZcdGood = 0;
+                    else if(++s_u32ZcdGood == ZCD_LOCK_CYCLES)
+                        s_u32ZcdErrQ8 = u32Abs;
+                }
+            }
+            else if(++s_u32ZcdBad < ZCD_BAD_CYCLES)
+            {
+                /* A single odd or missed cycle is skipped, the estimate runs on by whole periods */
+                s_u32ZcdGood = 0;
+                u32Adv = (u32Dist + (s_u32ZcdPeriodQ8 >> 9)) / (s_u32ZcdPeriodQ8 >> 8);
+                u32Adv = s_u32ZcdPeriodQ8 * (u32Adv ? u32Adv : 1);
+            }
+            else
+                u32Adv = 0;
+
+            if(u32Adv && ((s_u32ZcdPeriodQ8 >> 8) >= s_u32ZcdMinTicks) && ((s_u32ZcdPeriodQ8 >> 8) <= s_u32ZcdMaxTicks))
+            {
+                u32Frac = s_u32ZcdPeakFrac + (u32Adv & 0xFF);
+                s_u32ZcdPeak += (u32Adv >> 8) + (u32Frac >> 8);
+                s_u32ZcdPeakFrac = u32Frac & 0xFF;
+                s_u32ZcdBlank = (s_u32ZcdPeriodQ8 >> 9) * ZCD_BLANK_PERCENT / 100;
+                return;
+            }
+        }
+
+        /* Lost, start again from this peak */
+        s_u32ZcdResyncs++;
+        ZCD_Restart();
+    }
+    else if((s_u32ZcdPeaks == 1) && (u32Dist >= s_u32ZcdMinTicks) && (u32Dist <= s_u32ZcdMaxTicks))
+    {
+        s_u32ZcdPeriodQ8 = (u32Dist << 8) + u32Frac - s_u32ZcdPeakFrac;
+        s_u32ZcdErrQ8 = 0;
+        s_u32ZcdPeaks = 2;
+        s_u32ZcdPeak = u32Peak;
+        s_u32ZcdPeakFrac = u32Frac;
+        return;
+    }
+
+    s_u32ZcdPeaks = 1;
+    s_u32ZcdPeak = u32Peak;
+    s_u32ZcdPeakFrac = u32Frac;
+}
+
+/* Returns 1 if the edge is a crossing, 0 for a bounce */
+static uint32_t ZCD_Edge(uint32_t u32Time, uint32_t u32Rising)
+{
+    uint32_t u32High;
+
+    if(s_u32ZcdPrimed && ((u32Rising == s_u32ZcdLevel) || (u32Time - s_u32ZcdLast < s_u32ZcdBlank)))
+    {
+        s_u32ZcdRejected++;
+        return 0;
+    }
+
+    s_u32ZcdPrimed = 1;
+    s_u32ZcdLevel = u32Rising;
+    s_u32ZcdLast = u32Time;
+    s_u32ZcdEdges++;
+
+    if(u32Rising)
+    {
+        s_u32ZcdRise = u32Time;
+        s_u32ZcdRisen = 1;
+    }
+    else if(s_u32ZcdRisen)
+    {
+        u32High = u32Time - s_u32ZcdRise;
+        s_u32ZcdHigh = u32High;
+        ZCD_Peak(s_u32ZcdRise + (u32High >> 1), (u32High & 1) << 7);
+    }
+
+    return 1;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+
+/** @addtogroup NUC029_ZCD_EXPORTED_FUNCTIONS ZCD Exported Functions
+  @{
+*/
+
+/**
+  * @brief      Start detecting
+  *
+  * @param[in]  u32Mode     How edges are stamped:
+  *                         - \ref ZCD_MODE_ISR, the comparator interrupt reads the timer.
+  *                         - \ref ZCD_MODE_CAPTURE_ACMP, the timer captures the comparator output it is connected
+  *                           to inside the chip, see the timer chapter of the TRM for which one.
+  *                         - \ref ZCD_MODE_CAPTURE_PIN, the timer captures its TxEX pin, wired to the CPOn pin.
+  *
+  * @return     None
+  *
+  * @details    The comparator is enabled with hysteresis and V- from its pin. The clocks of the comparator and
+  *             of \ref ZCD_TIMER, and the comparator pins, are set up by the application. HXT or a fixed HCLK as
+  *             timer clock gives 83 ns or 20 ns steps. The IRQ handlers must call \ref ZCD_TimerHandler and, in
+  *             \ref ZCD_MODE_ISR, \ref ZCD_AcmpHandler. Both IRQs are set to the highest priority.
+  */
+void ZCD_Open(uint32_t u32Mode)
+{
+    s_u32ZcdMode = u32Mode;
+    s_u32ZcdClk = TIMER_GetModuleClock(ZCD_TIMER);
+    s_u32ZcdMinTicks = s_u32ZcdClk / ZCD_MAX_HZ;
+    s_u32ZcdMaxTicks = s_u32ZcdClk / ZCD_MIN_HZ;
+    s_u32ZcdPrimed = 0;
+    s_u32ZcdCapRising = 1;
+    s_u32ZcdEdges = 0;
+    s_u32ZcdRejected = 0;
+    s_u32ZcdResyncs = 0;
+    ZCD_Restart();
+
+    ZCD_TIMER->TCSR = 0;
+    ZCD_TIMER->TEXCON = 0;
+    ZCD_TIMER->TCMPR = ZCD_COUNTER_MAX;
+    ZCD_TIMER->TISR = TIMER_TISR_TIF_Msk;
+    ZCD_TIMER->TEXISR = TIMER_TEXISR_TEXIF_Msk;
+    s_u32ZcdWraps = 0;
+    ZCD_TIMER->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_IE_Msk | TIMER_TCSR_TDR_EN_Msk |
+                      ((u32Mode == ZCD_MODE_CAPTURE_ACMP) ? TIMER_CAPTURE_FROM_INTERNAL_ACMP : TIMER_CAPTURE_FROM_TXEX_PIN);
+    if(u32Mode != ZCD_MODE_ISR)
+    {
+        TIMER_EnableCapture(ZCD_TIMER, TIMER_CAPTURE_FREE_COUNTING_MODE, TIMER_CAPTURE_RISING_EDGE);
+        TIMER_EnableCaptureInt(ZCD_TIMER);
+    }
+
+    ACMP_Open(ZCD_ACMP, ZCD_ACMP_CH, ACMP_CR_VNEG_PIN, ACMP_CR_HYSTERESIS_ENABLE);
+    ACMP_CLR_INT_FLAG(ZCD_ACMP, ZCD_ACMP_CH);
+    if(u32Mode == ZCD_MODE_ISR)
+    {
+        ACMP_ENABLE_INT(ZCD_ACMP, ZCD_ACMP_CH);
+        NVIC_SetPriority(ZCD_ACMP_IRQn, 0);
+        NVIC_EnableIRQ(ZCD_ACMP_IRQn);
+    }
+
+    NVIC_SetPriority(ZCD_TIMER_IRQn, 0);
+    NVIC_EnableIRQ(ZCD_TIMER_IRQn);
+    TIMER_Start(ZCD_TIMER);
+}
+
+/**
+  * @brief      Stop detecting
+  *
+  * @param      None
+  *
+  * @return     None
+  */
+void ZCD_Close(void)
+{
+    if(s_u32ZcdMode == ZCD_MODE_ISR)
+    {
+        NVIC_DisableIRQ(ZCD_ACMP_IRQn);
+        ACMP_DISABLE_INT(ZCD_ACMP, ZCD_ACMP_CH);
+    }
+    NVIC_DisableIRQ(ZCD_TIMER_IRQn);
+    ACMP_Close(ZCD_ACMP, ZCD_ACMP_CH);
+    TIMER_Close(ZCD_TIMER);
+}
+
+/**
+  * @brief      Comparator interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called first thing from the IRQ handler of \ref ZCD_ACMP in \ref ZCD_MODE_ISR. Reads the
+  *             time before anything else, the output level gives the edge. The flag of the other comparator of
+  *             the module is left to the application.
+  */
+void ZCD_AcmpHandler(void)
+{
+    uint32_t u32Time = ZCD_GetTime();
+
+    if(!ACMP_GET_INT_FLAG(ZCD_ACMP, ZCD_ACMP_CH))
+        return;
+
+    ACMP_CLR_INT_FLAG(ZCD_ACMP, ZCD_ACMP_CH);
+    if(s_u32ZcdMode == ZCD_MODE_ISR)
+        ZCD_Edge(u32Time, ACMP_GET_OUTPUT(ZCD_ACMP, ZCD_ACMP_CH));
+}
+
+/**
+  * @brief      Timer interrupt handler
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Must be called from the IRQ handler of \ref ZCD_TIMER. Counts the wraps, takes the captured edges
+  *             and starts the estimate again when no crossing came for two periods. A capture taken in the same
+  *             interrupt as the wrap belongs after the wrap if the captured value is in the lower half of the
+  *             counter.
+  */
+void ZCD_TimerHandler(void)
+{
+    uint32_t u32Wraps = s_u32ZcdWraps;
+    uint32_t u32Cap = 0, u32Captured = 0;
+
+    if(TIMER_GetCaptureIntFlag(ZCD_TIMER))
+    {
+        u32Cap = TIMER_GetCaptureData(ZCD_TIMER) & ZCD_COUNTER_MAX;
+        TIMER_ClearCaptureIntFlag(ZCD_TIMER);
+        u32Captured = 1;
+    }
+
+    if(TIMER_GetIntFlag(ZCD_TIMER))
+    {
+        TIMER_ClearIntFlag(ZCD_TIMER);
+        s_u32ZcdWraps++;
+        if(u32Cap < (ZCD_COUNTER_MAX + 1) / 2)
+            u32Wraps++;
+
+        if(s_u32ZcdPeaks && (ZCD_GetTime() - s_u32ZcdLast > 2 * s_u32ZcdMaxTicks))
+            ZCD_Restart();
+    }
+
+    /* The capture edge alternates with each crossing, bounces leave it as it is */
+    if(u32Captured && ZCD_Edge((u32Wraps << 24) | u32Cap, s_u32ZcdCapRising))
+    {
+        s_u32ZcdCapRising ^= 1;
+        ZCD_TIMER->TEXCON = (ZCD_TIMER->TEXCON & ~TIMER_TEXCON_TEX_EDGE_Msk) |
+                            (s_u32ZcdCapRising ? TIMER_CAPTURE_RISING_EDGE : TIMER_CAPTURE_FALLING_EDGE);
+    }
+}
+
+/**
+  * @brief      Get the time
+  *
+  * @param      None
+  *
+  * @return     Counts of \ref ZCD_TIMER since \ref ZCD_Open, 32 bits
+  *
+  * @details    Lock free, may be called from any interrupt. A wrap still pending is counted if the counter was
+  *             read after it.
+  */
+uint32_t ZCD_GetTime(void)
+{
+    uint32_t u32Wraps, u32Cnt, u32Pending;
+
+    do
+    {
+        u32Wraps = s_u32ZcdWraps;
+        u32Cnt = ZCD_TIMER->TDR & ZCD_COUNTER_MAX;
+        u32Pending = TIMER_GetIntFlag(ZCD_TIMER);
+    }
+    while(u32Wraps != s_u32ZcdWraps);
+
+    if(u32Pending && (u32Cnt < (ZCD_COUNTER_MAX + 1) / 2))
+        u32Wraps++;
+
+    return (u32Wraps << 24) | u32Cnt;
+}
+
+/**
+  * @brief      Read the estimate
+  *
+  * @param[out] psResult    Estimate and counters
+  *
+  * @retval     0   Locked
+  * @retval     -1  Not locked. Frequency, period and zero crossing are 0 before two cycles were seen.
+  *
+  * @details    Locked after \ref ZCD_LOCK_CYCLES cycles in a row within 1/256 period of the estimate, until a
+  *             cycle is off by more than 1/16 period or no crossing comes for two periods.
+  */
+int32_t ZCD_Read(ZCD_RESULT_T *psResult)
+{
+    uint32_t u32PriMask, u32Peaks, u32Peak, u32Frac, u32PeriodQ8, u32ErrQ8, u32High, u32Quarter, u32Locked;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    u32Peaks = s_u32ZcdPeaks;
+    u32Peak = s_u32ZcdPeak;
+    u32Frac = s_u32ZcdPeakFrac;
+    u32PeriodQ8 = s_u32ZcdPeriodQ8;
+    u32ErrQ8 = s_u32ZcdErrQ8;
+    u32High = s_u32ZcdHigh;
+    u32Locked = (u32Peaks == 2) && (s_u32ZcdGood >= ZCD_LOCK_CYCLES) &&
+                (ZCD_GetTime() - s_u32ZcdLast <= 2 * s_u32ZcdMaxTicks);
+    psResult->u32Edges = s_u32ZcdEdges;
+    psResult->u32Rejected = s_u32ZcdRejected;
+    psResult->u32Resyncs = s_u32ZcdResyncs;
+
+    __set_PRIMASK(u32PriMask);
+
+    psResult->u32Locked = u32Locked;
+    if(u32Peaks < 2)
+    {
+        psResult->u32MilliHz = 0;
+        psResult->u32PeriodNs = 0;
+        psResult->u32Zero = 0;
+        psResult->u32ErrorNs = 0;
+        psResult->u32Duty = 0;
+        return -1;
+    }
+
+    u32Quarter = u32PeriodQ8 >> 2;
+    psResult->u32MilliHz = (uint32_t)(((uint64_t)s_u32ZcdClk * 256000) / u32PeriodQ8);
+    psResult->u32PeriodNs = (uint32_t)(((uint64_t)u32PeriodQ8 * 1000000000 / 256) / s_u32ZcdClk);
+    psResult->u32Zero = u32Peak - ((u32Quarter - u32Frac + 128) >> 8);
+    psResult->u32ErrorNs = (uint32_t)(((uint64_t)u32ErrQ8 * 1000000000 / 256) / s_u32ZcdClk);
+    psResult->u32Duty = (uint32_t)((uint64_t)u32High * 10000 * 256 / u32PeriodQ8);
+
+    return u32Locked ? 0 : -1;
+}
+
+/**
+  * @brief      Get the time of the next phase angle
+  *
+  * @param[in]  u32Angle    Phase after the rising zero crossing, 0 ~ 0xFFFF for a whole cycle.
+  *                         \ref ZCD_ANGLE_HALF is the falling zero crossing.
+  * @param[out] pu32Time    Time of the next point at this phase, after now, see \ref ZCD_GetTime
+  *
+  * @retval     0   Time predicted
+  * @retval     -1  Not locked
+  *
+  * @details    For phase control, start a one-shot timer with the difference to \ref ZCD_GetTime, both counted
+  *             in the same clock.
+  */
+int32_t ZCD_NextTime(uint32_t u32Angle, uint32_t *pu32Time)
+{
+    uint32_t u32PriMask, u32Peak, u32Frac, u32PeriodQ8, u32Locked, u32Off, u32Time, u32Now;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    u32Peak = s_u32ZcdPeak;
+    u32Frac = s_u32ZcdPeakFrac;
+    u32PeriodQ8 = s_u32ZcdPeriodQ8;
+    u32Now = ZCD_GetTime();
+    u32Locked = (s_u32ZcdPeaks == 2) && (s_u32ZcdGood >= ZCD_LOCK_CYCLES) && (u32Now - s_u32ZcdLast <= 2 * s_u32ZcdMaxTicks);
+
+    __set_PRIMASK(u32PriMask);
+
+    if(!u32Locked)
+        return -1;
+
+    /* The rising zero crossing is 3/4 period after the peak */
+    u32Off = (uint32_t)(((uint64_t)u32PeriodQ8 * ((u32Angle + 0xC000) & 0xFFFF)) >> 16);
+    u32Frac += u32Off;
+    u32Time = u32Peak + (u32Frac >> 8);
+    u32Frac &= 0xFF;
+
+    while((int32_t)(u32Time - u32Now) <= 0)
+    {
+        u32Frac += u32PeriodQ8;
+        u32Time += u32Frac >> 8;
+        u32Frac &= 0xFF;
+    }
+
+    *pu32Time = u32Time + (u32Frac >> 7);
+
+    return 0;
+}
+
+/*@}*/ /* end of group NUC029_ZCD_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NUC029_ZCD_Driver */
+
+/*@}*/ /* end of group NUC029_Device_Driver */
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,30 @@
+/***************************************************************************//**
+ * @file     lz_user.h
+ * @brief    Streaming LZ4 block decoder for compressed APROM update
+ * @version  0x31
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef LZ_USER_H
+#define LZ_USER_H
+
+#include "fmc_user.h"
+
+/*
+ * Largest match offset accepted. Bytes already programmed are read back from flash, so the window
+ * costs no SRAM besides the page buffer and can be as large as LZ4 allows.
+ */
+#ifndef LZ_WINDOW_SIZE
+#define LZ_WINDOW_SIZE      0xFFFF
+#endif
+
+#define LZ_ERROR            0xFFFFFFFF
+
+extern void LZ_Init(uint8_t *page, uint32_t addr, uint32_t len);
+extern uint32_t LZ_Decode(uint8_t *src, uint32_t len);
+extern void LZ_Rewind(void);
+
+#endif
+
+/*** (C) COPYRIGHT 2019 Nuvoton Technology Corp. ***/
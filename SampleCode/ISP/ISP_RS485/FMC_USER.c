@@ -118,11 +118,26 @@ void ReadData(unsigned int addr_start, unsigned int addr_end, unsigned int *data
 
 void WriteData(unsigned int addr_start, unsigned int addr_end, unsigned int *data)  // Write data into flash
 {
-    unsigned int wLoop;
+    unsigned int wLoop, Reg;
 
-    for (wLoop = addr_start; wLoop < addr_end; wLoop += 4) {
-        FMC_Write_User(wLoop, *data);
-        data++;
+    /* Target is erased, so 0xFFFFFFFF words need no program command. ISPCMD is set once for all words. */
+    FMC->ISPCMD = FMC_ISPCMD_PROGRAM;
+
+    for (wLoop = addr_start; wLoop < addr_end; wLoop += 4, data++) {
+        if (*data == 0xFFFFFFFF) {
+            continue;
+        }
+
+        FMC->ISPADR = wLoop;
+        FMC->ISPDAT = *data;
+        FMC->ISPTRG = 0x1;
+        __ISB();
+    }
+
+    Reg = FMC->ISPCON;
+
+    if (Reg & FMC_ISPCON_ISPFF_Msk) {
+        FMC->ISPCON = Reg;
     }
 }
 
@@ -13,8 +13,10 @@
 #define FW_VERSION					0x31
 
 #include "FMC_USER.h"
+#include "LZ_USER.h"
 
 //#define SUPPORT_WRITECKSUM
+#define SUPPORT_LZ_UPDATE			// CMD_UPDATE_APROM_LZ, LZ4 compressed APROM image
 #define USING_AUTODETECT 			// using autodetect for UART download
 //#define APPINFO_ON_DATA_FLASH		// must enable data flash and using first page
 //#define USING_RS485 				// To do...
@@ -39,6 +41,7 @@
 #define CMD_UPDATE_DATAFLASH 		0x000000C3
 #define CMD_WRITE_CHECKSUM 	 		0x000000C9
 #define CMD_GET_FLASHMODE 	 		0x000000CA
+#define CMD_UPDATE_APROM_LZ 		0x000000D0
 
 #define CMD_RESEND_PACKET       	0x000000FF
 
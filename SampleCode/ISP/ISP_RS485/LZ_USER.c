@@ -0,0 +1,210 @@
+/***************************************************************************//**
+ * @file     LZ_USER.c
+ * @brief    Streaming LZ4 block decoder for compressed APROM update
+ * @version  0x31
+ *
+ * @note     The host sends one LZ4 block (no frame header) in ISP packets. Each packet is decoded as it
+ *           arrives into the 512-byte page buffer, which is programmed when full. A sequence may be split
+ *           between packets, so the decoder keeps its position in a small state machine.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "LZ_USER.h"
+
+#define LZ_TOKEN        0
+#define LZ_LITLEN       1
+#define LZ_LITERAL      2
+#define LZ_OFFSET0      3
+#define LZ_OFFSET1      4
+#define LZ_MATLEN       5
+#define LZ_DONE         6
+
+#define LZ_PAGE(addr)   ((addr) & ~(FMC_FLASH_PAGE_SIZE - 1))
+
+typedef struct {
+    uint32_t state;
+    uint32_t start;         /* Start of image */
+    uint32_t addr;          /* Next output address */
+    uint32_t end;           /* End of image */
+    uint32_t programmed;    /* Flash below this address is programmed */
+    uint32_t count;         /* Literal or match length */
+    uint32_t offset;
+    uint32_t token;
+} LZ_STATE_T;
+
+static LZ_STATE_T g_lz, g_lzPacket;
+static uint8_t *g_lzPage;
+static uint32_t g_lzCacheAddr, g_lzCacheData;
+
+static void LZ_Flush(void)
+{
+    uint32_t page = LZ_PAGE(g_lz.addr);
+
+    /* Last page is padded with erased value */
+    if (g_lz.addr != page) {
+        memset(g_lzPage + (g_lz.addr - page), 0xFF, FMC_FLASH_PAGE_SIZE - (g_lz.addr - page));
+    } else {
+        page -= FMC_FLASH_PAGE_SIZE;
+    }
+
+    WriteData(page, page + FMC_FLASH_PAGE_SIZE, (uint32_t *)g_lzPage);
+    g_lz.programmed = g_lz.addr;
+}
+
+static void LZ_Put(uint8_t data)
+{
+    g_lzPage[g_lz.addr & (FMC_FLASH_PAGE_SIZE - 1)] = data;
+    g_lz.addr++;
+
+    if ((LZ_PAGE(g_lz.addr) == g_lz.addr) || (g_lz.addr == g_lz.end)) {
+        LZ_Flush();
+    }
+}
+
+static uint8_t LZ_Get(uint32_t addr)
+{
+    /* Current page is still in the buffer, older output is read back from flash */
+    if (addr >= LZ_PAGE(g_lz.addr)) {
+        return g_lzPage[addr & (FMC_FLASH_PAGE_SIZE - 1)];
+    }
+
+    if ((addr & ~3) != g_lzCacheAddr) {
+        g_lzCacheAddr = addr & ~3;
+        ReadData(g_lzCacheAddr, g_lzCacheAddr + 4, (uint32_t *)&g_lzCacheData);
+    }
+
+    return (uint8_t)(g_lzCacheData >> ((addr & 3) * 8));
+}
+
+/**
+ * @brief      Start decoding an image
+ *
+ * @param[in]  page     Page buffer, FMC_FLASH_PAGE_SIZE bytes, word aligned
+ * @param[in]  addr     Flash address of image, page aligned. Flash must be erased.
+ * @param[in]  len      Image length after decompression
+ */
+void LZ_Init(uint8_t *page, uint32_t addr, uint32_t len)
+{
+    g_lzPage = page;
+    g_lzCacheAddr = 0xFFFFFFFF;
+    g_lz.state = (len ? LZ_TOKEN : LZ_DONE);
+    g_lz.start = addr;
+    g_lz.addr = addr;
+    g_lz.end = addr + len;
+    g_lz.programmed = addr;
+    g_lz.offset = 0;
+    g_lzPacket = g_lz;
+}
+
+/**
+ * @brief      Decode a packet of the compressed stream
+ *
+ * @param[in]  src      Compressed data
+ * @param[in]  len      Length of compressed data. Bytes after the end of the image are ignored.
+ *
+ * @return     Bytes still to be decoded, 0 when the image is complete, or LZ_ERROR if the stream is corrupt
+ */
+uint32_t LZ_Decode(uint8_t *src, uint32_t len)
+{
+    uint32_t c, match;
+
+    g_lzPacket = g_lz;
+
+    while (len && (g_lz.state < LZ_DONE)) {
+        c = *src++;
+        len--;
+        match = 0;
+
+        switch (g_lz.state) {
+            case LZ_TOKEN:
+                g_lz.token = c;
+                g_lz.count = c >> 4;
+                g_lz.state = (g_lz.count == 15) ? LZ_LITLEN : (g_lz.count ? LZ_LITERAL : LZ_OFFSET0);
+                break;
+
+            case LZ_LITLEN:
+                g_lz.count += c;
+
+                if (c != 255) {
+                    g_lz.state = LZ_LITERAL;
+                }
+
+                break;
+
+            case LZ_LITERAL:
+                LZ_Put((uint8_t)c);
+
+                if (--g_lz.count == 0) {
+                    g_lz.state = LZ_OFFSET0;
+                }
+
+                break;
+
+            case LZ_OFFSET0:
+                g_lz.offset = c;
+                g_lz.state = LZ_OFFSET1;
+                break;
+
+            case LZ_OFFSET1:
+                g_lz.offset |= c << 8;
+                g_lz.count = (g_lz.token & 0xF) + 4;
+                g_lz.state = ((g_lz.token & 0xF) == 15) ? LZ_MATLEN : LZ_TOKEN;
+                match = (g_lz.state == LZ_TOKEN);
+                break;
+
+            default:    /* LZ_MATLEN */
+                g_lz.count += c;
+
+                if (c != 255) {
+                    g_lz.state = LZ_TOKEN;
+                    match = 1;
+                }
+
+                break;
+        }
+
+        if (match) {
+            if ((g_lz.offset == 0) || (g_lz.offset > LZ_WINDOW_SIZE) || (g_lz.offset > g_lz.addr - g_lz.start) ||
+                    (g_lz.count > g_lz.end - g_lz.addr)) {
+                g_lz.state = LZ_ERROR;
+                break;
+            }
+
+            for (; g_lz.count; g_lz.count--) {
+                LZ_Put(LZ_Get(g_lz.addr - g_lz.offset));
+            }
+        }
+
+        if (g_lz.addr == g_lz.end) {
+            g_lz.state = LZ_DONE;
+        }
+    }
+
+    return (g_lz.state == LZ_ERROR) ? LZ_ERROR : (g_lz.end - g_lz.addr);
+}
+
+/**
+ * @brief      Undo the last call to LZ_Decode, for CMD_RESEND_PACKET
+ */
+void LZ_Rewind(void)
+{
+    uint32_t page = LZ_PAGE(g_lzPacket.addr);
+    uint32_t addr;
+
+    /* Pages programmed while decoding the packet are read back to the buffer and erased */
+    if (g_lz.programmed != g_lzPacket.programmed) {
+        ReadData(page, page + FMC_FLASH_PAGE_SIZE, (uint32_t *)g_lzPage);
+
+        for (addr = page; addr < g_lz.programmed; addr += FMC_FLASH_PAGE_SIZE) {
+            FMC_Erase_User(addr);
+        }
+    }
+
+    g_lzCacheAddr = 0xFFFFFFFF;
+    g_lz = g_lzPacket;
+}
+
+/*** (C) COPYRIGHT 2019 Nuvoton Technology Corp. ***/
@@ -14,9 +14,18 @@ int FMC_Proc(unsigned int u32Cmd, unsigned int addr_start, unsigned int addr_end
     unsigned int u32Addr, Reg;
     uint32_t u32TimeOutCnt;
 
+    /* ISPCMD is kept for all words */
+    FMC->ISPCMD = u32Cmd;
+
     for(u32Addr = addr_start; u32Addr < addr_end; data++)
     {
-        FMC->ISPCMD = u32Cmd;
+        /* Erased flash already holds 0xFFFFFFFF, no need to program it */
+        if((u32Cmd == FMC_ISPCMD_PROGRAM) && (*data == 0xFFFFFFFF))
+        {
+            u32Addr += 4;
+            continue;
+        }
+
         FMC->ISPADR = u32Addr;
 
         if(u32Cmd == FMC_ISPCMD_PROGRAM)
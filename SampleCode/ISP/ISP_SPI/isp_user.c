@@ -136,6 +136,29 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
         TotalLen = inpw(pSrc + 4);
         pSrc += 8;
         srclen -= 8;
+#ifdef SUPPORT_LZ_UPDATE
+    }
+    else if(lcmd == CMD_UPDATE_APROM_LZ)
+    {
+        /* Length is the image size after decompression */
+        TotalLen = inpw(pSrc + 4);
+
+        if(TotalLen > g_apromSize)
+        {
+            /* Image does not fit, its data packets are ignored */
+            gcmd = 0;
+            outpw(response + 8, LZ_ERROR);
+            goto out;
+        }
+
+        /* APROM is erased only for an image that fits */
+        EraseAP(FMC_APROM_BASE, g_dataFlashAddr);
+        bUpdateApromCmd = TRUE;
+
+        LZ_Init(aprom_buf, FMC_APROM_BASE, TotalLen);
+        pSrc += 8;
+        srclen -= 8;
+#endif
     }
     else if(lcmd == CMD_UPDATE_CONFIG)
     {
@@ -151,6 +174,14 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
     else if(lcmd == CMD_RESEND_PACKET)      //for APROM&Data flash only
     {
         uint32_t PageAddress;
+
+#ifdef SUPPORT_LZ_UPDATE
+        if(gcmd == CMD_UPDATE_APROM_LZ)
+        {
+            LZ_Rewind();
+            goto out;
+        }
+#endif
         StartAddress -= LastDataLen;
         TotalLen += LastDataLen;
         PageAddress = StartAddress & (0x100000 - FMC_FLASH_PAGE_SIZE);
@@ -185,6 +216,21 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
         ReadData(StartAddress, StartAddress + srclen, (uint32_t *)pSrc);
         StartAddress += srclen;
         LastDataLen =  srclen;
+#ifdef SUPPORT_LZ_UPDATE
+    }
+    else if(gcmd == CMD_UPDATE_APROM_LZ)
+    {
+        TotalLen = LZ_Decode(pSrc, srclen);
+
+        if(TotalLen == LZ_ERROR)
+        {
+            outpw(response + 8, LZ_ERROR);
+        }
+        else if(TotalLen == 0)
+        {
+            outpw(response + 8, 0);
+        }
+#endif
     }
 
 out:
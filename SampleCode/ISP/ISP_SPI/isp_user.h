@@ -12,8 +12,11 @@
 #define FW_VERSION 0x33 // Revised Ver. Remove useless isp command to reduce code size
 
 #include "fmc_user.h"
+#include "lz_user.h"
 #include <string.h>
 
+#define SUPPORT_LZ_UPDATE     // CMD_UPDATE_APROM_LZ, LZ4 compressed APROM image
+
 #define CMD_UPDATE_APROM      0x000000A0
 #define CMD_UPDATE_CONFIG     0x000000A1
 #define CMD_READ_CONFIG       0x000000A2
@@ -26,6 +29,7 @@
 #define CMD_CONNECT           0x000000AE
 #define CMD_GET_DEVICEID      0x000000B1
 #define CMD_UPDATE_DATAFLASH  0x000000C3
+#define CMD_UPDATE_APROM_LZ   0x000000D0
 #define CMD_RESEND_PACKET     0x000000FF
 
 #define V6M_AIRCR_VECTKEY_DATA    0x05FA0000UL
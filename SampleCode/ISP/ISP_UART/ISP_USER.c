@@ -164,6 +164,26 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
         srclen -= 8;
         StartAddress_bak = StartAddress;
         TotalLen_bak = TotalLen;
+#ifdef SUPPORT_LZ_UPDATE
+    } else if (lcmd == CMD_UPDATE_APROM_LZ) {
+        /* Length is the image size after decompression */
+        TotalLen_bak = inpw(pSrc + 4);
+
+        if (TotalLen_bak > g_apromSize) {
+            /* Image does not fit, its data packets are ignored */
+            gcmd = 0;
+            outpw(response + 8, LZ_ERROR);
+            goto out;
+        }
+
+        /* APROM is erased only for an image that fits */
+        EraseAP(FMC_APROM_BASE, g_apromSize);
+        bUpdateApromCmd = TRUE;
+
+        pSrc += 8;
+        srclen -= 8;
+        LZ_Init(aprom_buf, FMC_APROM_BASE, TotalLen_bak);
+#endif
     } else if (lcmd == CMD_UPDATE_CONFIG) {
         if ((security == 0) && (!bUpdateApromCmd)) { //security lock
             goto out;
@@ -173,6 +193,12 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
         GetDataFlashInfo(&g_dataFlashAddr, &g_dataFlashSize);
         goto out;
     } else if (lcmd == CMD_RESEND_PACKET) { //for APROM&Data flash only
+#ifdef SUPPORT_LZ_UPDATE
+        if (gcmd == CMD_UPDATE_APROM_LZ) {
+            LZ_Rewind();
+            goto out;
+        }
+#endif
         StartAddress -= LastDataLen;
         TotalLen += LastDataLen;
 
@@ -207,6 +233,17 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
             lcksum = CalCheckSum(StartAddress_bak, TotalLen_bak);
             outps(response + 8, lcksum);
         }
+#ifdef SUPPORT_LZ_UPDATE
+    } else if (gcmd == CMD_UPDATE_APROM_LZ) {
+        TotalLen = LZ_Decode(pSrc, srclen);
+
+        if (TotalLen == LZ_ERROR) {
+            outpw(response + 8, LZ_ERROR);
+        } else if (TotalLen == 0) {
+            lcksum = CalCheckSum(FMC_APROM_BASE, TotalLen_bak);
+            outps(response + 8, lcksum);
+        }
+#endif
     }
 
 out:
@@ -0,0 +1,315 @@
+#!/usr/bin/env python
+#
+# @file     isp_lz.py
+# @brief    Host compressor for compressed APROM update (CMD_UPDATE_APROM_LZ).
+#
+#           "pack" compresses a binary image to one LZ4 block, the format decoded
+#           by LZ_USER.c / lz_user.c of the ISP samples. Match offsets are limited
+#           to --window bytes. A block made by any LZ4 library without frame
+#           header (e.g. lz4.block.compress(data, store_size=False)) works too.
+#
+#           "sim" compresses an image, splits it into ISP packets and replays
+#           them into a model of the LDROM decoder and a simulated FMC, which
+#           rejects programming of non-erased words. Packets can be resent at
+#           random to exercise CMD_RESEND_PACKET. The decoded flash is compared
+#           with the image, and transfer time of raw and compressed update is
+#           estimated for the given link speed.
+#
+# @copyright SPDX-License-Identifier: Apache-2.0
+# @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+#
+import argparse
+import random
+import struct
+import sys
+
+PAGE_SIZE = 512
+PACKET_SIZE = 64
+CMD_UPDATE_APROM = 0xA0
+CMD_UPDATE_APROM_LZ = 0xD0
+
+MIN_MATCH = 4
+LAST_LITERALS = 5       # LZ4 rule, keeps blocks readable by standard decoders
+MF_LIMIT = 12
+
+
+def _length(n):
+    out = bytearray()
+    n -= 15
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+    return out
+
+
+def _sequence(out, lit, mlen, offset):
+    ln = len(lit)
+    token = (min(ln, 15) << 4)
+    if mlen:
+        token |= min(mlen - MIN_MATCH, 15)
+    out.append(token)
+    if ln >= 15:
+        out += _length(ln)
+    out += lit
+    if mlen:
+        out += struct.pack('<H', offset)
+        if mlen - MIN_MATCH >= 15:
+            out += _length(mlen - MIN_MATCH)
+
+
+def compress(data, window=0xFFFF, depth=16):
+    """Greedy LZ4 block compressor with hash chains."""
+    n = len(data)
+    out = bytearray()
+    head = {}
+    chain = {}
+    anchor = 0
+    i = 0
+    limit = n - MF_LIMIT
+
+    def insert(p):
+        key = data[p:p + MIN_MATCH]
+        chain[p] = head.get(key)
+        head[key] = p
+
+    while i < limit:
+        key = data[i:i + MIN_MATCH]
+        best_len = 0
+        best_off = 0
+        cand = head.get(key)
+        tries = depth
+        while cand is not None and tries and i - cand <= window:
+            l = MIN_MATCH
+            maxl = n - LAST_LITERALS - i
+            while l < maxl and data[cand + l] == data[i + l]:
+                l += 1
+            if l > best_len:
+                best_len = l
+                best_off = i - cand
+            cand = chain.get(cand)
+            tries -= 1
+        if best_len >= MIN_MATCH:
+            _sequence(out, data[anchor:i], best_len, best_off)
+            for p in range(i, min(i + best_len, limit)):
+                insert(p)
+            i += best_len
+            anchor = i
+        else:
+            insert(i)
+            i += 1
+
+    _sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+class Flash(object):
+    """APROM model. Programming works like NOR flash: bits only go from 1 to 0."""
+
+    def __init__(self, size):
+        self.mem = bytearray(b'\xFF' * size)
+        self.erases = 0
+        self.words = 0
+
+    def erase(self, addr):
+        self.mem[addr:addr + PAGE_SIZE] = b'\xFF' * PAGE_SIZE
+        self.erases += 1
+
+    def write(self, addr, buf):
+        for a in range(0, len(buf), 4):
+            if self.mem[addr + a:addr + a + 4] != b'\xFF\xFF\xFF\xFF':
+                raise RuntimeError('program non-erased word at 0x%X' % (addr + a))
+            self.mem[addr + a:addr + a + 4] = buf[a:a + 4]
+            self.words += 1
+
+    def read(self, addr, n):
+        return self.mem[addr:addr + n]
+
+
+class Decoder(object):
+    """Model of the LDROM decoder, same states and page handling as LZ_USER.c."""
+
+    TOKEN, LITLEN, LITERAL, OFFSET0, OFFSET1, MATLEN, DONE, ERROR = range(8)
+
+    def __init__(self, flash, addr, length, window):
+        self.flash = flash
+        self.window = window
+        self.page = bytearray(b'\xFF' * PAGE_SIZE)
+        self.s = dict(state=self.TOKEN if length else self.DONE, start=addr, addr=addr,
+                      end=addr + length, programmed=addr, count=0, offset=0, token=0)
+        self.saved = dict(self.s)
+
+    def _flush(self):
+        s = self.s
+        page = s['addr'] & ~(PAGE_SIZE - 1)
+        if s['addr'] != page:
+            fill = s['addr'] - page
+            self.page[fill:] = b'\xFF' * (PAGE_SIZE - fill)
+        else:
+            page -= PAGE_SIZE
+        self.flash.write(page, self.page)
+        s['programmed'] = s['addr']
+
+    def _put(self, c):
+        s = self.s
+        self.page[s['addr'] & (PAGE_SIZE - 1)] = c
+        s['addr'] += 1
+        if (s['addr'] & (PAGE_SIZE - 1)) == 0 or s['addr'] == s['end']:
+            self._flush()
+
+    def _get(self, addr):
+        if addr >= (self.s['addr'] & ~(PAGE_SIZE - 1)):
+            return self.page[addr & (PAGE_SIZE - 1)]
+        return self.flash.read(addr, 1)[0]
+
+    def decode(self, src):
+        s = self.s
+        self.saved = dict(s)
+        for c in bytearray(src):
+            if s['state'] >= self.DONE:
+                break
+            match = False
+            st = s['state']
+            if st == self.TOKEN:
+                s['token'] = c
+                s['count'] = c >> 4
+                s['state'] = self.LITLEN if s['count'] == 15 else (self.LITERAL if s['count'] else self.OFFSET0)
+            elif st == self.LITLEN:
+                s['count'] += c
+                if c != 255:
+                    s['state'] = self.LITERAL
+            elif st == self.LITERAL:
+                self._put(c)
+                s['count'] -= 1
+                if s['count'] == 0:
+                    s['state'] = self.OFFSET0
+            elif st == self.OFFSET0:
+                s['offset'] = c
+                s['state'] = self.OFFSET1
+            elif st == self.OFFSET1:
+                s['offset'] |= c << 8
+                s['count'] = (s['token'] & 0xF) + 4
+                s['state'] = self.MATLEN if (s['token'] & 0xF) == 15 else self.TOKEN
+                match = s['state'] == self.TOKEN
+            else:
+                s['count'] += c
+                if c != 255:
+                    s['state'] = self.TOKEN
+                    match = True
+            if match:
+                if (s['offset'] == 0 or s['offset'] > self.window or s['offset'] > s['addr'] - s['start'] or
+                        s['count'] > s['end'] - s['addr']):
+                    s['state'] = self.ERROR
+                    break
+                while s['count']:
+                    self._put(self._get(s['addr'] - s['offset']))
+                    s['count'] -= 1
+            if s['addr'] == s['end']:
+                s['state'] = self.DONE
+        return None if s['state'] == self.ERROR else s['end'] - s['addr']
+
+    def rewind(self):
+        page = self.saved['addr'] & ~(PAGE_SIZE - 1)
+        if self.s['programmed'] != self.saved['programmed']:
+            self.page[:] = self.flash.read(page, PAGE_SIZE)
+            addr = page
+            while addr < self.s['programmed']:
+                self.flash.erase(addr)
+                addr += PAGE_SIZE
+        self.s = dict(self.saved)
+
+
+def packets(cmd, payload, total_len):
+    """Split payload like the ISP tool: first packet carries address and length."""
+    first = struct.pack('<IIII', cmd, 1, 0, total_len) + payload[:PACKET_SIZE - 16]
+    yield first + b'\0' * (PACKET_SIZE - len(first))
+    pos = PACKET_SIZE - 16
+    while pos < len(payload):
+        pkt = struct.pack('<II', 0, 0) + payload[pos:pos + PACKET_SIZE - 8]
+        yield pkt + b'\0' * (PACKET_SIZE - len(pkt))
+        pos += PACKET_SIZE - 8
+
+
+def link_time(npackets, words, erases, args):
+    """Seconds for packets and answers on the link plus flash programming and erase.
+    Erase of APROM before the update is the same for both and not counted."""
+    wire = npackets * 2 * PACKET_SIZE * args.bits / float(args.bps)
+    return wire + (npackets * args.turnaround + words * args.prog + erases * args.erase) * 1e-6
+
+
+def simulate(image, args):
+    comp = compress(image, args.window)
+    flash = Flash((len(image) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1))
+    rng = random.Random(args.seed)
+    pkts = list(packets(CMD_UPDATE_APROM_LZ, comp, len(image)))
+
+    dec = Decoder(flash, 0, len(image), args.window)
+    sent = 0
+    resent = 0
+    for n, pkt in enumerate(pkts):
+        data = pkt[16:] if n == 0 else pkt[8:]
+        left = dec.decode(data)
+        sent += 1
+        if left is not None and rng.random() < args.resend:
+            dec.rewind()
+            left = dec.decode(data)
+            sent += 2
+            resent += 1
+        if left is None:
+            print('decoder error in packet %d' % n)
+            return 1
+
+    if left != 0 or bytes(flash.mem[:len(image)]) != image:
+        print('FAIL: decoded flash differs from image')
+        return 1
+
+    raw_pkts = len(list(packets(CMD_UPDATE_APROM, image, len(image))))
+    raw_words = (len(image) + 3) // 4
+    t_raw = link_time(raw_pkts, raw_words, 0, args)
+    t_lz = link_time(sent, flash.words, flash.erases, args)
+
+    print('image      %6d bytes' % len(image))
+    print('compressed %6d bytes (%.1f%%), window %d' % (len(comp), 100.0 * len(comp) / max(len(image), 1), args.window))
+    print('packets    %6d raw, %d compressed (%d resent)' % (raw_pkts, sent, resent))
+    print('transfer   %6.2f s raw, %.2f s compressed at %d bit/s' % (t_raw, t_lz, args.bps))
+    print('PASS')
+    return 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__ or 'ISP LZ4 compressor')
+    sub = ap.add_subparsers(dest='cmd')
+    p = sub.add_parser('pack', help='compress image to LZ4 block')
+    p.add_argument('image')
+    p.add_argument('output')
+    p.add_argument('--window', type=int, default=0xFFFF, help='largest match offset, default 65535')
+    s = sub.add_parser('sim', help='replay compressed update into simulated FMC')
+    s.add_argument('image')
+    s.add_argument('--window', type=int, default=0xFFFF)
+    s.add_argument('--bps', type=int, default=115200, help='link bit rate, default UART 115200')
+    s.add_argument('--bits', type=int, default=10, help='bits on the wire per byte, 10 for UART, 8 for SPI/I2C')
+    s.add_argument('--turnaround', type=float, default=100, help='host turnaround per packet in us')
+    s.add_argument('--prog', type=float, default=40, help='word program time in us')
+    s.add_argument('--erase', type=float, default=20000, help='page erase time in us, for resent packets')
+    s.add_argument('--resend', type=float, default=0.0, help='probability a packet is resent')
+    s.add_argument('--seed', type=int, default=1)
+    args = ap.parse_args()
+
+    if args.cmd == 'pack':
+        with open(args.image, 'rb') as f:
+            image = f.read()
+        comp = compress(image, args.window)
+        with open(args.output, 'wb') as f:
+            f.write(comp)
+        print('%d -> %d bytes, send with CMD_UPDATE_APROM_LZ and length %d' % (len(image), len(comp), len(image)))
+        return 0
+    if args.cmd == 'sim':
+        with open(args.image, 'rb') as f:
+            image = f.read()
+        return simulate(image, args)
+    ap.print_help()
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
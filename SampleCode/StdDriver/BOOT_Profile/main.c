@@ -0,0 +1,120 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series boot time profiler sample code.
+ *           Times each boot phase from SystemInit to the UART being ready
+ *           and prints the breakdown.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+    BOOT_Mark("HIRC");
+
+    /* Enable external XTAL 12MHz clock. Already started with INIT_HXT_AT_BOOTING. */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+    BOOT_Mark("HXT wait");
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+    BOOT_Mark("PLL");
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+    BOOT_Mark("Clocks, pins");
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+    BOOT_Mark("UART_Open");
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    /* .bss and .data are initialized and the C library is ready */
+    BOOT_Mark("C runtime");
+
+    /* Drive P0.0 high first, before any clock setup */
+    P0->PMD = (P0->PMD & ~GPIO_PMD_PMD0_Msk) | (GPIO_PMD_OUTPUT << GPIO_PMD_PMD0_Pos);
+    P00 = 1;
+    BOOT_Mark("P0.0 output");
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    /* Free the timer, the marks are kept */
+    BOOT_Stop();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------+\n");
+    printf("|    Boot Time Profiler Sample Code       |\n");
+    printf("+-----------------------------------------+\n\n");
+
+    /*
+        Time from BOOT_Start in SystemInit, or in Reset_Handler with GCC. Define in the project:
+            INIT_HXT_AT_BOOTING     start the crystal in SystemInit, "HXT wait" shrinks
+            INIT_SYSCLK_AT_BOOTING  run the C runtime from PLL
+        and compare the reports.
+    */
+    BOOT_Report();
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,209 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series module clock manager sample code.
+ *           Two tasks share the ADC through reference counts. The ADC clock
+ *           is enabled only while one of them converts, and the report
+ *           shows the time it was on and the estimated energy.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#define ADC_CH              2           /* AIN2 on P1.2 */
+#define MONITOR_MS          100         /* Period of the monitor task */
+#define LOGGER_MS           2000        /* Period of the logger task */
+#define LOGGER_SAMPLES      64          /* Conversions averaged by the logger */
+#define REPORT_MS           10000       /* Period of the report */
+
+
+/**
+ * @brief       Timer3 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer3 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR3_IRQHandler(void)
+{
+    USEC_IRQHandler();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART and Timer3 module clock, the ADC clock is left to the clock manager */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR3_MODULE);
+
+    /* Select module clock sources, ADC clock is 22.1184/7 MHz */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3_S_HXT, 0);
+    CLK_SetModuleClock(ADC_MODULE, CLK_CLKSEL1_ADC_S_HIRC, CLK_CLKDIV_ADC(7));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+
+    /* Disable the P1.2 digital input path and set it to AIN2 */
+    GPIO_DISABLE_DIGITAL_PATH(P1, BIT2);
+    SYS->P1_MFP &= ~SYS_MFP_P12_Msk;
+    SYS->P1_MFP |= SYS_MFP_P12_AIN2;
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/* One conversion of ADC_CH, the caller holds the ADC clock */
+uint32_t AdcConvert(void)
+{
+    ADC_CLR_INT_FLAG(ADC, ADC_ADF_INT);
+    ADC_START_CONV(ADC);
+    while(!ADC_GET_INT_FLAG(ADC, ADC_ADF_INT));
+
+    return ADC_GET_CONVERSION_DATA(ADC, ADC_CH);
+}
+
+/* Monitor task, one conversion. Only this task holds the ADC, so it may reset it. */
+uint32_t MonitorTask(void)
+{
+    uint32_t u32Data;
+
+    if(CLKM_Acquire(ADC_MODULE) == 1)
+    {
+        CLKM_Reset(ADC_MODULE, ADC_RST);
+        ADC_Open(ADC, ADC_ADCR_DIFFEN_SINGLE_END, ADC_ADCR_ADMD_SINGLE, 1 << ADC_CH);
+    }
+    ADC_POWER_ON(ADC);
+
+    u32Data = AdcConvert();
+
+    if(CLKM_GetRef(ADC_MODULE) == 1)
+        ADC_POWER_DOWN(ADC);
+    CLKM_Release(ADC_MODULE);
+
+    return u32Data;
+}
+
+/* Logger task, averages a burst of conversions and calls the monitor task on the way */
+uint32_t LoggerTask(uint32_t *pu32Monitor)
+{
+    uint32_t u32Sum = 0, i;
+
+    CLKM_Acquire(ADC_MODULE);
+    ADC_Open(ADC, ADC_ADCR_DIFFEN_SINGLE_END, ADC_ADCR_ADMD_SINGLE, 1 << ADC_CH);
+    ADC_POWER_ON(ADC);
+
+    for(i = 0; i < LOGGER_SAMPLES; i++)
+    {
+        u32Sum += AdcConvert();
+
+        /* The ADC clock stays on, the monitor only adds a reference */
+        if(i == LOGGER_SAMPLES / 2)
+            *pu32Monitor = MonitorTask();
+    }
+
+    ADC_POWER_DOWN(ADC);
+    CLKM_Release(ADC_MODULE);
+
+    return u32Sum / LOGGER_SAMPLES;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint32_t u32Ms = 0, u32Monitor = 0, u32Average;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------+\n");
+    printf("|    Module Clock Manager Sample Code           |\n");
+    printf("+-----------------------------------------------+\n\n");
+    printf("  Monitor converts AIN2 every %d ms, logger averages %d conversions every %d ms.\n\n",
+           MONITOR_MS, LOGGER_SAMPLES, LOGGER_MS);
+
+    /* Timebase for the active time */
+    USEC_Open();
+
+    while(1)
+    {
+        USEC_Delay(MONITOR_MS * 1000);
+        u32Ms += MONITOR_MS;
+
+        if(u32Ms % LOGGER_MS == 0)
+        {
+            u32Average = LoggerTask(&u32Monitor);
+            printf("  %6d ms: average %4d, monitor %4d, ADC clock %s\n", u32Ms, u32Average, u32Monitor,
+                   (CLK->APBCLK & CLK_APBCLK_ADC_EN_Msk) ? "on" : "off");
+        }
+        else
+        {
+            u32Monitor = MonitorTask();
+        }
+
+        if(u32Ms % REPORT_MS == 0)
+        {
+            printf("\n  After %d s:\n", u32Ms / 1000);
+            CLKM_Report();
+            printf("\n");
+        }
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
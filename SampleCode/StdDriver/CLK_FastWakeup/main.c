@@ -0,0 +1,204 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series clock snapshot sample code.
+ *           Wake up from Power-down by Timer0 and compare the time to restore
+ *           PLL/HCLK from a clock snapshot with a SYS_Init style re-init.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#define WAKEUP_COUNT        10      /* Power-down cycles of each method */
+
+#define STCLK_PER_MS        (__HIRC / 2 / 1000)
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static CLK_SNAPSHOT_T s_sSnap;
+volatile uint32_t g_u32WakeupCount = 0;
+
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    TIMER_ClearIntFlag(TIMER0);
+
+    if(TIMER_GetWakeupFlag(TIMER0) == 1)
+    {
+        TIMER_ClearWakeupFlag(TIMER0);
+        g_u32WakeupCount++;
+    }
+}
+
+/* Clock setup as most applications do it after reset and again after every wake-up */
+void ClockInit(void)
+{
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC, SysTick keeps HIRC/2 */
+    CLK->CLKSEL0 = CLK_CLKSEL0_STCLK_S_HIRC_DIV2 | CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Enable external 12 MHz XTAL, IRC10K */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk | CLK_PWRCON_OSC10K_EN_Msk;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk | CLK_CLKSTATUS_IRC10K_STB_Msk);
+
+    /* Search PLL setting and wait for lock */
+    CLK_EnablePLL(CLK_PLLCON_PLL_SRC_HXT, PLL_CLOCK);
+
+    /* Switch HCLK clock source to PLL */
+    CLK->CLKSEL0 = CLK_CLKSEL0_STCLK_S_HIRC_DIV2 | CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable peripheral clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk;
+
+    /* Peripheral clock source */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_TMR0_S_LIRC;
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    ClockInit();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/* Enter Power-down and re-run ClockInit() after wake-up. Returns the time in SysTick clocks. */
+uint32_t PowerDownReinit(void)
+{
+    SysTick->CTRL = 0;
+    SysTick->LOAD = 0xFFFFFF;
+
+    CLK_PowerDown();
+
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_ENABLE_Msk;
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    ClockInit();
+
+    return 0xFFFFFF - SysTick->VAL;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t i, u32Cnt, u32Max, u32Sum;
+    int32_t i32Err = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+-------------------------------------------------+\n");
+    printf("|    Clock Snapshot Fast Wake-up Sample Code      |\n");
+    printf("+-------------------------------------------------+\n\n");
+
+    /* Timer0 on LIRC wakes the chip up every 100 ms */
+    TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, 10);
+    TIMER_EnableInt(TIMER0);
+    TIMER_EnableWakeup(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    TIMER_Start(TIMER0);
+
+    /* Clocks are final, take the snapshot */
+    CLK_SaveSnapshot(&s_sSnap);
+
+    printf("Time from wake-up until HCLK runs from PLL again, %d cycles each:\n", WAKEUP_COUNT);
+    UART_WAIT_TX_EMPTY(UART0);
+
+    /* Mask interrupts so the Timer0 handler runs after the clocks are restored */
+    u32Sum = u32Max = 0;
+    for(i = 0; i < WAKEUP_COUNT; i++)
+    {
+        __disable_irq();
+        u32Cnt = PowerDownReinit();
+        __enable_irq();
+
+        u32Sum += u32Cnt;
+        if(u32Cnt > u32Max)
+            u32Max = u32Cnt;
+    }
+    printf("  Re-init    average %5d us, max %5d us\n", u32Sum * 100 / WAKEUP_COUNT / (STCLK_PER_MS / 10),
+           u32Max * 100 / (STCLK_PER_MS / 10));
+    UART_WAIT_TX_EMPTY(UART0);
+
+    u32Sum = u32Max = 0;
+    for(i = 0; i < WAKEUP_COUNT; i++)
+    {
+        __disable_irq();
+        i32Err |= CLK_PowerDownRestore(&s_sSnap);
+        __enable_irq();
+
+        u32Sum += s_sSnap.u32WakeLatency;
+        if(s_sSnap.u32WakeLatency > u32Max)
+            u32Max = s_sSnap.u32WakeLatency;
+    }
+    printf("  Snapshot   average %5d us, max %5d us\n", u32Sum / WAKEUP_COUNT, u32Max);
+    printf("Wake-up count %d, CPU @ %d Hz\n", g_u32WakeupCount, SystemCoreClock);
+
+    TIMER_Close(TIMER0);
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    printf(i32Err ? "*** FAIL ***\n" : "*** PASS ***\n");
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
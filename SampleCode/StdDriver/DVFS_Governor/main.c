@@ -0,0 +1,214 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series core clock scaling governor sample code.
+ *           A periodic task changes its work every 5 seconds and the
+ *           governor moves HCLK between PLL 50 MHz, HIRC and HXT. UART0
+ *           and the 1 ms tick of Timer0 on HCLK stay correct at any level.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#define TASK_MS             10          /* Period of the task */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+volatile uint32_t g_u32Ms = 0;
+
+/* CPU cycles of work in each task period, 80 %, 6 % and 30 % load at 50 MHz */
+static const uint32_t s_au32Work[] = {400000, 30000, 150000};
+
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    TIMER_ClearIntFlag(TIMER0);
+    g_u32Ms++;
+}
+
+/**
+ * @brief       Timer3 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer3 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR3_IRQHandler(void)
+{
+    USEC_IRQHandler();
+}
+
+/* UART0 lets the last character leave before a change and sets its baud rate again after it.
+   The UART clock here is HXT and does not change, on PLL the divider would. */
+int32_t Uart0Notify(uint32_t u32Event, uint32_t u32Hclk)
+{
+    (void)u32Hclk;
+
+    if(u32Event == DVFS_EVENT_PRE)
+        UART_WAIT_TX_EMPTY(UART0);
+    else if(u32Event == DVFS_EVENT_POST)
+        UART_SetLine_Config(UART0, 115200, UART_WORD_LEN_8, UART_PARITY_NONE, UART_STOP_BIT_1);
+
+    return 0;
+}
+
+/* Timer0 counts HCLK, its prescaler and compare value follow the new clock */
+int32_t Timer0Notify(uint32_t u32Event, uint32_t u32Hclk)
+{
+    uint32_t u32Tcsr;
+
+    (void)u32Hclk;
+
+    if(u32Event == DVFS_EVENT_POST)
+    {
+        u32Tcsr = TIMER0->TCSR & (TIMER_TCSR_IE_Msk | TIMER_TCSR_CEN_Msk);
+        TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, 1000);
+        TIMER0->TCSR |= u32Tcsr;
+    }
+
+    return 0;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART, Timer0 and Timer3 module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(TMR3_MODULE);
+
+    /* Timer0 counts HCLK, the timebase on Timer3 counts the crystal */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0_S_HCLK, 0);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3_S_HXT, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    DVFS_STATS_T sStats;
+    uint32_t u32Task = 0, u32Report = 0, u32Phase = 0, u32Sec = 0, u32Start;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------+\n");
+    printf("|    Core Clock Scaling Governor Sample Code    |\n");
+    printf("+-----------------------------------------------+\n\n");
+
+    /* Timebase for load and latency */
+    USEC_Open();
+
+    /* 1 ms tick */
+    TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, 1000);
+    TIMER_EnableInt(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    TIMER_Start(TIMER0);
+    u32Start = USEC_Get32();
+
+    DVFS_Register(Uart0Notify);
+    DVFS_Register(Timer0Notify);
+    DVFS_Open(NULL, 0);
+
+    printf("  Tick ms  Time ms  kCyc   HCLK Hz   Load  Changes  Last us (IRQ off)  Max us (IRQ off)\n");
+
+    while(1)
+    {
+        if(g_u32Ms - u32Task >= TASK_MS)
+        {
+            u32Task += TASK_MS;
+            USEC_DelayCycles(s_au32Work[u32Phase]);
+        }
+
+        if(g_u32Ms - u32Report >= 1000)
+        {
+            u32Report += 1000;
+            DVFS_GetStats(&sStats);
+            printf("  %7d  %7d  %4d  %8d  %4d%%  %7d  %7d (%4d)       %6d (%4d)\n", g_u32Ms, (USEC_Get32() - u32Start) / 1000,
+                   s_au32Work[u32Phase] / 1000, SystemCoreClock, sStats.u32Load, sStats.u32Transitions,
+                   sStats.u32LastUs, sStats.u32LastIrqOffUs, sStats.u32MaxUs, sStats.u32MaxIrqOffUs);
+
+            /* Next work every 5 s */
+            if(++u32Sec % 5 == 0)
+                u32Phase = (u32Phase + 1) % (sizeof(s_au32Work) / sizeof(s_au32Work[0]));
+        }
+
+        /* Sleep until the next interrupt, the governor runs here */
+        DVFS_Idle();
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,321 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/06 2:15p $
+ * @brief    NUC029 Series external SRAM heap sample code.
+ *           Run a random allocation trace on a heap in external SRAM and report
+ *           allocation time, pool usage and fragmentation.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define HEAP_SIZE           0x10000 /* Bytes of external SRAM given to the heap */
+#define SLOT_NUM            64      /* Allocations alive at the same time */
+#define TRACE_LEN           20000   /* Alloc/free operations per run */
+#define CHECK_INTERVAL      1000    /* Operations between EHEAP_Check() calls */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+/* Placed in external SRAM by the linker */
+EBI_RAM_SECTION uint32_t g_au32HeapArea[HEAP_SIZE / 4];
+
+typedef struct
+{
+    uint8_t *pu8Ptr;
+    uint16_t u16Size;
+    uint8_t u8Tag;
+} SLOT_T;
+
+typedef struct
+{
+    uint32_t u32Count;
+    uint32_t u32Sum;
+    uint32_t u32Max;
+} CYCLES_T;
+
+static SLOT_T s_asSlot[SLOT_NUM];
+static CYCLES_T s_sAllocTime, s_sFreeTime;
+static uint32_t s_u32Seed = 1;
+
+
+static uint32_t Random(void)
+{
+    s_u32Seed = s_u32Seed * 1103515245 + 12345;
+    return s_u32Seed >> 8;
+}
+
+static void AddCycles(CYCLES_T *psTime, uint32_t u32Start)
+{
+    uint32_t u32Cycles = (TIMER0->TDR - u32Start) & TIMER_TDR_TDR_Msk;
+
+    psTime->u32Count++;
+    psTime->u32Sum += u32Cycles;
+    if(u32Cycles > psTime->u32Max)
+        psTime->u32Max = u32Cycles;
+}
+
+/* Size distribution: mostly small objects, some protocol buffers, a few large frames */
+static uint32_t RandomSize(void)
+{
+    uint32_t u32Class = Random() % 100;
+
+    if(u32Class < 60)
+        return 1 + Random() % EHEAP_POOL_MAX_SIZE;
+    else if(u32Class < 95)
+        return 1 + Random() % 1024;
+    else
+        return 1 + Random() % 8192;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Allocate or free a random slot. Each block is filled with a tag that is checked before it is freed.    */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t RunTrace(uint32_t u32Flags)
+{
+    SLOT_T *psSlot;
+    uint32_t u32Op, u32Start, i;
+
+    for(u32Op = 0; u32Op < TRACE_LEN; u32Op++)
+    {
+        psSlot = &s_asSlot[Random() % SLOT_NUM];
+
+        if(psSlot->pu8Ptr != NULL)
+        {
+            for(i = 0; i < psSlot->u16Size; i++)
+            {
+                if(psSlot->pu8Ptr[i] != psSlot->u8Tag)
+                {
+                    printf("  Data corrupted at 0x%08X\n", (uint32_t)&psSlot->pu8Ptr[i]);
+                    return -1;
+                }
+            }
+
+            u32Start = TIMER0->TDR;
+            EHEAP_Free(psSlot->pu8Ptr);
+            AddCycles(&s_sFreeTime, u32Start);
+            psSlot->pu8Ptr = NULL;
+        }
+        else
+        {
+            psSlot->u16Size = (uint16_t)RandomSize();
+
+            u32Start = TIMER0->TDR;
+            psSlot->pu8Ptr = EHEAP_Alloc(psSlot->u16Size, u32Flags);
+            AddCycles(&s_sAllocTime, u32Start);
+
+            if(psSlot->pu8Ptr != NULL)
+            {
+                psSlot->u8Tag = (uint8_t)Random();
+                EBI_MemSet(psSlot->pu8Ptr, psSlot->u8Tag, psSlot->u16Size);
+            }
+        }
+
+        if(((u32Op % CHECK_INTERVAL) == 0) && (EHEAP_Check() != 0))
+        {
+            printf("  Heap corrupted after %d operations\n", u32Op);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void PrintStats(void)
+{
+    EHEAP_POOL_STATS_T sPool;
+    EHEAP_STATS_T sHeap;
+    uint32_t u32Pool;
+
+    printf("  alloc cycles: avg %d max %d | free cycles: avg %d max %d\n",
+           s_sAllocTime.u32Sum / s_sAllocTime.u32Count, s_sAllocTime.u32Max,
+           s_sFreeTime.u32Sum / s_sFreeTime.u32Count, s_sFreeTime.u32Max);
+
+    for(u32Pool = 0; u32Pool <= EHEAP_POOL_NUM; u32Pool++)
+    {
+        EHEAP_GetPoolStats(u32Pool, &sPool);
+        printf("  %s %4d bytes: used %3d/%3d  peak %3d  empty %d\n", (u32Pool == EHEAP_POOL_NUM) ? "fast pool" : "pool     ",
+               sPool.u32BlockSize, sPool.u32Used, sPool.u32Blocks, sPool.u32Peak, sPool.u32Fail);
+    }
+
+    EHEAP_GetStats(&sHeap);
+    printf("  TLSF: size %d  free %d  min free %d  largest %d  blocks %d free/%d used  fail %d  fragmentation %d%%\n",
+           sHeap.u32Size, sHeap.u32Free, sHeap.u32MinFree, sHeap.u32LargestFree,
+           sHeap.u32FreeBlocks, sHeap.u32UsedBlocks, sHeap.u32Fail, sHeap.u32Frag);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Run one trace from an empty heap                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t HeapTest(uint32_t u32Flags)
+{
+    uint32_t i;
+
+    if(EHEAP_Init(g_au32HeapArea, sizeof(g_au32HeapArea)) != 0)
+    {
+        printf("  EHEAP_Init failed\n");
+        return -1;
+    }
+
+    for(i = 0; i < SLOT_NUM; i++)
+        s_asSlot[i].pu8Ptr = NULL;
+    s_sAllocTime.u32Count = s_sAllocTime.u32Sum = s_sAllocTime.u32Max = 0;
+    s_sFreeTime.u32Count = s_sFreeTime.u32Sum = s_sFreeTime.u32Max = 0;
+
+    if(RunTrace(u32Flags) != 0)
+        return -1;
+
+    PrintStats();
+
+    return 0;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12MHz XTAL */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = CLK_PLLCON_50MHz_HXT;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Switch HCLK clock source to PLL, STCLK to HCLK/2 */
+    CLK->CLKSEL0 = CLK_CLKSEL0_STCLK_S_HCLK_DIV2 | CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable EBI clock */
+    CLK->AHBCLK |= CLK_AHBCLK_EBI_EN_Msk;
+
+    /* Enable UART and Timer0 clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk;
+
+    /* UART clock source, Timer0 counts HCLK cycles */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_TMR0_S_HCLK;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD and EBI MCLK, nWR and nRD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk | SYS_MFP_P33_Msk | SYS_MFP_P36_Msk | SYS_MFP_P37_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0 | SYS_MFP_P33_MCLK | SYS_MFP_P36_nWR | SYS_MFP_P37_nRD);
+
+    /* Set P0 multi-function pins for EBI AD0 ~ AD7 */
+    SYS->P0_MFP &= ~(SYS_MFP_P00_Msk | SYS_MFP_P01_Msk | SYS_MFP_P02_Msk | SYS_MFP_P03_Msk |
+                     SYS_MFP_P04_Msk | SYS_MFP_P05_Msk | SYS_MFP_P06_Msk | SYS_MFP_P07_Msk);
+    SYS->P0_MFP |= (SYS_MFP_P00_AD0 | SYS_MFP_P01_AD1 | SYS_MFP_P02_AD2 | SYS_MFP_P03_AD3 |
+                    SYS_MFP_P04_AD4 | SYS_MFP_P05_AD5 | SYS_MFP_P06_AD6 | SYS_MFP_P07_AD7);
+    /* Set P2 multi-function pins for EBI AD8 ~ AD15 */
+    SYS->P2_MFP &= ~(SYS_MFP_P20_Msk | SYS_MFP_P21_Msk | SYS_MFP_P22_Msk | SYS_MFP_P23_Msk |
+                     SYS_MFP_P24_Msk | SYS_MFP_P25_Msk | SYS_MFP_P26_Msk | SYS_MFP_P27_Msk);
+    SYS->P2_MFP |= (SYS_MFP_P20_AD8 | SYS_MFP_P21_AD9 | SYS_MFP_P22_AD10 | SYS_MFP_P23_AD11 |
+                    SYS_MFP_P24_AD12 | SYS_MFP_P25_AD13 | SYS_MFP_P26_AD14 | SYS_MFP_P27_AD15);
+
+    /* Set P1 multi-function pins for EBI nWRL and nWRH */
+    SYS->P1_MFP &= ~(SYS_MFP_P10_Msk | SYS_MFP_P11_Msk);
+    SYS->P1_MFP |= (SYS_MFP_P10_nWRL | SYS_MFP_P11_nWRH);
+
+    /* Set P4 multi-function pins for EBI nCS, ALE and ICE CLK and DAT */
+    SYS->P4_MFP &= ~(SYS_MFP_P44_Msk | SYS_MFP_P45_Msk | SYS_MFP_P46_Msk | SYS_MFP_P47_Msk);
+    SYS->P4_MFP |= (SYS_MFP_P44_nCS | SYS_MFP_P45_ALE | SYS_MFP_P46_ICE_CLK | SYS_MFP_P47_ICE_DAT);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+-----------------------------------+\n");
+    printf("|   EBI External Heap Sample Code   |\n");
+    printf("+-----------------------------------+\n\n");
+
+    printf("***************************************************************************\n");
+    printf("* Please connect BS616LV4017 to NUC029 Series EBI bus before EBI testing !! *\n");
+    printf("***************************************************************************\n\n");
+
+    /* Timer0 free running on HCLK as cycle counter */
+    TIMER0->TCMPR = TIMER_TDR_TDR_Msk;
+    TIMER0->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk | TIMER_TCSR_CEN_Msk;
+
+    /* Initialize EBI bank0 to access external SRAM */
+    EBI_Open(0, EBI_BUSWIDTH_16BIT, EBI_TIMING_FASTEST, 0, 0);
+
+    printf("Heap at 0x%08X, %d bytes, %d live slots, %d operations per run\n\n",
+           (uint32_t)g_au32HeapArea, HEAP_SIZE, SLOT_NUM, TRACE_LEN);
+
+    printf("[1] Segregated pools and TLSF\n");
+    if(HeapTest(0) != 0)
+        goto lexit;
+
+    printf("\n[2] TLSF only\n");
+    if(HeapTest(EHEAP_FLAG_NOPOOL) != 0)
+        goto lexit;
+
+    printf("\n[3] Internal SRAM fast pool first\n");
+    if(HeapTest(EHEAP_FLAG_FAST) != 0)
+        goto lexit;
+
+    printf("\n*** EBI Heap Test Done ***\n");
+
+lexit:
+
+    /* Disable EBI function */
+    EBI_Close(0);
+
+    /* Disable EBI clock */
+    CLK->AHBCLK &= ~CLK_AHBCLK_EBI_EN_Msk;
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
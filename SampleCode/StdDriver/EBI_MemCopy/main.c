@@ -0,0 +1,299 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/01 10:34a $
+ * @brief    NUC029 Series EBI memory copy sample code.
+ *           Compare C library and EBI_MemCopy/EBI_MemSet/EBI_MemCmp bandwidth for each EBI timing class.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NUC029xAN.h"
+
+#define BENCH_SIZE          1024    /* Bytes moved by each test */
+
+/* Test operations */
+#define OP_SRAM_TO_EBI      0
+#define OP_EBI_TO_SRAM      1
+#define OP_EBI_TO_EBI       2
+#define OP_EBI_TO_EBI_ODD   3       /* Source and destination differ in alignment by one byte */
+#define OP_FILL             4
+#define OP_COMPARE          5
+#define OP_NUM              6
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+/* Placed in external SRAM by the linker, no copy or pointer arithmetic needed */
+EBI_RAM_SECTION uint8_t g_au8EbiBufA[BENCH_SIZE + 4];
+EBI_RAM_SECTION uint8_t g_au8EbiBufB[BENCH_SIZE + 4];
+
+static uint8_t s_au8SramBuf[BENCH_SIZE];
+
+static const char *s_apcOpName[OP_NUM] =
+{
+    "SRAM -> EBI copy ", "EBI -> SRAM copy ", "EBI -> EBI copy  ", "EBI -> EBI odd   ", "EBI fill         ", "EBI compare      "
+};
+
+static const char *s_apcTimingName[] =
+{
+    "EBI_TIMING_FASTEST", "EBI_TIMING_VERYFAST", "EBI_TIMING_FAST", "EBI_TIMING_NORMAL",
+    "EBI_TIMING_SLOW", "EBI_TIMING_VERYSLOW", "EBI_TIMING_SLOWEST"
+};
+
+
+static uint32_t BytesPerSecond(uint32_t u32Bytes, uint32_t u32Cycles)
+{
+    if(u32Cycles == 0)
+        return 0;
+
+    /* u32Bytes * SystemCoreClock / u32Cycles without 64-bit division */
+    return ((u32Bytes << 12) / u32Cycles) * (SystemCoreClock >> 12);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Run one operation with C library (u32Fast = 0) or EBI routines (u32Fast = 1), return HCLK cycles       */
+/*---------------------------------------------------------------------------------------------------------*/
+uint32_t RunOp(uint32_t u32Op, uint32_t u32Fast, int32_t *pi32Cmp)
+{
+    uint32_t u32Start, u32End;
+
+    u32Start = TIMER0->TDR;
+    switch(u32Op)
+    {
+        case OP_SRAM_TO_EBI:
+            if(u32Fast)
+                EBI_MemCopy(g_au8EbiBufA, s_au8SramBuf, BENCH_SIZE);
+            else
+                memcpy(g_au8EbiBufA, s_au8SramBuf, BENCH_SIZE);
+            break;
+
+        case OP_EBI_TO_SRAM:
+            if(u32Fast)
+                EBI_MemCopy(s_au8SramBuf, g_au8EbiBufA, BENCH_SIZE);
+            else
+                memcpy(s_au8SramBuf, g_au8EbiBufA, BENCH_SIZE);
+            break;
+
+        case OP_EBI_TO_EBI:
+            if(u32Fast)
+                EBI_MemCopy(g_au8EbiBufB, g_au8EbiBufA, BENCH_SIZE);
+            else
+                memcpy(g_au8EbiBufB, g_au8EbiBufA, BENCH_SIZE);
+            break;
+
+        case OP_EBI_TO_EBI_ODD:
+            if(u32Fast)
+                EBI_MemCopy(&g_au8EbiBufB[1], g_au8EbiBufA, BENCH_SIZE);
+            else
+                memcpy(&g_au8EbiBufB[1], g_au8EbiBufA, BENCH_SIZE);
+            break;
+
+        case OP_FILL:
+            if(u32Fast)
+                EBI_MemSet(g_au8EbiBufB, 0x5A, BENCH_SIZE);
+            else
+                memset(g_au8EbiBufB, 0x5A, BENCH_SIZE);
+            break;
+
+        default:
+            if(u32Fast)
+                *pi32Cmp = EBI_MemCmp(g_au8EbiBufA, g_au8EbiBufB, BENCH_SIZE);
+            else
+                *pi32Cmp = memcmp(g_au8EbiBufA, g_au8EbiBufB, BENCH_SIZE);
+            break;
+    }
+    u32End = TIMER0->TDR;
+
+    return (u32End - u32Start) & TIMER_TDR_TDR_Msk;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Benchmark all operations with current EBI timing                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t BenchTiming(void)
+{
+    uint32_t u32Op, u32Fast, u32Cycles[2], i;
+    int32_t i32Cmp = 0;
+
+    for(u32Op = 0; u32Op < OP_NUM; u32Op++)
+    {
+        for(u32Fast = 0; u32Fast < 2; u32Fast++)
+        {
+            /* Prepare data so that every copy result can be checked */
+            for(i = 0; i < BENCH_SIZE; i++)
+                s_au8SramBuf[i] = (uint8_t)(i * 7 + u32Op + u32Fast);
+            if(u32Op != OP_SRAM_TO_EBI)
+            {
+                EBI_MemCopy(g_au8EbiBufA, s_au8SramBuf, BENCH_SIZE);
+                EBI_MemCopy(g_au8EbiBufB, s_au8SramBuf, BENCH_SIZE);
+            }
+            if(u32Op == OP_EBI_TO_SRAM)
+                memset(s_au8SramBuf, 0, BENCH_SIZE);
+
+            u32Cycles[u32Fast] = RunOp(u32Op, u32Fast, &i32Cmp);
+
+            /* Check result */
+            if(((u32Op <= OP_EBI_TO_SRAM) && (memcmp(s_au8SramBuf, g_au8EbiBufA, BENCH_SIZE) != 0)) ||
+                    ((u32Op == OP_EBI_TO_EBI) && (memcmp(g_au8EbiBufA, g_au8EbiBufB, BENCH_SIZE) != 0)) ||
+                    ((u32Op == OP_EBI_TO_EBI_ODD) && (memcmp(g_au8EbiBufA, &g_au8EbiBufB[1], BENCH_SIZE) != 0)) ||
+                    ((u32Op == OP_FILL) && (g_au8EbiBufB[0] != 0x5A || g_au8EbiBufB[BENCH_SIZE - 1] != 0x5A)) ||
+                    ((u32Op == OP_COMPARE) && (i32Cmp != 0)))
+            {
+                printf("  %s FAIL (%s)\n", s_apcOpName[u32Op], u32Fast ? "EBI_Mem" : "C library");
+                return -1;
+            }
+        }
+
+        printf("  %s %9d  %9d  bytes/s\n", s_apcOpName[u32Op],
+               BytesPerSecond(BENCH_SIZE, u32Cycles[0]), BytesPerSecond(BENCH_SIZE, u32Cycles[1]));
+    }
+
+    return 0;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12MHz XTAL */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = CLK_PLLCON_50MHz_HXT;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Switch HCLK clock source to PLL, STCLK to HCLK/2 */
+    CLK->CLKSEL0 = CLK_CLKSEL0_STCLK_S_HCLK_DIV2 | CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable EBI clock */
+    CLK->AHBCLK |= CLK_AHBCLK_EBI_EN_Msk;
+
+    /* Enable UART and Timer0 clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk;
+
+    /* UART clock source, Timer0 counts HCLK cycles */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_TMR0_S_HCLK;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD and EBI MCLK, nWR and nRD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk | SYS_MFP_P33_Msk | SYS_MFP_P36_Msk | SYS_MFP_P37_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0 | SYS_MFP_P33_MCLK | SYS_MFP_P36_nWR | SYS_MFP_P37_nRD);
+
+    /* Set P0 multi-function pins for EBI AD0 ~ AD7 */
+    SYS->P0_MFP &= ~(SYS_MFP_P00_Msk | SYS_MFP_P01_Msk | SYS_MFP_P02_Msk | SYS_MFP_P03_Msk |
+                     SYS_MFP_P04_Msk | SYS_MFP_P05_Msk | SYS_MFP_P06_Msk | SYS_MFP_P07_Msk);
+    SYS->P0_MFP |= (SYS_MFP_P00_AD0 | SYS_MFP_P01_AD1 | SYS_MFP_P02_AD2 | SYS_MFP_P03_AD3 |
+                    SYS_MFP_P04_AD4 | SYS_MFP_P05_AD5 | SYS_MFP_P06_AD6 | SYS_MFP_P07_AD7);
+    /* Set P2 multi-function pins for EBI AD8 ~ AD15 */
+    SYS->P2_MFP &= ~(SYS_MFP_P20_Msk | SYS_MFP_P21_Msk | SYS_MFP_P22_Msk | SYS_MFP_P23_Msk |
+                     SYS_MFP_P24_Msk | SYS_MFP_P25_Msk | SYS_MFP_P26_Msk | SYS_MFP_P27_Msk);
+    SYS->P2_MFP |= (SYS_MFP_P20_AD8 | SYS_MFP_P21_AD9 | SYS_MFP_P22_AD10 | SYS_MFP_P23_AD11 |
+                    SYS_MFP_P24_AD12 | SYS_MFP_P25_AD13 | SYS_MFP_P26_AD14 | SYS_MFP_P27_AD15);
+
+    /* Set P1 multi-function pins for EBI nWRL and nWRH */
+    SYS->P1_MFP &= ~(SYS_MFP_P10_Msk | SYS_MFP_P11_Msk);
+    SYS->P1_MFP |= (SYS_MFP_P10_nWRL | SYS_MFP_P11_nWRH);
+
+    /* Set P4 multi-function pins for EBI nCS, ALE and ICE CLK and DAT */
+    SYS->P4_MFP &= ~(SYS_MFP_P44_Msk | SYS_MFP_P45_Msk | SYS_MFP_P46_Msk | SYS_MFP_P47_Msk);
+    SYS->P4_MFP |= (SYS_MFP_P44_nCS | SYS_MFP_P45_ALE | SYS_MFP_P46_ICE_CLK | SYS_MFP_P47_ICE_DAT);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t u32Timing;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+-----------------------------------+\n");
+    printf("|    EBI Memory Copy Sample Code    |\n");
+    printf("+-----------------------------------+\n\n");
+
+    printf("***************************************************************************\n");
+    printf("* Please connect BS616LV4017 to NUC029 Series EBI bus before EBI testing !! *\n");
+    printf("***************************************************************************\n\n");
+
+    /* Timer0 free running on HCLK as cycle counter */
+    TIMER0->TCMPR = TIMER_TDR_TDR_Msk;
+    TIMER0->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk | TIMER_TCSR_CEN_Msk;
+
+    printf("EBI buffers at 0x%08X and 0x%08X, %d bytes per test, 16-bit bus\n\n",
+           (uint32_t)g_au8EbiBufA, (uint32_t)g_au8EbiBufB, BENCH_SIZE);
+
+    for(u32Timing = EBI_TIMING_FASTEST; u32Timing <= EBI_TIMING_SLOWEST; u32Timing++)
+    {
+        EBI_Open(0, EBI_BUSWIDTH_16BIT, u32Timing, 0, 0);
+
+        printf("%s (MCLKDIV %d, EXTIME 0x%08X)\n", s_apcTimingName[u32Timing],
+               (EBI->EBICON & EBI_EBICON_MCLKDIV_Msk) >> EBI_EBICON_MCLKDIV_Pos, EBI->EXTIME);
+        printf("                    C library    EBI_Mem\n");
+        if(BenchTiming() != 0)
+            break;
+        printf("\n");
+    }
+
+    /* Disable EBI function */
+    EBI_Close(0);
+
+    /* Disable EBI clock */
+    CLK->AHBCLK &= ~CLK_AHBCLK_EBI_EN_Msk;
+
+    printf("*** EBI Memory Copy Test Done ***\n");
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
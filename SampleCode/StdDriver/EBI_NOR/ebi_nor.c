@@ -1,39 +1,388 @@
 /**************************************************************************//**
  * @file     ebi_nor.c
  * @version  V3.00
- * $Revision: 1 $
+ * $Revision: 2 $
  * $Date: 14/10/01 10:34a $
- * @brief    NOR Flash - W39L040P Driver Source File
+ * @brief    NOR Flash Driver Source File. Supports CFI (AMD command set) and JEDEC W39L040P parts.
  *
- * @note
+ * @note     The driver reads SysTick for command deadlines and does not use CLK_SysTickDelay(), which would
+ *           stop it. A stopped SysTick is started free running, one already running keeps its reload value
+ *           and must count HCLK.
  * @copyright SPDX-License-Identifier: Apache-2.0
  * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
  ******************************************************************************/
 #include <stdio.h>
+#include <string.h>
 #include "NUC029xAN.h"
 #include "ebi_nor.h"
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Status bits                                                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+#define NOR_DQ1                 BIT1    /* Write buffer abort */
+#define NOR_DQ5                 BIT5    /* Exceeded timing limits */
+#define NOR_DQ6                 BIT6    /* Toggle bit */
+#define NOR_DQ7                 BIT7    /* Data polling bit */
+
+#define NOR_POLL_DATA           0       /* DQ7 data polling against the programmed value */
+#define NOR_POLL_TOGGLE         1       /* DQ6 toggle polling */
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Global file scope (static) variables                                                                    */
 /*---------------------------------------------------------------------------------------------------------*/
 volatile uint8_t *g_pu8NorBaseAddr;
+NOR_INFO_T g_sNorInfo;
+
+static uint32_t s_u32NorShift;          /* CFI and ID offsets are shifted left by this */
+static uint32_t s_u32NorLast;           /* SysTick value at last deadline update */
+static uint32_t s_u32NorCycles;         /* Cycles not yet accounted in s_u32NorUs */
+static uint32_t s_u32NorUs;             /* Microseconds since NOR_TimeStart() */
+
+
+static __INLINE void NOR_Cmd(uint32_t u32Addr, uint32_t u32Data)
+{
+    if(g_sNorInfo.u32Flags & NOR_FLAG_BUS16)
+        EBI_WRITE_DATA16(u32Addr, u32Data);
+    else
+        EBI_WRITE_DATA8(u32Addr, u32Data);
+}
+
+static __INLINE uint32_t NOR_Rd(uint32_t u32Addr)
+{
+    if(g_sNorInfo.u32Flags & NOR_FLAG_BUS16)
+        return EBI_READ_DATA16(u32Addr);
+    else
+        return EBI_READ_DATA8(u32Addr);
+}
+
+static __INLINE void NOR_Unlock(void)
+{
+    NOR_Cmd(g_sNorInfo.u32Unlock1, 0xAA);
+    NOR_Cmd(g_sNorInfo.u32Unlock2, 0x55);
+}
+
+static void NOR_TimeStart(void)
+{
+    /* Restart SysTick if someone else has stopped it */
+    if((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == 0)
+    {
+        SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+        SysTick->VAL  = 0;
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    }
+
+    s_u32NorLast = SysTick->VAL;
+    s_u32NorCycles = 0;
+    s_u32NorUs = 0;
+}
+
+/* Microseconds since NOR_TimeStart(). Must be called at least once per SysTick period, LOAD + 1 cycles,
+   a missed wrap makes deadlines later, never earlier. */
+static uint32_t NOR_TimeUs(void)
+{
+    uint32_t u32Now = SysTick->VAL, u32Us;
+
+    /* SysTick counts down from LOAD, which may be an application tick rather than 0xFFFFFF */
+    if(u32Now <= s_u32NorLast)
+        s_u32NorCycles += s_u32NorLast - u32Now;
+    else
+        s_u32NorCycles += s_u32NorLast + (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1 - u32Now;
+    s_u32NorLast = u32Now;
+    if(s_u32NorCycles >= CyclesPerUs)
+    {
+        u32Us = s_u32NorCycles / CyclesPerUs;
+        s_u32NorCycles -= u32Us * CyclesPerUs;
+        s_u32NorUs += u32Us;
+    }
+
+    return s_u32NorUs;
+}
+
+static void NOR_DelayUs(uint32_t u32Us)
+{
+    NOR_TimeStart();
+    while(NOR_TimeUs() < u32Us);
+}
+
+/* Wait for an embedded algorithm at u32Addr to finish. DQ5 and DQ1 are only defined on CFI parts. */
+static int32_t NOR_Poll(uint32_t u32Addr, uint32_t u32Data, uint32_t u32Method, uint32_t u32TimeoutUs)
+{
+    uint32_t u32Status, u32Status2, u32Cfi;
+
+    u32Cfi = g_sNorInfo.u32Flags & NOR_FLAG_CFI;
+    NOR_TimeStart();
+
+    while(1)
+    {
+        u32Status = NOR_Rd(u32Addr);
+
+        if(u32Method == NOR_POLL_DATA)
+        {
+            if(((u32Status ^ u32Data) & NOR_DQ7) == 0)
+            {
+                /* DQ0 ~ DQ6 may become valid one read cycle after DQ7 */
+                if((u32Status == u32Data) || (NOR_Rd(u32Addr) == u32Data))
+                    return NOR_OK;
+                return NOR_ERR_VERIFY;
+            }
+            if(u32Cfi && (u32Status & (NOR_DQ5 | NOR_DQ1)))
+            {
+                if(((NOR_Rd(u32Addr) ^ u32Data) & NOR_DQ7) == 0)
+                    return (NOR_Rd(u32Addr) == u32Data) ? NOR_OK : NOR_ERR_VERIFY;
+                return NOR_ERR_FAIL;
+            }
+        }
+        else
+        {
+            u32Status2 = NOR_Rd(u32Addr);
+            if(((u32Status ^ u32Status2) & NOR_DQ6) == 0)
+                return NOR_OK;
+            if(u32Cfi && (u32Status2 & NOR_DQ5))
+            {
+                u32Status = NOR_Rd(u32Addr);
+                u32Status2 = NOR_Rd(u32Addr);
+                return (((u32Status ^ u32Status2) & NOR_DQ6) == 0) ? NOR_OK : NOR_ERR_FAIL;
+            }
+        }
+
+        if(NOR_TimeUs() > u32TimeoutUs)
+            return NOR_ERR_TIMEOUT;
+    }
+}
+
+/* Enter CFI query mode with 0x98 at u32Entry and check for "QRY" */
+static uint32_t NOR_CfiProbe(uint32_t u32Entry, uint32_t u32Shift)
+{
+    NOR_Cmd(0, 0xF0);
+    NOR_Cmd(u32Entry, 0x98);
+    NOR_DelayUs(1);
+
+    if(((NOR_Rd(0x10 << u32Shift) & 0xFF) == 'Q') &&
+            ((NOR_Rd(0x11 << u32Shift) & 0xFF) == 'R') &&
+            ((NOR_Rd(0x12 << u32Shift) & 0xFF) == 'Y'))
+    {
+        s_u32NorShift = u32Shift;
+        return TRUE;
+    }
+
+    NOR_Cmd(0, 0xF0);
+    return FALSE;
+}
+
+static uint32_t NOR_Cfi(uint32_t u32Offset)
+{
+    return NOR_Rd(u32Offset << s_u32NorShift) & 0xFF;
+}
+
+static uint32_t NOR_Cfi16(uint32_t u32Offset)
+{
+    return NOR_Cfi(u32Offset) | (NOR_Cfi(u32Offset + 1) << 8);
+}
+
+/* Read geometry, timeouts and capabilities. Device must be in CFI query mode. */
+static void NOR_ReadCfi(void)
+{
+    NOR_INFO_T *psInfo = &g_sNorInfo;
+    uint32_t i, u32Pri, u32Size;
+
+    psInfo->u32Flags |= NOR_FLAG_CFI;
+
+    /* Typical times are 2^N, maximum times are typical times 2^N */
+    psInfo->u32ProgTimeout = NOR_Cfi(0x1F) ? ((1UL << NOR_Cfi(0x1F)) << NOR_Cfi(0x23)) : NOR_JEDEC_PROG_TIMEOUT;
+    psInfo->u32BufTimeout = NOR_Cfi(0x20) ? ((1UL << NOR_Cfi(0x20)) << NOR_Cfi(0x24)) : 0;
+    psInfo->u32EraseTimeout = NOR_Cfi(0x21) ? ((1UL << NOR_Cfi(0x21)) << NOR_Cfi(0x25)) : NOR_JEDEC_ERASE_TIMEOUT;
+    psInfo->u32ChipTimeout = NOR_Cfi(0x22) ? ((1UL << NOR_Cfi(0x22)) << NOR_Cfi(0x26)) : NOR_JEDEC_CHIP_TIMEOUT;
+
+    u32Size = 1UL << NOR_Cfi(0x27);
+    psInfo->u32Size = (u32Size > EBI_MAX_SIZE) ? EBI_MAX_SIZE : u32Size;
+
+    psInfo->u32BufSize = 1UL << NOR_Cfi16(0x2A);
+    if((psInfo->u32BufTimeout != 0) && (psInfo->u32BufSize > 2))
+        psInfo->u32Flags |= NOR_FLAG_BUFFER;
+    else
+        psInfo->u32BufSize = 0;
+
+    psInfo->u32RegionNum = NOR_Cfi(0x2C);
+    if(psInfo->u32RegionNum > NOR_MAX_REGIONS)
+        psInfo->u32RegionNum = NOR_MAX_REGIONS;
+    for(i = 0; i < psInfo->u32RegionNum; i++)
+    {
+        psInfo->asRegion[i].u32Count = NOR_Cfi16(0x2D + i * 4) + 1;
+        u32Size = NOR_Cfi16(0x2F + i * 4);
+        psInfo->asRegion[i].u32Size = u32Size ? (u32Size * 256) : 128;
+    }
+
+    /* AMD/Fujitsu standard command set supports unlock bypass */
+    if(NOR_Cfi16(0x13) == 0x0002)
+    {
+        psInfo->u32Flags |= NOR_FLAG_BYPASS;
+
+        /* Primary vendor extended query, offset 6 is erase suspend support */
+        u32Pri = NOR_Cfi16(0x15);
+        if((NOR_Cfi(u32Pri) == 'P') && (NOR_Cfi(u32Pri + 1) == 'R') && (NOR_Cfi(u32Pri + 2) == 'I') &&
+                (NOR_Cfi(u32Pri + 6) != 0))
+            psInfo->u32Flags |= NOR_FLAG_SUSPEND;
+    }
+}
+
+/* Write one byte or word without polling */
+static __INLINE void NOR_PutUnit(uint32_t u32Addr, const uint8_t *pu8Data)
+{
+    if(g_sNorInfo.u32Flags & NOR_FLAG_BUS16)
+        EBI_WRITE_DATA16(u32Addr, pu8Data[0] | (pu8Data[1] << 8));
+    else
+        EBI_WRITE_DATA8(u32Addr, pu8Data[0]);
+}
+
+static __INLINE uint32_t NOR_GetUnit(const uint8_t *pu8Data)
+{
+    if(g_sNorInfo.u32Flags & NOR_FLAG_BUS16)
+        return pu8Data[0] | (pu8Data[1] << 8);
+    else
+        return pu8Data[0];
+}
+
+static int32_t NOR_ProgramUnits(uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len, uint32_t u32Bypass)
+{
+    uint32_t u32Step, u32Data, u32Erased;
+    int32_t i32Ret;
+
+    u32Step = (g_sNorInfo.u32Flags & NOR_FLAG_BUS16) ? 2 : 1;
+    u32Erased = (g_sNorInfo.u32Flags & NOR_FLAG_BUS16) ? 0xFFFF : 0xFF;
+
+    for(; u32Len; u32Addr += u32Step, pu8Data += u32Step, u32Len -= u32Step)
+    {
+        u32Data = NOR_GetUnit(pu8Data);
+
+        /* Erased state needs no programming */
+        if(u32Data == u32Erased)
+            continue;
+
+        if(!u32Bypass)
+            NOR_Unlock();
+        NOR_Cmd(g_sNorInfo.u32Unlock1, 0xA0);
+        NOR_PutUnit(u32Addr, pu8Data);
+
+        i32Ret = NOR_Poll(u32Addr, u32Data, NOR_POLL_DATA, g_sNorInfo.u32ProgTimeout);
+        if(i32Ret != NOR_OK)
+            return i32Ret;
+    }
+
+    return NOR_OK;
+}
+
+static int32_t NOR_ProgramBuffer(uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32Step, u32Chunk, u32Last, i;
+    int32_t i32Ret;
+
+    u32Step = (g_sNorInfo.u32Flags & NOR_FLAG_BUS16) ? 2 : 1;
+
+    while(u32Len)
+    {
+        /* A buffer program must not cross a write buffer page */
+        u32Chunk = g_sNorInfo.u32BufSize - (u32Addr & (g_sNorInfo.u32BufSize - 1));
+        if(u32Chunk > u32Len)
+            u32Chunk = u32Len;
+
+        for(i = 0; i < u32Chunk; i++)
+        {
+            if(pu8Data[i] != 0xFF)
+                break;
+        }
+
+        if(i < u32Chunk)
+        {
+            NOR_Unlock();
+            NOR_Cmd(u32Addr, 0x25);
+            NOR_Cmd(u32Addr, u32Chunk / u32Step - 1);
+            for(i = 0; i < u32Chunk; i += u32Step)
+                NOR_PutUnit(u32Addr + i, &pu8Data[i]);
+            NOR_Cmd(u32Addr, 0x29);
+
+            u32Last = u32Chunk - u32Step;
+            i32Ret = NOR_Poll(u32Addr + u32Last, NOR_GetUnit(&pu8Data[u32Last]), NOR_POLL_DATA, g_sNorInfo.u32BufTimeout);
+            if(i32Ret != NOR_OK)
+                return i32Ret;
+        }
+
+        u32Addr += u32Chunk;
+        pu8Data += u32Chunk;
+        u32Len -= u32Chunk;
+    }
+
+    return NOR_OK;
+}
 
 
 /**
  * @brief       NOR Flash Initial
  *
- * @param[in]   None
+ * @param[in]   u32BusWidth     EBI data bus width. Valid values are EBI_BUSWIDTH_8BIT and EBI_BUSWIDTH_16BIT.
  *
  * @return      None
  *
- * @details     Initial and reset NOR Flash - W39L040P.
+ * @details     Identify the NOR Flash by CFI query and fill g_sNorInfo. Parts without CFI, such as W39L040P,
+ *              use JEDEC unlock addresses with single byte programming only.
+ *              EBI must be opened with the same bus width before calling this function.
  */
-void NOR_Init(void)
+void NOR_Init(uint32_t u32BusWidth)
 {
+    NOR_INFO_T *psInfo = &g_sNorInfo;
+
     g_pu8NorBaseAddr = (uint8_t *)EBI_BASE_ADDR;
 
+    memset(psInfo, 0, sizeof(NOR_INFO_T));
+    if(u32BusWidth == EBI_BUSWIDTH_16BIT)
+        psInfo->u32Flags = NOR_FLAG_BUS16;
+
+    /* Unlock cycles go to word 0x555/0x2AA on 16-bit bus and x16 parts in byte mode, to byte 0x555/0x2AA on x8 parts */
+    if(u32BusWidth == EBI_BUSWIDTH_16BIT)
+    {
+        if(NOR_CfiProbe(0xAA, 1))
+        {
+            psInfo->u32Unlock1 = 0xAAA;
+            psInfo->u32Unlock2 = 0x554;
+        }
+    }
+    else
+    {
+        if(NOR_CfiProbe(0x55, 0))
+        {
+            psInfo->u32Unlock1 = 0x555;
+            psInfo->u32Unlock2 = 0x2AA;
+        }
+        else if(NOR_CfiProbe(0xAA, 1))
+        {
+            psInfo->u32Unlock1 = 0xAAA;
+            psInfo->u32Unlock2 = 0x555;
+        }
+    }
+
+    if(psInfo->u32Unlock1)
+    {
+        NOR_ReadCfi();
+        NOR_Cmd(0, 0xF0);
+    }
+    else
+    {
+        /* JEDEC part */
+        s_u32NorShift = (u32BusWidth == EBI_BUSWIDTH_16BIT) ? 1 : 0;
+        psInfo->u32Unlock1 = 0x5555 << s_u32NorShift;
+        psInfo->u32Unlock2 = 0x2AAA << s_u32NorShift;
+        psInfo->u32Size = EBI_MAX_SIZE;
+        psInfo->u32ProgTimeout = NOR_JEDEC_PROG_TIMEOUT;
+        psInfo->u32EraseTimeout = NOR_JEDEC_ERASE_TIMEOUT;
+        psInfo->u32ChipTimeout = NOR_JEDEC_CHIP_TIMEOUT;
+        psInfo->u32RegionNum = 1;
+        psInfo->asRegion[0].u32Count = EBI_MAX_SIZE / NOR_JEDEC_SECTOR_SIZE;
+        psInfo->asRegion[0].u32Size = NOR_JEDEC_SECTOR_SIZE;
+    }
+
     /* Reset NOR Flash */
     NOR_Reset();
+
+    psInfo->u32Id = NOR_GetID();
 }
 
 /**
@@ -43,13 +392,12 @@ void NOR_Init(void)
  *
  * @return      None
  *
- * @details     Reset NOR Flash - W39L040P.
+ * @details     Return NOR Flash to read array mode. Also clears a write buffer abort.
  */
 void NOR_Reset(void)
 {
-    *(g_pu8NorBaseAddr + 0x5555) = 0xAA;
-    *(g_pu8NorBaseAddr + 0x2AAA) = 0x55;
-    *(g_pu8NorBaseAddr + 0x0000) = 0xF0;
+    NOR_Unlock();
+    NOR_Cmd(0x0000, 0xF0);
 }
 
 /**
@@ -57,28 +405,25 @@ void NOR_Reset(void)
  *
  * @param[in]   None
  *
- * @return      Return Manufacture ID and Device ID
+ * @return      Return Manufacture ID << 16 | Device ID
  *
- * @details     Return the ID of W39L040P and Manufacture ID should be 0xDA, Device ID should be 0x31.
+ * @details     W39L040P returns Manufacture ID 0xDA, Device ID 0xB6.
  */
 uint32_t NOR_GetID(void)
 {
-    uint8_t u8ManuFactureID, u8DeviceID;
+    uint32_t u32ManuFactureID, u32DeviceID;
 
-    *(g_pu8NorBaseAddr + 0x5555) = 0xAA;
-    *(g_pu8NorBaseAddr + 0x2AAA) = 0x55;
-    *(g_pu8NorBaseAddr + 0x5555) = 0x90;
-    CLK_SysTickDelay(10);
+    NOR_Unlock();
+    NOR_Cmd(g_sNorInfo.u32Unlock1, 0x90);
+    NOR_DelayUs(10);
 
-    u8ManuFactureID = *(g_pu8NorBaseAddr + 0x0);
-    u8DeviceID      = *(g_pu8NorBaseAddr + 0x1);
+    u32ManuFactureID = NOR_Rd(0x0) & 0xFF;
+    u32DeviceID      = NOR_Rd(1 << s_u32NorShift);
 
-    *(g_pu8NorBaseAddr + 0x5555) = 0xAA;
-    *(g_pu8NorBaseAddr + 0x2AAA) = 0x55;
-    *(g_pu8NorBaseAddr + 0x5555) = 0xF0;
-    CLK_SysTickDelay(10);
+    NOR_Reset();
+    NOR_DelayUs(10);
 
-    return ((u8ManuFactureID << 8) | u8DeviceID);
+    return ((u32ManuFactureID << 16) | u32DeviceID);
 }
 
 /**
@@ -89,24 +434,20 @@ uint32_t NOR_GetID(void)
  * @retval      FALSE       Erase command fail
  * @retval      TRUE        Erase command pass
  *
- * @details     W39L040P whole chip erase.
+ * @details     Whole chip erase.
  */
 uint8_t NOR_Erase(void)
 {
-    uint8_t u8Status;
+    NOR_Unlock();
+    NOR_Cmd(g_sNorInfo.u32Unlock1, 0x80);
+    NOR_Unlock();
+    NOR_Cmd(g_sNorInfo.u32Unlock1, 0x10);
 
-    *(g_pu8NorBaseAddr + 0x5555) = 0xAA;
-    *(g_pu8NorBaseAddr + 0x2AAA) = 0x55;
-    *(g_pu8NorBaseAddr + 0x5555) = 0x80;
-    *(g_pu8NorBaseAddr + 0x5555) = 0xAA;
-    *(g_pu8NorBaseAddr + 0x2AAA) = 0x55;
-    *(g_pu8NorBaseAddr + 0x5555) = 0x10;
-
-    u8Status = NOR_CheckCMDComplete(0x0, 0x0);
-    if(u8Status == FALSE)
+    if(NOR_Poll(0, 0, NOR_POLL_TOGGLE, g_sNorInfo.u32ChipTimeout * 1000) != NOR_OK)
+    {
+        NOR_Reset();
         return FALSE;
-
-    CLK_SysTickDelay(200000);
+    }
 
     return TRUE;
 }
@@ -120,29 +461,11 @@ uint8_t NOR_Erase(void)
  * @retval      FALSE       Command fail
  * @retval      TRUE        Command complete
  *
- * @details     Check if the specified command is complete or not.
+ * @details     Check if the specified command is complete or not, using DQ7 data polling with 200 ms deadline.
  */
 uint8_t NOR_CheckCMDComplete(uint32_t u32Addr, uint8_t u8Data)
 {
-    /* Using Data Polling Algorithm to check if command is complete or not */
-    uint8_t u8CurData;
-    volatile uint32_t u32TimeOutCnts = 0;
-
-    /* Command timeout period is 200 ms */
-    u8Data = u8Data & (1 << 7); // read D7
-    while(u32TimeOutCnts < 200000)
-    {
-        u8CurData = NOR_ReadData(u32Addr);
-        u8CurData = u8CurData & (1 << 7); // read DQ7
-        if(u8Data == u8CurData)
-        {
-            return TRUE;
-        }
-        CLK_SysTickDelay(1);
-        u32TimeOutCnts++;
-    }
-
-    return FALSE;
+    return (NOR_Poll(u32Addr, u8Data, NOR_POLL_DATA, 200000) == NOR_OK) ? TRUE : FALSE;
 }
 
 /**
@@ -168,17 +491,205 @@ uint8_t NOR_ReadData(uint32_t u32DestAddr)
  * @retval      FALSE       Write command fail
  * @retval      TRUE        Write command pass
  *
- * @details     Write the date to specified address.
+ * @details     Write one byte with the full unlock sequence. 8-bit bus only, use NOR_Program() for bulk data.
  */
 uint8_t NOR_WriteData(uint32_t u32DestAddr, uint8_t u8Data)
 {
-    *(g_pu8NorBaseAddr + 0x5555) = 0xAA;
-    *(g_pu8NorBaseAddr + 0x2AAA) = 0x55;
-    *(g_pu8NorBaseAddr + 0x5555) = 0xA0;
+    return (NOR_Program(u32DestAddr, &u8Data, 1, NOR_MODE_SINGLE) == NOR_OK) ? TRUE : FALSE;
+}
+
+/**
+ * @brief       Get sector size
+ *
+ * @param[in]   u32Addr     Any address in the sector
+ *
+ * @return      Size in bytes of the sector containing u32Addr
+ */
+uint32_t NOR_GetSectorSize(uint32_t u32Addr)
+{
+    uint32_t i, u32Base = 0, u32End;
+
+    for(i = 0; i < g_sNorInfo.u32RegionNum; i++)
+    {
+        u32End = u32Base + g_sNorInfo.asRegion[i].u32Count * g_sNorInfo.asRegion[i].u32Size;
+        if(u32Addr < u32End)
+            return g_sNorInfo.asRegion[i].u32Size;
+        u32Base = u32End;
+    }
+
+    return NOR_JEDEC_SECTOR_SIZE;
+}
+
+/**
+ * @brief       Program data to NOR Flash
+ *
+ * @param[in]   u32Addr     Start address. Must be 2-byte aligned on 16-bit bus.
+ * @param[in]   pu8Data     Data to be programmed
+ * @param[in]   u32Len      Length in bytes. Must be even on 16-bit bus.
+ * @param[in]   u32Mode     NOR_MODE_SINGLE, NOR_MODE_BYPASS, NOR_MODE_BUFFER or NOR_MODE_AUTO
+ *
+ * @retval      NOR_OK              Success
+ * @retval      NOR_ERR_PARAM       Address, length or mode not valid
+ * @retval      NOR_ERR_UNSUPPORTED Mode not supported by the device
+ * @retval      NOR_ERR_TIMEOUT     Device still busy after the CFI maximum program time
+ * @retval      NOR_ERR_FAIL        Device reported program failure
+ * @retval      NOR_ERR_VERIFY      Programmed value does not match, e.g. area not erased
+ *
+ * @details     Bytes/words equal to the erased value are skipped. On error the device is reset to read mode.
+ */
+int32_t NOR_Program(uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len, uint32_t u32Mode)
+{
+    uint32_t u32Flags = g_sNorInfo.u32Flags;
+    int32_t i32Ret;
+
+    if((u32Addr + u32Len > g_sNorInfo.u32Size) || (u32Addr + u32Len < u32Addr))
+        return NOR_ERR_PARAM;
+    if((u32Flags & NOR_FLAG_BUS16) && ((u32Addr | u32Len) & 1))
+        return NOR_ERR_PARAM;
+
+    if(u32Mode == NOR_MODE_AUTO)
+    {
+        if(u32Flags & NOR_FLAG_BUFFER)
+            u32Mode = NOR_MODE_BUFFER;
+        else if(u32Flags & NOR_FLAG_BYPASS)
+            u32Mode = NOR_MODE_BYPASS;
+        else
+            u32Mode = NOR_MODE_SINGLE;
+    }
+
+    if(u32Mode == NOR_MODE_SINGLE)
+    {
+        i32Ret = NOR_ProgramUnits(u32Addr, pu8Data, u32Len, FALSE);
+    }
+    else if(u32Mode == NOR_MODE_BYPASS)
+    {
+        if(!(u32Flags & NOR_FLAG_BYPASS))
+            return NOR_ERR_UNSUPPORTED;
+
+        NOR_Unlock();
+        NOR_Cmd(g_sNorInfo.u32Unlock1, 0x20);
+
+        i32Ret = NOR_ProgramUnits(u32Addr, pu8Data, u32Len, TRUE);
+
+        /* Unlock bypass reset */
+        NOR_Cmd(0, 0x90);
+        NOR_Cmd(0, 0x00);
+    }
+    else if(u32Mode == NOR_MODE_BUFFER)
+    {
+        if(!(u32Flags & NOR_FLAG_BUFFER))
+            return NOR_ERR_UNSUPPORTED;
+
+        i32Ret = NOR_ProgramBuffer(u32Addr, pu8Data, u32Len);
+    }
+    else
+    {
+        return NOR_ERR_PARAM;
+    }
+
+    if(i32Ret != NOR_OK)
+        NOR_Reset();
+
+    return i32Ret;
+}
+
+/**
+ * @brief       Start sector erase
+ *
+ * @param[in]   u32Addr     Any address in the sector
+ *
+ * @return      None
+ *
+ * @details     Return as soon as the command is issued. Use NOR_IsBusy() or NOR_EraseWait() for completion.
+ */
+void NOR_EraseSectorStart(uint32_t u32Addr)
+{
+    NOR_Unlock();
+    NOR_Cmd(g_sNorInfo.u32Unlock1, 0x80);
+    NOR_Unlock();
+    NOR_Cmd(u32Addr, 0x30);
+}
+
+/**
+ * @brief       Wait for sector erase to finish
+ *
+ * @param[in]   u32Addr     Any address in the erasing sector
+ *
+ * @retval      NOR_OK              Erase done
+ * @retval      NOR_ERR_TIMEOUT     Still busy after the CFI maximum sector erase time
+ * @retval      NOR_ERR_FAIL        Device reported erase failure
+ *
+ * @details     DQ6 toggle polling. The deadline restarts on each call, so time spent suspended is not counted.
+ */
+int32_t NOR_EraseWait(uint32_t u32Addr)
+{
+    int32_t i32Ret;
+
+    i32Ret = NOR_Poll(u32Addr, 0, NOR_POLL_TOGGLE, g_sNorInfo.u32EraseTimeout * 1000);
+    if(i32Ret != NOR_OK)
+        NOR_Reset();
+
+    return i32Ret;
+}
+
+/**
+ * @brief       Erase one sector
+ *
+ * @param[in]   u32Addr     Any address in the sector
+ *
+ * @return      Same as NOR_EraseWait()
+ */
+int32_t NOR_EraseSector(uint32_t u32Addr)
+{
+    NOR_EraseSectorStart(u32Addr);
+    return NOR_EraseWait(u32Addr);
+}
+
+/**
+ * @brief       Check if an embedded program or erase is running
+ *
+ * @param[in]   u32Addr     Address in the sector being programmed or erased
+ *
+ * @retval      0   Ready, or erase suspended
+ * @retval      1   Busy
+ */
+uint32_t NOR_IsBusy(uint32_t u32Addr)
+{
+    return ((NOR_Rd(u32Addr) ^ NOR_Rd(u32Addr)) & NOR_DQ6) ? 1 : 0;
+}
+
+/**
+ * @brief       Suspend sector erase
+ *
+ * @param[in]   u32Addr     Any address in the erasing sector
+ *
+ * @retval      NOR_OK              Erase suspended or already finished, other sectors can be read
+ * @retval      NOR_ERR_UNSUPPORTED Device does not support erase suspend
+ * @retval      NOR_ERR_TIMEOUT     Device did not enter suspend in time
+ *
+ * @details     Sectors not being erased can be read until NOR_EraseResume() is called.
+ */
+int32_t NOR_EraseSuspend(uint32_t u32Addr)
+{
+    if(!(g_sNorInfo.u32Flags & NOR_FLAG_SUSPEND))
+        return NOR_ERR_UNSUPPORTED;
+
+    NOR_Cmd(u32Addr, 0xB0);
 
-    *(g_pu8NorBaseAddr + u32DestAddr) = u8Data;
+    /* DQ6 stops toggling once suspended */
+    return NOR_Poll(u32Addr, 0, NOR_POLL_TOGGLE, NOR_SUSPEND_TIMEOUT);
+}
 
-    return NOR_CheckCMDComplete(u32DestAddr, u8Data);
+/**
+ * @brief       Resume suspended sector erase
+ *
+ * @param[in]   u32Addr     Any address in the suspended sector
+ *
+ * @return      None
+ */
+void NOR_EraseResume(uint32_t u32Addr)
+{
+    NOR_Cmd(u32Addr, 0x30);
 }
 
 /*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -1,9 +1,9 @@
 /**************************************************************************//**
  * @file     ebi_nor.h
  * @version  V2.00
- * $Revision: 1 $
+ * $Revision: 2 $
  * $Date: 14/10/01 10:34a $
- * @brief    NOR Flash - W39L040P Driver Header File
+ * @brief    NOR Flash Driver Header File. Supports CFI (AMD command set) and JEDEC W39L040P parts.
  *
  * @note
  * @copyright SPDX-License-Identifier: Apache-2.0
@@ -18,10 +18,70 @@ extern "C"
 #endif
 
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Return codes                                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define NOR_OK                  0       /* Operation completed */
+#define NOR_ERR_TIMEOUT         (-1)    /* Deadline expired before the device became ready */
+#define NOR_ERR_FAIL            (-2)    /* Device reported failure (DQ5) or write buffer abort (DQ1) */
+#define NOR_ERR_VERIFY          (-3)    /* Data read back does not match */
+#define NOR_ERR_PARAM           (-4)    /* Address, length or mode not valid */
+#define NOR_ERR_UNSUPPORTED     (-5)    /* Device does not support the requested operation */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Programming modes                                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+#define NOR_MODE_SINGLE         0       /* Full unlock sequence for every byte/word */
+#define NOR_MODE_BYPASS         1       /* Unlock bypass, two bus cycles per byte/word */
+#define NOR_MODE_BUFFER         2       /* Write buffer programming */
+#define NOR_MODE_AUTO           3       /* Fastest mode the device supports */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Device capability flags                                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#define NOR_FLAG_CFI            BIT0    /* Geometry and timeouts read from CFI query */
+#define NOR_FLAG_BYPASS         BIT1    /* Unlock bypass supported */
+#define NOR_FLAG_BUFFER         BIT2    /* Write buffer programming supported */
+#define NOR_FLAG_SUSPEND        BIT3    /* Erase suspend supported */
+#define NOR_FLAG_BUS16          BIT4    /* 16-bit EBI data bus */
+
+#define NOR_MAX_REGIONS         4       /* Maximum erase block regions kept from CFI */
+
+/* Defaults for JEDEC parts without CFI, e.g. W39L040P */
+#define NOR_JEDEC_SECTOR_SIZE   0x10000
+#define NOR_JEDEC_PROG_TIMEOUT  200     /* us */
+#define NOR_JEDEC_ERASE_TIMEOUT 1000    /* ms */
+#define NOR_JEDEC_CHIP_TIMEOUT  10000   /* ms */
+#define NOR_SUSPEND_TIMEOUT     50      /* us, erase suspend latency */
+
+typedef struct
+{
+    uint32_t u32Count;                  /* Number of sectors in region */
+    uint32_t u32Size;                   /* Sector size in bytes */
+} NOR_REGION_T;
+
+typedef struct
+{
+    uint32_t u32Flags;                  /* NOR_FLAG_xxx */
+    uint32_t u32Id;                     /* Manufacture ID << 16 | Device ID */
+    uint32_t u32Size;                   /* Usable size, limited to EBI_MAX_SIZE */
+    uint32_t u32BufSize;                /* Write buffer size in bytes, 0 if not supported */
+    uint32_t u32Unlock1;                /* Byte offset of first unlock cycle */
+    uint32_t u32Unlock2;                /* Byte offset of second unlock cycle */
+    uint32_t u32ProgTimeout;            /* Single byte/word program deadline in us */
+    uint32_t u32BufTimeout;             /* Write buffer program deadline in us */
+    uint32_t u32EraseTimeout;           /* Sector erase deadline in ms */
+    uint32_t u32ChipTimeout;            /* Chip erase deadline in ms */
+    uint32_t u32RegionNum;
+    NOR_REGION_T asRegion[NOR_MAX_REGIONS];
+} NOR_INFO_T;
+
+extern NOR_INFO_T g_sNorInfo;
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Define EBI_NOR Functions Prototype                                                                      */
 /*---------------------------------------------------------------------------------------------------------*/
-void NOR_Init(void);
+void NOR_Init(uint32_t u32BusWidth);
 void NOR_Reset(void);
 uint32_t NOR_GetID(void);
 uint8_t NOR_Erase(void);
@@ -29,6 +89,15 @@ uint8_t NOR_CheckCMDComplete(uint32_t u32DestAddr, uint8_t u8Data);
 uint8_t NOR_ReadData(uint32_t u32DestAddr);
 uint8_t NOR_WriteData(uint32_t u32DestAddr, uint8_t u8Data);
 
+uint32_t NOR_GetSectorSize(uint32_t u32Addr);
+int32_t NOR_Program(uint32_t u32Addr, const uint8_t *pu8Data, uint32_t u32Len, uint32_t u32Mode);
+int32_t NOR_EraseSector(uint32_t u32Addr);
+void NOR_EraseSectorStart(uint32_t u32Addr);
+int32_t NOR_EraseWait(uint32_t u32Addr);
+uint32_t NOR_IsBusy(uint32_t u32Addr);
+int32_t NOR_EraseSuspend(uint32_t u32Addr);
+void NOR_EraseResume(uint32_t u32Addr);
+
 #ifdef __cplusplus
 }
 #endif
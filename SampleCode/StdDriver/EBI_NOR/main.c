@@ -17,42 +17,156 @@
 #define PLL_CLOCK           50000000
 
 
+#define NOR_BUS_WIDTH       EBI_BUSWIDTH_8BIT   /* EBI_BUSWIDTH_16BIT for x16 parts on AD0 ~ AD15 */
+#define NOR_TEST_SIZE       0x10000             /* Bytes programmed by each mode */
+#define NOR_CHUNK_SIZE      256                 /* Bytes passed to NOR_Program() per call */
+
+static uint8_t s_au8Chunk[NOR_CHUNK_SIZE];
+static const char *s_apcModeName[] = {"Single", "Unlock bypass", "Write buffer"};
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Timer0 runs at 1 MHz in continuous mode, TDR is a microsecond counter wrapping every 16.7 seconds       */
+/*---------------------------------------------------------------------------------------------------------*/
+static void Timer0_Start(void)
+{
+    TIMER0->TCMPR = TIMER_TDR_TDR_Msk;
+    TIMER0->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk | TIMER_TCSR_CEN_Msk | (__HXT / 1000000 - 1);
+}
+
+static uint32_t Timer0_GetUs(void)
+{
+    return TIMER0->TDR;
+}
+
+static uint8_t TestPattern(uint32_t u32Addr)
+{
+    return (uint8_t)((u32Addr % 256) + (u32Addr >> 8));
+}
+
+static uint32_t BytesPerSecond(uint32_t u32Bytes, uint32_t u32Us)
+{
+    if(u32Us < 1000)
+        u32Us = 1000;
+
+    /* u32Bytes * 1000000 / u32Us without 32-bit overflow */
+    return u32Bytes * 1000 / (u32Us / 1000);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Erase test area sector by sector                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t EraseArea(uint32_t u32Size)
+{
+    uint32_t u32Addr, u32Start;
+    int32_t i32Ret;
+
+    u32Start = Timer0_GetUs();
+    for(u32Addr = 0; u32Addr < u32Size; u32Addr += NOR_GetSectorSize(u32Addr))
+    {
+        i32Ret = NOR_EraseSector(u32Addr);
+        if(i32Ret != NOR_OK)
+        {
+            printf("    >> Erase sector 0x%05X FAIL (%d)\n", u32Addr, i32Ret);
+            return i32Ret;
+        }
+    }
+    printf("    >> Erase 0x%X bytes: %d ms\n", u32Size, ((Timer0_GetUs() - u32Start) & TIMER_TDR_TDR_Msk) / 1000);
+
+    for(u32Addr = 0; u32Addr < u32Size; u32Addr++)
+    {
+        if(NOR_ReadData(u32Addr) != 0xFF)
+        {
+            printf("    >> Erase verify FAIL !! Addr:0x%X, Data:0x%X.\n", u32Addr, NOR_ReadData(u32Addr));
+            return NOR_ERR_VERIFY;
+        }
+    }
+
+    return NOR_OK;
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
-/* Program Continue Data to NOR Flash                                                                      */
+/* Program test area with one mode, report throughput and verify                                          */
 /*---------------------------------------------------------------------------------------------------------*/
-uint8_t ProgramContinueDataTest(void)
+int32_t ProgramModeTest(uint32_t u32Mode, uint32_t u32Size)
 {
-    uint8_t u8DataIn, u8DataOut;
-    uint32_t u32NORAddr;
+    uint32_t u32Addr, i, u32Us, u32Start;
+    uint8_t u8DataOut;
+    int32_t i32Ret;
 
-    printf("    >> Start to program flash ... \n");
+    printf("  [%s]\n", s_apcModeName[u32Mode]);
 
-    /* Write */
-    for(u32NORAddr = 0; u32NORAddr < EBI_MAX_SIZE; u32NORAddr++)
+    if(EraseArea(u32Size) != NOR_OK)
+        return NOR_ERR_FAIL;
+
+    u32Us = 0;
+    for(u32Addr = 0; u32Addr < u32Size; u32Addr += NOR_CHUNK_SIZE)
     {
-        u8DataIn = (u32NORAddr % 256) + u32NORAddr;
-        if(NOR_WriteData(u32NORAddr, u8DataIn) == FALSE)
+        for(i = 0; i < NOR_CHUNK_SIZE; i++)
+            s_au8Chunk[i] = TestPattern(u32Addr + i);
+
+        /* Only time spent in the driver is counted */
+        u32Start = Timer0_GetUs();
+        i32Ret = NOR_Program(u32Addr, s_au8Chunk, NOR_CHUNK_SIZE, u32Mode);
+        u32Us += (Timer0_GetUs() - u32Start) & TIMER_TDR_TDR_Msk;
+
+        if(i32Ret != NOR_OK)
         {
-            printf("Program [0x%05X]:[0x%02X] FAIL !!! \n\n", u32NORAddr, u8DataIn);
-            return FALSE;
+            printf("    >> Program [0x%05X] FAIL (%d) !!!\n\n", u32Addr, i32Ret);
+            return i32Ret;
         }
     }
+    printf("    >> Program 0x%X bytes: %d ms, %d bytes/s\n", u32Size, u32Us / 1000, BytesPerSecond(u32Size, u32Us));
 
-    /* Read */
-    for(u32NORAddr = 0; u32NORAddr < EBI_MAX_SIZE; u32NORAddr++)
+    for(u32Addr = 0; u32Addr < u32Size; u32Addr++)
     {
-        u8DataIn = (u32NORAddr % 256) + u32NORAddr;
-        u8DataOut = NOR_ReadData(u32NORAddr);
-        if(u8DataOut != u8DataIn)
+        u8DataOut = NOR_ReadData(u32Addr);
+        if(u8DataOut != TestPattern(u32Addr))
         {
-            printf("Read [0x%05X]:[0x%02X] FAIL !!! (Got [0x%02X]) \n\n", u32NORAddr, u8DataIn, u8DataOut);
-            printf("Program flash FAIL !!! \n\n");
-            return FALSE;
+            printf("    >> Read [0x%05X]:[0x%02X] FAIL !!! (Got [0x%02X])\n\n", u32Addr, TestPattern(u32Addr), u8DataOut);
+            return NOR_ERR_VERIFY;
         }
     }
-    printf("    >> Continue Data Program OK !!! \n\n");
+    printf("    >> Verify OK\n");
+
+    return NOR_OK;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Suspend a sector erase, read another sector, then resume                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t EraseSuspendTest(void)
+{
+    uint32_t u32Sector1 = NOR_GetSectorSize(0);
+    uint32_t u32Start, u32Us;
+    uint8_t u8Data;
+    int32_t i32Ret;
+
+    printf("  [Erase suspend/resume]\n");
+
+    /* Sector 0 holds the pattern of the last mode test, sector 1 is erased while sector 0 is read */
+    NOR_EraseSectorStart(u32Sector1);
+    CLK_SysTickDelay(1000);
+
+    u32Start = Timer0_GetUs();
+    i32Ret = NOR_EraseSuspend(u32Sector1);
+    u32Us = (Timer0_GetUs() - u32Start) & TIMER_TDR_TDR_Msk;
+    if(i32Ret != NOR_OK)
+    {
+        printf("    >> Suspend FAIL (%d)\n", i32Ret);
+        NOR_EraseWait(u32Sector1);
+        return i32Ret;
+    }
+
+    u8Data = NOR_ReadData(0x10);
+    printf("    >> Suspended in %d us, read [0x00010]:[0x%02X] %s\n", u32Us, u8Data,
+           (u8Data == TestPattern(0x10)) ? "OK" : "FAIL");
 
-    return TRUE;
+    NOR_EraseResume(u32Sector1);
+    i32Ret = NOR_EraseWait(u32Sector1);
+    printf("    >> Resumed, erase %s\n", (i32Ret == NOR_OK) && (NOR_ReadData(u32Sector1) == 0xFF) ? "OK" : "FAIL");
+
+    return i32Ret;
 }
 
 void SYS_Init(void)
@@ -87,11 +201,11 @@ void SYS_Init(void)
     /* Enable EBI clock */
     CLK->AHBCLK |= CLK_AHBCLK_EBI_EN_Msk;
 
-    /* Enable UART clock */
-    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk;
+    /* Enable UART and Timer0 clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk;
 
-    /* UART clock source */
-    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL;
+    /* UART and Timer0 clock source */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_TMR0_S_HXT;
 
     /* Update System Core Clock */
     /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
@@ -142,9 +256,8 @@ void UART0_Init(void)
 /*---------------------------------------------------------------------------------------------------------*/
 int main(void)
 {
-    uint32_t u32i;
-    uint32_t u32NORIDInfo;
-    uint8_t u8ReadOutData;
+    NOR_INFO_T *psInfo = &g_sNorInfo;
+    uint32_t i, u32Mode, u32Size;
 
     /* Unlock protected registers */
     SYS_UnlockReg();
@@ -164,44 +277,56 @@ int main(void)
     printf("+---------------------------------+\n\n");
 
     printf("**************************************************************************\n");
-    printf("* Please connect W39L040P to NUC029 Series EBI bus before EBI testing !! *\n");
+    printf("* Please connect NOR flash to NUC029 Series EBI bus before EBI testing !! *\n");
+    printf("* W39L040P or CFI parts with AMD command set are supported.              *\n");
     printf("**************************************************************************\n\n");
 
-    /* Enable EBI function and bus width to 8-bit */
-    EBI_Open(0, EBI_BUSWIDTH_8BIT, EBI_TIMING_NORMAL, 0, 0);
+    Timer0_Start();
 
-    /* Initial NOR flash and check ID */
-    NOR_Init();
-    u32NORIDInfo = NOR_GetID();
-    if(u32NORIDInfo == 0xDAB6)
-    {
-        printf("NOR W39L040P initial OK ! Manufacture ID:0x%X, Device ID:0x%X.\n", (u32NORIDInfo >> 8), (u32NORIDInfo & 0xFF));
-    }
-    else
+    /* Enable EBI function and bus width */
+    EBI_Open(0, NOR_BUS_WIDTH, EBI_TIMING_NORMAL, 0, 0);
+
+    /* Initial NOR flash and read geometry */
+    NOR_Init(NOR_BUS_WIDTH);
+    printf("NOR Manufacture ID:0x%X, Device ID:0x%X, %s\n", psInfo->u32Id >> 16, psInfo->u32Id & 0xFFFF,
+           (psInfo->u32Flags & NOR_FLAG_CFI) ? "CFI" : "JEDEC (no CFI)");
+    if((psInfo->u32Id >> 16) == 0 || (psInfo->u32Id >> 16) == 0xFF)
     {
-        printf("NOR W39L040P initial fail ! (ID:0x%X)\n\n", u32NORIDInfo);
+        printf("NOR flash initial fail !\n\n");
         goto lexit;
     }
-
-    /* Erase flash */
-    NOR_Erase();
-    for(u32i = 0; u32i < EBI_MAX_SIZE; u32i++)
+    printf("  Size on EBI: 0x%X bytes, write buffer: %d bytes\n", psInfo->u32Size, psInfo->u32BufSize);
+    for(i = 0; i < psInfo->u32RegionNum; i++)
+        printf("  Erase region %d: %d x %d bytes\n", i, psInfo->asRegion[i].u32Count, psInfo->asRegion[i].u32Size);
+    printf("  Max program %d us, buffer program %d us, sector erase %d ms\n",
+           psInfo->u32ProgTimeout, psInfo->u32BufTimeout, psInfo->u32EraseTimeout);
+    printf("  Unlock bypass: %s, erase suspend: %s\n\n",
+           (psInfo->u32Flags & NOR_FLAG_BYPASS) ? "yes" : "no", (psInfo->u32Flags & NOR_FLAG_SUSPEND) ? "yes" : "no");
+
+    u32Size = (psInfo->u32Size < NOR_TEST_SIZE) ? psInfo->u32Size : NOR_TEST_SIZE;
+
+    /* Program the same area with every mode the device supports */
+    for(u32Mode = NOR_MODE_SINGLE; u32Mode <= NOR_MODE_BUFFER; u32Mode++)
     {
-        u8ReadOutData = NOR_ReadData(u32i);
-        if(u8ReadOutData != 0xFF)
+        if(((u32Mode == NOR_MODE_BYPASS) && !(psInfo->u32Flags & NOR_FLAG_BYPASS)) ||
+                ((u32Mode == NOR_MODE_BUFFER) && !(psInfo->u32Flags & NOR_FLAG_BUFFER)))
         {
-            printf("    >> Chip Erase Fail !! Addr:0x%X, Data:0x%X.\n\n", u32i, u8ReadOutData);
-            goto lexit;
+            printf("  [%s] not supported\n", s_apcModeName[u32Mode]);
+            continue;
         }
+
+        if(ProgramModeTest(u32Mode, u32Size) != NOR_OK)
+            goto lexit;
     }
-    printf("    >> Chip Erase OK !!!\n");
 
-    /* Start to program NOR flash test */
-    if( ProgramContinueDataTest() == TRUE )
+    if((psInfo->u32Flags & NOR_FLAG_SUSPEND) && (NOR_GetSectorSize(0) < psInfo->u32Size))
     {
-        printf("*** NOR Flash Test OK ***\n");
+        if(EraseSuspendTest() != NOR_OK)
+            goto lexit;
     }
 
+    printf("\n*** NOR Flash Test OK ***\n");
+
 lexit:
 
     /* Disable EBI function */
@@ -210,8 +335,6 @@ lexit:
     /* Disable EBI clock */
     CLK->AHBCLK &= ~CLK_AHBCLK_EBI_EN_Msk;
 
-    printf("*** NOR Flash Test OK ***\n");
-
     while(1);
 }
 
@@ -16,9 +16,51 @@
 #define PLL_CLOCK           50000000
 
 
+/* Calibrated EBI timing is kept in the first Data Flash page */
+#define EBI_CAL_FLASH_ADDR  (FMC->DFBADR)
+
 extern int32_t SRAM_BS616LV4017(void);
 
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Use EBI timing saved by an earlier boot, otherwise calibrate and save it                                */
+/*---------------------------------------------------------------------------------------------------------*/
+void EBI_TimingInit(void)
+{
+    EBI_CAL_T sCal;
+
+    EBI_MeasureBandwidth(0, EBI_MAX_SIZE, 0, &sCal);
+    printf("EBI_TIMING_NORMAL : read %d bytes/s, write %d bytes/s\n", sCal.u32ReadBps, sCal.u32WriteBps);
+
+    /* Registers are still unlocked for ISP */
+    FMC_Open();
+
+    if(EBI_LoadCalibration(EBI_CAL_FLASH_ADDR, &sCal) == 0)
+    {
+        EBI_ApplyCalibration(0, &sCal);
+        EBI_MeasureBandwidth(0, EBI_MAX_SIZE, 0, &sCal);
+        printf("Saved timing      : ");
+    }
+    else
+    {
+        printf("Calibrating EBI timing ... ");
+        if(EBI_Calibrate(0, 0, EBI_MAX_SIZE, 0, &sCal) != 0)
+        {
+            printf("FAIL, keep EBI_TIMING_NORMAL\n\n");
+            FMC_Close();
+            return;
+        }
+        printf("%s\n", (EBI_SaveCalibration(EBI_CAL_FLASH_ADDR, &sCal) == 0) ? "saved to Data Flash" : "save FAIL");
+        printf("Calibrated timing : ");
+    }
+
+    FMC_Close();
+
+    printf("read %d bytes/s, write %d bytes/s\n", sCal.u32ReadBps, sCal.u32WriteBps);
+    printf("    MCLKDIV %d, ExttALE %d, EXTIME 0x%08X\n\n", sCal.u32MclkDiv, sCal.u32ALE, sCal.u32ExTime);
+}
+
+
 void SYS_Init(void)
 {
     /*---------------------------------------------------------------------------------------------------------*/
@@ -111,9 +153,6 @@ int main(void)
     /* Init System, peripheral clock and multi-function I/O */
     SYS_Init();
 
-    /* Lock protected registers */
-    SYS_LockReg();
-
     /* Init UART0 for printf */
     UART0_Init();
 #if !( __GNUC__ )
@@ -130,6 +169,12 @@ int main(void)
     /* Enable EBI function and bus width to 16-bit */
     EBI_Open(0, EBI_BUSWIDTH_16BIT, EBI_TIMING_NORMAL, 0, 0);
 
+    /* Replace the canned timing class with the fastest timing this board passes */
+    EBI_TimingInit();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
     /* Start SRAM test */
     if( SRAM_BS616LV4017() == 0)
     {
@@ -0,0 +1,290 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/08 4:20p $
+ * @brief    NUC029 Series A/B dual image firmware update sample code
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLLCON_SETTING      CLK_PLLCON_50MHz_HXT
+#define PLL_CLOCK           50000000
+
+#define CHUNK_SIZE          256     /* Image bytes received between two acknowledges */
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12 MHz XTAL */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = PLLCON_SETTING;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Switch HCLK clock source to PLL */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable peripheral clock. Keep WDT clock, the boot manager may have started the trial WDT. */
+    CLK->APBCLK |= CLK_APBCLK_UART0_EN_Msk;
+
+    /* Peripheral clock source */
+    CLK->CLKSEL1 = (CLK->CLKSEL1 & ~CLK_CLKSEL1_UART_S_Msk) | CLK_CLKSEL1_UART_S_PLL;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+#if defined(BOOT_MANAGER)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Boot manager at address 0. Kept free of printf to fit in DUALIMG_BOOT_SIZE.                            */
+/*---------------------------------------------------------------------------------------------------------*/
+void PutString(const char *pcStr)
+{
+    while(*pcStr)
+    {
+        while(UART_IS_TX_FULL(UART0));
+        UART_WRITE(UART0, *pcStr++);
+    }
+    UART_WAIT_TX_EMPTY(UART0);
+}
+
+int32_t main(void)
+{
+    /* Unlock protected registers for ISP, VECMAP and WDT */
+    SYS_UnlockReg();
+
+    SYS_Init();
+
+    UART0_Init();
+
+    FMC_Open();
+
+    PutString("\nBoot manager\n");
+
+    /* Does not return unless neither slot holds a valid image or the rollback record cannot be written */
+    if(DUALIMG_Boot() == -2)
+        PutString("Cannot save rollback record, flash error\n");
+    else
+        PutString("No valid image, program slot A or B\n");
+
+    while(1);
+}
+
+#else
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Application image, built for slot A and slot B                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+uint8_t g_au8Buf[CHUNK_SIZE];
+
+uint32_t GetWord(void)
+{
+    uint32_t i, u32Data = 0;
+
+    for(i = 0; i < 32; i += 8)
+        u32Data |= (uint32_t)getchar() << i;
+
+    return u32Data;
+}
+
+void ShowState(void)
+{
+    DUALIMG_STATE_T sState;
+    uint32_t i;
+
+    DUALIMG_GetState(&sState);
+
+    printf("Record #%d: active %c, pending %c, trial boots %d\n", sState.u32Seq, 'A' + sState.u32Active,
+           (sState.u32Pending == DUALIMG_SLOT_NONE) ? '-' : 'A' + sState.u32Pending, sState.u32Attempts);
+    for(i = 0; i < 2; i++)
+        printf("  Slot %c @ 0x%05X: length %d, CRC 0x%08X\n", 'A' + i, DUALIMG_SLOT_BASE(i), sState.au32Len[i], sState.au32Crc[i]);
+}
+
+/*
+    Host sends the image length (4 bytes, little endian), the image in chunks of CHUNK_SIZE bytes and its CRC-32
+    (4 bytes). After each chunk the host waits for '.' because the CPU stalls while a page is erased and the
+    UART FIFO would overflow.
+*/
+void Update(void)
+{
+    uint32_t u32Slot = DUALIMG_GetRunningSlot() ^ 1;
+    uint32_t u32Len, u32Crc, u32Offset, u32Size, i;
+
+    printf("Send image for slot %c: length, data, CRC-32\n", 'A' + u32Slot);
+
+    u32Len = GetWord();
+    if((u32Len == 0) || (u32Len > DUALIMG_SLOT_SIZE))
+    {
+        printf("Invalid length %d\n", u32Len);
+        return;
+    }
+
+    FMC_ENABLE_AP_UPDATE();
+
+    for(u32Offset = 0; u32Offset < u32Len; u32Offset += u32Size)
+    {
+        u32Size = (u32Len - u32Offset > CHUNK_SIZE) ? CHUNK_SIZE : u32Len - u32Offset;
+        for(i = 0; i < u32Size; i++)
+            g_au8Buf[i] = getchar();
+
+        /* Pad last chunk to a word */
+        for(; i & 3; i++)
+            g_au8Buf[i] = 0xFF;
+
+        if(DUALIMG_Write(u32Slot, u32Offset, g_au8Buf, i) != 0)
+        {
+            FMC_DISABLE_AP_UPDATE();
+            printf("\nWrite failed at offset 0x%X\n", u32Offset);
+            return;
+        }
+
+        WDT_RESET_COUNTER();
+        putchar('.');
+    }
+
+    FMC_DISABLE_AP_UPDATE();
+
+    u32Crc = GetWord();
+    if(DUALIMG_Commit(u32Slot, u32Len, u32Crc) != 0)
+    {
+        printf("\nImage rejected, CRC 0x%08X expected 0x%08X\n", DUALIMG_CalcCrc(0, (uint8_t *)DUALIMG_SLOT_BASE(u32Slot), u32Len), u32Crc);
+        return;
+    }
+
+    printf("\nSlot %c pending, reset to start it\n", 'A' + u32Slot);
+}
+
+int32_t main(void)
+{
+    DUALIMG_STATE_T sState;
+    int32_t i32Ch;
+
+    /* Unlock protected registers for ISP and WDT. A real application would lock them again. */
+    SYS_UnlockReg();
+
+    SYS_Init();
+
+    UART0_Init();
+
+    FMC_Open();
+
+    /*
+        This sample code shows A/B firmware update with rollback.
+        NOTE: VECMAP only valid when CBS = 00'b or 10'b.
+
+        To use this sample code, please:
+        1. Build all targets and download to device individually. The targets are:
+            FMC_DualImage,       RO=0x0,    boot manager
+            FMC_DualImage_SlotA, RO=0x1000
+            FMC_DualImage_SlotB, RO=0x8800
+        2. Reset MCU. The boot manager starts slot A.
+        3. Send the binary of the other slot with 'u', reset with 'r'. The new image runs on trial.
+           Without 'c' within the WDT period it is reset, and rolled back after DUALIMG_TRIAL_BOOTS resets.
+    */
+
+    printf("\n\n");
+    printf("+--------------------------------------------------------+\n");
+    printf("|    Dual Image Update Sample Code, running slot %c       |\n", 'A' + SLOT);
+    printf("+--------------------------------------------------------+\n");
+
+    if(DUALIMG_GetRunningSlot() != SLOT)
+    {
+        printf("Not started by the boot manager, VECMAP = 0x%X\n", FMC_GetVECMAP());
+        while(1);
+    }
+
+    ShowState();
+    DUALIMG_GetState(&sState);
+
+    while(1)
+    {
+        printf("\n[c] Confirm  [u] Update other slot  [r] Reset  [h] Hang  [s] State\n");
+
+        /* Feed the WDT only after confirmation, so an image left on trial is rolled back */
+        while(UART_GET_RX_EMPTY(UART0))
+        {
+            if((sState.u32Pending != SLOT) && (WDT->WTCR & WDT_WTCR_WTE_Msk))
+                WDT_RESET_COUNTER();
+        }
+        i32Ch = getchar();
+
+        switch(i32Ch)
+        {
+            case 'c':
+                printf("Confirm %s\n", (DUALIMG_Confirm() == 0) ? "done" : "failed");
+                ShowState();
+                DUALIMG_GetState(&sState);
+                break;
+
+            case 'u':
+                Update();
+                break;
+
+            case 'r':
+                printf("Reset\n");
+                UART_WAIT_TX_EMPTY(UART0);
+                SYS_ResetChip();
+                break;
+
+            case 'h':
+                printf("Hang, WDT resets the chip if it is running\n");
+                __disable_irq();
+                while(1);
+
+            case 's':
+                ShowState();
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+#endif
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
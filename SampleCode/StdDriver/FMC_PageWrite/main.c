@@ -0,0 +1,216 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/08 5:10p $
+ * @brief    NUC029 Series FMC page program sample code.
+ *           Compare word by word programming with FMC_WritePage on APROM and
+ *           Data Flash pages and report program time of each page.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define APROM_TEST_PAGE     0x8000          /* Must not overlap this program */
+#define DATA_FLASH_TEST_PAGE (FMC->DFBADR)
+
+#define PAGE_WORDS          (FMC_FLASH_PAGE_SIZE / 4)
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t s_au32Page[PAGE_WORDS];
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Test patterns. Sparse has every other word erased, like a partly used record page.                     */
+/*---------------------------------------------------------------------------------------------------------*/
+static void FillPage(uint32_t u32Pattern)
+{
+    uint32_t i, u32Seed = 0x12345678;
+
+    for(i = 0; i < PAGE_WORDS; i++)
+    {
+        u32Seed = u32Seed * 1103515245 + 12345;
+        if(u32Pattern == 0)
+            s_au32Page[i] = u32Seed;
+        else if(u32Pattern == 1)
+            s_au32Page[i] = (i & 1) ? 0xFFFFFFFF : u32Seed;
+        else
+            s_au32Page[i] = 0xFFFFFFFF;
+    }
+}
+
+/* Program the page with FMC_Write, one ISP command per word, and check it with FMC_Read */
+static int32_t WriteByWord(uint32_t u32Addr)
+{
+    uint32_t i;
+
+    for(i = 0; i < PAGE_WORDS; i++)
+    {
+        if(FMC_Write(u32Addr + i * 4, s_au32Page[i]) != 0)
+            return -1;
+    }
+
+    for(i = 0; i < PAGE_WORDS; i++)
+    {
+        if(FMC_Read(u32Addr + i * 4) != s_au32Page[i])
+            return -1;
+    }
+
+    return 0;
+}
+
+static int32_t TestPage(char *pcName, uint32_t u32Addr)
+{
+    static char *const s_apcPattern[] = {"random", "sparse", "erased"};
+    uint32_t u32Pattern, u32Start, u32Word, u32Page;
+    int32_t i32Cnt;
+
+    printf("%s page 0x%05X\n", pcName, u32Addr);
+    printf("  Pattern   Words   FMC_Write+Read   FMC_WritePage+verify\n");
+
+    for(u32Pattern = 0; u32Pattern < 3; u32Pattern++)
+    {
+        FillPage(u32Pattern);
+
+        FMC_Erase(u32Addr);
+        u32Start = TIMER0->TDR;
+        if(WriteByWord(u32Addr) != 0)
+        {
+            printf("  FMC_Write failed\n");
+            return -1;
+        }
+        u32Word = (TIMER0->TDR - u32Start) & TIMER_TDR_TDR_Msk;
+
+        FMC_Erase(u32Addr);
+        u32Start = TIMER0->TDR;
+        i32Cnt = FMC_WritePage(u32Addr, s_au32Page, FMC_WRITE_VERIFY);
+        u32Page = (TIMER0->TDR - u32Start) & TIMER_TDR_TDR_Msk;
+        if(i32Cnt < 0)
+        {
+            printf("  FMC_WritePage failed, error %d\n", g_FMC_i32ErrCode);
+            return -1;
+        }
+
+        printf("  %-8s  %3d     %6d us        %6d us\n", s_apcPattern[u32Pattern], i32Cnt,
+               u32Word / CyclesPerUs, u32Page / CyclesPerUs);
+    }
+
+    FMC_Erase(u32Addr);
+
+    return 0;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12MHz XTAL */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = CLK_PLLCON_50MHz_HXT;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Switch HCLK clock source to PLL */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable UART and Timer0 clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk;
+
+    /* UART clock source, Timer0 counts HCLK cycles */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_TMR0_S_HCLK;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+-----------------------------------------+\n");
+    printf("|   FMC Page Program Sample Code          |\n");
+    printf("+-----------------------------------------+\n\n");
+
+    /* Timer0 free running on HCLK as cycle counter */
+    TIMER0->TCMPR = TIMER_TDR_TDR_Msk;
+    TIMER0->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk | TIMER_TCSR_CEN_Msk;
+
+    /* Enable FMC ISP function and APROM update */
+    FMC_Open();
+    FMC_ENABLE_AP_UPDATE();
+
+    if(TestPage("APROM", APROM_TEST_PAGE) != 0)
+        goto lexit;
+
+    printf("\n");
+    if(TestPage("Data Flash", DATA_FLASH_TEST_PAGE) != 0)
+        goto lexit;
+
+    printf("\n*** FMC Page Program Test Done ***\n");
+
+lexit:
+
+    /* Disable APROM update and FMC ISP function */
+    FMC_DISABLE_AP_UPDATE();
+    FMC_Close();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
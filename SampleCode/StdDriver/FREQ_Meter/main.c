@@ -0,0 +1,173 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series frequency and duty meter sample code.
+ *           Timer3 sweeps a test signal from 1 Hz to 200 kHz, the meter
+ *           reads it on Timer1 with Timer0 as gate.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#define STEP_SECONDS        3       /* Time on each test frequency */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static const uint32_t s_au32TestHz[] = {1, 10, 100, 1000, 4000, 10000, 100000, 200000};
+
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    FREQ_GateHandler();
+}
+
+/**
+ * @brief       Timer1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer1 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR1_IRQHandler(void)
+{
+    FREQ_TimerHandler();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART and Timer module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(TMR1_MODULE);
+    CLK_EnableModuleClock(TMR3_MODULE);
+
+    /* Timer1 measures on HCLK for 20 ns resolution, the gate and the test signal run from the crystal */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0_S_HXT, 0);
+    CLK_SetModuleClock(TMR1_MODULE, CLK_CLKSEL1_TMR1_S_HCLK, 0);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3_S_HXT, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD, TXD, T1 and T1EX */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk | SYS_MFP_P35_Msk | SYS_MFP_P33_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0 | SYS_MFP_P35_T1 | SYS_MFP_P33_T1EX);
+
+    /* Set P1 multi-function pins for T3 */
+    SYS->P1_MFP &= ~SYS_MFP_P11_Msk;
+    SYS->P1_MFP |= SYS_MFP_P11_T3;
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    FREQ_RESULT_T sResult;
+    uint32_t u32Step, u32Sec, u32Wait;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------+\n");
+    printf("|    Frequency and Duty Meter Sample Code       |\n");
+    printf("+-----------------------------------------------+\n");
+    printf("  Connect T3(P1.1) to T1(P3.5) and T1EX(P3.3).\n\n");
+
+    FREQ_Open();
+
+    for(u32Step = 0; ; u32Step = (u32Step + 1) % (sizeof(s_au32TestHz) / sizeof(s_au32TestHz[0])))
+    {
+        /* Toggle output runs at half the timer frequency */
+        TIMER_Open(TIMER3, TIMER_TOGGLE_MODE, s_au32TestHz[u32Step] * 2);
+        TIMER_Start(TIMER3);
+        printf("Test signal %d Hz\n", s_au32TestHz[u32Step]);
+
+        for(u32Sec = 0; u32Sec < STEP_SECONDS; u32Sec++)
+        {
+            for(u32Wait = 0; u32Wait < 10; u32Wait++)
+                CLK_SysTickDelay(100000);
+
+            if(FREQ_Read(&sResult, 0) != 0)
+            {
+                printf("  no signal\n");
+                continue;
+            }
+
+            printf("  %s %d.%03d Hz +/- %d.%03d Hz", (sResult.u32Mode == FREQ_MODE_PERIOD) ? "period" : "count ",
+                   sResult.u32MilliHz / 1000, sResult.u32MilliHz % 1000,
+                   sResult.u32ResMilliHz / 1000, sResult.u32ResMilliHz % 1000);
+            if(sResult.u32Duty != FREQ_DUTY_UNKNOWN)
+                printf(", duty %d.%02d %%", sResult.u32Duty / 100, sResult.u32Duty % 100);
+            printf(", %d samples\n", sResult.u32Samples);
+        }
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
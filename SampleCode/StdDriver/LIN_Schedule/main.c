@@ -0,0 +1,228 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series LIN protocol stack sample code.
+ *           The master runs a schedule table from Timer2, the slave answers
+ *           from the UART1 interrupt. Build with LIN_NODE_MASTER 0 for the slave.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#ifndef LIN_NODE_MASTER
+#define LIN_NODE_MASTER     1
+#endif
+
+#define LIN_BAUD            19200
+
+/* Frame IDs */
+#define ID_COMMAND          0x10    /* Master to slave, 2 bytes */
+#define ID_STATUS           0x20    /* Slave to master, 4 bytes */
+
+#define REPORT_FRAMES       200     /* Status frames between reports */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#if LIN_NODE_MASTER
+static LIN_FRAME_T s_asFrames[] =
+{
+    {ID_COMMAND, 2, LIN_FRAME_PUBLISH},
+    {ID_STATUS, 4, 0},
+};
+
+/* 10 ms cycle, and a faster one with the status frame twice */
+static const LIN_SCHED_T s_asNormal[] = {{ID_COMMAND, 5}, {ID_STATUS, 5}};
+static const LIN_SCHED_T s_asFast[] = {{ID_COMMAND, 4}, {ID_STATUS, 3}, {ID_STATUS, 3}};
+#else
+static LIN_FRAME_T s_asFrames[] =
+{
+    {ID_COMMAND, 2, 0},
+    {ID_STATUS, 4, LIN_FRAME_PUBLISH},
+};
+#endif
+
+
+/**
+ * @brief       UART1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The UART1 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void UART1_IRQHandler(void)
+{
+    LIN_IRQHandler();
+}
+
+/**
+ * @brief       Timer2 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer2 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR2_IRQHandler(void)
+{
+    LIN_TimerHandler();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART0, UART1 and Timer2 module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(UART1_MODULE);
+    CLK_EnableModuleClock(TMR2_MODULE);
+
+    /* Select module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(UART1_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(TMR2_MODULE, CLK_CLKSEL1_TMR2_S_HXT, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+
+    /* Set P1 multi-function pins for UART1 RXD and TXD */
+    SYS->P1_MFP &= ~(SYS_MFP_P12_Msk | SYS_MFP_P13_Msk);
+    SYS->P1_MFP |= (SYS_MFP_P12_RXD1 | SYS_MFP_P13_TXD1);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+void PrintStats(void)
+{
+    LIN_STATS_T sStats;
+
+    LIN_GetStats(&sStats);
+    printf("Frames %d, errors: sync %d, parity %d, checksum %d, no response %d, incomplete %d, bit %d, framing %d\n",
+           sStats.u32Frames, sStats.u32Sync, sStats.u32Parity, sStats.u32Checksum, sStats.u32NoResponse,
+           sStats.u32Incomplete, sStats.u32BitError, sStats.u32Framing);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint8_t au8Command[2] = {0}, au8Status[4] = {0};
+    uint32_t u32Count = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------+\n");
+    printf("|    LIN %s Sample Code                     |\n", LIN_NODE_MASTER ? "Master" : "Slave ");
+    printf("+-----------------------------------------------+\n");
+    printf("  UART1 P1.2/P1.3 to a LIN transceiver, %d bit/s.\n\n", LIN_BAUD);
+
+    if(LIN_Open(LIN_BAUD, LIN_NODE_MASTER ? LIN_MODE_MASTER : LIN_MODE_SLAVE, s_asFrames,
+                sizeof(s_asFrames) / sizeof(s_asFrames[0])) != 0)
+    {
+        printf("LIN_Open failed\n");
+        while(1);
+    }
+
+#if LIN_NODE_MASTER
+    LIN_SetSchedule(s_asNormal, sizeof(s_asNormal) / sizeof(s_asNormal[0]));
+#endif
+
+    /* Frames are sent and received in interrupts, the main loop only sees completed frames */
+    while(1)
+    {
+        __WFI();
+
+#if LIN_NODE_MASTER
+        if(LIN_ReadFrame(&s_asFrames[1], au8Status) == 0)
+            continue;
+
+        /* Command follows the status of the slave */
+        au8Command[0] = au8Status[0] + 1;
+        au8Command[1] = u32Count & 0xFF;
+        LIN_WriteFrame(&s_asFrames[0], au8Command);
+
+        if(++u32Count % REPORT_FRAMES)
+            continue;
+
+        /* Alternate the schedule table on each report */
+        if((u32Count / REPORT_FRAMES) & 1)
+            LIN_SetSchedule(s_asFast, sizeof(s_asFast) / sizeof(s_asFast[0]));
+        else
+            LIN_SetSchedule(s_asNormal, sizeof(s_asNormal) / sizeof(s_asNormal[0]));
+#else
+        if(LIN_ReadFrame(&s_asFrames[0], au8Command) == 0)
+            continue;
+
+        /* Status echoes the command */
+        au8Status[0] = au8Command[0];
+        au8Status[1] = au8Command[1];
+        au8Status[2]++;
+        LIN_WriteFrame(&s_asFrames[1], au8Status);
+
+        if(++u32Count % REPORT_FRAMES)
+            continue;
+#endif
+
+        PrintStats();
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
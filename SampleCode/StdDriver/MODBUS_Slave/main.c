@@ -0,0 +1,187 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series Modbus RTU slave sample code.
+ *           Serves 16 coils, the P2 pins as discrete inputs, 32 holding
+ *           registers and the counters of the slave as input registers.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#define MB_SLAVE_ADDR       1
+#define MB_BAUD             115200
+
+#define HOLDING_NUM         32
+#define INPUT_REG_NUM       7       /* Uptime in seconds, then the MB_STATS_T counters */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint8_t s_au8Coils[2];
+static uint8_t s_u8Inputs;
+static uint16_t s_au16Holding[HOLDING_NUM];
+static uint16_t s_au16InputRegs[INPUT_REG_NUM];
+static volatile uint32_t s_u32Written = 0;
+
+void Written(uint32_t u32Func, uint32_t u32Addr, uint32_t u32Num);
+
+static const MB_MAP_T s_sMap =
+{
+    s_au8Coils, 0, 16,
+    &s_u8Inputs, 0, 8,
+    s_au16Holding, 0, HOLDING_NUM,
+    s_au16InputRegs, 0, INPUT_REG_NUM,
+    Written
+};
+
+
+/**
+ * @brief       UART1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The UART1 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void UART1_IRQHandler(void)
+{
+    MB_IRQHandler();
+}
+
+/* Runs in the UART interrupt, only note that the master changed something */
+void Written(uint32_t u32Func, uint32_t u32Addr, uint32_t u32Num)
+{
+    s_u32Written++;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(UART1_MODULE);
+
+    /* Select UART module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(UART1_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+
+    /* Set P1 multi-function pins for UART1 RXD and TXD */
+    SYS->P1_MFP &= ~(SYS_MFP_P12_Msk | SYS_MFP_P13_Msk);
+    SYS->P1_MFP |= (SYS_MFP_P12_RXD1 | SYS_MFP_P13_TXD1);
+
+    /* Set P0 multi-function pins for UART1 RTS */
+    SYS->P0_MFP = (SYS->P0_MFP & (~SYS_MFP_P01_Msk)) | SYS_MFP_P01_RTS1;
+}
+
+void UART0_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    MB_STATS_T sStats;
+    uint32_t u32Sec, u32Wait, u32Written = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------------------+\n");
+    printf("|     Modbus RTU Slave Sample Code, address %3d             |\n", MB_SLAVE_ADDR);
+    printf("+-----------------------------------------------------------+\n");
+    printf("  UART1 TXD(P1.3), RXD(P1.2) and RTS(P0.1) to an RS485 transceiver,\n");
+    printf("  %d bit/s, 8E1.\n\n", MB_BAUD);
+
+    /* UART1 is reset here, MB_Open() sets it up */
+    SYS_ResetModule(UART1_RST);
+    MB_Open(MB_BAUD, UART_PARITY_EVEN, MB_SLAVE_ADDR, &s_sMap);
+
+    /* Requests are served in the UART interrupt, the main loop only refreshes the inputs */
+    for(u32Sec = 0; ; u32Sec++)
+    {
+        for(u32Wait = 0; u32Wait < 10; u32Wait++)
+        {
+            s_u8Inputs = P2->PIN;
+            CLK_SysTickDelay(100000);
+        }
+
+        MB_GetStats(&sStats);
+        __disable_irq();
+        s_au16InputRegs[0] = u32Sec;
+        s_au16InputRegs[1] = sStats.u32Frames;
+        s_au16InputRegs[2] = sStats.u32Broadcast;
+        s_au16InputRegs[3] = sStats.u32Other;
+        s_au16InputRegs[4] = sStats.u32CrcError;
+        s_au16InputRegs[5] = sStats.u32Overrun;
+        s_au16InputRegs[6] = sStats.u32Exception;
+        __enable_irq();
+
+        if(s_u32Written != u32Written)
+        {
+            u32Written = s_u32Written;
+            printf("%d writes, coils 0x%02X%02X, holding[0] 0x%04X\n", u32Written, s_au8Coils[1], s_au8Coils[0],
+                   s_au16Holding[0]);
+        }
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,218 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series tickless power manager sample code.
+ *           Periodic tasks driven by software timers. Between them the chip
+ *           sleeps in Idle or Power-down mode, and residency is reported.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLLCON_SETTING      CLK_PLLCON_50MHz_HXT
+#define PLL_CLOCK           50000000
+
+/* Task priorities, 0 is the highest */
+#define TASK_SAMPLE         0
+#define TASK_REPORT         1
+
+/* Events */
+#define EVT_TIMER           BIT0
+#define EVT_SHORT           BIT1
+
+#define SAMPLE_MS           100     /* Sample task period */
+#define SHORT_MS            2       /* Conversion delay, too short for Power-down */
+#define REPORT_MS           5000    /* Report period */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static PM_TIMER_T s_sSampleTimer, s_sShortTimer, s_sReportTimer;
+static uint32_t s_u32Samples, s_u32Conversions, s_u32MaxLate;
+
+
+/**
+ * @brief       Timer1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer1 default IRQ, declared in startup_NUC029xAN.s. Timer1 is the power manager timebase.
+ */
+void TMR1_IRQHandler(void)
+{
+    PM_IRQHandler();
+}
+
+/* Timer callback, runs in TMR1_IRQHandler. Post an event to the task given as argument. */
+void PostTask(void *pvArg)
+{
+    SCHED_PostEvent((uint32_t)pvArg, EVT_TIMER);
+}
+
+/* Timer callback of the one-shot conversion delay */
+void ShortDone(void *pvArg)
+{
+    SCHED_PostEvent(TASK_SAMPLE, EVT_SHORT);
+}
+
+/* Short work every SAMPLE_MS. Every other sample waits SHORT_MS like a sensor conversion delay. */
+void Task_Sample(uint32_t u32Events, void *pvArg)
+{
+    uint32_t u32Late;
+
+    if(u32Events & EVT_TIMER)
+    {
+        /* Lateness against the ideal period grid shows the timebase stays exact across sleeps */
+        u32Late = PM_GetTicks() - (s_sSampleTimer.u32Expire - s_sSampleTimer.u32Period);
+        if(u32Late > s_u32MaxLate)
+            s_u32MaxLate = u32Late;
+
+        if((++s_u32Samples & 1) == 0)
+            PM_StartTimer(&s_sShortTimer, PM_MsToTicks(SHORT_MS), 0, ShortDone, NULL);
+    }
+
+    if(u32Events & EVT_SHORT)
+        s_u32Conversions++;
+}
+
+void Task_Report(uint32_t u32Events, void *pvArg)
+{
+    PM_STATS_T sStats;
+    uint32_t u32Total, u32Run, i;
+    static char *const s_apcMode[PM_MODE_NUM] = {"Idle", "Power-down"};
+    static uint32_t s_u32Last;
+
+    PM_GetStats(&sStats);
+    PM_ResetStats();
+
+    u32Total = PM_GetTicks() - s_u32Last;
+    s_u32Last += u32Total;
+    u32Run = u32Total - sStats.au32Ticks[PM_MODE_IDLE] - sStats.au32Ticks[PM_MODE_PD];
+
+    /* UART stops in Power-down, hold it off until the report is sent */
+    PM_Lock();
+
+    printf("\n%d ticks, %d samples, %d conversions, max lateness %d ticks\n", u32Total, s_u32Samples,
+           s_u32Conversions, s_u32MaxLate);
+    printf("  %-10s  %5d.%d%%\n", "Run", u32Run * 100 / u32Total, u32Run * 1000 / u32Total % 10);
+    for(i = 0; i < PM_MODE_NUM; i++)
+    {
+        printf("  %-10s  %5d.%d%%  %5d entries\n", s_apcMode[i], sStats.au32Ticks[i] * 100 / u32Total,
+               sStats.au32Ticks[i] * 1000 / u32Total % 10, sStats.au32Count[i]);
+    }
+    printf("  Max wake-up from Power-down %d ticks\n", sStats.u32MaxWakeup);
+
+    UART_WAIT_TX_EMPTY(UART0);
+    PM_Unlock();
+
+    s_u32MaxLate = 0;
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12 MHz XTAL */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = PLLCON_SETTING;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Switch HCLK clock source to PLL */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable peripheral clock. Timer1 is set up by PM_Open(). */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk;
+
+    /* Peripheral clock source */
+    CLK->CLKSEL1 = (CLK->CLKSEL1 & ~CLK_CLKSEL1_UART_S_Msk) | CLK_CLKSEL1_UART_S_PLL;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+------------------------------------------------+\n");
+    printf("|     Tickless Power Manager Sample Code         |\n");
+    printf("+------------------------------------------------+\n\n");
+
+    /* Timer1 on LIRC as timebase */
+    PM_Open();
+    printf("LIRC measured %d Hz\n", PM_Calibrate(1000));
+    printf("Sample task every %d ms, report every %d ms.\n", SAMPLE_MS, REPORT_MS);
+    printf("The project defines SCHED_IDLE() as PM_Idle(), so the scheduler sleeps through the power manager.\n");
+    UART_WAIT_TX_EMPTY(UART0);
+
+    SCHED_AddTask(TASK_SAMPLE, Task_Sample, NULL);
+    SCHED_AddTask(TASK_REPORT, Task_Report, NULL);
+
+    PM_StartTimer(&s_sSampleTimer, PM_MsToTicks(SAMPLE_MS), PM_MsToTicks(SAMPLE_MS), PostTask, (void *)TASK_SAMPLE);
+    PM_StartTimer(&s_sReportTimer, PM_MsToTicks(REPORT_MS), PM_MsToTicks(REPORT_MS), PostTask, (void *)TASK_REPORT);
+
+    /* Lock protected registers. PM_Idle() unlocks them while it changes clock settings. */
+    SYS_LockReg();
+
+    SCHED_Run();
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
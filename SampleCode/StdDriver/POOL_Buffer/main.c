@@ -0,0 +1,191 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/07 3:40p $
+ * @brief    NUC029 Series fixed-block memory pool sample code.
+ *           UART0 interrupt receives lines into blocks borrowed from a pool and hands
+ *           them to the main loop, which sends them back from the same block.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#define LINE_SIZE           32      /* Bytes per block, longest line received at once */
+#define LINE_NUM            4       /* Blocks in pool, lines waiting at most */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+/* Line buffers, LINE_SIZE * LINE_NUM bytes of SRAM */
+POOL_DEFINE(g_sLinePool, LINE_SIZE, LINE_NUM);
+
+/* Lines passed from UART0 interrupt to main loop. Holds every block of the pool, so it never overflows. */
+static uint8_t *s_apu8Line[LINE_NUM];
+static uint8_t s_au8LineLen[LINE_NUM];
+static volatile uint32_t s_u32LineHead = 0;
+static volatile uint32_t s_u32LineTail = 0;
+
+static uint8_t *s_pu8RxBlk = NULL;  /* Block being filled by UART0 interrupt */
+static uint32_t s_u32RxLen;
+static volatile uint32_t s_u32Dropped = 0;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* ISR to handle UART Channel 0 interrupt event                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+void UART0_IRQHandler(void)
+{
+    uint8_t u8InChar;
+
+    while(UART_IS_RX_READY(UART0))
+    {
+        u8InChar = UART_READ(UART0);
+
+        /* Borrow a block when a line starts */
+        if(s_pu8RxBlk == NULL)
+        {
+            s_pu8RxBlk = POOL_Alloc(&g_sLinePool);
+            s_u32RxLen = 0;
+            if(s_pu8RxBlk == NULL)
+            {
+                /* Main loop is behind, drop the character */
+                s_u32Dropped++;
+                continue;
+            }
+        }
+
+        s_pu8RxBlk[s_u32RxLen++] = u8InChar;
+
+        /* Pass the block to main loop at end of line or when full. Ownership moves with the pointer. */
+        if((u8InChar == '\r') || (s_u32RxLen == LINE_SIZE))
+        {
+            s_apu8Line[s_u32LineTail % LINE_NUM] = s_pu8RxBlk;
+            s_au8LineLen[s_u32LineTail % LINE_NUM] = (uint8_t)s_u32RxLen;
+            s_u32LineTail++;
+            s_pu8RxBlk = NULL;
+        }
+    }
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint8_t *pu8Line;
+    uint32_t u32Len, i;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf and testing */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+-----------------------------------------+\n");
+    printf("|     Fixed-Block Memory Pool Sample      |\n");
+    printf("+-----------------------------------------+\n\n");
+    printf("  Type text and press Enter. Each line is received into a %d byte pool block by\n", LINE_SIZE);
+    printf("  UART0 interrupt and written back from the same block, without copying.\n");
+    printf("  A line starting with '?' prints pool statistics.\n\n");
+
+    UART_EnableInt(UART0, UART_IER_RDA_IEN_Msk);
+
+    while(1)
+    {
+        if(s_u32LineHead == s_u32LineTail)
+            continue;
+
+        pu8Line = s_apu8Line[s_u32LineHead % LINE_NUM];
+        u32Len = s_au8LineLen[s_u32LineHead % LINE_NUM];
+        s_u32LineHead++;
+
+        if(pu8Line[0] == '?')
+        {
+            printf("\n  pool: %d blocks of %d bytes, %d free, peak %d used, %d failed, %d characters dropped\n",
+                   g_sLinePool.u16Blocks, g_sLinePool.u16BlockSize, POOL_GET_FREE(&g_sLinePool),
+                   g_sLinePool.u16Peak, g_sLinePool.u32Fail, s_u32Dropped);
+        }
+        else
+        {
+            /* Process in place, then send from the pool block */
+            for(i = 0; i < u32Len; i++)
+            {
+                if((pu8Line[i] >= 'a') && (pu8Line[i] <= 'z'))
+                    pu8Line[i] -= 'a' - 'A';
+            }
+            UART_Write(UART0, pu8Line, u32Len);
+            if(pu8Line[u32Len - 1] == '\r')
+                UART_Write(UART0, (uint8_t *)"\n", 1);
+        }
+
+        /* Give the block back, the interrupt handler may take it again at once */
+        POOL_Free(&g_sLinePool, pu8Line);
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
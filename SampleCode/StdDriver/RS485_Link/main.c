@@ -0,0 +1,217 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series RS485 link layer sample code.
+ *           The master polls the slaves in turn, each slave answers from the
+ *           frame callback. Build with RS485_NODE_ADDR set to a slave address
+ *           for the slaves.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+#define MASTER_ADDR         0xF0
+#define SLAVE_FIRST         0x01    /* Slaves are 0x01 ~ SLAVE_NUM */
+#define SLAVE_NUM           4
+
+#ifndef RS485_NODE_ADDR
+#define RS485_NODE_ADDR     MASTER_ADDR
+#endif
+
+#define RS485_BAUD          115200
+#define REPLY_TIMEOUT_US    5000
+#define REPORT_POLLS        1000
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint8_t s_au8Tx[16];
+
+
+/**
+ * @brief       UART1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The UART1 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void UART1_IRQHandler(void)
+{
+    RS485_IRQHandler();
+}
+
+#if (RS485_NODE_ADDR != MASTER_ADDR)
+/* Slave, answer each request with its sequence number and own address */
+void Reply(uint8_t *pu8Data, uint32_t u32Len)
+{
+    if(u32Len < 1)
+        return;
+
+    s_au8Tx[0] = pu8Data[0];
+    s_au8Tx[1] = RS485_NODE_ADDR;
+    RS485_Send(MASTER_ADDR, s_au8Tx, 2);
+}
+#endif
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(UART1_MODULE);
+
+    /* Select UART module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(UART1_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+
+    /* Set P1 multi-function pins for UART1 RXD and TXD */
+    SYS->P1_MFP &= ~(SYS_MFP_P12_Msk | SYS_MFP_P13_Msk);
+    SYS->P1_MFP |= (SYS_MFP_P12_RXD1 | SYS_MFP_P13_TXD1);
+
+    /* Set P0 multi-function pins for UART1 RTS */
+    SYS->P0_MFP = (SYS->P0_MFP & (~SYS_MFP_P01_Msk)) | SYS_MFP_P01_RTS1;
+}
+
+void UART0_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+void PrintStats(void)
+{
+    RS485_STATS_T sStats;
+    uint32_t i;
+
+    RS485_GetStats(&sStats);
+    printf("RX %d frames %d bytes, TX %d frames, %d interrupts\n", sStats.u32RxFrames, sStats.u32RxBytes,
+           sStats.u32TxFrames, sStats.u32Interrupts);
+    printf("  dropped %d, too long %d, line error %d, overflow %d\n", sStats.u32Dropped, sStats.u32TooLong,
+           sStats.u32LineError, sStats.u32Overflow);
+    for(i = 0; i < RS485_PEER_NUM; i++)
+    {
+        if(sStats.au32PeerTx[i])
+            printf("  TX to 0x%02X %d frames\n", i, sStats.au32PeerTx[i]);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint32_t u32Wait;
+#if (RS485_NODE_ADDR == MASTER_ADDR)
+    uint8_t au8Rx[RS485_MAX_FRAME];
+    uint32_t u32Poll, u32Slave, au32Miss[SLAVE_NUM] = {0};
+#endif
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------------------+\n");
+    printf("|     RS485 Link Layer Sample Code, node address 0x%02X       |\n", RS485_NODE_ADDR);
+    printf("+-----------------------------------------------------------+\n");
+    printf("  UART1 TXD(P1.3), RXD(P1.2) and RTS(P0.1) to an RS485 transceiver.\n\n");
+
+    /* UART1 is reset here, RS485_Open() sets it up */
+    SYS_ResetModule(UART1_RST);
+
+#if (RS485_NODE_ADDR == MASTER_ADDR)
+    RS485_Open(RS485_BAUD, RS485_NODE_ADDR, NULL);
+
+    for(u32Poll = 1; ; u32Poll++)
+    {
+        for(u32Slave = 0; u32Slave < SLAVE_NUM; u32Slave++)
+        {
+            s_au8Tx[0] = u32Poll & 0xFF;
+            RS485_Send(SLAVE_FIRST + u32Slave, s_au8Tx, 1);
+
+            /* Reply must carry the sequence number */
+            for(u32Wait = 0; u32Wait < REPLY_TIMEOUT_US / 100; u32Wait++)
+            {
+                if((RS485_Receive(au8Rx, sizeof(au8Rx)) >= 2) && (au8Rx[0] == s_au8Tx[0]))
+                    break;
+                CLK_SysTickDelay(100);
+            }
+            if(u32Wait == REPLY_TIMEOUT_US / 100)
+                au32Miss[u32Slave]++;
+        }
+
+        if(u32Poll % REPORT_POLLS)
+            continue;
+
+        printf("\n%d polls\n", u32Poll);
+        for(u32Slave = 0; u32Slave < SLAVE_NUM; u32Slave++)
+            printf("  slave 0x%02X missed %d\n", SLAVE_FIRST + u32Slave, au32Miss[u32Slave]);
+        PrintStats();
+    }
+#else
+    RS485_Open(RS485_BAUD, RS485_NODE_ADDR, Reply);
+
+    /* Frames to other slaves are filtered by the UART, the CPU only wakes up for its own */
+    while(1)
+    {
+        for(u32Wait = 0; u32Wait < 10; u32Wait++)
+            CLK_SysTickDelay(100000);
+        PrintStats();
+    }
+#endif
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,220 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/01 10:35a $
+ * @brief    NUC029 Series cooperative scheduler sample code.
+ *           Measure latency from interrupt posting an event to the task starting.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLLCON_SETTING      CLK_PLLCON_50MHz_HXT
+#define PLL_CLOCK           50000000
+
+/* Task priorities, 0 is the highest */
+#define TASK_TICK           0
+#define TASK_WORK           1
+#define TASK_REPORT         2
+
+/* Events */
+#define EVT_TICK            BIT0
+#define EVT_WORK            BIT0
+#define EVT_REPORT          BIT0
+
+#define TICK_FREQ           1000    /* Events posted per second from Timer1 interrupt */
+#define WORK_LOOPS          2000    /* Length of background work task */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+volatile uint32_t g_u32PostTime;    /* Timer0 count when tick event was posted */
+
+typedef struct
+{
+    uint32_t u32Count;
+    uint32_t u32Min;
+    uint32_t u32Max;
+    uint32_t u32Sum;
+} LATENCY_T;
+
+static LATENCY_T s_sLatency;
+static LATENCY_T s_sReport;
+
+
+/**
+ * @brief       Timer1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer1 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR1_IRQHandler(void)
+{
+    if(TIMER_GetIntFlag(TIMER1) == 1)
+    {
+        /* Clear Timer1 time-out interrupt flag */
+        TIMER_ClearIntFlag(TIMER1);
+
+        g_u32PostTime = TIMER0->TDR;
+        SCHED_PostEvent(TASK_TICK, EVT_TICK);
+    }
+}
+
+/* Highest priority task. Record dispatch latency in HCLK cycles. */
+void Task_Tick(uint32_t u32Events, void *pvArg)
+{
+    LATENCY_T *psLat = (LATENCY_T *)pvArg;
+    uint32_t u32Cycles = (TIMER0->TDR - g_u32PostTime) & TIMER_TDR_TDR_Msk;
+
+    if(u32Cycles < psLat->u32Min)
+        psLat->u32Min = u32Cycles;
+    if(u32Cycles > psLat->u32Max)
+        psLat->u32Max = u32Cycles;
+    psLat->u32Sum += u32Cycles;
+    psLat->u32Count++;
+
+    /* Some background work every 10 ticks */
+    if((psLat->u32Count % 10) == 0)
+        SCHED_PostEvent(TASK_WORK, EVT_WORK);
+
+    if(psLat->u32Count >= TICK_FREQ)
+    {
+        s_sReport = *psLat;
+        psLat->u32Count = 0;
+        psLat->u32Min = 0xFFFFFFFF;
+        psLat->u32Max = 0;
+        psLat->u32Sum = 0;
+        SCHED_PostEvent(TASK_REPORT, EVT_REPORT);
+    }
+}
+
+/* Lower priority work. A higher priority event posted meanwhile waits until it completes. */
+void Task_Work(uint32_t u32Events, void *pvArg)
+{
+    volatile uint32_t i;
+
+    for(i = 0; i < WORK_LOOPS; i++);
+}
+
+/* Lowest priority task. Printing is slow but only delays lower priority work. */
+void Task_Report(uint32_t u32Events, void *pvArg)
+{
+    uint32_t u32CyclesPerUs = SystemCoreClock / 1000000;
+
+    printf("dispatch latency (cycles): min %4d  avg %4d  max %5d  | (us): min %d  avg %d  max %d  | runs %d/%d/%d\n",
+           s_sReport.u32Min, s_sReport.u32Sum / s_sReport.u32Count, s_sReport.u32Max,
+           s_sReport.u32Min / u32CyclesPerUs, s_sReport.u32Sum / s_sReport.u32Count / u32CyclesPerUs,
+           s_sReport.u32Max / u32CyclesPerUs,
+           SCHED_GetRunCount(TASK_TICK), SCHED_GetRunCount(TASK_WORK), SCHED_GetRunCount(TASK_REPORT));
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12 MHz XTAL */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = PLLCON_SETTING;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Switch HCLK clock source to PLL, STCLK to HCLK/2 */
+    CLK->CLKSEL0 = CLK_CLKSEL0_STCLK_S_HCLK_DIV2 | CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable peripheral clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk | CLK_APBCLK_TMR1_EN_Msk;
+
+    /* Peripheral clock source. Timer0 counts HCLK cycles. */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_TMR0_S_HCLK | CLK_CLKSEL1_TMR1_S_HXT;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+------------------------------------------------+\n");
+    printf("|     Cooperative Scheduler Benchmark Sample     |\n");
+    printf("+------------------------------------------------+\n\n");
+    printf("  Timer1 posts %d events per second to the highest priority task.\n", TICK_FREQ);
+    printf("  Latency from post to task start is measured with Timer0 counting HCLK.\n");
+    printf("  CPU enters idle mode when no task is ready.\n\n");
+
+    /* Timer0 free running on HCLK as cycle counter */
+    TIMER0->TCMPR = TIMER_TDR_TDR_Msk;
+    TIMER0->TCSR = TIMER_CONTINUOUS_MODE | TIMER_TCSR_TDR_EN_Msk | TIMER_TCSR_CEN_Msk;
+
+    s_sLatency.u32Min = 0xFFFFFFFF;
+    SCHED_AddTask(TASK_TICK, Task_Tick, &s_sLatency);
+    SCHED_AddTask(TASK_WORK, Task_Work, NULL);
+    SCHED_AddTask(TASK_REPORT, Task_Report, NULL);
+
+    TIMER_Open(TIMER1, TIMER_PERIODIC_MODE, TICK_FREQ);
+    TIMER_EnableInt(TIMER1);
+    NVIC_EnableIRQ(TMR1_IRQn);
+    TIMER_Start(TIMER1);
+
+    /* Registers stay unlocked so that CLK_Idle() can clear PWR_DOWN_EN */
+    SCHED_Run();
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,165 @@
+#!/usr/bin/env python
+#
+# @file     tlog_render.py
+# @brief    Host renderer for NUC029 tokenized deferred log (tlog.h).
+#
+#           Reads the format strings from the application ELF file and turns a
+#           captured UART stream back into text. Plain ASCII bytes in the
+#           stream (e.g. printf output before logging started) are passed through.
+#
+#           Stream encoding:
+#             0xA0|argc id[2] varint[argc]   log frame
+#             0xB0 varint                    frames dropped on device
+#
+# @copyright SPDX-License-Identifier: Apache-2.0
+# @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+#
+import argparse
+import re
+import struct
+import sys
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 2
+
+FMT_RE = re.compile(r'%([-+ #0]*)(\d*)(\.\d+)?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+class Elf(object):
+    """Minimal ELF32 little endian section reader."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        d = self.data
+        if d[:4] != b'\x7fELF' or d[4:5] != b'\x01':
+            sys.exit('%s: not an ELF32 file' % path)
+        shoff, = struct.unpack_from('<I', d, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', d, 0x2E)
+        raw = []
+        for i in range(shnum):
+            raw.append(struct.unpack_from('<IIIIIIIIII', d, shoff + i * shentsize))
+        strtab = raw[shstrndx]
+        self.sections = []
+        for name, typ, flags, addr, off, size, _, _, _, _ in raw:
+            if typ != SHT_PROGBITS or size == 0:
+                continue
+            end = d.index(b'\0', strtab[4] + name)
+            sname = d[strtab[4] + name:end].decode('latin-1')
+            self.sections.append((sname, flags, addr, off, size))
+
+    def _cstr(self, off):
+        end = self.data.index(b'\0', off)
+        return self.data[off:end].decode('latin-1')
+
+    def string_at(self, addr):
+        """C string at a device address in a loaded section, or None."""
+        for name, flags, base, off, size in self.sections:
+            if (flags & SHF_ALLOC) and base <= addr < base + size:
+                return self._cstr(off + addr - base)
+        return None
+
+    def fmt(self, fid):
+        # GCC: non-loaded .tlog_fmt section, ID is the section address
+        for name, flags, base, off, size in self.sections:
+            if name.startswith('.tlog_fmt') and base <= fid < base + size:
+                return self._cstr(off + fid - base)
+        # Keil/IAR: string stays in flash, ID is the low 16 bits of its address
+        for name, flags, base, off, size in self.sections:
+            addr = (base & 0xFFFF0000) | fid
+            if (flags & SHF_ALLOC) and base <= addr < base + size:
+                return self._cstr(off + addr - base)
+        return None
+
+
+def render(elf, fmt, args):
+    it = iter(args)
+
+    def conv(m):
+        flags, width, prec, _, spec = m.groups()
+        if spec == '%':
+            return '%'
+        try:
+            v = next(it)
+        except StopIteration:
+            return m.group(0)
+        spec_py = '%' + flags + width + (prec or '')
+        if spec in 'di':
+            return (spec_py + 'd') % (v - (1 << 32) if v & 0x80000000 else v)
+        if spec == 'u':
+            return (spec_py + 'd') % v
+        if spec in 'xXo':
+            return (spec_py + spec) % v
+        if spec == 'c':
+            return (spec_py + 'c') % chr(v & 0xFF)
+        if spec == 'p':
+            return '0x%08x' % v
+        s = elf.string_at(v)
+        return (spec_py + 's') % (s if s is not None else '<str@0x%08X>' % v)
+
+    return FMT_RE.sub(conv, fmt)
+
+
+def varint(data, i):
+    v = 0
+    shift = 0
+    while True:
+        if i >= len(data):
+            raise IndexError
+        b = data[i]
+        i += 1
+        v |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return v & 0xFFFFFFFF, i
+
+
+def decode(elf, data, out):
+    data = bytearray(data)
+    i = 0
+    while i < len(data):
+        b = data[i]
+        try:
+            if 0xA0 <= b <= 0xA8:
+                fid = data[i + 1] | (data[i + 2] << 8)
+                j = i + 3
+                args = []
+                for _ in range(b & 0x0F):
+                    v, j = varint(data, j)
+                    args.append(v)
+                fmt = elf.fmt(fid)
+                if fmt is None:
+                    out.write('<unknown format id 0x%04X args %s>\n' % (fid, args))
+                else:
+                    out.write(render(elf, fmt, args))
+                i = j
+                continue
+            if b == 0xB0:
+                n, i = varint(data, i + 1)
+                out.write('*** %d log frames dropped ***\n' % n)
+                continue
+        except IndexError:
+            break
+        # Plain text outside log frames
+        if b < 0x80:
+            out.write(chr(b))
+        i += 1
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Render NUC029 tokenized log stream')
+    ap.add_argument('elf', help='application ELF/AXF file the device runs')
+    ap.add_argument('capture', help='binary UART capture, - for stdin')
+    args = ap.parse_args()
+
+    elf = Elf(args.elf)
+    if args.capture == '-':
+        data = getattr(sys.stdin, 'buffer', sys.stdin).read()
+    else:
+        with open(args.capture, 'rb') as f:
+            data = f.read()
+    decode(elf, data, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,175 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/01 10:35a $
+ * @brief    NUC029 Series binary event trace sample code.
+ *           Timestamp events from interrupt and thread context and drain them to UART0.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLLCON_SETTING      CLK_PLLCON_50MHz_HXT
+#define PLL_CLOCK           50000000
+
+/* Application event IDs. Keep in sync with trace_decode.py */
+#define EVT_TMR1_TICK       (TRACE_ID_USER + 0)
+#define EVT_WORK            (TRACE_ID_USER + 1)
+#define EVT_LOOP            (TRACE_ID_USER + 2)
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+volatile uint32_t g_u32TickCount = 0;
+
+
+/**
+ * @brief       Timer1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer1 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR1_IRQHandler(void)
+{
+    if(TIMER_GetIntFlag(TIMER1) == 1)
+    {
+        /* Clear Timer1 time-out interrupt flag */
+        TIMER_ClearIntFlag(TIMER1);
+
+        g_u32TickCount++;
+        TRACE_EVENT(EVT_TMR1_TICK, g_u32TickCount);
+    }
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12 MHz XTAL */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = PLLCON_SETTING;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Switch HCLK clock source to PLL, STCLK to HCLK/2 */
+    CLK->CLKSEL0 = CLK_CLKSEL0_STCLK_S_HCLK_DIV2 | CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable peripheral clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_TMR0_EN_Msk | CLK_APBCLK_TMR1_EN_Msk;
+
+    /* Peripheral clock source. Timer0 is the trace timestamp source. */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_TMR0_S_HXT | CLK_CLKSEL1_TMR1_S_HXT;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t u32Freq, u32Loop, i, u32Sum;
+    uint32_t u32LastTick = 0;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Enable FMC ISP function. Registers stay unlocked for FMC access. */
+    FMC_Open();
+
+    /* Start trace timestamp at 1 MHz before any instrumented driver call */
+    u32Freq = TRACE_Open(TIMER0, 1000000);
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+------------------------------------------------+\n");
+    printf("|         Binary Event Trace Sample Code         |\n");
+    printf("+------------------------------------------------+\n\n");
+    printf("  Timestamp: Timer0 @ %d Hz, ring of %d records.\n", u32Freq, TRACE_BUF_SIZE);
+    printf("  Capture the binary stream that follows and decode it on host with:\n");
+    printf("      python trace_decode.py --freq %d capture.bin\n", u32Freq);
+    printf("  Or dump g_sTraceBuf from the debugger and decode it with --dump.\n\n");
+
+    /* Wait for the banner to leave the UART before switching to binary stream */
+    UART_WAIT_TX_EMPTY(UART0);
+
+    /* Timer1 ticks 10 times per second and records an event from interrupt context */
+    TIMER_Open(TIMER1, TIMER_PERIODIC_MODE, 10);
+    TIMER_EnableInt(TIMER1);
+    NVIC_EnableIRQ(TMR1_IRQn);
+    TIMER_Start(TIMER1);
+
+    for(u32Loop = 0; ; u32Loop++)
+    {
+        if(g_u32TickCount != u32LastTick)
+        {
+            u32LastTick = g_u32TickCount;
+
+            /* Measure a section of application code */
+            TRACE_ENTER(EVT_WORK, u32Loop);
+            for(i = 0, u32Sum = 0; i < 1000; i++)
+                u32Sum += i;
+            TRACE_EXIT(EVT_WORK, u32Sum);
+
+            /* Instrumented driver calls record their own entry/exit events */
+            FMC_Read(FMC_APROM_BASE);
+
+            TRACE_Event32(TRACE_TYPE_POINT | EVT_LOOP, u32Loop);
+        }
+
+        /* Drain whatever fits into UART TX FIFO, never wait */
+        TRACE_Flush(UART0);
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
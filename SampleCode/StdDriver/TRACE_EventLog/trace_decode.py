@@ -0,0 +1,128 @@
+#!/usr/bin/env python
+#
+# @file     trace_decode.py
+# @brief    Host decoder for NUC029 binary event trace.
+#
+#           Input is either the UART stream produced by TRACE_Flush()
+#           (frames of A5 5A time[4] event[2] arg[2], little endian), or a raw
+#           memory dump of g_sTraceBuf (--dump), which carries its own header.
+#
+#           Output is a timeline with absolute and delta time in microseconds.
+#           Enter/exit pairs are matched per event ID and their duration printed.
+#
+# @copyright SPDX-License-Identifier: Apache-2.0
+# @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+#
+import argparse
+import struct
+import sys
+
+TRACE_MAGIC = 0x45435254
+SYNC = b'\xA5\x5A'
+
+TYPE_NAMES = {0: 'POINT', 1: 'ENTER', 2: 'EXIT ', 3: 'ARGHI'}
+
+# Keep in sync with trace.h and the application event IDs in main.c
+EVENT_NAMES = {
+    0x0101: 'UART_Open',
+    0x0102: 'UART_Read',
+    0x0103: 'UART_Write',
+    0x0104: 'UART_SetLine_Config',
+    0x0201: 'SPI_Open',
+    0x0202: 'SPI_Close',
+    0x0203: 'SPI_SetBusClock',
+    0x0301: 'I2C_Open',
+    0x0302: 'I2C_Close',
+    0x0303: 'I2C_SetBusClockFreq',
+    0x0401: 'FMC_Read',
+    0x0402: 'FMC_Write',
+    0x0403: 'FMC_Erase',
+    0x1000: 'TMR1_Tick',
+    0x1001: 'Work',
+    0x1002: 'Loop',
+    0x3FFF: '*** LOST ***',
+}
+
+
+def parse_stream(data):
+    """Yield (time, event, arg) from framed UART capture, resyncing on garbage."""
+    i = 0
+    while True:
+        i = data.find(SYNC, i)
+        if i < 0 or i + 10 > len(data):
+            return
+        yield struct.unpack_from('<IHH', data, i + 2)
+        i += 10
+
+
+def parse_dump(data):
+    """Yield (time, event, arg) from a memory dump of g_sTraceBuf, oldest first."""
+    magic, freq, size, head, tail, lost = struct.unpack_from('<6I', data, 0)
+    if magic != TRACE_MAGIC:
+        sys.exit('not a trace buffer dump (magic 0x%08X)' % magic)
+    if lost and head != tail:
+        # Report loss at the time of the oldest surviving record, as TRACE_Flush() does
+        t = struct.unpack_from('<I', data, 24 + (tail % size) * 8)[0]
+        yield (t, 0x3FFF, min(lost, 0xFFFF))
+    for n in range(tail, head):
+        yield struct.unpack_from('<IHH', data, 24 + (n % size) * 8)
+
+
+def dump_freq(data):
+    return struct.unpack_from('<I', data, 4)[0]
+
+
+def decode(records, freq, out):
+    to_us = 1e6 / freq
+    stack = {}
+    base = None
+    prev = None
+    last = None
+
+    for t, evt, arg in records:
+        typ = evt >> 14
+        eid = evt & 0x3FFF
+
+        if typ == 3:
+            # Upper half of previous record's argument
+            if last is not None and last[1] == eid:
+                out.write('%40s arg32 = 0x%08X (%d)\n' % ('', (arg << 16) | last[2], (arg << 16) | last[2]))
+            continue
+
+        if base is None:
+            base = t
+        # 32-bit timestamp wraps after 2^32 ticks
+        rel = (t - base) & 0xFFFFFFFF
+        delta = 0 if prev is None else (t - prev) & 0xFFFFFFFF
+        prev = t
+        last = (t, eid, arg)
+
+        name = EVENT_NAMES.get(eid, '0x%04X' % eid)
+        line = '%12.1f us  +%10.1f  %s  %-22s arg=0x%04X' % (rel * to_us, delta * to_us, TYPE_NAMES[typ], name, arg)
+
+        if typ == 1:
+            stack.setdefault(eid, []).append(t)
+        elif typ == 2 and stack.get(eid):
+            start = stack[eid].pop()
+            line += '  [%.1f us]' % (((t - start) & 0xFFFFFFFF) * to_us)
+        out.write(line + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Decode NUC029 binary event trace')
+    ap.add_argument('file', help='UART capture or g_sTraceBuf memory dump')
+    ap.add_argument('--dump', action='store_true', help='input is a memory dump of g_sTraceBuf')
+    ap.add_argument('--freq', type=int, default=1000000, help='timestamp frequency in Hz for UART capture')
+    args = ap.parse_args()
+
+    with open(args.file, 'rb') as f:
+        data = f.read()
+
+    if args.dump:
+        decode(parse_dump(data), dump_freq(data), sys.stdout)
+    else:
+        decode(parse_stream(data), args.freq, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,157 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series microsecond timebase and delay sample code.
+ *           Measures USEC_Delay() with SysTick counting HCLK and shows
+ *           the 64-bit timebase.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static const uint32_t s_au32DelayUs[] = {1, 2, 5, 10, 20, 50, 100, 101, 500, 2000};
+
+
+/**
+ * @brief       Timer3 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer3 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR3_IRQHandler(void)
+{
+    USEC_IRQHandler();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART and Timer3 module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(TMR3_MODULE);
+
+    /* Timebase counts the crystal, 1 MHz after the prescaler */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3_S_HXT, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P3 multi-function pins for UART0 RXD and TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/* HCLK cycles taken by USEC_Delay(), SysTick counts down */
+uint32_t MeasureDelay(uint32_t u32Us)
+{
+    uint32_t u32Start;
+
+    __disable_irq();
+    SysTick->VAL = 0;
+    u32Start = SysTick->VAL;
+    USEC_Delay(u32Us);
+    u32Start -= SysTick->VAL;
+    __enable_irq();
+
+    return u32Start & 0xFFFFFF;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    uint64_t u64Now;
+    uint32_t u32Cycles, i;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------+\n");
+    printf("|    Microsecond Timebase and Delay Sample Code |\n");
+    printf("+-----------------------------------------------+\n\n");
+
+    USEC_Open();
+
+    /* SysTick free running on HCLK, without interrupt */
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    printf("  Delay      Measured\n");
+    for(i = 0; i < sizeof(s_au32DelayUs) / sizeof(s_au32DelayUs[0]); i++)
+    {
+        u32Cycles = MeasureDelay(s_au32DelayUs[i]);
+        printf("  %4d us    %4d.%02d us (%d cycles)\n", s_au32DelayUs[i], u32Cycles / CyclesPerUs,
+               (u32Cycles % CyclesPerUs) * 100 / CyclesPerUs, u32Cycles);
+    }
+
+    printf("\nTimebase:\n");
+    while(1)
+    {
+        USEC_Delay(1000000);
+        u64Now = USEC_Get();
+        printf("  %d.%06d s\n", (uint32_t)(u64Now / 1000000), (uint32_t)(u64Now % 1000000));
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
@@ -0,0 +1,218 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series watchdog supervisor sample code.
+ *           Two tasks check in with the supervisor, which is serviced by
+ *           Timer0 and feeds WDT only while both meet their deadlines.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLLCON_SETTING      CLK_PLLCON_50MHz_HXT
+#define PLL_CLOCK           50000000
+
+#define SERVICE_MS          10      /* Timer0 period */
+#define USE_WWDT            0       /* 1 to feed WWDT instead of WDT */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t g_i32TaskA, g_i32TaskB;
+
+
+/**
+ * @brief       IRQ Handler for WDT and WWDT Interrupt
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The WDT_IRQHandler is default IRQ of WDT and WWDT, declared in startup_NUC029xAN.s.
+ */
+void WDT_IRQHandler(void)
+{
+    WDTS_IRQHandler();
+}
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    TIMER_ClearIntFlag(TIMER0);
+    WDTS_Service();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Enable IRC22M clock */
+    CLK->PWRCON |= CLK_PWRCON_IRC22M_EN_Msk;
+
+    /* Waiting for IRC22M clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_IRC22M_STB_Msk);
+
+    /* Switch HCLK clock source to HIRC */
+    CLK->CLKSEL0 = CLK_CLKSEL0_HCLK_S_HIRC;
+
+    /* Set PLL to Power-down mode and PLL_STB bit in CLKSTATUS register will be cleared by hardware.*/
+    CLK->PLLCON |= CLK_PLLCON_PD_Msk;
+
+    /* Enable external 12 MHz XTAL, IRC 10 kHz */
+    CLK->PWRCON |= CLK_PWRCON_XTL12M_EN_Msk | CLK_PWRCON_OSC10K_EN_Msk;
+
+    /* Enable PLL and Set PLL frequency */
+    CLK->PLLCON = PLLCON_SETTING;
+
+    /* Waiting for clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_PLL_STB_Msk | CLK_CLKSTATUS_XTL12M_STB_Msk | CLK_CLKSTATUS_IRC10K_STB_Msk);
+
+    /* Switch HCLK clock source to PLL, STCLK to HCLK/2 */
+    CLK->CLKSEL0 = CLK_CLKSEL0_STCLK_S_HCLK_DIV2 | CLK_CLKSEL0_HCLK_S_PLL;
+
+    /* Enable peripheral clock */
+    CLK->APBCLK = CLK_APBCLK_UART0_EN_Msk | CLK_APBCLK_WDT_EN_Msk | CLK_APBCLK_TMR0_EN_Msk;
+
+    /* Peripheral clock source, WWDT runs from HCLK/2048 */
+    CLK->CLKSEL1 = CLK_CLKSEL1_UART_S_PLL | CLK_CLKSEL1_WDT_S_LIRC | CLK_CLKSEL1_TMR0_S_HXT;
+    CLK->CLKSEL2 = CLK_CLKSEL2_WWDT_S_HCLK_DIV2048;
+
+    /* Update System Core Clock */
+    /* User can use SystemCoreClockUpdate() to calculate PllClock, SystemCoreClock and CyclesPerUs automatically. */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set P3 multi-function pins for UART0 RXD, TXD */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0);
+
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset IP */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+void ShowLog(void)
+{
+    const WDTS_LOG_T *psLog = WDTS_GetLog();
+    const WDTS_ENTRY_T *psEntry;
+    uint32_t i;
+
+    printf("Boot %d, %d watchdog resets\n", psLog->u32Boots, psLog->u32Resets);
+
+    i = (psLog->u32Count > WDTS_LOG_SIZE) ? psLog->u32Count - WDTS_LOG_SIZE : 0;
+    for(; i < psLog->u32Count; i++)
+    {
+        psEntry = &psLog->asEntry[i % WDTS_LOG_SIZE];
+        if(psEntry->u8Reason == WDTS_REASON_MISS)
+            printf("  Boot %d: task %d missed its deadline at %d ms\n", psEntry->u16Boot, psEntry->u8Client,
+                   psEntry->u32Tick * SERVICE_MS);
+        else
+            printf("  Boot %d: watchdog reset without a miss, service stalled\n", psEntry->u16Boot);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t u32Loop = 0, u32HangB = 0;
+    int32_t i32Ch;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
+    printf("+--------------------------------------+\n");
+    printf("|    Watchdog Supervisor Sample Code   |\n");
+    printf("+--------------------------------------+\n\n");
+
+    /* The log is checked and the reset counted before the watchdog starts */
+    WDTS_Open(USE_WWDT ? WDTS_HW_WWDT : WDTS_HW_WDT, SERVICE_MS);
+
+    /* Lock protected registers. The supervisor unlocks them to feed WDT. */
+    SYS_LockReg();
+
+    ShowLog();
+
+    /* Task A runs every 1 ms, task B every 100 ms */
+    g_i32TaskA = WDTS_Register(20);
+    g_i32TaskB = WDTS_Register(300);
+
+    TIMER_Open(TIMER0, TIMER_PERIODIC_MODE, 1000 / SERVICE_MS);
+    TIMER_EnableInt(TIMER0);
+    NVIC_EnableIRQ(TMR0_IRQn);
+    TIMER_Start(TIMER0);
+
+    printf("\n[b] Hang task B  [s] Stop the service  [c] Clear log\n");
+
+    /* Use P0.0 to show task A running */
+    GPIO_SetMode(P0, BIT0, GPIO_PMD_OUTPUT);
+
+    while(1)
+    {
+        /* Task A */
+        P00 ^= 1;
+        WDTS_CheckIn(g_i32TaskA);
+
+        /* Task B, stops checking in once it hangs */
+        if((++u32Loop % 100) == 0 && !u32HangB)
+            WDTS_CheckIn(g_i32TaskB);
+
+        if(!UART_GET_RX_EMPTY(UART0))
+        {
+            i32Ch = getchar();
+            if(i32Ch == 'b')
+            {
+                printf("Task B hangs, task A keeps running\n");
+                u32HangB = 1;
+            }
+            else if(i32Ch == 's')
+            {
+                printf("Service stopped, both tasks keep running\n");
+                NVIC_DisableIRQ(TMR0_IRQn);
+            }
+            else if(i32Ch == 'c')
+            {
+                WDTS_ClearLog();
+                printf("Log cleared\n");
+            }
+        }
+
+        CLK_SysTickDelay(1000);
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/
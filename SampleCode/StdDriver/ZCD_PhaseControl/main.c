@@ -0,0 +1,241 @@
+/**************************************************************************//**
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 14/10/09 3:10p $
+ * @brief    NUC029 Series zero-crossing detector sample code.
+ *           ACMP0 compares the mains waveform, reduced and biased to
+ *           half VDD, on ACMP0_P (P1.5) with the bias on ACMP0_N (P1.4).
+ *           Timer0 stamps the crossings and Timer1 fires a gate pulse on
+ *           P2.0 at a phase angle of each half cycle, as a triac dimmer.
+ *           Press '+' or '-' to move the angle by 10 degrees.
+ *
+ * @note
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2014 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stdio.h>
+#include "NUC029xAN.h"
+
+#define PLL_CLOCK           50000000
+
+/* ZCD_MODE_ISR, ZCD_MODE_CAPTURE_ACMP, or ZCD_MODE_CAPTURE_PIN with ACMP0_O (P3.6) wired to T0EX (P3.2) */
+#define SAMPLE_MODE         ZCD_MODE_ISR
+
+#define GATE_US             100         /* Gate pulse width */
+#define ANGLE_STEP          0x071C      /* 10 degrees */
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global Interface Variables Declarations                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+volatile uint32_t g_u32Angle = 90 * 0x10000 / 360;
+volatile uint32_t g_u32Armed = 0;
+volatile uint32_t g_u32Pulses = 0;
+
+
+/* Start Timer1 for the next gate pulse at the angle, in this half cycle or the next one */
+void ScheduleGate(void)
+{
+    uint32_t u32Time, u32Half, u32Delay;
+
+    if(ZCD_NextTime(g_u32Angle, &u32Time) != 0)
+    {
+        g_u32Armed = 0;
+        return;
+    }
+
+    if((ZCD_NextTime(g_u32Angle + ZCD_ANGLE_HALF, &u32Half) == 0) && ((int32_t)(u32Half - u32Time) < 0))
+        u32Time = u32Half;
+
+    /* Timer0 and Timer1 count the same clock */
+    u32Delay = u32Time - ZCD_GetTime();
+    if((int32_t)u32Delay < 2)
+        u32Delay = 2;
+
+    TIMER1->TCSR = TIMER_TCSR_CRST_Msk;
+    TIMER1->TCMPR = u32Delay;
+    TIMER1->TCSR = TIMER_ONESHOT_MODE | TIMER_TCSR_IE_Msk | TIMER_TCSR_CEN_Msk;
+    g_u32Armed = 1;
+}
+
+/**
+ * @brief       ACMP0/1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The ACMP01 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void ACMP01_IRQHandler(void)
+{
+    ZCD_AcmpHandler();
+}
+
+/**
+ * @brief       Timer0 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer0 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR0_IRQHandler(void)
+{
+    ZCD_TimerHandler();
+}
+
+/**
+ * @brief       Timer1 IRQ
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     The Timer1 default IRQ, declared in startup_NUC029xAN.s.
+ */
+void TMR1_IRQHandler(void)
+{
+    TIMER_ClearIntFlag(TIMER1);
+
+    P20 = 1;
+    CLK_SysTickDelay(GATE_US);
+    P20 = 0;
+    g_u32Pulses++;
+
+    ScheduleGate();
+}
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_OSC22M_EN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_OSC22M_STB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLK_S_HIRC, CLK_CLKDIV_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCON_XTL12M_EN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_CLKSTATUS_XTL12M_STB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART, ACMP01, Timer0 and Timer1 module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+    CLK_EnableModuleClock(ACMP01_MODULE);
+    CLK_EnableModuleClock(TMR0_MODULE);
+    CLK_EnableModuleClock(TMR1_MODULE);
+
+    /* Both timers count the crystal, 83 ns steps */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART_S_HXT, CLK_CLKDIV_UART(1));
+    CLK_SetModuleClock(TMR0_MODULE, CLK_CLKSEL1_TMR0_S_HXT, 0);
+    CLK_SetModuleClock(TMR1_MODULE, CLK_CLKSEL1_TMR1_S_HXT, 0);
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Set P1.4 and P1.5 multi-function pins for ACMP0 negative and positive input */
+    SYS->P1_MFP &= ~(SYS_MFP_P14_Msk | SYS_MFP_P15_Msk);
+    SYS->P1_MFP |= (SYS_MFP_P14_ACMP0_N | SYS_MFP_P15_ACMP0_P);
+
+    /* Disable digital input path of analog pins to prevent leakage */
+    GPIO_DISABLE_DIGITAL_PATH(P1, BIT4 | BIT5);
+
+    /* Set P3 multi-function pins for UART0 RXD, TXD, T0EX and ACMP0 output */
+    SYS->P3_MFP &= ~(SYS_MFP_P30_Msk | SYS_MFP_P31_Msk | SYS_MFP_P32_Msk | SYS_MFP_P36_Msk);
+    SYS->P3_MFP |= (SYS_MFP_P30_RXD0 | SYS_MFP_P31_TXD0 | SYS_MFP_P32_T0EX | SYS_MFP_P36_ACMP0_O);
+
+    /* P2.0 drives the gate */
+    P20 = 0;
+    P2->PMD = (P2->PMD & ~GPIO_PMD_PMD0_Msk) | (GPIO_PMD_OUTPUT << GPIO_PMD_PMD0_Pos);
+}
+
+void UART0_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Reset UART0 module */
+    SYS_ResetModule(UART0_RST);
+
+    /* Configure UART0 and set UART0 Baudrate */
+    UART_Open(UART0, 115200);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MAIN function                                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    ZCD_RESULT_T sResult;
+    uint32_t u32Report, u32Locked;
+    int32_t i32Angle;
+    char ch;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, peripheral clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 for printf */
+    UART0_Init();
+
+    printf("\n\nCPU @ %dHz\n", SystemCoreClock);
+    printf("+-----------------------------------------------+\n");
+    printf("|      Zero-Crossing Detector Sample Code       |\n");
+    printf("+-----------------------------------------------+\n\n");
+
+    /* Gate timer interrupt below the detector */
+    NVIC_SetPriority(TMR1_IRQn, 1);
+    NVIC_EnableIRQ(TMR1_IRQn);
+
+    ZCD_Open(SAMPLE_MODE);
+    u32Report = ZCD_GetTime();
+
+    printf("  Lock  Freq mHz  Period ns  Dev ns  Duty %%  Edges  Bounces  Resyncs  Angle  Pulses\n");
+
+    while(1)
+    {
+        /* Move the angle, 0 fires at the zero crossing */
+        if(!UART_GET_RX_EMPTY(UART0))
+        {
+            ch = UART_READ(UART0);
+            i32Angle = (int32_t)g_u32Angle + ((ch == '+') ? ANGLE_STEP : (ch == '-') ? -ANGLE_STEP : 0);
+            if((i32Angle >= 0) && (i32Angle < ZCD_ANGLE_HALF))
+                g_u32Angle = i32Angle;
+        }
+
+        /* Start firing once locked, the timer keeps it going */
+        if(!g_u32Armed)
+            ScheduleGate();
+
+        if(ZCD_GetTime() - u32Report >= __HXT)
+        {
+            u32Report += __HXT;
+            u32Locked = (ZCD_Read(&sResult) == 0);
+            printf("  %4s  %8d  %9d  %6d  %3d.%02d  %5d  %7d  %7d  %5d  %6d\n", u32Locked ? "yes" : "no",
+                   sResult.u32MilliHz, sResult.u32PeriodNs, sResult.u32ErrorNs, sResult.u32Duty / 100,
+                   sResult.u32Duty % 100, sResult.u32Edges, sResult.u32Rejected, sResult.u32Resyncs,
+                   g_u32Angle * 360 / 0x10000, g_u32Pulses);
+        }
+    }
+}
+
+/*** (C) COPYRIGHT 2013 Nuvoton Technology Corp. ***/